@@ -0,0 +1,191 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+// ------------------------------------------------------------------
+// Compares projected Gauss-Seidel and ADMM on square piles of spheres
+// resting on the ground (and on each other) with increasing numbers of
+// contacts, both from a cold start and warm started from the impulses of
+// the previous solve, and prints the per-iteration convergence of both
+// methods for the largest pile.
+//
+// usage: Ravelin-contact-benchmark [tolerance]
+// ------------------------------------------------------------------
+
+#include <cstdlib>
+#include <cmath>
+#include <cstdio>
+#include <sys/time.h>
+#include <boost/shared_ptr.hpp>
+#include <Ravelin/RigidBodyd.h>
+#include <Ravelin/ContactSolverd.h>
+
+using boost::shared_ptr;
+using namespace Ravelin;
+
+const shared_ptr<const Pose3d> GLOBAL_3D;
+const double RADIUS = 0.5, MASS = 1.0, MU = 0.6;
+
+// a pile of spheres: an n x n grid of columns, each h spheres high
+struct Pile
+{
+  std::vector<shared_ptr<RigidBodyd> > spheres;
+  std::vector<ContactSolverd::Contact> contacts;
+};
+
+// creates a sphere at the given position
+shared_ptr<RigidBodyd> create_sphere(const Origin3d& x)
+{
+  shared_ptr<RigidBodyd> rb(new RigidBodyd);
+  rb->set_pose(Pose3d(Quatd(0,0,0,1), x));
+  SpatialRBInertiad J;
+  J.pose = rb->get_pose();
+  J.m = MASS;
+  J.J = Matrix3d::identity()*(0.4*MASS*RADIUS*RADIUS);
+  rb->set_inertia(J);
+  return rb;
+}
+
+// gets the position of a sphere
+Vector3d get_position(shared_ptr<RigidBodyd> rb)
+{
+  return Pose3d::transform_point(GLOBAL_3D, Vector3d(0,0,0,rb->get_pose()));
+}
+
+// creates a contact between two spheres (or between a sphere and the ground, if s2 is null)
+ContactSolverd::Contact create_contact(shared_ptr<RigidBodyd> s1, shared_ptr<RigidBodyd> s2, uint64_t key)
+{
+  ContactSolverd::Contact c;
+  c.body1 = s1;
+  c.body2 = s2;
+  c.mu = MU;
+  c.key = key;
+
+  Vector3d x1 = get_position(s1);
+  if (!s2)
+  {
+    Vector3d n(0,1,0,GLOBAL_3D);
+    ContactSolverd::calc_contact_jacobian(s1, s1, x1 - n*RADIUS, n, c.J1);
+  }
+  else
+  {
+    Vector3d x2 = get_position(s2);
+    Vector3d n = Vector3d::normalize(x1 - x2);
+    Vector3d p = x2 + n*RADIUS;
+    ContactSolverd::calc_contact_jacobian(s1, s1, p, n, c.J1);
+    ContactSolverd::calc_contact_jacobian(s2, s2, p, n, c.J2);
+  }
+
+  return c;
+}
+
+// creates a pile; the spheres are slightly staggered so that contacts are not all aligned
+Pile create_pile(unsigned n, unsigned h)
+{
+  Pile pile;
+  for (unsigned i=0; i< n; i++)
+    for (unsigned j=0; j< n; j++)
+      for (unsigned k=0; k< h; k++)
+      {
+        double dx = 0.02*std::sin((double) (i+3*j+7*k));
+        double dz = 0.02*std::cos((double) (2*i+j+5*k));
+        Origin3d x(2.0*RADIUS*i + dx, RADIUS + 2.0*RADIUS*k, 2.0*RADIUS*j + dz);
+        shared_ptr<RigidBodyd> s = create_sphere(x);
+        pile.spheres.push_back(s);
+        shared_ptr<RigidBodyd> below;
+        if (k > 0)
+          below = pile.spheres[pile.spheres.size()-2];
+        pile.contacts.push_back(create_contact(s, below, pile.spheres.size()));
+
+        // contact with the neighboring columns
+        if (i > 0)
+          pile.contacts.push_back(create_contact(s, pile.spheres[pile.spheres.size()-1-n*h], pile.spheres.size() + 1000000));
+        if (j > 0)
+          pile.contacts.push_back(create_contact(s, pile.spheres[pile.spheres.size()-1-h], pile.spheres.size() + 2000000));
+      }
+
+  return pile;
+}
+
+// sets the velocities of the spheres in a pile (falling, with some spin)
+void set_velocities(Pile& pile)
+{
+  for (unsigned i=0; i< pile.spheres.size(); i++)
+  {
+    double s = std::sin((double) i), c = std::cos((double) i);
+    pile.spheres[i]->set_velocity(SVelocityd(0.3*c, 0.1*s, -0.2*s, 0.1*s, -1.0, 0.1*c, pile.spheres[i]->get_gc_pose()));
+  }
+}
+
+// gets the current time in seconds
+double get_time()
+{
+  timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + t.tv_usec*1e-6;
+}
+
+// solves the contacts in a pile, returning the number of iterations and the time (in milliseconds)
+unsigned solve(ContactSolverd& solver, Pile& pile, double& t)
+{
+  set_velocities(pile);
+  double start = get_time();
+  unsigned iters = solver.solve(pile.contacts);
+  t = (get_time() - start)*1e3;
+  return iters;
+}
+
+int main(int argc, char* argv[])
+{
+  const double TOL = (argc > 1) ? std::atof(argv[1]) : 1e-6;
+  const ContactSolverd::SolverType TYPES[2] = { ContactSolverd::ePGS, ContactSolverd::eADMM };
+  const char* NAMES[2] = { "PGS", "ADMM" };
+
+  std::printf("tolerance: %g\n", TOL);
+  std::printf("%8s %6s %10s %12s %10s %12s\n", "contacts", "method", "cold its", "cold (ms)", "warm its", "warm (ms)");
+  for (unsigned n=1; n<= 4; n *= 2)
+  {
+    Pile pile = create_pile(n, 4);
+    for (unsigned t=0; t< 2; t++)
+    {
+      ContactSolverd solver;
+      solver.solver_type = TYPES[t];
+      solver.tolerance = TOL;
+      solver.max_iterations = 10000;
+
+      // the cold start has no previous impulses; the warm start reuses the
+      // impulses from the cold start for the same (keyed) contacts
+      double t_cold, t_warm;
+      unsigned i_cold = solve(solver, pile, t_cold);
+      unsigned i_warm = solve(solver, pile, t_warm);
+      std::printf("%8u %6s %10u %12.3f %10u %12.3f\n", (unsigned) pile.contacts.size(), NAMES[t], i_cold, t_cold, i_warm, t_warm);
+    }
+  }
+
+  // print the convergence of both methods for the largest pile
+  Pile pile = create_pile(4, 4);
+  for (unsigned t=0; t< 2; t++)
+  {
+    ContactSolverd solver;
+    solver.solver_type = TYPES[t];
+    solver.tolerance = TOL;
+    solver.max_iterations = 10000;
+    double tm;
+    solve(solver, pile, tm);
+    const std::vector<ContactSolverd::Iteration>& telemetry = solver.get_telemetry();
+    std::printf("\n%s convergence (%u contacts)\n", NAMES[t], (unsigned) pile.contacts.size());
+    std::printf("%8s %14s %14s %14s\n", "iter", "max |dlambda|", "primal", "dual");
+    for (unsigned i=0; i< telemetry.size(); i++)
+    {
+      // print the first ten iterations, then every tenth, and the last
+      if (i >= 10 && i % 10 != 0 && i+1 != telemetry.size())
+        continue;
+      std::printf("%8u %14.4e %14.4e %14.4e\n", i, telemetry[i].impulse_change, telemetry[i].primal_residual, telemetry[i].dual_residual);
+    }
+  }
+
+  return 0;
+}
+
@@ -0,0 +1,154 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+// ------------------------------------------------------------------
+// Compares the running times of Featherstone's (serial) articulated body
+// algorithm and the (parallel) divide-and-conquer algorithm on serial chains
+// of increasing length, and reports the chain length beyond which the
+// divide-and-conquer algorithm is faster.
+//
+// usage: Ravelin-dca-benchmark [number of threads]
+// ------------------------------------------------------------------
+
+#include <cstdlib>
+#include <cmath>
+#include <cstdio>
+#include <sys/time.h>
+#include <boost/shared_ptr.hpp>
+#include <Ravelin/RCArticulatedBodyd.h>
+#include <Ravelin/RevoluteJointd.h>
+#include <Ravelin/ThreadPool.h>
+
+using boost::shared_ptr;
+using namespace Ravelin;
+
+// creates a fixed-base chain of n cylinders hanging from the origin,
+// connected by revolute joints whose axes alternate between x and z
+shared_ptr<RCArticulatedBodyd> create_chain(unsigned n)
+{
+  const shared_ptr<const Pose3d> GLOBAL_3D;
+  const double R = 0.025, H = 0.1;
+  std::vector<shared_ptr<RigidBodyd> > links;
+  std::vector<shared_ptr<Jointd> > joints;
+
+  // create the base
+  shared_ptr<RigidBodyd> base(new RigidBodyd);
+  base->body_id = "base";
+  base->set_enabled(false);
+  links.push_back(base);
+
+  // create the links and joints
+  for (unsigned i=0; i< n; i++)
+  {
+    shared_ptr<RigidBodyd> link(new RigidBodyd);
+    char buf[32];
+    sprintf(buf, "link%u", i);
+    link->body_id = buf;
+    link->set_pose(Pose3d(Quatd(0,0,0,1), Origin3d(0,-H*i-H/2.0,0)));
+    SpatialRBInertiad J;
+    J.pose = link->get_pose();
+    J.m = 1.0;
+    J.J.set_zero(3,3);
+    J.J(0,0) = J.J(2,2) = 1.0/12*J.m*H*H + 0.25*J.m*R*R;
+    J.J(1,1) = 0.5*J.m*R*R;
+    link->set_inertia(J);
+    links.push_back(link);
+
+    shared_ptr<RevoluteJointd> joint(new RevoluteJointd);
+    joint->set_location(Vector3d(0,-H*i,0,GLOBAL_3D), links[i], link);
+    joint->set_axis((i % 2 == 0) ? Vector3d(1,0,0,GLOBAL_3D) : Vector3d(0,0,1,GLOBAL_3D));
+    sprintf(buf, "joint%u", i);
+    joint->joint_id = buf;
+    joints.push_back(joint);
+  }
+
+  // create the body
+  shared_ptr<RCArticulatedBodyd> body(new RCArticulatedBodyd);
+  body->set_links_and_joints(links, joints);
+  body->set_floating_base(false);
+  body->set_computation_frame_type(eLink);
+
+  // set a nonzero configuration and velocity
+  VectorNd q, qd;
+  body->get_generalized_coordinates_euler(q);
+  body->get_generalized_velocity(DynamicBodyd::eSpatial, qd);
+  for (unsigned i=0; i< q.size(); i++)
+  {
+    q[i] = 0.1*std::sin((double) i);
+    qd[i] = 0.1*std::cos((double) i);
+  }
+  body->set_generalized_coordinates_euler(q);
+  body->set_generalized_velocity(DynamicBodyd::eSpatial, qd);
+
+  return body;
+}
+
+// gets the current time in seconds
+double get_time()
+{
+  timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + t.tv_usec*1e-6;
+}
+
+// gets the average time (in microseconds) of a forward dynamics computation
+double time_fwd_dyn(shared_ptr<RCArticulatedBodyd> body)
+{
+  // run for at least 0.2 seconds
+  unsigned iters = 0;
+  double start = get_time(), elapsed = 0.0;
+  do
+  {
+    for (unsigned i=0; i< 10; i++)
+      body->calc_fwd_dyn();
+    iters += 10;
+    elapsed = get_time() - start;
+  }
+  while (elapsed < 0.2);
+
+  return elapsed/iters*1e6;
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned NTHREADS = (argc > 1) ? std::atoi(argv[1]) : ThreadPool::num_processors();
+  int crossover = -1;
+  VectorNd qdd1, qdd2;
+
+  std::printf("threads: %u\n", NTHREADS);
+  std::printf("%8s %12s %12s %8s %12s\n", "links", "ABA (us)", "DCA (us)", "ratio", "max |diff|");
+  for (unsigned n=4; n<= 512; n *= 2)
+  {
+    shared_ptr<RCArticulatedBodyd> body = create_chain(n);
+    body->set_num_threads(NTHREADS);
+
+    // time Featherstone's algorithm
+    body->algorithm_type = RCArticulatedBodyd::eFeatherstone;
+    double t_aba = time_fwd_dyn(body);
+    body->get_generalized_acceleration(qdd1);
+
+    // time the divide-and-conquer algorithm
+    body->algorithm_type = RCArticulatedBodyd::eDivideAndConquer;
+    double t_dca = time_fwd_dyn(body);
+    body->get_generalized_acceleration(qdd2);
+
+    // compare the results
+    qdd2 -= qdd1;
+    std::printf("%8u %12.2f %12.2f %8.2f %12.3g\n", n, t_aba, t_dca, t_aba/t_dca, qdd2.norm_inf());
+    if (t_dca < t_aba && crossover < 0)
+      crossover = (int) n;
+    else if (t_dca >= t_aba)
+      crossover = -1;
+  }
+
+  if (crossover < 0)
+    std::printf("the divide-and-conquer algorithm was not faster for any of these chain lengths\n");
+  else
+    std::printf("the divide-and-conquer algorithm is faster for chains of %d or more links\n", crossover);
+
+  return 0;
+}
+
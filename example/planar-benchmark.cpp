@@ -0,0 +1,158 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+// ------------------------------------------------------------------
+// Times forward dynamics and joint space inertia computations for planar
+// serial chains of increasing length, using both the planar (3D spatial
+// algebra) algorithms of PlanarArticulatedBody and the general (6D) ones of
+// RCArticulatedBody on an equivalent chain moving in the plane.
+//
+// usage: Ravelin-planar-benchmark [number of iterations]
+// ------------------------------------------------------------------
+
+#include <cstdlib>
+#include <cmath>
+#include <cstdio>
+#include <sys/time.h>
+#include <boost/shared_ptr.hpp>
+#include <Ravelin/PlanarArticulatedBodyd.h>
+#include <Ravelin/RCArticulatedBodyd.h>
+#include <Ravelin/RevoluteJointd.h>
+
+using boost::shared_ptr;
+using namespace Ravelin;
+
+// creates a chain of n rods hanging from the origin in the x-y plane,
+// connected by revolute joints, both as a planar body and as a 3D body
+shared_ptr<RCArticulatedBodyd> create_chain(unsigned n, PlanarArticulatedBodyd& planar)
+{
+  const shared_ptr<const Pose3d> GLOBAL_3D;
+  const double L = 0.1, M = 1.0, J = M*L*L/12.0;
+  std::vector<shared_ptr<RigidBodyd> > links;
+  std::vector<shared_ptr<Jointd> > joints;
+
+  // create the base
+  shared_ptr<RigidBodyd> base(new RigidBodyd);
+  base->body_id = "base";
+  base->set_enabled(false);
+  links.push_back(base);
+
+  // create the links and joints
+  for (unsigned i=0; i< n; i++)
+  {
+    planar.add_link((int) i-1, PlanarArticulatedBodyd::eRevolute, Pose2d(Rot2d(0.0), Origin2d(0.0, (i == 0) ? 0.0 : -L)), M, Origin2d(0.0, -L/2.0), J);
+
+    shared_ptr<RigidBodyd> link(new RigidBodyd);
+    char buf[32];
+    sprintf(buf, "link%u", i);
+    link->body_id = buf;
+    link->set_pose(Pose3d(Quatd(0,0,0,1), Origin3d(0,-L*i-L/2.0,0)));
+    SpatialRBInertiad Jx;
+    Jx.pose = link->get_pose();
+    Jx.m = M;
+    Jx.J.set_zero(3,3);
+    Jx.J(0,0) = Jx.J(2,2) = J;
+    Jx.J(1,1) = 1e-3*J;
+    link->set_inertia(Jx);
+    links.push_back(link);
+
+    shared_ptr<RevoluteJointd> joint(new RevoluteJointd);
+    joint->set_location(Vector3d(0,-L*i,0,GLOBAL_3D), links[i], link);
+    joint->set_axis(Vector3d(0,0,1,GLOBAL_3D));
+    sprintf(buf, "joint%u", i);
+    joint->joint_id = buf;
+    joints.push_back(joint);
+  }
+
+  // create the body
+  shared_ptr<RCArticulatedBodyd> body(new RCArticulatedBodyd);
+  body->set_links_and_joints(links, joints);
+  body->set_floating_base(false);
+  return body;
+}
+
+// gets the current time in seconds
+double get_time()
+{
+  timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + t.tv_usec*1e-6;
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned NITER = (argc > 1) ? std::atoi(argv[1]) : 2000;
+  VectorNd q, qd, tau, qdd, qdd3;
+  MatrixNd H;
+
+  std::printf("iterations: %u\n", NITER);
+  std::printf("%6s %-12s %12s %12s %8s %10s\n", "links", "algorithm", "planar (us)", "3D (us)", "ratio", "max diff");
+  for (unsigned n=4; n<= 64; n *= 2)
+  {
+    PlanarArticulatedBodyd planar;
+    shared_ptr<RCArticulatedBodyd> body = create_chain(n, planar);
+    const std::vector<shared_ptr<RigidBodyd> >& links = body->get_links();
+    const std::vector<shared_ptr<Jointd> >& joints = body->get_joints();
+
+    // set a nonzero state and joint forces
+    q.resize(n);
+    qd.resize(n);
+    tau.resize(n);
+    for (unsigned i=0; i< n; i++)
+    {
+      q[i] = 0.3*std::sin((double) i);
+      qd[i] = 0.2*std::cos((double) i);
+      tau[i] = 0.1*std::sin(2.0*i);
+    }
+    body->set_generalized_coordinates_euler(q);
+    body->set_generalized_velocity(DynamicBodyd::eSpatial, qd);
+
+    // time the planar forward dynamics
+    double start = get_time();
+    for (unsigned k=0; k< NITER; k++)
+      planar.calc_fwd_dyn(q, qd, tau, qdd);
+    const double T_ABA = (get_time() - start)/NITER;
+
+    // time the planar joint space inertia
+    start = get_time();
+    for (unsigned k=0; k< NITER; k++)
+      planar.calc_joint_space_inertia(q, H);
+    const double T_CRBA = (get_time() - start)/NITER;
+
+    // time the 3D algorithms
+    for (unsigned alg=0; alg< 2; alg++)
+    {
+      body->algorithm_type = (alg == 0) ? RCArticulatedBodyd::eFeatherstone : RCArticulatedBodyd::eCRB;
+      start = get_time();
+      for (unsigned k=0; k< NITER; k++)
+      {
+        body->reset_accumulators();
+        for (unsigned i=1; i< links.size(); i++)
+          links[i]->add_force(SForced(0.0, -9.81*links[i]->get_mass(), 0.0, 0.0, 0.0, 0.0, links[i]->get_mixed_pose()));
+        for (unsigned i=0; i< joints.size(); i++)
+          joints[i]->force[0] = tau[i];
+        body->calc_fwd_dyn();
+      }
+      const double T_3D = (get_time() - start)/NITER;
+
+      // the accelerations must agree
+      body->get_generalized_acceleration(qdd3);
+      qdd3 -= qdd;
+      std::printf("%6u %-12s %12.2f %12.2f %8.2f %10.3g\n", n, (alg == 0) ? "fwd (ABA)" : "fwd (CRB)", T_ABA*1e6, T_3D*1e6, T_3D/T_ABA, qdd3.norm_inf());
+    }
+
+    // time the 3D joint space inertia
+    MatrixNd H3;
+    start = get_time();
+    for (unsigned k=0; k< NITER; k++)
+      body->get_generalized_inertia(H3);
+    const double T_H3 = (get_time() - start)/NITER;
+    H3 -= H;
+    std::printf("%6u %-12s %12.2f %12.2f %8.2f %10.3g\n", n, "inertia", T_CRBA*1e6, T_H3*1e6, T_H3/T_CRBA, H3.norm_inf());
+  }
+
+  return 0;
+}
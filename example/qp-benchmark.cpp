@@ -0,0 +1,169 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+// ------------------------------------------------------------------
+// Times the active-set QP solver on problems shaped like those solved by
+// whole-body controllers: n variables (accelerations and contact forces),
+// n/3 equality constraints (the equations of motion) and 2n inequality
+// constraints (torque limits and linearized friction cones), with a cost
+// that tracks a slowly varying set of task accelerations. A sequence of
+// problems is solved as in a 1 kHz control loop, both from a cold start and
+// warm started from the previous active set, and the number of heap
+// allocations made by the warm-started solves is reported.
+//
+// usage: Ravelin-qp-benchmark [number of control steps]
+// ------------------------------------------------------------------
+
+#include <cstdlib>
+#include <cmath>
+#include <cstdio>
+#include <new>
+#include <sys/time.h>
+#include <Ravelin/ActiveSetQPd.h>
+
+using namespace Ravelin;
+
+// counts heap allocations
+static unsigned long nallocs = 0;
+
+void* operator new(std::size_t sz)
+{
+  nallocs++;
+  void* p = std::malloc(sz ? sz : 1);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) throw() { std::free(p); }
+
+void* operator new[](std::size_t sz) { return operator new(sz); }
+
+void operator delete[](void* p) throw() { std::free(p); }
+
+#if __cplusplus >= 201402L
+void operator delete(void* p, std::size_t) throw() { std::free(p); }
+
+void operator delete[](void* p, std::size_t) throw() { std::free(p); }
+#endif
+
+// gets a random number in [-1, 1]
+double rnd()
+{
+  return 2.0*(double) rand()/RAND_MAX - 1.0;
+}
+
+// a whole-body control QP: min 1/2 |J*x - xdd(t)|^2 + eps*|x|^2 s.t. A*x = b, M*x >= q
+struct ControlQP
+{
+  MatrixNd G, J, A, M;
+  VectorNd c, b, q, xdd0;
+
+  ControlQP(unsigned n)
+  {
+    const unsigned ME = n/3, MI = 2*n, NTASK = n/2;
+    J.resize(NTASK, n);
+    A.resize(ME, n);
+    M.resize(MI, n);
+    xdd0.resize(NTASK);
+    for (unsigned i=0; i< NTASK; i++)
+    {
+      xdd0[i] = rnd();
+      for (unsigned j=0; j< n; j++)
+        J(i,j) = rnd();
+    }
+    for (unsigned i=0; i< ME; i++)
+      for (unsigned j=0; j< n; j++)
+        A(i,j) = rnd();
+    for (unsigned i=0; i< MI; i++)
+      for (unsigned j=0; j< n; j++)
+        M(i,j) = rnd();
+
+    // the constraints are satisfied (with some slack) at a random point
+    VectorNd xf(n);
+    for (unsigned j=0; j< n; j++)
+      xf[j] = 0.1*rnd();
+    A.mult(xf, b);
+    M.mult(xf, q);
+    for (unsigned i=0; i< MI; i++)
+      q[i] -= 0.5*(rnd() + 1.0);
+
+    // G = J'*J + eps*I
+    J.transpose_mult(J, G);
+    for (unsigned j=0; j< n; j++)
+      G(j,j) += 1e-3;
+    c.resize(n);
+  }
+
+  // sets the cost for control step k (c = -J'*xdd(t))
+  void update(unsigned k)
+  {
+    VectorNd xdd = xdd0;
+    for (unsigned i=0; i< xdd.size(); i++)
+      xdd[i] *= 10.0*(1.0 + 0.5*std::sin(0.002*k + i));
+    J.transpose_mult(xdd, c);
+    c.negate();
+  }
+};
+
+// gets the current time in seconds
+double get_time()
+{
+  timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + t.tv_usec*1e-6;
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned NSTEPS = (argc > 1) ? std::atoi(argv[1]) : 1000;
+  const unsigned SIZES[3] = { 30, 60, 100 };
+
+  std::printf("control steps: %u\n", NSTEPS);
+  std::printf("%6s %6s %6s %12s %12s %12s %12s %10s %10s\n", "n", "eq", "ineq", "cold (us)", "cold its", "warm (us)", "warm its", "max (us)", "allocs");
+  for (unsigned s=0; s< 3; s++)
+  {
+    srand(s);
+    ControlQP qp(SIZES[s]);
+    ActiveSetQPd cold, warm;
+    cold.warm_start = false;
+    VectorNd x;
+    double t_cold = 0.0, t_warm = 0.0, t_max = 0.0;
+    unsigned long its_cold = 0, its_warm = 0, allocs = 0;
+    unsigned failures = 0;
+
+    for (unsigned k=0; k< NSTEPS; k++)
+    {
+      qp.update(k);
+
+      // solve from a cold start
+      double start = get_time();
+      if (cold.solve(qp.G, qp.c, qp.A, qp.b, qp.M, qp.q, x) != ActiveSetQPd::eOptimal)
+        failures++;
+      t_cold += get_time() - start;
+      its_cold += cold.get_iterations();
+
+      // solve from the previous active set, counting allocations after the first step
+      unsigned long n0 = nallocs;
+      start = get_time();
+      if (warm.solve(qp.G, qp.c, qp.A, qp.b, qp.M, qp.q, x) != ActiveSetQPd::eOptimal)
+        failures++;
+      double t = get_time() - start;
+      if (k > 0)
+        allocs += nallocs - n0;
+      t_warm += t;
+      t_max = std::max(t_max, t);
+      its_warm += warm.get_iterations();
+    }
+
+    std::printf("%6u %6u %6u %12.2f %12.2f %12.2f %12.2f %10.2f %10lu\n", SIZES[s], qp.A.rows(), qp.M.rows(), t_cold/NSTEPS*1e6, (double) its_cold/NSTEPS, t_warm/NSTEPS*1e6, (double) its_warm/NSTEPS, t_max*1e6, allocs);
+    if (failures > 0)
+      std::printf("  %u solves did not find the optimum\n", failures);
+  }
+
+  return 0;
+}
+
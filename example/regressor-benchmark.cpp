@@ -0,0 +1,145 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+// ------------------------------------------------------------------
+// Times the computation of the dynamic-parameter regressor for serial chains
+// of increasing length, and the accumulation of the normal equations for
+// identifying the inertial parameters from a logged trajectory using
+// increasing numbers of threads. The trajectory is synthesized from the
+// true parameters, which must then satisfy the normal equations.
+//
+// usage: Ravelin-regressor-benchmark [number of samples]
+// ------------------------------------------------------------------
+
+#include <cstdlib>
+#include <cmath>
+#include <cstdio>
+#include <sys/time.h>
+#include <boost/shared_ptr.hpp>
+#include <Ravelin/RCArticulatedBodyd.h>
+#include <Ravelin/RevoluteJointd.h>
+#include <Ravelin/ThreadPool.h>
+
+using boost::shared_ptr;
+using namespace Ravelin;
+
+// creates a fixed-base chain of n cylinders hanging from the origin,
+// connected by revolute joints whose axes alternate between x and z
+shared_ptr<RCArticulatedBodyd> create_chain(unsigned n)
+{
+  const shared_ptr<const Pose3d> GLOBAL_3D;
+  const double R = 0.025, H = 0.1;
+  std::vector<shared_ptr<RigidBodyd> > links;
+  std::vector<shared_ptr<Jointd> > joints;
+
+  // create the base
+  shared_ptr<RigidBodyd> base(new RigidBodyd);
+  base->body_id = "base";
+  base->set_enabled(false);
+  links.push_back(base);
+
+  // create the links and joints
+  for (unsigned i=0; i< n; i++)
+  {
+    shared_ptr<RigidBodyd> link(new RigidBodyd);
+    char buf[32];
+    sprintf(buf, "link%u", i);
+    link->body_id = buf;
+    link->set_pose(Pose3d(Quatd(0,0,0,1), Origin3d(0,-H*i-H/2.0,0)));
+    SpatialRBInertiad J;
+    J.pose = link->get_pose();
+    J.m = 1.0;
+    J.J.set_zero(3,3);
+    J.J(0,0) = J.J(2,2) = 1.0/12*J.m*H*H + 0.25*J.m*R*R;
+    J.J(1,1) = 0.5*J.m*R*R;
+    link->set_inertia(J);
+    links.push_back(link);
+
+    shared_ptr<RevoluteJointd> joint(new RevoluteJointd);
+    joint->set_location(Vector3d(0,-H*i,0,GLOBAL_3D), links[i], link);
+    joint->set_axis((i % 2 == 0) ? Vector3d(1,0,0,GLOBAL_3D) : Vector3d(0,0,1,GLOBAL_3D));
+    sprintf(buf, "joint%u", i);
+    joint->joint_id = buf;
+    joints.push_back(joint);
+  }
+
+  // create the body
+  shared_ptr<RCArticulatedBodyd> body(new RCArticulatedBodyd);
+  body->set_links_and_joints(links, joints);
+  body->set_floating_base(false);
+
+  // set a nonzero configuration and velocity
+  VectorNd q, qd;
+  body->get_generalized_coordinates_euler(q);
+  body->get_generalized_velocity(DynamicBodyd::eSpatial, qd);
+  for (unsigned i=0; i< q.size(); i++)
+  {
+    q[i] = 0.1*std::sin((double) i);
+    qd[i] = 0.1*std::cos((double) i);
+  }
+  body->set_generalized_coordinates_euler(q);
+  body->set_generalized_velocity(DynamicBodyd::eSpatial, qd);
+
+  return body;
+}
+
+// gets the current time in seconds
+double get_time()
+{
+  timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + t.tv_usec*1e-6;
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned NSAMPLES = (argc > 1) ? std::atoi(argv[1]) : 2000;
+  const unsigned NTHREADS = ThreadPool::num_processors();
+  const Vector3d GRAVITY(0.0, -9.81, 0.0, shared_ptr<const Pose3d>());
+  MatrixNd Y, YtY;
+  VectorNd pi, qdd, tau, Ytau, r, x;
+
+  std::printf("samples: %u\n", NSAMPLES);
+  std::printf("%8s %8s %14s %10s %14s %12s\n", "links", "threads", "regressor (us)", "batch (s)", "samples / s", "residual");
+  for (unsigned n=6; n<= 24; n *= 2)
+  {
+    shared_ptr<RCArticulatedBodyd> body = create_chain(n);
+    body->get_inertial_parameters(pi);
+
+    // synthesize a trajectory and the joint forces that produce it 
+    MatrixNd q(n, NSAMPLES), qd(n, NSAMPLES), qdds(n, NSAMPLES), taus(n, NSAMPLES);
+    double t_reg = 0.0;
+    for (unsigned j=0; j< NSAMPLES; j++)
+    {
+      for (unsigned i=0; i< n; i++)
+      {
+        q(i,j) = std::sin(0.01*j*(i+1));
+        qd(i,j) = 0.01*(i+1)*std::cos(0.01*j*(i+1));
+        qdds(i,j) = -1e-4*(i+1)*(i+1)*std::sin(0.01*j*(i+1));
+      }
+      body->set_generalized_coordinates_euler(q.get_column(j, x));
+      body->set_generalized_velocity(DynamicBodyd::eSpatial, qd.get_column(j, x));
+      qdds.get_column(j, qdd);
+      double start = get_time();
+      body->calc_regressor(qdd, GRAVITY, Y);
+      t_reg += get_time() - start;
+      taus.set_column(j, Y.mult(pi, tau));
+    }
+
+    // accumulate the normal equations; the true parameters must satisfy them
+    for (unsigned nthreads=1; nthreads<= NTHREADS; nthreads *= 2)
+    {
+      double start = get_time();
+      body->calc_regressor_normal_equations(q, qd, qdds, taus, GRAVITY, YtY, Ytau, nthreads);
+      double t_batch = get_time() - start;
+      YtY.mult(pi, r) -= Ytau;
+      std::printf("%8u %8u %14.2f %10.3f %14.0f %12.3g\n", n, nthreads, t_reg/NSAMPLES*1e6, t_batch, NSAMPLES/t_batch, r.norm_inf()/Ytau.norm_inf());
+    }
+  }
+
+  return 0;
+}
+
@@ -0,0 +1,154 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+// ------------------------------------------------------------------
+// Times the 3D and spatial kernels (quaternion products and rotations,
+// 3x3 matrix products, spatial cross and dot products, and spatial
+// transforms) for the scalar instruction set and for every vector
+// instruction set that the processor supports, and reports the largest
+// difference from the scalar results.
+//
+// usage: Ravelin-simd-benchmark [number of iterations]
+// ------------------------------------------------------------------
+
+#include <cstdlib>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include <sys/time.h>
+#include <Ravelin/SIMD3d.h>
+
+using namespace Ravelin;
+
+// the number of inputs cycled through by each kernel
+const unsigned N = 256;
+
+// the kernels that are timed
+enum Kernel { eQuatMult, eQuatRotate, eMult, eTransposeMult, eMultTranspose, eTransposeMultTranspose, eMultVector, eTransposeMultVector, eSkewSymmetricMult, eSpatialCrossMotion, eSpatialCrossForce, eSpatialDot, eSpatialTransform, eSpatialInverseTransform, eNumKernels };
+
+const char* KERNEL_NAMES[eNumKernels] = { "quat_mult", "quat_rotate", "mult", "transpose_mult", "mult_transpose", "transpose_mult_transpose", "mult_vector", "transpose_mult_vector", "skew_symmetric_mult", "spatial_cross_motion", "spatial_cross_force", "spatial_dot", "spatial_transform", "spatial_inverse_transform" };
+
+// the inputs to the kernels
+struct Inputs
+{
+  std::vector<double> A, B, q, v, w;
+};
+
+// gets the current time in seconds
+double get_time()
+{
+  timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + t.tv_usec*1e-6;
+}
+
+// gets a random number in [-1, 1]
+double rnd()
+{
+  return 2.0*std::rand()/(double) RAND_MAX - 1.0;
+}
+
+// sets up random inputs (quaternions are normalized)
+void setup_inputs(Inputs& in)
+{
+  in.A.resize(N*9);
+  in.B.resize(N*9);
+  in.q.resize(N*4);
+  in.v.resize(N*6);
+  in.w.resize(N*6);
+  std::generate(in.A.begin(), in.A.end(), rnd);
+  std::generate(in.B.begin(), in.B.end(), rnd);
+  std::generate(in.v.begin(), in.v.end(), rnd);
+  std::generate(in.w.begin(), in.w.end(), rnd);
+  for (unsigned i=0; i< N; i++)
+  {
+    double* q = &in.q[i*4];
+    double nrm = 0.0;
+    for (unsigned j=0; j< 4; j++)
+    {
+      q[j] = rnd();
+      nrm += q[j]*q[j];
+    }
+    for (unsigned j=0; j< 4; j++)
+      q[j] /= std::sqrt(nrm);
+  }
+}
+
+// runs a kernel over all of the inputs, NITER times, storing the results in out (9 values per input); returns the time per call
+double run(Kernel k, unsigned NITER, const Inputs& in, std::vector<double>& out)
+{
+  const double* A = &in.A[0];
+  const double* B = &in.B[0];
+  const double* q = &in.q[0];
+  const double* v = &in.v[0];
+  const double* w = &in.w[0];
+  out.assign(N*9, 0.0);
+  double* r = &out[0];
+
+  #define LOOP(stmt) for (unsigned iter=0; iter< NITER; iter++) for (unsigned i=0; i< N; i++) { stmt; }
+  const double start = get_time();
+  switch (k)
+  {
+    case eQuatMult:                LOOP(SIMD3d::quat_mult(q+i*4, q+((i+1)%N)*4, r+i*9)); break;
+    case eQuatRotate:              LOOP(SIMD3d::quat_rotate(q+i*4, v+i*6, r+i*9)); break;
+    case eMult:                    LOOP(SIMD3d::mult(A+i*9, B+i*9, r+i*9)); break;
+    case eTransposeMult:           LOOP(SIMD3d::transpose_mult(A+i*9, B+i*9, r+i*9)); break;
+    case eMultTranspose:           LOOP(SIMD3d::mult_transpose(A+i*9, B+i*9, r+i*9)); break;
+    case eTransposeMultTranspose:  LOOP(SIMD3d::transpose_mult_transpose(A+i*9, B+i*9, r+i*9)); break;
+    case eMultVector:              LOOP(SIMD3d::mult_vector(A+i*9, v+i*6, r+i*9)); break;
+    case eTransposeMultVector:     LOOP(SIMD3d::transpose_mult_vector(A+i*9, v+i*6, r+i*9)); break;
+    case eSkewSymmetricMult:       LOOP(SIMD3d::skew_symmetric_mult(v+i*6, B+i*9, r+i*9)); break;
+    case eSpatialCrossMotion:      LOOP(SIMD3d::spatial_cross_motion(v+i*6, w+i*6, r+i*9)); break;
+    case eSpatialCrossForce:       LOOP(SIMD3d::spatial_cross_force(v+i*6, w+i*6, r+i*9)); break;
+    case eSpatialDot:              LOOP(r[i*9] += SIMD3d::spatial_dot(v+i*6, w+i*6)); break;
+    case eSpatialTransform:        LOOP(SIMD3d::spatial_transform(A+i*9, B+i*9, w+i*6, r+i*9)); break;
+    case eSpatialInverseTransform: LOOP(SIMD3d::spatial_inverse_transform(A+i*9, B+i*9, w+i*6, r+i*9)); break;
+    default: break;
+  }
+  #undef LOOP
+
+  return (get_time() - start)/((double) NITER*N);
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned NITER = (argc > 1) ? std::atoi(argv[1]) : 20000;
+  const SIMD3d::InstructionSet DEFAULT = SIMD3d::get_instruction_set();
+  const SIMD3d::InstructionSet ISETS[] = { SIMD3d::eSSE2, SIMD3d::eAVX2, SIMD3d::eAVX512 };
+  Inputs in;
+  std::vector<double> scalar_out, out;
+
+  setup_inputs(in);
+  std::printf("iterations: %u (x %u inputs)\n", NITER, N);
+  std::printf("selected instruction set: %s\n", SIMD3d::get_name(DEFAULT));
+  std::printf("%-26s %-8s %10s %10s %8s %10s\n", "kernel", "isa", "scalar (ns)", "isa (ns)", "speedup", "max diff");
+  for (unsigned k=0; k< eNumKernels; k++)
+  {
+    // time the scalar kernel
+    SIMD3d::set_instruction_set(SIMD3d::eScalar);
+    const double T_SCALAR = run((Kernel) k, NITER, in, scalar_out);
+
+    // time the kernel for each supported instruction set
+    for (unsigned j=0; j< sizeof(ISETS)/sizeof(ISETS[0]); j++)
+    {
+      if (!SIMD3d::set_instruction_set(ISETS[j]))
+        continue;
+      const double T = run((Kernel) k, NITER, in, out);
+
+      // the results must agree with the scalar results
+      double diff = 0.0;
+      for (unsigned i=0; i< out.size(); i++)
+        diff = std::max(diff, std::fabs(out[i] - scalar_out[i]));
+      std::printf("%-26s %-8s %10.2f %10.2f %8.2f %10.3g\n", KERNEL_NAMES[k], SIMD3d::get_name(ISETS[j]), T_SCALAR*1e9, T*1e9, T_SCALAR/T, diff);
+    }
+  }
+
+  // restore the selected instruction set
+  SIMD3d::set_instruction_set(DEFAULT);
+
+  return 0;
+}
@@ -0,0 +1,100 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef ACTIVE_SET_QP
+#error This class is not to be included by the user directly. Use ActiveSetQPd.h or ActiveSetQPf.h instead.
+#endif
+
+/// Solves dense, strictly convex quadratic programs using an active-set method
+/**
+ * The solver computes the solution x of:
+ *
+ *   min 1/2 x'*G*x + c'*x  subject to A*x = b, M*x >= q
+ *
+ * where G is symmetric positive definite, using the dual active-set method
+ * of Goldfarb and Idnani (1983). With G = L*L' and N the matrix whose
+ * columns are the normals of the active constraints, the method maintains
+ * the QR factorization inv(L)*N = Q*R, which is updated in O(n^2) time using
+ * LINALG::update_QR_insert_cols() and LINALG::update_QR_delete_cols() as
+ * constraints enter and leave the active set.
+ *
+ * The method requires no feasible starting point. When warm starting, the
+ * inequality constraints that were active at the solution of the previous
+ * call to solve() are made active first (and any with negative multipliers
+ * are then removed), so a sequence of similar problems (as in a control
+ * loop) typically requires only a few active-set changes per problem. Once
+ * the work matrices have grown to the problem size, solve() does not
+ * allocate memory.
+ */
+class ACTIVE_SET_QP
+{
+  public:
+    enum Status { eOptimal, eInfeasible, eMaxIterations, eNotConvex };
+
+    ACTIVE_SET_QP();
+    Status solve(const MATRIXN& G, const VECTORN& c, const MATRIXN& A, const VECTORN& b, const MATRIXN& M, const VECTORN& q, VECTORN& x);
+    void clear_warm_start() { _warm.clear(); }
+
+    /// Gets the indices of the inequality constraints that are active at the last solution
+    const std::vector<unsigned>& get_active_set() const { return _warm; }
+
+    /// Gets the multipliers of the equality constraints at the last solution
+    const VECTORN& get_equality_multipliers() const { return _lambda; }
+
+    /// Gets the multipliers of the inequality constraints at the last solution (zero for inactive constraints)
+    const VECTORN& get_inequality_multipliers() const { return _mu; }
+
+    /// Gets the number of active-set changes made by the last call to solve()
+    unsigned get_iterations() const { return _iterations; }
+
+    /// The maximum number of active-set changes
+    unsigned max_iterations;
+
+    /// The tolerance on constraint violation (and on negative multipliers when warm starting)
+    REAL tolerance;
+
+    /// Whether to warm start from the active set of the last call to solve()
+    bool warm_start;
+
+  private:
+    bool add_constraint(const MATRIXN& C, unsigned row, unsigned index);
+    void drop_constraint(unsigned j);
+    void solve_active_set(const VECTORN& c, const VECTORN& b, const VECTORN& q, VECTORN& x);
+    REAL calc_residual(unsigned index, const VECTORN& b, const VECTORN& q, const VECTORN& x) const;
+
+    /// The linear algebra object (for the QR updates)
+    LINALG _LA;
+
+    /// The Cholesky factor of G (G = U'*U)
+    MATRIXN _U;
+
+    /// The QR factorization of inv(U')*N
+    MATRIXN _Q, _R;
+
+    /// The constraints in the active set (equalities first; inequality i has index A.rows() + i)
+    std::vector<unsigned> _active;
+
+    /// The multipliers of the active constraints
+    VECTORN _u;
+
+    /// The equality and inequality constraint matrices of the problem being solved
+    const MATRIXN* _A;
+    const MATRIXN* _M;
+
+    /// Work variables
+    VECTORN _n, _v, _d, _z, _r, _slack;
+    MATRIXN _workM;
+
+    /// The multipliers at the last solution
+    VECTORN _lambda, _mu;
+
+    /// The active inequality constraints at the last solution
+    std::vector<unsigned> _warm;
+
+    /// The number of active-set changes made by the last call to solve()
+    unsigned _iterations;
+}; // end class
+
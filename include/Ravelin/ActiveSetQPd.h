@@ -0,0 +1,24 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_ACTIVE_SET_QPD_H
+#define _RAVELIN_ACTIVE_SET_QPD_H
+
+#include <vector>
+#include <Ravelin/MatrixNd.h>
+#include <Ravelin/VectorNd.h>
+#include <Ravelin/LinAlgd.h>
+
+namespace Ravelin {
+
+#include "ddefs.h"
+#include "ActiveSetQP.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
@@ -35,6 +35,9 @@ class ARTICULATED_BODY : public virtual DYNAMIC_BODY
     virtual MATRIXN& calc_jacobian(boost::shared_ptr<const POSE3> target_pose, boost::shared_ptr<DYNAMIC_BODY> body, MATRIXN& J);
     virtual MATRIXN& calc_jacobian_dot(boost::shared_ptr<const POSE3> target_pose, boost::shared_ptr<DYNAMIC_BODY> body, MATRIXN& J);
 
+    /// Notifies the body that the inertia of one of its links has changed (quantities depending on the inertias should be recomputed)
+    virtual void invalidate_inertias() { }
+
     /// Articulated bodies are always enabled
     virtual bool is_enabled() const { return true; }
 
@@ -32,6 +32,9 @@ class CRB_ALGORITHM
 
   private:
     void calc_fwd_dyn_special();
+    void calc_fwd_dyn_locked(const std::vector<bool>& unlocked);
+    void precalc_locked(boost::shared_ptr<RC_ARTICULATED_BODY> body);
+    VECTORN& M_solve_locked(VECTORN& xb);
     static boost::shared_ptr<const POSE3> get_computation_frame(boost::shared_ptr<RC_ARTICULATED_BODY> body);
     std::vector<unsigned> _lambda;
     void setup_parent_array();
@@ -107,7 +110,28 @@ class CRB_ALGORITHM
     std::vector<SVELOCITY> _J;
 
     // precalc
-    VECTORN _gc_last;
+    VECTORN _gc_last, _gc, _gc_delta;
+
+    /// Whether some generalized coordinates are locked (accelerations held at zero) during forward dynamics
+    bool _locked;
+
+    /// The generalized coordinates (rows of _M) that are not locked
+    std::vector<bool> _unlocked;
+
+    // precalc_locked(): the rows of _M that were unlocked and the generalized
+    // coordinates when _fM_locked was last computed
+    std::vector<bool> _unlocked_last;
+    VECTORN _gc_locked_last;
+
+    /// A factorization of the rows and columns of _M that are unlocked 
+    MATRIXN _fM_locked;
+
+    /// Determines whether the system of equations for the unlocked coordinates is rank-deficient
+    bool _rank_deficient_locked;
+
+    // temporaries for solving the system for the unlocked coordinates
+    MATRIXN _uM_locked, _vM_locked;
+    VECTORN _sM_locked, _x_locked;
 
     #include "CRBAlgorithm.inl"
 }; // end class
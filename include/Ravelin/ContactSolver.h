@@ -0,0 +1,164 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef CONTACT_SOLVER
+#error This class is not to be included by the user directly. Use ContactSolverd.h or ContactSolverf.h instead.
+#endif
+
+/// Computes contact impulses subject to friction cones for a set of contacts
+/**
+ * The solver computes the impulses lambda (one three-dimensional impulse per
+ * contact, in [normal; tangent; tangent] coordinates) that solve the cone
+ * complementarity problem (Anitescu and Tasora, 2010):
+ *
+ *   min 1/2 lambda'*A*lambda + lambda'*b  subject to lambda_i in K_i
+ *
+ * where A = J*inv(M)*J' is the Delassus operator, b = J*v + bias is the
+ * relative contact velocity before the impulses are applied (with the normal
+ * bias added), and K_i is the friction cone of contact i. The contact
+ * Jacobians are given as 3 x n blocks, one for each body at a contact, so
+ * J is never assembled. A is never formed either: inv(M)*J' is computed
+ * for each body using DYNAMIC_BODY::transpose_solve_generalized_inertia(),
+ * which uses the articulated body algorithm for reduced-coordinate bodies
+ * that use RC_ARTICULATED_BODY::eFeatherstone (and the factorized generalized
+ * inertia otherwise).
+ *
+ * Two methods are available: projected Gauss-Seidel (ePGS) and the
+ * alternating direction method of multipliers (eADMM); the latter solves its
+ * linear subproblems matrix-free using conjugate gradients. Both can be warm
+ * started from the impulses computed for contacts with the same key in the
+ * previous call to solve(). The change in impulses (and, for ADMM, the
+ * primal and dual residuals) are recorded for each iteration.
+ */
+class CONTACT_SOLVER
+{
+  public:
+    enum SolverType { ePGS, eADMM };
+
+    /// A contact between two bodies or between a body and the (static) environment
+    struct Contact
+    {
+      Contact() { mu = (REAL) 0.0; bias = (REAL) 0.0; key = 0; impulse.set_zero(); }
+
+      /// The bodies in contact; body2 may be null (or disabled) for contact with the environment
+      boost::shared_ptr<DYNAMIC_BODY> body1, body2;
+
+      /// The 3 x n Jacobians mapping the (spatial) generalized velocity of each body to the velocity of its contact point, projected onto [normal; tangent; tangent]
+      /**
+       * The normal points from body2 toward body1, so the relative velocity
+       * of the contact is J1*v1 - J2*v2 (see calc_contact_jacobian()).
+       */
+      MATRIXN J1, J2;
+
+      /// The coefficient of friction
+      REAL mu;
+
+      /// The bias added to the normal relative velocity (e.g., for restitution or stabilization)
+      REAL bias;
+
+      /// A key identifying the contact across calls to solve() for warm starting (0 to disable)
+      uint64_t key;
+
+      /// The computed impulse [normal; tangent; tangent], applied to body1 (and negated to body2)
+      ORIGIN3 impulse;
+    };
+
+    /// Convergence information for a single iteration
+    struct Iteration
+    {
+      /// The largest change in any impulse component
+      REAL impulse_change;
+
+      /// The primal and dual residuals (ADMM only)
+      REAL primal_residual, dual_residual;
+    };
+
+    CONTACT_SOLVER();
+    unsigned solve(std::vector<Contact>& contacts);
+    void clear_warm_start() { _warm.clear(); }
+    static MATRIXN& calc_contact_jacobian(boost::shared_ptr<DYNAMIC_BODY> body, boost::shared_ptr<RIGIDBODY> link, const VECTOR3& point, const VECTOR3& normal, MATRIXN& J);
+    static ORIGIN3 project_friction_cone(const ORIGIN3& lambda, REAL mu);
+
+    /// Gets the convergence information for each iteration of the last call to solve()
+    const std::vector<Iteration>& get_telemetry() const { return _telemetry; }
+
+    /// The method used to compute the impulses
+    SolverType solver_type;
+
+    /// The maximum number of iterations
+    unsigned max_iterations;
+
+    /// The solver terminates when the change in impulses (and, for ADMM, the residuals) fall below this tolerance
+    REAL tolerance;
+
+    /// The relaxation factor for PGS (in (0, 2))
+    REAL relaxation;
+
+    /// The initial ADMM penalty parameter (0 indicates that it is chosen from the Delassus operator)
+    REAL rho;
+
+    /// The maximum number of conjugate gradient iterations for each ADMM iteration
+    unsigned max_cg_iterations;
+
+    /// The factor by which impulses from the previous call to solve() are scaled before warm starting (0 disables warm starting)
+    REAL warm_start_factor;
+
+  private:
+    /// A body in contact
+    struct Body
+    {
+      /// The body
+      boost::shared_ptr<DYNAMIC_BODY> body;
+
+      /// The generalized velocity (updated as impulses change)
+      VECTORN v;
+
+      /// The stacked (signed) contact Jacobians of the body and inv(M) times their transpose
+      MATRIXN J, W;
+    };
+
+    /// Where the Jacobian of one side of a contact is stored
+    struct Side
+    {
+      /// The index of the body (-1 for none) and the first row of its Jacobian in Body::J
+      int body;
+      unsigned row;
+    };
+
+    int add_body(boost::shared_ptr<DYNAMIC_BODY> body, std::map<boost::shared_ptr<DYNAMIC_BODY>, unsigned>& index);
+    void setup(std::vector<Contact>& contacts);
+    ORIGIN3 calc_velocity(unsigned i) const;
+    void apply_impulse_change(unsigned i, const ORIGIN3& dlambda);
+    unsigned solve_pgs(std::vector<Contact>& contacts);
+    unsigned solve_admm(std::vector<Contact>& contacts);
+    void mult_delassus(const std::vector<ORIGIN3>& x, std::vector<ORIGIN3>& y);
+
+    /// The bodies in contact
+    std::vector<Body> _bodies;
+
+    /// The two sides of each contact
+    std::vector<Side> _sides[2];
+
+    /// The relative contact velocity (with the bias) before the impulses are applied
+    std::vector<ORIGIN3> _b;
+
+    /// The diagonal blocks of the Delassus operator
+    std::vector<MATRIX3> _D;
+
+    /// The impulses
+    std::vector<ORIGIN3> _lambda;
+
+    /// Work variables
+    std::vector<VECTORN> _workv;
+    std::vector<ORIGIN3> _r, _p, _Ap, _z, _y, _zprev;
+
+    /// The impulses from the last call to solve(), by contact key
+    std::map<uint64_t, ORIGIN3> _warm;
+
+    /// The convergence information from the last call to solve()
+    std::vector<Iteration> _telemetry;
+}; // end class
+
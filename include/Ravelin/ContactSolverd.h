@@ -0,0 +1,31 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_CONTACT_SOLVERD_H
+#define _RAVELIN_CONTACT_SOLVERD_H
+
+#include <map>
+#include <vector>
+#include <stdint.h>
+#include <boost/shared_ptr.hpp>
+#include <Ravelin/Origin3d.h>
+#include <Ravelin/Matrix3d.h>
+#include <Ravelin/Vector3d.h>
+#include <Ravelin/MatrixNd.h>
+#include <Ravelin/VectorNd.h>
+#include <Ravelin/DynamicBodyd.h>
+#include <Ravelin/RigidBodyd.h>
+
+namespace Ravelin {
+
+#include "ddefs.h"
+#include "ContactSolver.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
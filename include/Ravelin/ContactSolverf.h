@@ -0,0 +1,31 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_CONTACT_SOLVERF_H
+#define _RAVELIN_CONTACT_SOLVERF_H
+
+#include <map>
+#include <vector>
+#include <stdint.h>
+#include <boost/shared_ptr.hpp>
+#include <Ravelin/Origin3f.h>
+#include <Ravelin/Matrix3f.h>
+#include <Ravelin/Vector3f.h>
+#include <Ravelin/MatrixNf.h>
+#include <Ravelin/VectorNf.h>
+#include <Ravelin/DynamicBodyf.h>
+#include <Ravelin/RigidBodyf.h>
+
+namespace Ravelin {
+
+#include "fdefs.h"
+#include "ContactSolver.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
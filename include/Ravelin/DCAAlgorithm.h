@@ -0,0 +1,147 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef DCA_ALGORITHM
+#error This class is not to be included by the user directly. Use DCAAlgorithmd.h or DCAAlgorithmf.h instead.
+#endif
+
+class RC_ARTICULATED_BODY;
+
+/// Implements Featherstone's divide-and-conquer algorithm for forward dynamics
+/**
+ * The divide-and-conquer algorithm (Featherstone, "A Divide-and-Conquer
+ * Articulated-Body Algorithm for Parallel O(log(n)) Calculation of Rigid-Body
+ * Dynamics", 1999) treats each link as a subassembly with two handles (its
+ * inner and outer joints). Neighboring subassemblies are assembled pairwise
+ * into a balanced binary tree; the inverse inertias and bias accelerations at
+ * the handles of each subassembly are computed from those of its two
+ * children (assembly), after which the joint forces and accelerations are
+ * computed from the root down (disassembly). The subtrees at the same depth
+ * are independent, so the tree is split into as many subtrees as there are
+ * threads, each of which is processed on a thread of a pool; the remaining
+ * (top) levels of the tree are processed serially.
+ *
+ * The quantities of each handle are computed in a frame aligned with the
+ * global frame and located at the joint that the handle represents (the
+ * inner handle of the base of a floating-base chain is located at the base,
+ * and the outer handle of the last link at that link), regardless of the
+ * computation frame of the body; expressing the inertias of distant links in
+ * a single frame would make them, and the inverse inertias formed from them,
+ * increasingly ill-conditioned as the chain grows. The algorithm requires O(n) work and, with p threads, O(n/p + log(p)) time;
+ * each assembly costs several times as much as a step of Featherstone's
+ * algorithm, so it is only faster for long chains and several threads (see
+ * example/dca-benchmark.cpp).
+ *
+ * Only serial chains (each link has at most one child) are supported; for
+ * other topologies, and for joints whose equations are rank deficient,
+ * FSAB_ALGORITHM is used instead.
+ */
+class DCA_ALGORITHM
+{
+  friend class RC_ARTICULATED_BODY;
+
+  public:
+    DCA_ALGORITHM();
+    ~DCA_ALGORITHM() {}
+    boost::shared_ptr<RC_ARTICULATED_BODY> get_body() const { return boost::shared_ptr<RC_ARTICULATED_BODY>(_body); }
+    void set_body(boost::shared_ptr<RC_ARTICULATED_BODY> body) { _body = body; _chain.clear(); }
+    void calc_fwd_dyn();
+    void set_num_threads(unsigned nthreads);
+
+    /// Gets the number of threads used (zero indicates the number of processors)
+    unsigned get_num_threads() const { return _nthreads; }
+
+    /// The body that this algorithm operates on
+    boost::weak_ptr<RC_ARTICULATED_BODY> _body;
+
+  private:
+    /// A subassembly of consecutive links of the chain (a node of the assembly tree)
+    struct Subassembly
+    {
+      /// The indices (into the chain) of the first and last links
+      unsigned first, last;
+
+      /// The children of this node (-1 for a leaf)
+      int left, right;
+
+      /// The inverse inertias at the handles (Phi21 = Phi12'); Phi12 maps forces at the outer handle to accelerations at the inner handle
+      MATRIXN Phi11, Phi12, Phi22;
+
+      /// The bias accelerations of the handles
+      VECTORN b1, b2;
+
+      /// The forces applied at the handles (computed during disassembly)
+      VECTORN f1, f2;
+
+      /// Quantities for the joint connecting the children (see assemble())
+      MATRIXN P, G, D;
+      VECTORN e, beta;
+
+      /// Whether the joint equations could not be factorized
+      bool singular;
+
+      /// Work variables
+      MATRIXN workM;
+      VECTORN workv, workv2;
+    };
+
+    /// Per-link quantities gathered from the body (in the frame of the inner handle of the link)
+    struct LinkData
+    {
+      /// The rigid body inertia (forces in [torque; force] order)
+      MATRIXN M;
+
+      /// The negated isolated zero acceleration force (forces in [torque; force] order)
+      VECTORN f;
+
+      /// The spatial axes, velocity-product acceleration, generalized force, and implicit inertia of the inner joint
+      MATRIXN S;
+      VECTORN c, tau, H;
+
+      /// The computed spatial acceleration and joint acceleration
+      VECTORN a, qdd;
+    };
+
+    bool build_chain(boost::shared_ptr<RC_ARTICULATED_BODY> body);
+    int build_tree(unsigned first, unsigned last, unsigned depth, unsigned seg_depth, std::vector<unsigned>& top);
+    ORIGIN3 get_handle_location(unsigned k) const;
+    void gather(unsigned k);
+    void assemble(Subassembly& node, const Subassembly& A, const Subassembly& B, const LinkData& J);
+    void disassemble(Subassembly& node, Subassembly& A, Subassembly& B, LinkData& J);
+    void calc_leaf(Subassembly& node);
+    void calc_leaf_accel(Subassembly& node);
+    void assemble_segment(unsigned i);
+    void disassemble_segment(unsigned i);
+    static void assemble_segment_task(void* data, unsigned i);
+    static void disassemble_segment_task(void* data, unsigned i);
+
+    /// The number of threads (zero indicates the number of processors)
+    unsigned _nthreads;
+
+    /// The thread pool
+    boost::shared_ptr<ThreadPool> _pool;
+
+    /// The links of the chain, from the base outward
+    std::vector<boost::shared_ptr<RIGIDBODY> > _chain;
+
+    /// The per-link quantities
+    std::vector<LinkData> _links;
+
+    /// The frames of the inner handles of the links of the chain (aligned with the global frame); the outer handle of a link shares the frame of the next link
+    std::vector<boost::shared_ptr<POSE3> > _frames;
+
+    /// The nodes of the assembly tree, the root, and the ground (for fixed bases)
+    std::vector<Subassembly> _nodes;
+    int _root;
+    Subassembly _ground, _fixed_root;
+
+    /// The nodes of each subtree that is processed by a single thread (children before parents)
+    std::vector<std::vector<unsigned> > _segments;
+
+    /// The nodes above the subtrees (children before parents)
+    std::vector<unsigned> _top;
+}; // end class
+
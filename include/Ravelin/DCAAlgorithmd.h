@@ -0,0 +1,27 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_DCA_ALGORITHMD_H
+#define _RAVELIN_DCA_ALGORITHMD_H
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <Ravelin/ThreadPool.h>
+#include <Ravelin/Pose3d.h>
+#include <Ravelin/MatrixNd.h>
+#include <Ravelin/VectorNd.h>
+
+namespace Ravelin {
+
+#include "ddefs.h"
+#include "DCAAlgorithm.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
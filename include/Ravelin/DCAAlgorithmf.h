@@ -0,0 +1,27 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_DCA_ALGORITHMF_H
+#define _RAVELIN_DCA_ALGORITHMF_H
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <Ravelin/ThreadPool.h>
+#include <Ravelin/Pose3f.h>
+#include <Ravelin/MatrixNf.h>
+#include <Ravelin/VectorNf.h>
+
+namespace Ravelin {
+
+#include "fdefs.h"
+#include "DCAAlgorithm.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
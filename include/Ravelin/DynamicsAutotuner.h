@@ -0,0 +1,86 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef DYNAMICS_AUTOTUNER
+#error This class is not to be included by the user directly. Use DynamicsAutotunerd.h or DynamicsAutotunerf.h instead.
+#endif
+
+/// Selects the fastest forward dynamics algorithm and computation frame for an articulated body
+/**
+ * tune() times RC_ARTICULATED_BODY::calc_fwd_dyn() for every combination of
+ * forward dynamics algorithm and computation frame (a "configuration") over a
+ * set of randomized states of the body: the joint positions are perturbed and
+ * the generalized velocities and joint forces are chosen randomly. Each
+ * configuration must compute the same generalized accelerations as the
+ * configuration of the body when tune() was called. The fastest
+ * configuration that agrees is applied to the body and recorded under the
+ * hash of the body's model (see TRAJECTORY_WRITER::calc_model_hash()), so
+ * that apply() can configure other bodies of the same model without tuning.
+ * Recorded choices can be saved to and loaded from a text file.
+ */
+class DYNAMICS_AUTOTUNER
+{
+  public:
+    /// The timing of a single configuration
+    struct Timing
+    {
+      /// The forward dynamics algorithm
+      RC_ARTICULATED_BODY::ForwardDynamicsAlgorithmType algorithm;
+
+      /// The computation frame
+      ReferenceFrameType frame;
+
+      /// The mean time (in seconds) of a call to calc_fwd_dyn()
+      REAL time;
+
+      /// The largest difference from the reference accelerations, relative to the magnitude of the reference accelerations
+      REAL error;
+
+      /// Whether the configuration ran and agreed with the reference
+      bool agrees;
+    };
+
+    DYNAMICS_AUTOTUNER();
+    const Timing& tune(boost::shared_ptr<RC_ARTICULATED_BODY> body);
+    bool apply(boost::shared_ptr<RC_ARTICULATED_BODY> body) const;
+    void save(const std::string& fname) const;
+    void load(const std::string& fname);
+    void report(std::ostream& out) const;
+    static const char* get_name(RC_ARTICULATED_BODY::ForwardDynamicsAlgorithmType algorithm);
+    static const char* get_name(ReferenceFrameType frame);
+
+    /// Gets the timings of all configurations from the last call to tune()
+    const std::vector<Timing>& get_timings() const { return _timings; }
+
+    /// The number of randomized states
+    unsigned num_states;
+
+    /// The number of times that the dynamics are computed for each state and configuration
+    unsigned num_repetitions;
+
+    /// The largest perturbation of each joint position
+    REAL perturbation;
+
+    /// The largest allowable relative difference from the reference accelerations
+    REAL tolerance;
+
+    /// The seed used to generate the randomized states
+    unsigned seed;
+
+  private:
+    REAL random(REAL lo, REAL hi);
+
+    /// The state of the random number generator
+    unsigned _rng;
+
+    /// The chosen configuration for each model hash
+    std::map<uint64_t, std::pair<RC_ARTICULATED_BODY::ForwardDynamicsAlgorithmType, ReferenceFrameType> > _choices;
+
+    /// The timings from the last call to tune() and the index of the fastest
+    std::vector<Timing> _timings;
+    unsigned _best;
+}; // end class
+
@@ -0,0 +1,28 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_DYNAMICS_AUTOTUNERF_H
+#define _RAVELIN_DYNAMICS_AUTOTUNERF_H
+
+#include <map>
+#include <vector>
+#include <string>
+#include <ostream>
+#include <stdint.h>
+#include <boost/shared_ptr.hpp>
+#include <Ravelin/Types.h>
+#include <Ravelin/RCArticulatedBodyf.h>
+
+namespace Ravelin {
+
+#include "fdefs.h"
+#include "DynamicsAutotuner.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,120 @@
+/****************************************************************************
+ * Copyright 2013 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0 
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef MATRIXN
+#error This file is not to be included by the user directly. Use EigenInteropd.h or EigenInteropf.h instead.
+#endif
+
+/// Gets an Eigen view of a Ravelin matrix (no data is copied)
+inline Eigen::Map<Eigen::Matrix<REAL, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Unaligned, Eigen::OuterStride<> > eigen_map(MATRIXN& m)
+{
+  return Eigen::Map<Eigen::Matrix<REAL, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Unaligned, Eigen::OuterStride<> >(m.data(), m.rows(), m.columns(), Eigen::OuterStride<>(m.leading_dim()));
+}
+
+/// Gets a constant Eigen view of a Ravelin matrix (no data is copied)
+inline Eigen::Map<const Eigen::Matrix<REAL, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Unaligned, Eigen::OuterStride<> > eigen_map(const MATRIXN& m)
+{
+  return Eigen::Map<const Eigen::Matrix<REAL, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Unaligned, Eigen::OuterStride<> >(m.data(), m.rows(), m.columns(), Eigen::OuterStride<>(m.leading_dim()));
+}
+
+/// Gets an Eigen view of a Ravelin shared matrix (no data is copied)
+inline Eigen::Map<Eigen::Matrix<REAL, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Unaligned, Eigen::OuterStride<> > eigen_map(SHAREDMATRIXN& m)
+{
+  return Eigen::Map<Eigen::Matrix<REAL, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Unaligned, Eigen::OuterStride<> >(m.data(), m.rows(), m.columns(), Eigen::OuterStride<>(m.leading_dim()));
+}
+
+/// Gets a constant Eigen view of a Ravelin shared matrix (no data is copied)
+inline Eigen::Map<const Eigen::Matrix<REAL, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Unaligned, Eigen::OuterStride<> > eigen_map(const SHAREDMATRIXN& m)
+{
+  return Eigen::Map<const Eigen::Matrix<REAL, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Unaligned, Eigen::OuterStride<> >(m.data(), m.rows(), m.columns(), Eigen::OuterStride<>(m.leading_dim()));
+}
+
+/// Gets a constant Eigen view of a Ravelin constant shared matrix (no data is copied)
+inline Eigen::Map<const Eigen::Matrix<REAL, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Unaligned, Eigen::OuterStride<> > eigen_map(const CONST_SHAREDMATRIXN& m)
+{
+  return Eigen::Map<const Eigen::Matrix<REAL, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Unaligned, Eigen::OuterStride<> >(m.data(), m.rows(), m.columns(), Eigen::OuterStride<>(m.leading_dim()));
+}
+
+/// Gets an Eigen view of a Ravelin vector (no data is copied)
+inline Eigen::Map<Eigen::Matrix<REAL, Eigen::Dynamic, 1> > eigen_map(VECTORN& v)
+{
+  return Eigen::Map<Eigen::Matrix<REAL, Eigen::Dynamic, 1> >(v.data(), v.size());
+}
+
+/// Gets a constant Eigen view of a Ravelin vector (no data is copied)
+inline Eigen::Map<const Eigen::Matrix<REAL, Eigen::Dynamic, 1> > eigen_map(const VECTORN& v)
+{
+  return Eigen::Map<const Eigen::Matrix<REAL, Eigen::Dynamic, 1> >(v.data(), v.size());
+}
+
+/// Gets an Eigen view of a Ravelin shared vector, using its increment as the stride (no data is copied)
+inline Eigen::Map<Eigen::Matrix<REAL, Eigen::Dynamic, 1>, Eigen::Unaligned, Eigen::InnerStride<> > eigen_map(SHAREDVECTORN& v)
+{
+  return Eigen::Map<Eigen::Matrix<REAL, Eigen::Dynamic, 1>, Eigen::Unaligned, Eigen::InnerStride<> >(v.data(), v.size(), Eigen::InnerStride<>(v.inc()));
+}
+
+/// Gets a constant Eigen view of a Ravelin shared vector, using its increment as the stride (no data is copied)
+inline Eigen::Map<const Eigen::Matrix<REAL, Eigen::Dynamic, 1>, Eigen::Unaligned, Eigen::InnerStride<> > eigen_map(const SHAREDVECTORN& v)
+{
+  return Eigen::Map<const Eigen::Matrix<REAL, Eigen::Dynamic, 1>, Eigen::Unaligned, Eigen::InnerStride<> >(v.data(), v.size(), Eigen::InnerStride<>(v.inc()));
+}
+
+/// Gets a constant Eigen view of a Ravelin constant shared vector, using its increment as the stride (no data is copied)
+inline Eigen::Map<const Eigen::Matrix<REAL, Eigen::Dynamic, 1>, Eigen::Unaligned, Eigen::InnerStride<> > eigen_map(const CONST_SHAREDVECTORN& v)
+{
+  return Eigen::Map<const Eigen::Matrix<REAL, Eigen::Dynamic, 1>, Eigen::Unaligned, Eigen::InnerStride<> >(v.data(), v.size(), Eigen::InnerStride<>(v.inc()));
+}
+
+/// Wraps column-major Eigen storage as a Ravelin shared matrix (no data is copied)
+/**
+ * Accepts Eigen matrices, Maps, and blocks of column-major storage; 
+ * expressions without direct, column-major access fail to compile. The 
+ * Eigen object retains ownership of the storage and must outlive the view.
+ * Resizing the view beyond the wrapped storage detaches it.
+ */
+inline SHAREDMATRIXN shared_matrix(Eigen::Ref<Eigen::Matrix<REAL, Eigen::Dynamic, Eigen::Dynamic>, 0, Eigen::OuterStride<> > m)
+{
+  const unsigned LD = (unsigned) m.outerStride();
+  const unsigned SZ = (m.cols() == 0) ? 0 : LD*(m.cols()-1) + m.rows();
+  SharedResizable<REAL> data(boost::shared_array<REAL>(m.data(), EigenNullDeleter()), SZ);
+  return SHAREDMATRIXN(m.rows(), m.cols(), LD, 0, data);
+}
+
+/// Wraps a (contiguous) Eigen matrix as a constant Ravelin shared matrix (no data is copied)
+/**
+ * The Eigen matrix retains ownership of the storage and must outlive the view.
+ */
+inline CONST_SHAREDMATRIXN const_shared_matrix(const Eigen::Matrix<REAL, Eigen::Dynamic, Eigen::Dynamic>& m)
+{
+  SharedResizable<REAL> data(boost::shared_array<REAL>(const_cast<REAL*>(m.data()), EigenNullDeleter()), m.size());
+  return CONST_SHAREDMATRIXN(m.rows(), m.cols(), m.rows(), 0, data);
+}
+
+/// Wraps strided Eigen vector storage as a Ravelin shared vector (no data is copied)
+/**
+ * Accepts Eigen vectors, Maps, and segments, rows, or columns of 
+ * column-major matrices; the Eigen inner stride becomes the vector 
+ * increment. The Eigen object retains ownership of the storage and must
+ * outlive the view.
+ */
+inline SHAREDVECTORN shared_vector(Eigen::Ref<Eigen::Matrix<REAL, Eigen::Dynamic, 1>, 0, Eigen::InnerStride<> > v)
+{
+  const unsigned INC = (unsigned) v.innerStride();
+  const unsigned SZ = (v.size() == 0) ? 0 : INC*(v.size()-1) + 1;
+  SharedResizable<REAL> data(boost::shared_array<REAL>(v.data(), EigenNullDeleter()), SZ);
+  return SHAREDVECTORN(v.size(), INC, 0, data);
+}
+
+/// Wraps a (contiguous) Eigen vector as a constant Ravelin shared vector (no data is copied)
+/**
+ * The Eigen vector retains ownership of the storage and must outlive the view.
+ */
+inline CONST_SHAREDVECTORN const_shared_vector(const Eigen::Matrix<REAL, Eigen::Dynamic, 1>& v)
+{
+  SharedResizable<REAL> data(boost::shared_array<REAL>(const_cast<REAL*>(v.data()), EigenNullDeleter()), v.size());
+  return CONST_SHAREDVECTORN(v.size(), 1, 0, data);
+}
+
@@ -0,0 +1,27 @@
+/****************************************************************************
+ * Copyright 2013 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0 
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_EIGEN_INTEROPF_H
+#define _RAVELIN_EIGEN_INTEROPF_H
+
+#include <Eigen/Core>
+#include <Ravelin/SharedResizable>
+#include <Ravelin/EigenNullDeleter.h>
+#include <Ravelin/MatrixNf.h>
+#include <Ravelin/VectorNf.h>
+#include <Ravelin/SharedMatrixNf.h>
+#include <Ravelin/SharedVectorNf.h>
+
+namespace Ravelin {
+
+#include "fdefs.h"
+#include "EigenInterop.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
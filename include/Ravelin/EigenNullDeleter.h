@@ -0,0 +1,22 @@
+/****************************************************************************
+ * Copyright 2013 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0 
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_EIGEN_NULL_DELETER_H
+#define _RAVELIN_EIGEN_NULL_DELETER_H
+
+namespace Ravelin {
+
+/// Deleter for shared arrays that wrap Eigen-owned storage (does nothing)
+struct EigenNullDeleter
+{
+  template <class T>
+  void operator()(T*) const {}
+}; // end struct
+
+} // end namespace
+
+#endif
+
@@ -42,6 +42,7 @@ class FSAB_ALGORITHM
     boost::shared_ptr<RC_ARTICULATED_BODY> get_body() const { return boost::shared_ptr<RC_ARTICULATED_BODY>(_body); }
     void set_body(boost::shared_ptr<RC_ARTICULATED_BODY> body) { _body = body; }
     void calc_fwd_dyn();
+    void calc_hybrid_dyn();
     void calc_inverse_generalized_inertia_noprecalc(MATRIXN& iM);
     void solve_generalized_inertia_noprecalc(SHAREDVECTORN& v);
     void solve_generalized_inertia_noprecalc(SHAREDMATRIXN& Y);
@@ -95,6 +96,9 @@ class FSAB_ALGORITHM
     /// processed vector
     std::vector<bool> _processed;
 
+    /// Whether the recursions treat acceleration-prescribed joints specially 
+    bool _hybrid;
+
     void calc_fwd_dyn_special();
     static REAL sgn(REAL x);
     static void push_children(boost::shared_ptr<RIGIDBODY> link, std::queue<boost::shared_ptr<RIGIDBODY> >& q);
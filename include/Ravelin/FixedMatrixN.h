@@ -0,0 +1,83 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef FIXEDMATRIXN
+#error This class is not to be included by the user directly. Use FixedMatrixNd.h or FixedMatrixNf.h instead.
+#endif
+
+/// A matrix of at most R*C elements whose storage lies within the object
+/**
+ * A FIXEDMATRIXN is a MATRIXN (column-major, with leading dimension equal to
+ * the number of rows), so it can be passed anywhere a MATRIXN can, but
+ * resizing it to any dimensions with no more than R*C elements never
+ * allocates memory; a 6 x k spatial axis matrix (k <= 6) fits in a
+ * FIXEDMATRIXN<6,6>, for example. Like MATRIXN, a default constructed matrix
+ * is 0 x 0. Resizing beyond R*C elements moves the matrix to heap storage.
+ *
+ * Copying, moving, assigning, and swapping always copy elements; see
+ * FIXEDVECTORN.
+ */
+template <unsigned R, unsigned C>
+class FIXEDMATRIXN : public MATRIXN
+{
+  public:
+    FIXEDMATRIXN() { attach(); }
+    FIXEDMATRIXN(unsigned rows, unsigned columns) { attach(); resize(rows, columns); }
+    FIXEDMATRIXN(const FIXEDMATRIXN& m) : MATRIXN() { attach(); MATRIXN::operator=(m); }
+    FIXEDMATRIXN(const MATRIXN& m) : MATRIXN() { attach(); MATRIXN::operator=(m); }
+    FIXEDMATRIXN(const SHAREDMATRIXN& m) : MATRIXN() { attach(); MATRIXN::operator=(m); }
+    FIXEDMATRIXN(const CONST_SHAREDMATRIXN& m) : MATRIXN() { attach(); MATRIXN::operator=(m); }
+    FIXEDMATRIXN(const MATRIX3& m) : MATRIXN() { attach(); MATRIXN::operator=(m); }
+
+    /// Gets the number of elements that can be stored without allocating memory
+    static unsigned max_size() { return R*C; }
+
+    /// Determines whether the elements are stored within this object
+    bool is_inline() const { return _data.get() == _buf; }
+
+    using MATRIXN::operator=;
+
+    /// Copies another matrix
+    FIXEDMATRIXN& operator=(const FIXEDMATRIXN& m) { MATRIXN::operator=(m); return *this; }
+
+    #if __cplusplus >= 201103L
+    /// Copies another matrix (the storage of m is not taken)
+    FIXEDMATRIXN& operator=(MATRIXN&& m) { MATRIXN::operator=(m); return *this; }
+    #endif
+
+    /// Swaps the elements of this matrix with those of m
+    /**
+     * The elements are copied, through a temporary MATRIXN, which allocates
+     * memory; see FIXEDVECTORN::swap().
+     */
+    FIXEDMATRIXN& swap(MATRIXN& m)
+    {
+      MATRIXN tmp(m);
+      m = *this;
+      MATRIXN::operator=(tmp);
+      return *this;
+    }
+
+    /// Frees no memory (the storage is inline); sets the size to 0 x 0
+    void free_memory() { resize(0,0); }
+
+    /// Does nothing (the storage is inline)
+    void compress() { }
+
+  private:
+    /// Points the (0 x 0) matrix at the inline storage
+    void attach()
+    {
+      // alias the inline storage with an empty owner, so that nothing is
+      // allocated and nothing is ever deleted
+      _data = SharedResizable<REAL>(boost::shared_array<REAL>(boost::shared_array<REAL>(), _buf), R*C);
+      _data.resize(0);
+      _rows = _columns = 0;
+    }
+
+    REAL _buf[R*C];
+}; // end class
+
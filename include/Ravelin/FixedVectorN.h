@@ -0,0 +1,85 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef FIXEDVECTORN
+#error This class is not to be included by the user directly. Use FixedVectorNd.h or FixedVectorNf.h instead.
+#endif
+
+/// A vector of at most N elements whose storage lies within the object
+/**
+ * A FIXEDVECTORN is a VECTORN, so it can be passed anywhere a VECTORN can
+ * (including OPS, CBLAS, and LINALG routines), but resizing it to N or
+ * fewer elements never allocates memory. Like VECTORN, a default
+ * constructed vector has zero elements. Resizing beyond N elements moves the
+ * vector to heap storage.
+ *
+ * Copying, moving, assigning, and swapping always copy elements, including
+ * through a VECTORN reference (VECTORN only takes over storage that it
+ * owns), so the inline storage is never taken over by another vector. Views
+ * of a FIXEDVECTORN (from segment()) do not keep the storage alive. Because
+ * such copies may allocate memory, the VECTORN move operations are not
+ * noexcept.
+ */
+template <unsigned N>
+class FIXEDVECTORN : public VECTORN
+{
+  public:
+    FIXEDVECTORN() { attach(0); }
+    explicit FIXEDVECTORN(unsigned n) { attach(n); }
+    FIXEDVECTORN(const FIXEDVECTORN& v) : VECTORN() { attach(0); VECTORN::operator=(v); }
+    FIXEDVECTORN(const VECTORN& v) : VECTORN() { attach(0); VECTORN::operator=(v); }
+    FIXEDVECTORN(const SHAREDVECTORN& v) : VECTORN() { attach(0); VECTORN::operator=(v); }
+    FIXEDVECTORN(const CONST_SHAREDVECTORN& v) : VECTORN() { attach(0); VECTORN::operator=(v); }
+    FIXEDVECTORN(const VECTOR3& v) : VECTORN() { attach(0); VECTORN::operator=(v); }
+
+    /// Gets the number of elements that can be stored without allocating memory
+    static unsigned max_size() { return N; }
+
+    /// Determines whether the elements are stored within this object
+    bool is_inline() const { return _data.get() == _buf; }
+
+    using VECTORN::operator=;
+
+    /// Copies another vector
+    FIXEDVECTORN& operator=(const FIXEDVECTORN& v) { VECTORN::operator=(v); return *this; }
+
+    #if __cplusplus >= 201103L
+    /// Copies another vector (the storage of v is not taken)
+    FIXEDVECTORN& operator=(VECTORN&& v) { VECTORN::operator=(v); return *this; }
+    #endif
+
+    /// Swaps the elements of this vector with those of v
+    /**
+     * Unlike VECTORN::swap(), the elements are copied, through a temporary
+     * VECTORN; the temporary allocates memory.
+     */
+    FIXEDVECTORN& swap(VECTORN& v)
+    {
+      VECTORN tmp(v);
+      v = *this;
+      VECTORN::operator=(tmp);
+      return *this;
+    }
+
+    /// Frees no memory (the storage is inline); sets the size to zero
+    void free_memory() { resize(0); }
+
+    /// Does nothing (the storage is inline)
+    void compress() { }
+
+  private:
+    /// Points the vector at the inline storage, with n elements
+    void attach(unsigned n)
+    {
+      // alias the inline storage with an empty owner, so that nothing is
+      // allocated and nothing is ever deleted
+      _data = SharedResizable<REAL>(boost::shared_array<REAL>(boost::shared_array<REAL>(), _buf), N);
+      _data.resize(n);
+    }
+
+    REAL _buf[N];
+}; // end class
+
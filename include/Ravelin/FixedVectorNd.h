@@ -0,0 +1,23 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_FIXEDVECTORND_H
+#define _RAVELIN_FIXEDVECTORND_H
+
+#include <boost/shared_array.hpp>
+#include <Ravelin/SharedResizable>
+#include <Ravelin/VectorNd.h>
+
+namespace Ravelin {
+
+#include "ddefs.h"
+#include "FixedVectorN.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
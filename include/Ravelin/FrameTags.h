@@ -0,0 +1,43 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_FRAME_TAGS_H
+#define _RAVELIN_FRAME_TAGS_H
+
+namespace Ravelin {
+
+/// Tags that identify frames at compile time (see FramedSpatiald.h)
+/**
+ * A tag is any (empty) type; the tags below cover the frames used by the
+ * dynamics algorithms. Algorithms may define their own tags to distinguish
+ * further frames (e.g., the frames of two different links).
+ */
+namespace FrameTag {
+
+/// The global frame
+struct Global {};
+
+/// The frame of a link
+struct Link {};
+
+/// The frame of the parent (inboard) link of a link
+struct ParentLink {};
+
+/// The frame located at a link's center-of-mass and aligned with the global frame
+struct LinkCOM {};
+
+/// The frame of a joint
+struct Joint {};
+
+/// A frame located at a link's origin and aligned with the global frame
+struct Mixed {};
+
+} // end namespace FrameTag
+
+} // end namespace Ravelin
+
+#endif
+
@@ -0,0 +1,223 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef FRAMED_SPATIAL
+#error This class is not to be included by the user directly. Use FramedSpatiald.h or FramedSpatialf.h instead.
+#endif
+
+/// A three-dimensional vector whose frame is identified at compile time
+/**
+ * The frame is given by a tag type (see FrameTags.h) rather than a pose, so
+ * vectors carry no pose pointer and mixing frames is a compile error rather
+ * than a FrameException. Conversions from and to VECTOR3 are for API
+ * boundaries; the checked constructor verifies the pose of the VECTOR3.
+ */
+template <class Frame>
+class FRAMED_VECTOR3
+{
+  public:
+    FRAMED_VECTOR3() {}
+    FRAMED_VECTOR3(REAL x, REAL y, REAL z) : _v(x, y, z) {}
+    explicit FRAMED_VECTOR3(const ORIGIN3& v) : _v(v) {}
+    explicit FRAMED_VECTOR3(const VECTOR3& v) : _v(v) {}
+
+    /// Constructs a vector from a VECTOR3, verifying that it is defined in the given pose
+    FRAMED_VECTOR3(const VECTOR3& v, boost::shared_ptr<const POSE3> pose) : _v(v)
+    {
+      #ifndef NEXCEPT
+      if (v.pose != pose)
+        throw FrameException();
+      #endif
+    }
+
+    /// Converts this vector to a VECTOR3 defined in the given pose
+    VECTOR3 to_vector(boost::shared_ptr<const POSE3> pose) const { return VECTOR3(_v, pose); }
+
+    static FRAMED_VECTOR3 zero() { return FRAMED_VECTOR3(ORIGIN3::zero()); }
+    const ORIGIN3& get() const { return _v; }
+    REAL& operator[](unsigned i) { return _v[i]; }
+    const REAL& operator[](unsigned i) const { return _v[i]; }
+    REAL norm() const { return _v.norm(); }
+    REAL norm_sq() const { return _v.norm_sq(); }
+    REAL dot(const FRAMED_VECTOR3& v) const { return _v.dot(v._v); }
+    FRAMED_VECTOR3 cross(const FRAMED_VECTOR3& v) const { return FRAMED_VECTOR3(ORIGIN3::cross(_v, v._v)); }
+    FRAMED_VECTOR3 operator+(const FRAMED_VECTOR3& v) const { return FRAMED_VECTOR3(_v + v._v); }
+    FRAMED_VECTOR3 operator-(const FRAMED_VECTOR3& v) const { return FRAMED_VECTOR3(_v - v._v); }
+    FRAMED_VECTOR3 operator-() const { return FRAMED_VECTOR3(-_v); }
+    FRAMED_VECTOR3 operator*(REAL scalar) const { return FRAMED_VECTOR3(_v*scalar); }
+    FRAMED_VECTOR3& operator+=(const FRAMED_VECTOR3& v) { _v += v._v; return *this; }
+    FRAMED_VECTOR3& operator-=(const FRAMED_VECTOR3& v) { _v -= v._v; return *this; }
+    FRAMED_VECTOR3& operator*=(REAL scalar) { _v *= scalar; return *this; }
+
+  private:
+    ORIGIN3 _v;
+}; // end class
+
+/// A spatial vector (of type S) whose frame is identified at compile time
+/**
+ * S is the runtime-checked spatial type (SVELOCITY, SACCEL, SFORCE, or
+ * SMOMENTUM) that the vector converts to and from; it determines the layout
+ * of the upper and lower components (angular on top for velocities and
+ * accelerations, linear on top for forces and momenta). Frames and spatial
+ * types are both part of the type, so, e.g., adding a force to a velocity or
+ * a link frame velocity to a global frame velocity does not compile.
+ */
+template <class Frame, class S>
+class FRAMED_SPATIAL
+{
+  public:
+    FRAMED_SPATIAL() {}
+    FRAMED_SPATIAL(const ORIGIN3& upper, const ORIGIN3& lower) : _upper(upper), _lower(lower) {}
+    explicit FRAMED_SPATIAL(const S& s) : _upper(s.data()), _lower(s.data()+3) {}
+
+    /// Constructs a spatial vector from its runtime-checked type, verifying that it is defined in the given pose
+    FRAMED_SPATIAL(const S& s, boost::shared_ptr<const POSE3> pose) : _upper(s.data()), _lower(s.data()+3)
+    {
+      #ifndef NEXCEPT
+      if (s.pose != pose)
+        throw FrameException();
+      #endif
+    }
+
+    /// Converts this vector to its runtime-checked type, defined in the given pose
+    S to_spatial(boost::shared_ptr<const POSE3> pose) const
+    {
+      S s(pose);
+      std::copy(_upper.data(), _upper.data()+3, s.data());
+      std::copy(_lower.data(), _lower.data()+3, s.data()+3);
+      return s;
+    }
+
+    static FRAMED_SPATIAL zero() { return FRAMED_SPATIAL(ORIGIN3::zero(), ORIGIN3::zero()); }
+    const ORIGIN3& get_upper() const { return _upper; }
+    const ORIGIN3& get_lower() const { return _lower; }
+    void set_upper(const ORIGIN3& upper) { _upper = upper; }
+    void set_lower(const ORIGIN3& lower) { _lower = lower; }
+    REAL& operator[](unsigned i) { return (i < 3) ? _upper[i] : _lower[i-3]; }
+    const REAL& operator[](unsigned i) const { return (i < 3) ? _upper[i] : _lower[i-3]; }
+    FRAMED_SPATIAL operator+(const FRAMED_SPATIAL& v) const { return FRAMED_SPATIAL(_upper + v._upper, _lower + v._lower); }
+    FRAMED_SPATIAL operator-(const FRAMED_SPATIAL& v) const { return FRAMED_SPATIAL(_upper - v._upper, _lower - v._lower); }
+    FRAMED_SPATIAL operator-() const { return FRAMED_SPATIAL(-_upper, -_lower); }
+    FRAMED_SPATIAL operator*(REAL scalar) const { return FRAMED_SPATIAL(_upper*scalar, _lower*scalar); }
+    FRAMED_SPATIAL& operator+=(const FRAMED_SPATIAL& v) { _upper += v._upper; _lower += v._lower; return *this; }
+    FRAMED_SPATIAL& operator-=(const FRAMED_SPATIAL& v) { _upper -= v._upper; _lower -= v._lower; return *this; }
+    FRAMED_SPATIAL& operator*=(REAL scalar) { _upper *= scalar; _lower *= scalar; return *this; }
+
+    /// Computes the spatial dot product with a vector in the same frame (e.g., the power of a force on a velocity)
+    template <class S2>
+    REAL dot(const FRAMED_SPATIAL<Frame, S2>& v) const
+    {
+      return _upper.dot(v.get_lower()) + _lower.dot(v.get_upper());
+    }
+
+    /// Computes the spatial cross product of this (motion) vector with a velocity
+    FRAMED_SPATIAL<Frame, SVELOCITY> cross(const FRAMED_SPATIAL<Frame, SVELOCITY>& v) const { return cross_motion(v); }
+
+    /// Computes the spatial cross product of this (motion) vector with an acceleration
+    FRAMED_SPATIAL<Frame, SACCEL> cross(const FRAMED_SPATIAL<Frame, SACCEL>& a) const { return cross_motion(a); }
+
+    /// Computes the spatial cross product of this (motion) vector with a force
+    FRAMED_SPATIAL<Frame, SFORCE> cross(const FRAMED_SPATIAL<Frame, SFORCE>& f) const { return cross_force<SFORCE>(f); }
+
+    /// Computes the spatial cross product of this (motion) vector with a momentum (yielding a force)
+    FRAMED_SPATIAL<Frame, SFORCE> cross(const FRAMED_SPATIAL<Frame, SMOMENTUM>& m) const { return cross_force<SFORCE>(m); }
+
+  private:
+    /// The motion cross product: | ax  0 ; bx  ax | for this = [a; b]
+    template <class S2>
+    FRAMED_SPATIAL<Frame, S2> cross_motion(const FRAMED_SPATIAL<Frame, S2>& m) const
+    {
+      ORIGIN3 top = ORIGIN3::cross(_upper, m.get_upper());
+      ORIGIN3 bot = ORIGIN3::cross(_lower, m.get_upper()) + ORIGIN3::cross(_upper, m.get_lower());
+      return FRAMED_SPATIAL<Frame, S2>(top, bot);
+    }
+
+    /// The force cross product: | ax  0 ; bx  ax | for this = [a; b], applied to [linear; angular]
+    template <class S2, class S3>
+    FRAMED_SPATIAL<Frame, S2> cross_force(const FRAMED_SPATIAL<Frame, S3>& f) const
+    {
+      ORIGIN3 top = ORIGIN3::cross(_upper, f.get_upper());
+      ORIGIN3 bot = ORIGIN3::cross(_upper, f.get_lower()) + ORIGIN3::cross(_lower, f.get_upper());
+      return FRAMED_SPATIAL<Frame, S2>(top, bot);
+    }
+
+    ORIGIN3 _upper, _lower;
+}; // end class
+
+/// A rigid transformation from frame Source to frame Target, both identified at compile time
+/**
+ * The transformation consists of the rotation E (from Source orientation to
+ * Target orientation) and the origin x of Source, expressed in Target. Only
+ * vectors in Source can be transformed and only vectors in Target can be
+ * inverse transformed; transforms compose only when the frames chain, i.e.,
+ * FRAMED_TRANSFORM3<A, B> * FRAMED_TRANSFORM3<B, C> yields
+ * FRAMED_TRANSFORM3<A, C>.
+ */
+template <class Target, class Source>
+class FRAMED_TRANSFORM3
+{
+  public:
+    FRAMED_TRANSFORM3() { _E.set_identity(); _x.set_zero(); }
+    FRAMED_TRANSFORM3(const MATRIX3& E, const ORIGIN3& x) : _E(E), _x(x) {}
+    explicit FRAMED_TRANSFORM3(const TRANSFORM3& T) : _E(T.q), _x(T.x) {}
+
+    /// Constructs a transform from a TRANSFORM3, verifying its source and target poses
+    FRAMED_TRANSFORM3(const TRANSFORM3& T, boost::shared_ptr<const POSE3> source, boost::shared_ptr<const POSE3> target) : _E(T.q), _x(T.x)
+    {
+      #ifndef NEXCEPT
+      if (T.source != source || T.target != target)
+        throw FrameException();
+      #endif
+    }
+
+    /// Computes the transform between two poses
+    static FRAMED_TRANSFORM3 calc_transform(boost::shared_ptr<const POSE3> source, boost::shared_ptr<const POSE3> target) { return FRAMED_TRANSFORM3(POSE3::calc_relative_pose(source, target)); }
+
+    /// Gets the rotation from the Source orientation to the Target orientation
+    const MATRIX3& get_rotation() const { return _E; }
+
+    /// Gets the origin of Source, expressed in Target
+    const ORIGIN3& get_translation() const { return _x; }
+
+    FRAMED_VECTOR3<Target> transform_point(const FRAMED_VECTOR3<Source>& p) const { return FRAMED_VECTOR3<Target>(_E*p.get() + _x); }
+    FRAMED_VECTOR3<Target> transform_vector(const FRAMED_VECTOR3<Source>& v) const { return FRAMED_VECTOR3<Target>(_E*v.get()); }
+    FRAMED_VECTOR3<Source> inverse_transform_point(const FRAMED_VECTOR3<Target>& p) const { return FRAMED_VECTOR3<Source>(_E.transpose_mult(p.get() - _x)); }
+    FRAMED_VECTOR3<Source> inverse_transform_vector(const FRAMED_VECTOR3<Target>& v) const { return FRAMED_VECTOR3<Source>(_E.transpose_mult(v.get())); }
+
+    /// Transforms a spatial vector: [E*top; E*bottom + x x (E*top)]
+    template <class S>
+    FRAMED_SPATIAL<Target, S> transform(const FRAMED_SPATIAL<Source, S>& w) const
+    {
+      ORIGIN3 top = _E*w.get_upper();
+      return FRAMED_SPATIAL<Target, S>(top, _E*w.get_lower() + ORIGIN3::cross(_x, top));
+    }
+
+    /// Transforms a spatial vector with the inverse transform: [E'*top; E'*(bottom - x x top)]
+    template <class S>
+    FRAMED_SPATIAL<Source, S> inverse_transform(const FRAMED_SPATIAL<Target, S>& w) const
+    {
+      const ORIGIN3& top = w.get_upper();
+      return FRAMED_SPATIAL<Source, S>(_E.transpose_mult(top), _E.transpose_mult(w.get_lower() - ORIGIN3::cross(_x, top)));
+    }
+
+    /// Composes this transform with one whose target is Source
+    template <class Other>
+    FRAMED_TRANSFORM3<Target, Other> operator*(const FRAMED_TRANSFORM3<Source, Other>& T) const
+    {
+      return FRAMED_TRANSFORM3<Target, Other>(_E*T.get_rotation(), _E*T.get_translation() + _x);
+    }
+
+    /// Gets the inverse of this transform
+    FRAMED_TRANSFORM3<Source, Target> inverse() const
+    {
+      return FRAMED_TRANSFORM3<Source, Target>(MATRIX3::transpose(_E), -_E.transpose_mult(_x));
+    }
+
+  private:
+    MATRIX3 _E;
+    ORIGIN3 _x;
+}; // end class
+
@@ -0,0 +1,33 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_FRAMED_SPATIALD_H
+#define _RAVELIN_FRAMED_SPATIALD_H
+
+#include <algorithm>
+#include <boost/shared_ptr.hpp>
+#include <Ravelin/FrameException.h>
+#include <Ravelin/FrameTags.h>
+#include <Ravelin/Origin3d.h>
+#include <Ravelin/Matrix3d.h>
+#include <Ravelin/Vector3d.h>
+#include <Ravelin/SVelocityd.h>
+#include <Ravelin/SAcceld.h>
+#include <Ravelin/SForced.h>
+#include <Ravelin/SMomentumd.h>
+#include <Ravelin/Transform3d.h>
+#include <Ravelin/Pose3d.h>
+
+namespace Ravelin {
+
+#include "ddefs.h"
+#include "FramedSpatial.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
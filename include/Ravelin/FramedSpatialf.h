@@ -0,0 +1,33 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_FRAMED_SPATIALF_H
+#define _RAVELIN_FRAMED_SPATIALF_H
+
+#include <algorithm>
+#include <boost/shared_ptr.hpp>
+#include <Ravelin/FrameException.h>
+#include <Ravelin/FrameTags.h>
+#include <Ravelin/Origin3f.h>
+#include <Ravelin/Matrix3f.h>
+#include <Ravelin/Vector3f.h>
+#include <Ravelin/SVelocityf.h>
+#include <Ravelin/SAccelf.h>
+#include <Ravelin/SForcef.h>
+#include <Ravelin/SMomentumf.h>
+#include <Ravelin/Transform3f.h>
+#include <Ravelin/Pose3f.h>
+
+namespace Ravelin {
+
+#include "fdefs.h"
+#include "FramedSpatial.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
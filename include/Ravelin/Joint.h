@@ -13,10 +13,15 @@ class RIGIDBODY;
 /// Defines a bilateral constraint (a joint)
 class JOINT : public virtual_enable_shared_from_this<JOINT>
 {
+  friend class RC_ARTICULATED_BODY;
+
   public:
     enum ConstraintType { eUnknown, eExplicit, eImplicit };
     enum DOFs { DOF_1=0, DOF_2=1, DOF_3=2, DOF_4=3, DOF_5=4, DOF_6=5 };
 
+    /// Maps the frames of an articulated body to the frames of a copy of that body (see RC_ARTICULATED_BODY::clone())
+    typedef std::map<boost::shared_ptr<const POSE3>, boost::shared_ptr<POSE3> > PoseMap;
+
     JOINT();
     virtual const std::vector<SVELOCITY>& get_spatial_axes();
     void add_force(const VECTORN& force);
@@ -38,6 +43,7 @@ class JOINT : public virtual_enable_shared_from_this<JOINT>
     virtual void set_outboard_pose(boost::shared_ptr<POSE3> outboard_pose, bool update_joint_pose);
     virtual void update_spatial_axes();
     virtual void evaluate_constraints_dot(REAL C[]);
+    virtual boost::shared_ptr<JOINT> clone(const PoseMap& poses) const;
     virtual void set_q_tare(const VECTORN& tare) { _q_tare = tare; }
     virtual const VECTORN& get_q_tare() const { return _q_tare; }  
 
@@ -48,13 +54,44 @@ class JOINT : public virtual_enable_shared_from_this<JOINT>
     boost::shared_ptr<RIGIDBODY> get_outboard_link() const { return (_outboard_link.expired()) ? boost::shared_ptr<RIGIDBODY>() : boost::shared_ptr<RIGIDBODY>(_outboard_link); }
 
     /// The acceleration of this joint
-    VECTORN qdd;
+    FIXEDVECTORN<6> qdd;
 
     /// The actuator force (user/controller sets this)
-    VECTORN force;
+    FIXEDVECTORN<6> force;
 
     /// Constraint forces calculated by forward dynamics
-    VECTORN lambda;
+    FIXEDVECTORN<6> lambda;
+
+    /// The stiffness of the joint spring (for each degree-of-freedom)
+    /**
+     * Joint springs and dampers are treated implicitly by the forward 
+     * dynamics algorithms of reduced-coordinate articulated bodies; see
+     * RC_ARTICULATED_BODY::set_implicit_step_size(). The joint has no spring
+     * unless this vector has num_dof() elements; a spring without a damper
+     * (or vice versa) is permitted.
+     */
+    FIXEDVECTORN<6> stiffness;
+
+    /// The viscous damping coefficient of the joint (for each degree-of-freedom)
+    /**
+     * The joint has no damper unless this vector has num_dof() elements.
+     */
+    FIXEDVECTORN<6> damping;
+
+    /// The joint position at which the joint spring exerts no force
+    /**
+     * Zero is used unless this vector has num_dof() elements.
+     */
+    FIXEDVECTORN<6> q_rest;
+
+    VECTORN& calc_spring_damper_force(REAL h, VECTORN& f) const;
+    VECTORN& calc_spring_damper_inertia(REAL h, VECTORN& d) const;
+
+    /// Sets whether the acceleration of this joint is prescribed (qdd given, force computed) by hybrid dynamics
+    void set_acceleration_prescribed(bool flag) { _accel_prescribed = flag; }
+
+    /// Gets whether the acceleration of this joint is prescribed by hybrid dynamics
+    bool is_acceleration_prescribed() const { return _accel_prescribed; }
 
     /// Gets the joint index (returns UINT_MAX if not set)
     unsigned get_index() const { return _joint_idx; }
@@ -88,6 +125,13 @@ class JOINT : public virtual_enable_shared_from_this<JOINT>
     /// Gets the pose of this joint relative to the outboard pose (rather than the inboard pose as returned by get_pose())
     boost::shared_ptr<const POSE3> get_pose_from_outboard() const { return _Fb; };
 
+    /// Gets a counter that is incremented whenever the frames or axes of this joint are set
+    /**
+     * Reduced-coordinate articulated bodies use this to detect joints whose
+     * geometry has changed since the link poses were last computed.
+     */
+    unsigned long get_geometry_version() const { return _geometry_version; }
+
     /// Gets whether this joint is in a singular configuration
     /**
      * \note only used by reduced-coordinate articulated bodies
@@ -127,10 +171,15 @@ class JOINT : public virtual_enable_shared_from_this<JOINT>
     virtual unsigned num_dof() const = 0;
   
     /// The position of this joint
-    VECTORN q;
+    /**
+     * The per-DOF state of a joint (position, velocity, acceleration, force,
+     * and constraint forces) has at most six entries and is stored inline in
+     * the joint, so that it is never allocated on the heap.
+     */
+    FIXEDVECTORN<6> q;
 
     /// The velocity of this joint
-    VECTORN qd;
+    FIXEDVECTORN<6> qd;
 
     /// Computes the constraint Jacobian for this joint with respect to the given body
     /**
@@ -149,6 +198,9 @@ class JOINT : public virtual_enable_shared_from_this<JOINT>
     virtual void calc_constraint_jacobian_dot(bool inboard, MATRIXN& Cq) = 0;
 
   protected:
+    void remap_poses(const PoseMap& poses);
+    static void remap(boost::shared_ptr<const POSE3>& pose, const PoseMap& poses);
+    static void remap(std::vector<SVELOCITY>& s, const PoseMap& poses);
     void calc_constraint_jacobian_numeric(bool inboard, MATRIXN& Cq);
     bool transform_jacobian(MATRIXN& J, bool use_inboard, MATRIXN& output);
     void invalidate_pose_vectors() { get_outboard_link()->invalidate_pose_vectors(); }
@@ -185,11 +237,15 @@ class JOINT : public virtual_enable_shared_from_this<JOINT>
      * so that- when the body's joints are set to the zero vector- the body
      * re-enters the initial configuration.
      */
-    VECTORN _q_tare;
+    FIXEDVECTORN<6> _q_tare;
+
+    /// Incremented whenever the frames or axes of this joint are set
+    unsigned long _geometry_version;
 
     boost::weak_ptr<RIGIDBODY> _inboard_link;
     boost::weak_ptr<RIGIDBODY> _outboard_link;
     ConstraintType _constraint_type;
+    bool _accel_prescribed;
     unsigned _joint_idx;
     unsigned _coord_idx;
     unsigned _constraint_idx;
@@ -13,10 +13,12 @@
 #include <limits>
 #include <iostream>
 #include <vector>
+#include <map>
 #include <boost/shared_ptr.hpp>
 #include <Ravelin/Pose3d.h>
 #include <Ravelin/RigidBodyd.h>
 #include <Ravelin/MatrixNd.h>
+#include <Ravelin/FixedVectorNd.h>
 #include <Ravelin/SAcceld.h>
 #include <Ravelin/LinAlgd.h>
 #include <Ravelin/FrameException.h>
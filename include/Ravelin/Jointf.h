@@ -13,10 +13,12 @@
 #include <limits>
 #include <iostream>
 #include <vector>
+#include <map>
 #include <boost/shared_ptr.hpp>
 #include <Ravelin/Pose3f.h>
 #include <Ravelin/RigidBodyf.h>
 #include <Ravelin/MatrixNf.h>
+#include <Ravelin/FixedVectorNf.h>
 #include <Ravelin/SAccelf.h>
 #include <Ravelin/LinAlgf.h>
 #include <Ravelin/FrameException.h>
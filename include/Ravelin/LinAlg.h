@@ -17,6 +17,9 @@ class LINALG
   public:
     enum SVD { eSVD1, eSVD2 };
 
+    /// Decompositions for pseudo-inverses, nullspaces, and least squares: automatically selected, complete orthogonal decomposition, or SVD
+    enum LSMethod { eLSAuto, eLSCOD, eLSSVD };
+
   private:
     static REAL log2(REAL x);
     static void lartg_(REAL* F, REAL* G, REAL* CS, REAL* SN, REAL* R);
@@ -43,18 +46,28 @@ LDA, REAL* B, INTEGER* LDB, REAL* RCOND, INTEGER* INFO);
     static void getrf_(INTEGER* M, INTEGER* N, REAL* A, INTEGER* LDA, INTEGER* IPIV, INTEGER* INFO);
     void getri_(INTEGER* N, REAL* A, INTEGER* LDA, INTEGER* IPIV, INTEGER* INFO);
     static void getrs_(char* TRANS, INTEGER* N, INTEGER* NRHS, REAL* A, INTEGER* LDA, INTEGER* IPIV, REAL* B, INTEGER* LDB, INTEGER* INFO);
+    static void triangularize_QR(MATRIXN& Q, MATRIXN& R, unsigned k);
+    static unsigned ereach(unsigned k, const unsigned* Ap, const unsigned* Ai, const std::vector<unsigned>& parent, std::vector<unsigned>& stack, std::vector<unsigned>& mark);
     void orgqr_(INTEGER* M, INTEGER* N, INTEGER* K, REAL* A, INTEGER* LDA, REAL* TAU, INTEGER* INFO);
+    void tzrzf_(INTEGER* M, INTEGER* N, REAL* A, INTEGER* LDA, REAL* TAU, INTEGER* INFO);
+    void ormrz_(char* SIDE, char* TRANS, INTEGER* M, INTEGER* N, INTEGER* K, INTEGER* L, REAL* A, INTEGER* LDA, REAL* TAU, REAL* C, INTEGER* LDC, INTEGER* INFO);
 
   public:
     void compress();
     void free_memory();
     static void factor_LDL(MATRIXN& M, std::vector<int>& IPIV);
     MATRIXN& pseudo_invert(MATRIXN& A, REAL tol=(REAL) -1.0);
+    MATRIXN& pseudo_invert(MATRIXN& A, LSMethod method, REAL tol=(REAL) -1.0);
     static void givens(REAL a, REAL b, REAL& c, REAL& s);
     static MATRIX2 givens(REAL c, REAL s);
     static void householder(REAL alpha, const VECTORN& x, REAL& tau, VECTORN& v);
     static VECTORN& solve_sparse_direct(const SPARSEMATRIXN& A, const VECTORN& b, Transposition trans, VECTORN& x);
     static MATRIXN& solve_sparse_direct(const SPARSEMATRIXN& A, const MATRIXN& B, Transposition trans, MATRIXN& X);
+    static VECTORN& solve_sparse_direct(const SPARSESYMMATRIXN& A, const VECTORN& b, VECTORN& x);
+    static MATRIXN& solve_sparse_direct(const SPARSESYMMATRIXN& A, const MATRIXN& B, MATRIXN& X);
+    static bool factor_chol(const SPARSESYMMATRIXN& A, SPARSEMATRIXN& L);
+    static VECTORN& solve_chol_fast(const SPARSEMATRIXN& L, VECTORN& xb);
+    static MATRIXN& solve_chol_fast(const SPARSEMATRIXN& L, MATRIXN& XB);
     void update_QR_rank1(MATRIXN& Q, MATRIXN& R, const VECTORN& u, const VECTORN& v);
     void update_QR_delete_cols(MATRIXN& Q, MATRIXN& R, unsigned k, unsigned p);
     void update_QR_insert_cols(MATRIXN& Q, MATRIXN& R, MATRIXN& U, unsigned k);
@@ -82,6 +95,12 @@ LDA, REAL* B, INTEGER* LDB, REAL* RCOND, INTEGER* INFO);
     /// work STL integer vector (LAPACK routines)
     FastThreadable<std::vector<INTEGER> > iworkv;
 
+    /// work vectors (for complete orthogonal decomposition)
+    FastThreadable<VECTORN> tauQR, tauRZ;
+
+    /// work STL integer vector (for complete orthogonal decomposition)
+    FastThreadable<std::vector<INTEGER> > pivCOD;
+
     // include templated routines here...
     #include "LinAlg.inl"
 
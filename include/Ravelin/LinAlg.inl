@@ -382,6 +382,72 @@ MATRIXN& nullspace(Y& A, MATRIXN& nullspace, REAL tol = -1.0)
   }
 }
 
+/// Computes the nullspace of a matrix using the requested decomposition
+/**
+ * eLSAuto uses the complete orthogonal decomposition unless the numerical
+ * rank of A is ambiguous, in which case the SVD is used.
+ * \note A is destroyed on return
+ */
+template <class Y>
+MATRIXN& nullspace(Y& A, MATRIXN& nullspace, LSMethod method, REAL tol = -1.0)
+{
+  #ifndef NEXCEPT
+  if (sizeof(A.data()) != sizeof(nullspace.data()))
+    throw DataMismatchException();
+  #endif
+
+  // get the dimensions of A
+  const unsigned m = A.rows();
+  const unsigned n = A.columns();
+
+  // check for SVD or easy out
+  if (method == eLSSVD || m == 0 || n == 0)
+    return this->nullspace(A, nullspace, tol);
+
+  // backup A, if necessary 
+  MATRIXN& A_backup = workM2();
+  if (method == eLSAuto)
+    A_backup = A;
+
+  // compute the complete orthogonal decomposition
+  bool ambiguous;
+  std::vector<INTEGER>& PI = pivCOD();
+  VECTORN& tQR = tauQR();
+  VECTORN& tRZ = tauRZ();
+  const unsigned r = factor_COD(A, PI, tQR, tRZ, ambiguous, tol);
+
+  // fall back to the SVD if the rank is numerically ambiguous
+  if (ambiguous && method == eLSAuto)
+  {
+    A = A_backup;
+    return this->nullspace(A, nullspace, tol);
+  }
+
+  // the nullspace of AP is spanned by Z'*[0; I]
+  MATRIXN& W = workM2();
+  W.set_zero(n, n - r);
+  for (unsigned i=r; i< n; i++)
+    W(i, i-r) = (REAL) 1.0;
+  if (r > 0 && r < n)
+  {
+    char SIDE = 'L', TRANS = 'T';
+    INTEGER N = n, NC = n - r, R = r, L = n - r;
+    INTEGER LDA = A.leading_dim(), LDW = W.leading_dim(), INFO;
+    ormrz_(&SIDE, &TRANS, &N, &NC, &R, &L, A.data(), &LDA, tRZ.data(), W.data(), &LDW, &INFO);
+  }
+
+  // undo the column permutation
+  nullspace.resize(n, n - r);
+  for (unsigned i=0; i< n; i++)
+  {
+    const unsigned pi = (unsigned) PI[i] - 1;
+    for (unsigned j=0; j< n - r; j++)
+      nullspace(pi,j) = W(i,j);
+  }
+
+  return nullspace;
+}
+
 /// Computes the condition number of a matrix
 template <class X>
 REAL cond(X& A)
@@ -1303,6 +1369,207 @@ Y& solve_fast(X& A, Y& XB)
   return XB;
 }
 
+/// Computes a complete orthogonal decomposition of a matrix
+/**
+ * Factorizes A*P = Q*[T 0; 0 0]*Z, where P is a permutation matrix, Q and Z 
+ * are orthogonal, and T is an r x r upper triangular matrix (r is the 
+ * numerical rank of A). The rank is determined from the diagonal of the
+ * column-pivoted QR factorization of A. That diagonal only brackets the
+ * singular values of A, so the rank is flagged as ambiguous when the
+ * diagonal is not clearly separated by the tolerance.
+ * \param A the matrix A on input; the factorization (in LAPACK format) on 
+ *        return
+ * \param PI the (one-indexed) column pivots on return
+ * \param tQR the scalar factors of the elementary reflectors of Q on return
+ * \param tRZ the scalar factors of the elementary reflectors of Z on return
+ * \param ambiguous set to <b>true</b> on return if the numerical rank of A
+ *        is ambiguous
+ * \param tol the tolerance for determining the rank of A; if tol < 0.0,
+ *        tol is computed using machine epsilon
+ * \return the numerical rank of A
+ */
+template <class Y>
+unsigned factor_COD(Y& A, std::vector<INTEGER>& PI, VECTORN& tQR, VECTORN& tRZ, bool& ambiguous, REAL tol = (REAL) -1.0)
+{
+  // get the dimensionality of A
+  const unsigned m = A.rows();
+  const unsigned n = A.columns();
+  const unsigned minmn = std::min(m, n);
+
+  // setup the pivots for entry 
+  PI.resize(n);
+  std::fill(PI.begin(), PI.end(), 0);
+  ambiguous = false;
+
+  // check for easy out
+  if (minmn == 0)
+  {
+    for (unsigned i=0; i< n; i++)
+      PI[i] = (INTEGER) i+1;
+    tQR.resize(0);
+    tRZ.resize(0);
+    return 0;
+  }
+
+  // compute the QR factorization with column pivoting
+  INTEGER M = m;
+  INTEGER N = n;
+  INTEGER LDA = A.leading_dim();
+  INTEGER INFO;
+  tQR.resize(minmn);
+  geqp3_(&M, &N, A.data(), &LDA, &PI.front(), tQR.data(), &INFO);
+  assert(INFO == 0);
+
+  // determine the rank using the diagonal of R
+  const REAL* data = A.data();
+  if (tol < (REAL) 0.0)
+    tol = std::fabs(data[0]) * std::max(m,n) * std::numeric_limits<REAL>::epsilon();
+  unsigned r = 0;
+  while (r < minmn && std::fabs(data[r*LDA+r]) > tol)
+    r++;
+
+  // the trailing block has 2-norm no greater than sqrt(n-r)*|R(r,r)|, while 
+  // the r-th singular value may lie below |R(r-1,r-1)| by a factor up to 
+  // (roughly) sqrt(n); flag the rank as ambiguous when either falls near tol
+  const REAL GAP = std::sqrt((REAL) n);
+  if (r > 0 && std::fabs(data[(r-1)*LDA+r-1]) <= GAP*tol)
+    ambiguous = true;
+  if (r < minmn && std::sqrt((REAL) (n-r))*std::fabs(data[r*LDA+r]) > tol)
+    ambiguous = true;
+
+  // reduce [R11 R12] to [T 0]*Z
+  tRZ.resize(r);
+  if (r > 0 && r < n)
+  {
+    INTEGER R = r;
+    tzrzf_(&R, &N, A.data(), &LDA, tRZ.data(), &INFO);
+    assert(INFO == 0);
+  }
+
+  return r;
+}
+
+/// Computes the minimum-norm least-squares solution to AX = B using a complete orthogonal decomposition
+/**
+ * \param AF the factorization of A computed by factor_COD()
+ * \param r the rank returned by factor_COD()
+ * \param PI the column pivots computed by factor_COD()
+ * \param tQR the scalar factors of Q computed by factor_COD()
+ * \param tRZ the scalar factors of Z computed by factor_COD()
+ * \param XB the m x k matrix B on input, the n x k matrix X on return
+ */
+template <class Y, class X>
+X& solve_COD_fast(Y& AF, unsigned r, const std::vector<INTEGER>& PI, VECTORN& tQR, VECTORN& tRZ, X& XB)
+{
+  // get the dimensionality of A
+  const unsigned m = AF.rows();
+  const unsigned n = AF.columns();
+  const unsigned k = XB.columns();
+
+  #ifndef NEXCEPT
+  if (XB.rows() != m)
+    throw MissizeException();
+
+  if (sizeof(AF.data()) != sizeof(XB.data()))
+    throw DataMismatchException();
+  #endif
+
+  // check for easy out
+  if (r == 0 || k == 0)
+  {
+    XB.set_zero(n, k);
+    return XB;
+  }
+
+  // compute Q'*B
+  char SIDE = 'L', TRANS = 'T';
+  INTEGER M = m, NRHS = k, K = std::min(m, n);
+  INTEGER LDA = AF.leading_dim(), LDB = XB.leading_dim(), INFO;
+  ormqr_(&SIDE, &TRANS, &M, &NRHS, &K, AF.data(), &LDA, tQR.data(), XB.data(), &LDB, &INFO);
+
+  // solve T*Y = first r rows of Q'*B
+  MATRIXN& W = workM();
+  W.set_zero(n, k);
+  for (unsigned j=0; j< k; j++)
+    std::copy(XB.data()+j*LDB, XB.data()+j*LDB+r, W.data()+j*W.leading_dim());
+  char UPLO = 'U', NOTRANS = 'N';
+  INTEGER R = r, LDW = W.leading_dim();
+  trtrs_(&UPLO, &NOTRANS, &R, &NRHS, AF.data(), &LDA, W.data(), &LDW, &INFO);
+  if (INFO > 0)
+    throw SingularException();
+
+  // compute Z'*[Y; 0]
+  if (r < n)
+  {
+    INTEGER N = n, L = n - r;
+    ormrz_(&SIDE, &TRANS, &N, &NRHS, &R, &L, AF.data(), &LDA, tRZ.data(), W.data(), &LDW, &INFO);
+  }
+
+  // undo the column permutation (indexing the raw data, so that XB may be
+  // a vector or a matrix)
+  XB.resize(n, k);
+  REAL* xb = XB.data();
+  const unsigned LDX = XB.leading_dim();
+  for (unsigned i=0; i< n; i++)
+  {
+    const unsigned pi = (unsigned) PI[i] - 1;
+    for (unsigned j=0; j< k; j++)
+      xb[j*LDX+pi] = W(i,j);
+  }
+
+  return XB;
+}
+
+/// Least squares solver using the requested decomposition
+/**
+ * Solves rank-deficient and underdetermined (minimum norm solution) systems.
+ * Computes least-squares solution to overdetermined systems. eLSAuto uses
+ * the complete orthogonal decomposition unless the numerical rank of A is 
+ * ambiguous, in which case the SVD is used.
+ * \param A the coefficient matrix (destroyed on return)
+ * \param XB the matrix B on input, the matrix X on return
+ * \param method the decomposition to use
+ * \param tol the tolerance for determining the rank of A; if tol < 0.0,
+ *        tol is computed using machine epsilon
+ */
+template <class X, class Y>
+X& solve_LS_fast(Y& A, X& XB, LSMethod method, REAL tol)
+{
+  // verify that A and B are appropriate sizes
+  #ifndef NEXCEPT
+  if (A.rows() != XB.rows())
+    throw MissizeException();
+
+  if (sizeof(A.data()) != sizeof(XB.data()))
+    throw DataMismatchException();
+  #endif
+
+  // check for SVD or easy out
+  if (method == eLSSVD || A.rows() == 0 || A.columns() == 0)
+    return solve_LS_fast(A, XB, eSVD1, tol);
+
+  // backup A, if necessary 
+  MATRIXN& A_backup = workM2();
+  if (method == eLSAuto)
+    A_backup = A;
+
+  // compute the complete orthogonal decomposition
+  bool ambiguous;
+  std::vector<INTEGER>& PI = pivCOD();
+  VECTORN& tQR = tauQR();
+  VECTORN& tRZ = tauRZ();
+  const unsigned r = factor_COD(A, PI, tQR, tRZ, ambiguous, tol);
+
+  // fall back to the SVD if the rank is numerically ambiguous
+  if (ambiguous && method == eLSAuto)
+  {
+    A = A_backup;
+    return solve_LS_fast(A, XB, eSVD1, tol);
+  }
+
+  return solve_COD_fast(A, r, PI, tQR, tRZ, XB);
+}
+
 template <class X, class Y>
 X& solve_LS_fast1(Y& A, X& XB, REAL tol = (REAL) -1.0) 
 { 
@@ -17,6 +17,7 @@
 #include <Ravelin/Matrix2d.h>
 #include <Ravelin/FastThreadable.h>
 #include <Ravelin/SparseMatrixNd.h>
+#include <Ravelin/SparseSymMatrixNd.h>
 #include <Ravelin/VectorNd.h>
 
 namespace Ravelin {
@@ -18,6 +18,7 @@
 #include <Ravelin/Matrix2f.h>
 #include <Ravelin/FastThreadable.h>
 #include <Ravelin/SparseMatrixNf.h>
+#include <Ravelin/SparseSymMatrixNf.h>
 #include <Ravelin/VectorNf.h>
 
 namespace Ravelin {
@@ -70,6 +70,7 @@ class MATRIX3
     static MATRIX3 skew_symmetric(const ORIGIN3& o);
     static MATRIX3 skew_symmetric(const VECTOR3& v);
     static VECTOR3 inverse_skew_symmetric(const MATRIX3& R);
+    static MATRIX3 skew_symmetric_mult(const ORIGIN3& o, const MATRIX3& m);
     static MATRIX3 transpose(const MATRIX3& m);
     void transpose();
     static bool valid_rotation(const MATRIX3& R);
@@ -98,8 +99,8 @@ class MATRIX3
     MATRIX3 operator*(REAL scalar) const { MATRIX3 m = *this; m *= scalar; return m; }
     MATRIX3 operator/(REAL scalar) const { return operator*(1.0/scalar); }
     MATRIX3 operator-() const; 
-    MATRIX3 operator*(const MATRIX3& m) const { MATRIX3 result; mult(m, result); return result; }
-    ORIGIN3 operator*(const ORIGIN3& v) const { ORIGIN3 result; mult(v, result); return result; }
+    MATRIX3 operator*(const MATRIX3& m) const { return mult(m); }
+    ORIGIN3 operator*(const ORIGIN3& v) const { return mult(v); }
     unsigned leading_dim() const { return 3; }
     unsigned inc() const { return 1; }
     ORIGIN3 get_column(unsigned i) const;
@@ -30,6 +30,11 @@ class MATRIXN
     MATRIXN(const MATRIX2& m);
     MATRIXN(const MATRIX3& m);
     MATRIXN(const MATRIXN& m);
+    #if __cplusplus >= 201103L
+    MATRIXN(MATRIXN&& m);
+    MATRIXN& operator=(MATRIXN&& m);
+    #endif
+    MATRIXN& swap(MATRIXN& m);
     MATRIXN(const SHAREDMATRIXN& m);
     MATRIXN(const CONST_SHAREDMATRIXN& m);
     MATRIXN& set_identity();
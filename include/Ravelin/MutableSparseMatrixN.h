@@ -0,0 +1,111 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef MUTABLESPARSEMATRIXN
+#error This class is not to be included by the user directly. Use MutableSparseMatrixNd.h or MutableSparseMatrixNf.h instead.
+#endif
+
+/// A sparse matrix whose rows and columns can be replaced, inserted, and removed efficiently
+/**
+ * The matrix is stored by rows (eCSR) or by columns (eCSC), like
+ * SPARSEMATRIXN, but each row (column, if CSC) has its own segment of
+ * storage with room to grow. Replacing, inserting, or removing a row (column,
+ * if CSC) takes time proportional to the number of nonzeros in that row
+ * (column) plus the number of rows (columns); the segment is moved to the end
+ * of the storage when it runs out of room, and the storage is compacted
+ * once at least half of it is unused. Operations on columns of row-major
+ * storage (rows of column-major storage) are supported but must visit every
+ * row (column); choose the storage type that matches the updates.
+ *
+ * Use to_sparse() to compact the matrix into a SPARSEMATRIXN.
+ */
+class MUTABLESPARSEMATRIXN
+{
+  public:
+    MUTABLESPARSEMATRIXN(SPARSEMATRIXN::StorageType stype = SPARSEMATRIXN::eCSR);
+    MUTABLESPARSEMATRIXN(SPARSEMATRIXN::StorageType stype, unsigned m, unsigned n);
+    MUTABLESPARSEMATRIXN(const SPARSEMATRIXN& m, unsigned slack = 0);
+    MUTABLESPARSEMATRIXN& set(const SPARSEMATRIXN& m, unsigned slack = 0);
+    MUTABLESPARSEMATRIXN& set_zero(unsigned m, unsigned n);
+    void set_row(unsigned i, const VECTORN& v);
+    void set_row(unsigned i, const SPARSEVECTORN& v);
+    void set_column(unsigned i, const VECTORN& v);
+    void set_column(unsigned i, const SPARSEVECTORN& v);
+    void insert_row(unsigned i, const VECTORN& v);
+    void insert_row(unsigned i, const SPARSEVECTORN& v);
+    void insert_column(unsigned i, const VECTORN& v);
+    void insert_column(unsigned i, const SPARSEVECTORN& v);
+    void remove_row(unsigned i);
+    void remove_column(unsigned i);
+    VECTORN& get_row(unsigned i, VECTORN& row) const;
+    VECTORN& get_column(unsigned i, VECTORN& column) const;
+    VECTORN& mult(const VECTORN& x, VECTORN& result) const;
+    VECTORN& transpose_mult(const VECTORN& x, VECTORN& result) const;
+    SPARSEMATRIXN& to_sparse(SPARSEMATRIXN& m) const;
+    MATRIXN& to_dense(MATRIXN& m) const;
+    void compact(unsigned slack = 0);
+
+    /// Appends a row to the bottom of the matrix
+    void append_row(const VECTORN& v) { insert_row(_rows, v); }
+
+    /// Appends a row to the bottom of the matrix
+    void append_row(const SPARSEVECTORN& v) { insert_row(_rows, v); }
+
+    /// Appends a column to the right of the matrix
+    void append_column(const VECTORN& v) { insert_column(_columns, v); }
+
+    /// Appends a column to the right of the matrix
+    void append_column(const SPARSEVECTORN& v) { insert_column(_columns, v); }
+
+    /// Gets the number of rows
+    unsigned rows() const { return _rows; }
+
+    /// Gets the number of columns
+    unsigned columns() const { return _columns; }
+
+    /// Gets the number of nonzeros
+    unsigned get_nnz() const { return _nnz; }
+
+    /// Gets the storage type
+    SPARSEMATRIXN::StorageType get_storage_type() const { return _stype; }
+
+  private:
+    void get_nonzeros(const VECTORN& v);
+    void get_nonzeros(const SPARSEVECTORN& v);
+    void set_line(unsigned i);
+    void insert_line(unsigned i);
+    void remove_line(unsigned i);
+    void set_cross(unsigned j);
+    void insert_cross(unsigned j);
+    void remove_cross(unsigned j);
+    void reserve_line(unsigned i, unsigned len);
+    void pack();
+    unsigned num_lines() const { return (_stype == SPARSEMATRIXN::eCSR) ? _rows : _columns; }
+
+    /// The storage type
+    SPARSEMATRIXN::StorageType _stype;
+
+    /// The number of rows and columns
+    unsigned _rows, _columns;
+
+    /// The number of nonzeros
+    unsigned _nnz;
+
+    /// The start, number of nonzeros, and capacity of each row (column, if CSC)
+    std::vector<unsigned> _start, _len, _cap;
+
+    /// The column (row, if CSC) indices and values of the nonzeros
+    std::vector<unsigned> _indices;
+    std::vector<REAL> _data;
+
+    /// The amount of storage no longer used by any row (column)
+    unsigned _unused;
+
+    /// The indices and values of the nonzeros of the vector being set
+    std::vector<unsigned> _vindices;
+    std::vector<REAL> _vdata;
+}; // end class
+
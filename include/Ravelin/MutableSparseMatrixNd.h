@@ -0,0 +1,25 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _MUTABLE_SPARSE_MATRIX_ND_H_
+#define _MUTABLE_SPARSE_MATRIX_ND_H_
+
+#include <vector>
+#include <Ravelin/SparseMatrixNd.h>
+#include <Ravelin/SparseVectorNd.h>
+#include <Ravelin/MatrixNd.h>
+#include <Ravelin/VectorNd.h>
+
+namespace Ravelin {
+
+#include "ddefs.h"
+#include "MutableSparseMatrixN.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
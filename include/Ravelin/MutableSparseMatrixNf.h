@@ -0,0 +1,25 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _MUTABLE_SPARSE_MATRIX_NF_H_
+#define _MUTABLE_SPARSE_MATRIX_NF_H_
+
+#include <vector>
+#include <Ravelin/SparseMatrixNf.h>
+#include <Ravelin/SparseVectorNf.h>
+#include <Ravelin/MatrixNf.h>
+#include <Ravelin/VectorNf.h>
+
+namespace Ravelin {
+
+#include "fdefs.h"
+#include "MutableSparseMatrixN.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
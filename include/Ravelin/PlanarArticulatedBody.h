@@ -0,0 +1,109 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef PLANAR_ARTICULATED_BODY
+#error This class is not to be included by the user directly. Use PlanarArticulatedBodyd.h or PlanarArticulatedBodyf.h instead.
+#endif
+
+/// A tree of rigid bodies that moves in the plane, with dynamics computed using planar spatial algebra
+/**
+ * Motions and forces in the plane are three-dimensional spatial vectors
+ * (stored in ORIGIN3 objects): a planar spatial velocity is [omega; vx; vy]
+ * and a planar spatial force is [torque; fx; fy], both expressed in the
+ * frame of a link, and spatial transforms and inertias are 3x3 matrices
+ * (stored in MATRIX3 objects). The inverse dynamics (recursive
+ * Newton-Euler), joint space inertia (composite rigid body), and forward
+ * dynamics (articulated body) algorithms then require roughly a quarter of
+ * the arithmetic of their six-dimensional counterparts in
+ * RC_ARTICULATED_BODY, and avoid its frame bookkeeping.
+ *
+ * Unlike RC_ARTICULATED_BODY, this class is not a DYNAMIC_BODY: the body is
+ * described by its links (added in order with add_link(), each after its
+ * parent) and the generalized coordinates, velocities, and forces are
+ * passed to the algorithms. Root links are connected to the (fixed) world
+ * frame; a 2D floating base is a root link with a planar joint. Gravity acts
+ * on all links.
+ */
+class PLANAR_ARTICULATED_BODY
+{
+  public:
+    /// The type of joint connecting a link to its parent
+    enum JointType
+    {
+      eRevolute,    ///< one DOF: rotation (counter-clockwise) about the joint frame origin
+      ePrismatic,   ///< one DOF: translation along an axis of the joint frame
+      ePlanar       ///< three DOF: x and y position (in the parent joint frame) and rotation
+    };
+
+    PLANAR_ARTICULATED_BODY();
+    unsigned add_link(int parent, JointType type, const POSE2& placement, REAL mass, const ORIGIN2& com, REAL inertia, const ORIGIN2& axis = ORIGIN2((REAL) 1.0, (REAL) 0.0));
+    VECTORN& calc_inverse_dynamics(const VECTORN& q, const VECTORN& qd, const VECTORN& qdd, VECTORN& tau);
+    MATRIXN& calc_joint_space_inertia(const VECTORN& q, MATRIXN& H);
+    VECTORN& calc_fwd_dyn(const VECTORN& q, const VECTORN& qd, const VECTORN& tau, VECTORN& qdd);
+    std::vector<POSE2>& calc_link_poses(const VECTORN& q, std::vector<POSE2>& poses);
+
+    /// Gets the number of links
+    unsigned num_links() const { return _parent.size(); }
+
+    /// Gets the number of degrees-of-freedom (the size of the generalized coordinates)
+    unsigned num_dof() const { return _ndof; }
+
+    /// Gets the parent of a link (-1 if the link is connected to the world)
+    int get_parent(unsigned i) const { return _parent[i]; }
+
+    /// Gets the index of the first generalized coordinate of the joint of a link
+    unsigned get_coord_index(unsigned i) const { return _coord[i]; }
+
+    /// Gets the spatial inertia of a link (in the link frame)
+    const MATRIX3& get_inertia(unsigned i) const { return _I[i]; }
+
+    /// The acceleration due to gravity (in the world frame)
+    ORIGIN2 gravity;
+
+  private:
+    static MATRIX3 calc_transform(REAL theta, REAL x, REAL y);
+    static ORIGIN3 cross_motion(const ORIGIN3& v, const ORIGIN3& m);
+    static ORIGIN3 cross_force(const ORIGIN3& v, const ORIGIN3& f);
+    static MATRIX3 transform_inertia(const MATRIX3& X, const MATRIX3& I);
+    void calc_joint_kinematics(const VECTORN& q);
+    void calc_joint_velocity(unsigned i, const VECTORN& qd);
+
+    /// The parent of each link (-1 for the world)
+    std::vector<int> _parent;
+
+    /// The joint type of each link
+    std::vector<JointType> _type;
+
+    /// The index of the first generalized coordinate of each joint and the number of DOF of each joint
+    std::vector<unsigned> _coord, _nq;
+
+    /// The pose of each joint frame relative to the parent link frame
+    std::vector<POSE2> _placement;
+
+    /// The transform from the parent link frame to the joint frame (at zero joint position)
+    std::vector<MATRIX3> _Xtree;
+
+    /// The prismatic joint axes (in the joint frame)
+    std::vector<ORIGIN2> _axis;
+
+    /// The spatial inertia of each link (in the link frame)
+    std::vector<MATRIX3> _I;
+
+    /// The total number of degrees-of-freedom
+    unsigned _ndof;
+
+    // temporaries: transforms from parent to link frames and joint motion
+    // subspaces (one column per DOF), velocity product accelerations, and
+    // joint velocities
+    std::vector<MATRIX3> _Xup, _S;
+    std::vector<ORIGIN3> _cJ, _vJ;
+
+    // temporaries for the recursive algorithms
+    std::vector<ORIGIN3> _v, _a, _c, _f, _pA;
+    std::vector<MATRIX3> _IA, _U, _Dinv;
+    std::vector<ORIGIN3> _u;
+}; // end class
+
@@ -0,0 +1,27 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_PLANAR_ARTICULATED_BODYD_H
+#define _RAVELIN_PLANAR_ARTICULATED_BODYD_H
+
+#include <vector>
+#include <Ravelin/Origin2d.h>
+#include <Ravelin/Pose2d.h>
+#include <Ravelin/Origin3d.h>
+#include <Ravelin/Matrix3d.h>
+#include <Ravelin/VectorNd.h>
+#include <Ravelin/MatrixNd.h>
+
+namespace Ravelin {
+
+#include "ddefs.h"
+#include "PlanarArticulatedBody.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,27 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_PLANAR_ARTICULATED_BODYF_H
+#define _RAVELIN_PLANAR_ARTICULATED_BODYF_H
+
+#include <vector>
+#include <Ravelin/Origin2f.h>
+#include <Ravelin/Pose2f.h>
+#include <Ravelin/Origin3f.h>
+#include <Ravelin/Matrix3f.h>
+#include <Ravelin/VectorNf.h>
+#include <Ravelin/MatrixNf.h>
+
+namespace Ravelin {
+
+#include "fdefs.h"
+#include "PlanarArticulatedBody.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
@@ -30,16 +30,169 @@ class RC_ARTICULATED_BODY : public virtual ARTICULATED_BODY
 {
   friend class CRB_ALGORITHM;
   friend class FSAB_ALGORITHM;
+  friend class DCA_ALGORITHM;
+  friend class RNE_ALGORITHM;
 
   public:
-    enum ForwardDynamicsAlgorithmType { eFeatherstone, eCRB }; 
+    enum ForwardDynamicsAlgorithmType { eFeatherstone, eCRB, eDivideAndConquer }; 
+
+    /// A snapshot of the state of a reduced-coordinate articulated body
+    /**
+     * Holds the joint positions, velocities, accelerations, and actuator
+     * forces, the poses induced by the joints, the link poses, and the link 
+     * velocities, accelerations, and accumulated forces. The factorized 
+     * generalized inertia may be held as well. Buffers are reused when a 
+     * snapshot is saved repeatedly, so save_state() and restore_state() do
+     * not allocate memory after the first save.
+     * \sa RC_ARTICULATED_BODY::save_state()
+     */
+    class State
+    {
+      friend class RC_ARTICULATED_BODY;
+
+      public:
+        State() : _body(NULL), _poses_applied_valid(false), _position_invalidated(true), _has_factorizations(false) { }
+
+        /// Gets whether this snapshot holds the factorized generalized inertia
+        bool has_factorizations() const { return _has_factorizations; }
+
+      private:
+        // the body that the snapshot was saved from
+        const RC_ARTICULATED_BODY* _body;
+
+        // q, qd, qdd, and force of each joint, concatenated over all joints,
+        // and the sizes of the four vectors of each joint
+        std::vector<REAL> _joint_data;
+        std::vector<unsigned> _joint_sizes;
+
+        // induced joint poses followed by link poses and link mixed poses
+        // (orientation and then origin, seven values per pose)
+        std::vector<REAL> _pose_data;
+
+        // the data used by update_link_poses() to detect moved links
+        std::vector<FIXEDVECTORN<6> > _q_applied, _q_tare_applied;
+        std::vector<unsigned long> _geometry_version_applied;
+        POSE3 _base_pose_applied;
+        bool _poses_applied_valid;
+        std::vector<unsigned long> _link_pose_version;
+
+        // link quantities (per link, link c.o.m. frame)
+        std::vector<SVELOCITY> _xd;
+        std::vector<SACCEL> _xdd;
+        std::vector<SFORCE> _f;
+
+        // factorized inertia data
+        bool _position_invalidated;
+        bool _has_factorizations;
+        ForwardDynamicsAlgorithmType _algorithm_type;
+        ReferenceFrameType _rftype;
+        VECTORN _implicit_inertia;
+
+        // CRB factorization
+        MATRIXN _M, _fM, _uM, _vM;
+        VECTORN _sM, _gc_last;
+        bool _rank_deficient;
+
+        // FSAB factorization
+        std::vector<SPATIAL_AB_INERTIA> _I;
+        std::vector<std::vector<SMOMENTUM> > _Is;
+        std::vector<MATRIXN> _sIs, _usIs, _vsIs;
+        std::vector<VECTORN> _ssIs;
+        std::vector<bool> _fsab_rank_deficient;
+    }; // end class
+
+    /// Kinematic quantities shared by the dynamics algorithms
+    /**
+     * Holds, for each link (indexed by link index), the spatial axes of its 
+     * inner joint and their time derivatives, the transform from the 
+     * computation frame of its parent to its own computation frame, and its
+     * velocity, all in link computation frames. Entries for the base are 
+     * empty (or identity). Spatial inertias are cached by the links 
+     * themselves (see RIGIDBODY::get_inertia()). 
+     *
+     * The pose-dependent quantities are computed once per pose version and
+     * the velocity-dependent ones once per velocity version; 
+     * update_link_poses() and update_link_velocities() advance the versions,
+     * and RC_ARTICULATED_BODY::get_kinematics() recomputes whatever is stale.
+     * The pose-dependent quantities are only recomputed for links whose 
+     * poses changed since they were last computed.
+     */
+    class Kinematics
+    {
+      friend class RC_ARTICULATED_BODY;
+
+      public:
+        Kinematics() : _pose_version(0), _velocity_version(0) { }
+
+        /// Gets the pose version for which the pose-dependent quantities were computed 
+        unsigned long get_pose_version() const { return _pose_version; }
+
+        /// Gets the velocity version for which the velocity-dependent quantities were computed
+        unsigned long get_velocity_version() const { return _velocity_version; }
+
+        /// The spatial axes of the inner joint of each link
+        std::vector<std::vector<SVELOCITY> > s;
+
+        /// The time derivatives of the spatial axes of the inner joint of each link
+        std::vector<std::vector<SVELOCITY> > sdot;
+
+        /// The transform from the computation frame of the parent of each link to that of the link
+        std::vector<TRANSFORM3> X;
+
+        /// The velocity of each link
+        std::vector<SVELOCITY> v;
+
+      private:
+        unsigned long _pose_version, _velocity_version;
+
+        /// The pose version for which the entries of each link were computed
+        std::vector<unsigned long> _link_version;
+    }; // end class
+
     RC_ARTICULATED_BODY();
     virtual ~RC_ARTICULATED_BODY() {}
     virtual void reset_accumulators();
     virtual void update_link_poses();    
+    void invalidate_link_poses();
+    virtual void invalidate_inertias();
     virtual void update_link_velocities();
     virtual void apply_impulse(const SMOMENTUM& w, boost::shared_ptr<RIGIDBODY> link);
     virtual void calc_fwd_dyn();
+    void calc_hybrid_dyn();
+    State& save_state(State& state, bool save_factorizations = false);
+    void restore_state(const State& state);
+    boost::shared_ptr<RC_ARTICULATED_BODY> clone() const;
+    MATRIXN& calc_regressor(const VECTORN& qdd, const VECTOR3& gravity, MATRIXN& Y);
+    void calc_regressor_normal_equations(const MATRIXN& q, const MATRIXN& qd, const MATRIXN& qdd, const MATRIXN& tau, const VECTOR3& gravity, MATRIXN& YtY, VECTORN& Ytau, unsigned nthreads = 0) const;
+    VECTORN& calc_gravity_vector(const VECTOR3& gravity, VECTORN& g);
+    VECTORN& calc_coriolis_vector(VECTORN& Cqd);
+    MATRIXN& calc_coriolis_matrix(MATRIXN& C);
+    VECTORN& get_inertial_parameters(VECTORN& pi) const;
+    void set_inertial_parameters(const VECTORN& pi);
+    void sleep(REAL wake_force, REAL wake_speed);
+    void wake();
+    void freeze(boost::shared_ptr<RIGIDBODY> link, REAL wake_force, REAL wake_speed);
+    void thaw(boost::shared_ptr<RIGIDBODY> link);
+    unsigned num_frozen_dof() const;
+    const Kinematics& get_kinematics();
+
+    /// Gets the version of the link poses (advanced whenever the link poses or computation frames change)
+    unsigned long get_pose_version() const { return _pose_version; }
+
+    /// Gets the version of the link velocities (advanced whenever the link velocities change)
+    unsigned long get_velocity_version() const { return _velocity_version; }
+
+    /// Gets whether this body is asleep
+    bool is_asleep() const { return _asleep; }
+
+    /// Gets whether the given link is in a frozen subtree
+    bool is_frozen(boost::shared_ptr<RIGIDBODY> link) const { return link->get_index() < _frozen.size() && _frozen[link->get_index()]; }
+
+    /// Gets the number of calls to calc_fwd_dyn() skipped while this body was asleep
+    unsigned long get_num_skipped_dynamics() const { return _nskipped; }
+
+    /// Gets the total number of joint DOF removed from forward dynamics computations by sleeping and freezing
+    unsigned long get_num_skipped_dof() const { return _nskipped_dof; }
     boost::shared_ptr<RC_ARTICULATED_BODY> get_this() { return boost::dynamic_pointer_cast<RC_ARTICULATED_BODY>(shared_from_this()); }
     boost::shared_ptr<const RC_ARTICULATED_BODY> get_this() const { return boost::dynamic_pointer_cast<const RC_ARTICULATED_BODY>(shared_from_this()); }
     virtual void set_generalized_forces(const SHAREDVECTORN& gf);
@@ -58,6 +211,8 @@ class RC_ARTICULATED_BODY : public virtual ARTICULATED_BODY
     virtual VECTORN& get_generalized_forces(VECTORN& f) { return DYNAMIC_BODY::get_generalized_forces(f); }
     virtual SHAREDVECTORN& convert_to_generalized_force(boost::shared_ptr<SINGLE_BODY> body, const SFORCE& w, SHAREDVECTORN& gf);
     virtual VECTORN& convert_to_generalized_force(boost::shared_ptr<SINGLE_BODY> body, const SFORCE& w, VECTORN& gf) { return DYNAMIC_BODY::convert_to_generalized_force(body, w, gf); }
+    SHAREDVECTORN& convert_to_generalized_force(const std::vector<boost::shared_ptr<RIGIDBODY> >& links, const std::vector<SFORCE>& w, SHAREDVECTORN& gf);
+    VECTORN& convert_to_generalized_force(const std::vector<boost::shared_ptr<RIGIDBODY> >& links, const std::vector<SFORCE>& w, VECTORN& gf);
     virtual unsigned num_generalized_coordinates(DYNAMIC_BODY::GeneralizedCoordinateType gctype) const;
     virtual void set_links_and_joints(const std::vector<boost::shared_ptr<RIGIDBODY> >& links, const std::vector<boost::shared_ptr<JOINT> >& joints);
     virtual unsigned num_joint_dof_implicit() const;
@@ -96,6 +251,11 @@ class RC_ARTICULATED_BODY : public virtual ARTICULATED_BODY
     /// Gets whether the base of this body is fixed or "floating"
     virtual bool is_floating_base() const { return _floating_base; }
 
+    void set_implicit_step_size(REAL h);
+
+    /// Gets the step size used to treat joint springs and dampers implicitly
+    REAL get_implicit_step_size() const { return _implicit_h; }
+
     /// Gets the number of DOF of the explicit joints in the body, not including floating base DOF
     virtual unsigned num_joint_dof() const { return _n_joint_DOF_explicit + num_joint_dof_implicit(); }
 
@@ -105,6 +265,12 @@ class RC_ARTICULATED_BODY : public virtual ARTICULATED_BODY
     /// The forward dynamics algorithm
     ForwardDynamicsAlgorithmType algorithm_type;
 
+    /// Sets the number of threads used by the divide-and-conquer algorithm (zero indicates the number of processors)
+    void set_num_threads(unsigned nthreads) { _dca.set_num_threads(nthreads); }
+
+    /// Gets the number of threads used by the divide-and-conquer algorithm (zero indicates the number of processors)
+    unsigned get_num_threads() const { return _dca.get_num_threads(); }
+
     /// Gets the vector of explicit joint constraints
     virtual const std::vector<boost::shared_ptr<JOINT> >& get_explicit_joints() const { return _ejoints; }
 
@@ -135,12 +301,107 @@ class RC_ARTICULATED_BODY : public virtual ARTICULATED_BODY
     /// The FSAB algorithm
     FSAB_ALGORITHM _fsab;
 
+    /// The divide-and-conquer algorithm
+    DCA_ALGORITHM _dca;
+
     /// Linear algebra object
     boost::shared_ptr<LINALG> _LA;
 
+    /// The step size used to treat joint springs and dampers implicitly
+    REAL _implicit_h;
+
+    /// The joint-space inertia terms (h*D + h^2*K) from joint springs and dampers, indexed by coordinate
+    VECTORN _implicit_inertia;
+
+    /// Whether this body is asleep
+    bool _asleep;
+
+    /// Whether each link (indexed by link index) is in a frozen subtree
+    std::vector<bool> _frozen;
+
+    /// Whether the forces applied to each link and its inner joint at rest have been recorded
+    std::vector<bool> _rest_valid;
+
+    /// The force applied to each link at rest (link c.o.m. frame)
+    std::vector<SFORCE> _rest_forces;
+
+    /// The force applied to the inner joint of each link at rest
+    std::vector<VECTORN> _rest_joint_forces;
+
+    /// The change in applied force and the change in joint speed that wake each resting link
+    std::vector<REAL> _wake_force, _wake_speed;
+
+    /// The number of calls to calc_fwd_dyn() skipped while asleep
+    unsigned long _nskipped;
+
+    /// The total number of joint DOF removed from forward dynamics computations
+    unsigned long _nskipped_dof;
+
+    /// The generalized coordinates that are not frozen (for the CRB algorithm)
+    std::vector<bool> _unlocked;
+
+    /// The indices of the links in breadth-first order from the base
+    std::vector<unsigned> _link_order;
+
+    /// The index of the parent of each link (indexed by link index)
+    std::vector<unsigned> _parent_index;
+
+    /// The total force on the subtree rooted at each link (in the generalized coordinate frame)
+    std::vector<SFORCE> _subtree_forces;
+
+    /// The link velocities and accelerations (link computation frames) from the last call to propagate_link_motion()
+    std::vector<SVELOCITY> _link_v;
+    std::vector<SACCEL> _link_a;
+
+    /// The versions of the link poses and link velocities
+    unsigned long _pose_version, _velocity_version;
+
+    /// The pose version at which the pose of each link (indexed by link index) last changed
+    std::vector<unsigned long> _link_pose_version;
+
+    /// The joint coordinates and tare values (indexed by joint index) last applied by update_link_poses()
+    std::vector<FIXEDVECTORN<6> > _q_applied, _q_tare_applied;
+
+    /// The joint geometry versions (indexed by joint index) last applied by update_link_poses()
+    std::vector<unsigned long> _geometry_version_applied;
+
+    /// The base pose last applied by update_link_poses()
+    POSE3 _base_pose_applied;
+
+    /// Whether the applied joint coordinates and base pose reflect the link poses
+    bool _poses_applied_valid;
+
+    /// Whether the pose of each link changed during the last call to update_link_poses()
+    std::vector<bool> _link_moved;
+
+    /// The kinematic quantities shared by the dynamics algorithms
+    Kinematics _kinematics;
+
+    /// Work variables for apply_generalized_impulse()
+    VECTORN _gv, _gv_delta;
+
+    /// Work variable for update_implicit_joint_inertia()
+    VECTORN _implicit_inertia_new;
+
+    /// The target frame and transformed spatial axes used by calc_jacobian_column()
+    boost::shared_ptr<POSE3> _jacobian_target;
+    std::vector<SVELOCITY> _jacobian_sprime;
+
+    /// The force on each link (link computation frames) used to compute the gravity and Coriolis/centrifugal terms
+    std::vector<SFORCE> _link_f;
+
+    /// The cached gravity vector g(q), computed for gravity _gravity_last
+    VECTORN _gravity_vector;
+    VECTOR3 _gravity_last;
+
+    /// Whether the cached gravity vector is valid (it is invalidated when the link poses or inertias change)
+    bool _gravity_vector_valid;
 
   private:
+    struct RegressorBatch;
+
     RC_ARTICULATED_BODY(const RC_ARTICULATED_BODY& rcab) {}
+    static void calc_regressor_normal_equations_task(void* data, unsigned i);
     virtual MATRIXN& calc_jacobian_column(boost::shared_ptr<JOINT> joint, const VECTOR3& point, MATRIXN& Jc);
 /*
     virtual MATRIXN& calc_jacobian_floating_base(const VECTOR3& point, MATRIXN& J);
@@ -150,6 +411,7 @@ class RC_ARTICULATED_BODY : public virtual ARTICULATED_BODY
     static REAL sgn(REAL x);
     bool treat_link_as_leaf(boost::shared_ptr<RIGIDBODY> link) const;
     void update_factorized_generalized_inertia();
+    void update_implicit_joint_inertia();
     static bool supports(boost::shared_ptr<JOINT> joint, boost::shared_ptr<RIGIDBODY> link);
     void determine_generalized_forces(VECTORN& gf) const;
     void determine_generalized_accelerations(VECTORN& xdd) const;
@@ -158,6 +420,18 @@ class RC_ARTICULATED_BODY : public virtual ARTICULATED_BODY
     void determine_implicit_constraint_jacobian(MATRIXN& J);
     void determine_implicit_constraint_jacobian_dot(MATRIXN& J);
     void set_implicit_constraint_forces(const VECTORN& lambda);
+    void reset_rest_data();
+    bool rest_forces_changed(boost::shared_ptr<RIGIDBODY> root);
+    void settle_resting_velocities();
+    void get_subtree(boost::shared_ptr<RIGIDBODY> root, std::vector<boost::shared_ptr<RIGIDBODY> >& subtree) const;
+    void update_pose_kinematics();
+    static bool coords_equal(const VECTORN& a, const VECTORN& b);
+    static REAL* save_pose(const POSE3& P, REAL* data);
+    static const REAL* restore_pose(const REAL* data, POSE3& P);
+    void update_velocity_kinematics();
+    void propagate_link_motion(const VECTORN* qdd, const VECTOR3& gravity, bool use_velocities);
+    VECTORN& calc_bias_forces(const VECTOR3& gravity, bool use_velocities, VECTORN& tau);
+    static SFORCE mult_bias_matrix(const MATRIXN& B, const SVELOCITY& v);
 }; // end class
 
 #include "RCArticulatedBody.inl"
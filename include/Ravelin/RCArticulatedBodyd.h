@@ -18,6 +18,7 @@
 #include <Ravelin/SForced.h>
 #include <Ravelin/RigidBodyd.h>
 #include <Ravelin/FSABAlgorithmd.h>
+#include <Ravelin/DCAAlgorithmd.h>
 #include <Ravelin/CRBAlgorithmd.h>
 #include <Ravelin/Jointd.h>
 #include <Ravelin/ArticulatedBodyd.h>
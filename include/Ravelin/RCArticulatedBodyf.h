@@ -18,6 +18,7 @@
 #include <Ravelin/SForcef.h>
 #include <Ravelin/RigidBodyf.h>
 #include <Ravelin/FSABAlgorithmf.h>
+#include <Ravelin/DCAAlgorithmf.h>
 #include <Ravelin/CRBAlgorithmf.h>
 #include <Ravelin/Jointf.h>
 #include <Ravelin/ArticulatedBodyf.h>
@@ -12,6 +12,7 @@ class REVOLUTEJOINT : public virtual JOINT
 {
   public:
     REVOLUTEJOINT();
+    virtual boost::shared_ptr<JOINT> clone(const PoseMap& poses) const;
     virtual void update_spatial_axes();    
     virtual void determine_q(VECTORN& q);
     virtual boost::shared_ptr<const POSE3> get_induced_pose();
@@ -93,6 +93,14 @@ class RIGIDBODY : public virtual SINGLE_BODY
     SFORCE calc_euler_torques();
     void set_enabled(bool flag);
     void invalidate_pose_vectors();
+    void sleep(REAL wake_force, REAL wake_speed);
+    void wake();
+
+    /// Gets whether this (free) body is asleep
+    bool is_asleep() const { return _asleep; }
+
+    /// Gets the number of calls to calc_fwd_dyn() skipped while this body was asleep
+    unsigned long get_num_skipped_dynamics() const { return _nskipped; }
 
     template <class OutputIterator>
     OutputIterator get_parent_links(OutputIterator begin) const;
@@ -275,6 +283,21 @@ class RIGIDBODY : public virtual SINGLE_BODY
     /// Flag for determining whether or not the body is physically enabled
     bool _enabled;
 
+    /// Whether this body is asleep
+    bool _asleep;
+
+    /// Whether the force applied to this body at rest has been recorded
+    bool _rest_force_valid;
+
+    /// The force applied to this body at rest (link c.o.m. frame)
+    SFORCE _rest_force;
+
+    /// The change in applied force and the change in velocity that wake this body
+    REAL _wake_force, _wake_speed;
+
+    /// The number of calls to calc_fwd_dyn() skipped while asleep
+    unsigned long _nskipped;
+
   protected:
     void update_mixed_pose();
 
@@ -308,6 +331,9 @@ class RIGIDBODY : public virtual SINGLE_BODY
     /// Outer joints and associated data
     std::set<boost::shared_ptr<JOINT> > _outer_joints;
 
+    /// Linear algebra routines (used to invert the generalized inertia)
+    mutable LINALG _LA;
+
 }; // end class
 
 // incline inline functions
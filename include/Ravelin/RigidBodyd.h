@@ -12,6 +12,7 @@
 #include <boost/foreach.hpp>
 #include <Ravelin/SingleBodyd.h>
 #include <Ravelin/DynamicBodyd.h>
+#include <Ravelin/LinAlgd.h>
 
 namespace Ravelin {
 
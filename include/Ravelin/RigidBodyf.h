@@ -12,6 +12,7 @@
 #include <boost/foreach.hpp>
 #include <Ravelin/SingleBodyf.h>
 #include <Ravelin/DynamicBodyf.h>
+#include <Ravelin/LinAlgf.h>
 
 namespace Ravelin {
 
@@ -0,0 +1,113 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef SIMD3
+#error This class is not to be included by the user directly. Use SIMD3d.h or SIMD3f.h instead.
+#endif
+
+/// Vectorized kernels for the 3D and spatial primitives
+/**
+ * These kernels underlie QUAT, MATRIX3, the spatial vectors, and TRANSFORM3.
+ * They operate on raw arrays. 3x3 matrices are column-major (like MATRIX3),
+ * quaternions are stored as (x, y, z, w), and 6D spatial vectors use the
+ * storage of SVECTOR6: velocities and accelerations are [angular; linear]
+ * and forces and momenta are [linear; angular]. Unless noted, the output of
+ * a kernel may not alias its inputs.
+ *
+ * Each kernel is compiled once for each supported instruction set. On x86
+ * processors, the best instruction set that the processor supports is
+ * selected the first time the library is loaded, so a single binary runs
+ * well on different processors. The selection can be overridden with
+ * set_instruction_set() (e.g., to compare against the scalar kernels).
+ * The SSE2 kernels are only used in single precision, since four doubles do
+ * not fit in an SSE2 register.
+ * Defining NSIMD when building the library disables all but the scalar
+ * kernels.
+ */
+class SIMD3
+{
+  public:
+    enum InstructionSet { eScalar, eSSE2, eAVX2, eAVX512 };
+
+    /// The kernels compiled for one instruction set
+    struct Kernels
+    {
+      void (*quat_mult)(const REAL* q1, const REAL* q2, REAL* result);
+      void (*quat_rotate)(const REAL* q, const REAL* v, REAL* result);
+      void (*mult)(const REAL* A, const REAL* B, REAL* C);
+      void (*transpose_mult)(const REAL* A, const REAL* B, REAL* C);
+      void (*mult_transpose)(const REAL* A, const REAL* B, REAL* C);
+      void (*transpose_mult_transpose)(const REAL* A, const REAL* B, REAL* C);
+      void (*mult_vector)(const REAL* A, const REAL* v, REAL* result);
+      void (*transpose_mult_vector)(const REAL* A, const REAL* v, REAL* result);
+      void (*skew_symmetric_mult)(const REAL* a, const REAL* B, REAL* C);
+      void (*spatial_cross_motion)(const REAL* v, const REAL* u, REAL* result);
+      void (*spatial_cross_force)(const REAL* v, const REAL* f, REAL* result);
+      REAL (*spatial_dot)(const REAL* v, const REAL* f);
+      void (*spatial_transform)(const REAL* E, const REAL* rx, const REAL* w, REAL* result);
+      void (*spatial_inverse_transform)(const REAL* E, const REAL* xx, const REAL* w, REAL* result);
+    };
+
+    static InstructionSet detect_instruction_set();
+    static bool is_supported(InstructionSet iset);
+    static const char* get_name(InstructionSet iset);
+    static bool set_instruction_set(InstructionSet iset);
+
+    /// Gets the instruction set used by the kernels
+    static InstructionSet get_instruction_set() { return _iset; }
+
+    /// Computes the quaternion product q1*q2
+    static void quat_mult(const REAL* q1, const REAL* q2, REAL* result) { (*_kernels->quat_mult)(q1, q2, result); }
+
+    /// Rotates the 3D vector v by quaternion q (see QUAT::operator*(const ORIGIN3&))
+    static void quat_rotate(const REAL* q, const REAL* v, REAL* result) { (*_kernels->quat_rotate)(q, v, result); }
+
+    /// Computes C = A*B for 3x3 matrices
+    static void mult(const REAL* A, const REAL* B, REAL* C) { (*_kernels->mult)(A, B, C); }
+
+    /// Computes C = A'*B for 3x3 matrices
+    static void transpose_mult(const REAL* A, const REAL* B, REAL* C) { (*_kernels->transpose_mult)(A, B, C); }
+
+    /// Computes C = A*B' for 3x3 matrices
+    static void mult_transpose(const REAL* A, const REAL* B, REAL* C) { (*_kernels->mult_transpose)(A, B, C); }
+
+    /// Computes C = A'*B' for 3x3 matrices
+    static void transpose_mult_transpose(const REAL* A, const REAL* B, REAL* C) { (*_kernels->transpose_mult_transpose)(A, B, C); }
+
+    /// Computes A*v for a 3x3 matrix and a 3D vector
+    static void mult_vector(const REAL* A, const REAL* v, REAL* result) { (*_kernels->mult_vector)(A, v, result); }
+
+    /// Computes A'*v for a 3x3 matrix and a 3D vector
+    static void transpose_mult_vector(const REAL* A, const REAL* v, REAL* result) { (*_kernels->transpose_mult_vector)(A, v, result); }
+
+    /// Computes C = skew(a)*B for a 3D vector and a 3x3 matrix, without forming skew(a)
+    static void skew_symmetric_mult(const REAL* a, const REAL* B, REAL* C) { (*_kernels->skew_symmetric_mult)(a, B, C); }
+
+    /// Computes the spatial cross product of velocity v and motion vector u
+    static void spatial_cross_motion(const REAL* v, const REAL* u, REAL* result) { (*_kernels->spatial_cross_motion)(v, u, result); }
+
+    /// Computes the spatial cross product of velocity v and force vector f
+    static void spatial_cross_force(const REAL* v, const REAL* f, REAL* result) { (*_kernels->spatial_cross_force)(v, f, result); }
+
+    /// Computes the spatial dot product of motion vector v and force vector f
+    static REAL spatial_dot(const REAL* v, const REAL* f) { return (*_kernels->spatial_dot)(v, f); }
+
+    /// Transforms spatial vector w by [E 0; -E*rx E] (result may alias w)
+    static void spatial_transform(const REAL* E, const REAL* rx, const REAL* w, REAL* result) { (*_kernels->spatial_transform)(E, rx, w, result); }
+
+    /// Transforms spatial vector w by [E' 0; -E'*xx E'] (result may alias w)
+    static void spatial_inverse_transform(const REAL* E, const REAL* xx, const REAL* w, REAL* result) { (*_kernels->spatial_inverse_transform)(E, xx, w, result); }
+
+  private:
+    static const Kernels* get_kernels(InstructionSet iset);
+
+    /// The instruction set used by the kernels
+    static InstructionSet _iset;
+
+    /// The kernels for the selected instruction set
+    static const Kernels* _kernels;
+}; // end class
+
@@ -0,0 +1,19 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_SIMD3D_H
+#define _RAVELIN_SIMD3D_H
+
+namespace Ravelin {
+
+#include "ddefs.h"
+#include "SIMD3.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
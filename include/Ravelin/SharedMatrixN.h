@@ -25,6 +25,9 @@ class CONST_SHAREDMATRIXN
     CONST_SHAREDMATRIXN();
     CONST_SHAREDMATRIXN(const SHAREDMATRIXN& source);
     CONST_SHAREDMATRIXN(const CONST_SHAREDMATRIXN& source);
+    #if __cplusplus >= 201103L
+    CONST_SHAREDMATRIXN(CONST_SHAREDMATRIXN&& source) noexcept : _data(std::move(source._data)), _rows(source._rows), _start(source._start), _columns(source._columns), _ld(source._ld) { }
+    #endif
     CONST_SHAREDMATRIXN(unsigned rows, unsigned cols, unsigned leading_dim, unsigned start, SharedResizable<REAL> data);
     const SHAREDMATRIXN get() const;
     void reset_from(const CONST_SHAREDMATRIXN& source);
@@ -64,6 +67,9 @@ class SHAREDMATRIXN
   public:
     SHAREDMATRIXN();
     SHAREDMATRIXN(const SHAREDMATRIXN& source);
+    #if __cplusplus >= 201103L
+    SHAREDMATRIXN(SHAREDMATRIXN&& source) noexcept : _data(std::move(source._data)), _rows(source._rows), _start(source._start), _columns(source._columns), _ld(source._ld) { }
+    #endif
     SHAREDMATRIXN(unsigned rows, unsigned cols, unsigned leading_dim, unsigned start, SharedResizable<REAL> data);
     void reset_from(const SHAREDMATRIXN& source);
     SHAREDMATRIXN& set_identity();
@@ -25,6 +25,9 @@ class SHAREDVECTORN
   public:
     SHAREDVECTORN();
     SHAREDVECTORN(const SHAREDVECTORN& source) { reset_from(source); }
+    #if __cplusplus >= 201103L
+    SHAREDVECTORN(SHAREDVECTORN&& source) noexcept : _data(std::move(source._data)), _start(source._start), _inc(source._inc), _len(source._len) { }
+    #endif
     SHAREDVECTORN(unsigned len, unsigned inc, unsigned start, SharedResizable<REAL> data);
     void reset_from(const SHAREDVECTORN& source);
     virtual ~SHAREDVECTORN() {}
@@ -89,6 +92,9 @@ class CONST_SHAREDVECTORN
     CONST_SHAREDVECTORN(unsigned len, unsigned inc, unsigned start, SharedResizable<REAL> data);
     CONST_SHAREDVECTORN(const SHAREDVECTORN& source) { reset_from(source); }
     CONST_SHAREDVECTORN(const CONST_SHAREDVECTORN& source) { reset_from(source); }
+    #if __cplusplus >= 201103L
+    CONST_SHAREDVECTORN(CONST_SHAREDVECTORN&& source) noexcept : _data(std::move(source._data)), _start(source._start), _inc(source._inc), _len(source._len) { }
+    #endif
     const SHAREDVECTORN get() const; 
     void reset_from(const SHAREDVECTORN& source);
     void reset_from(const CONST_SHAREDVECTORN& source);
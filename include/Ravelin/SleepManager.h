@@ -0,0 +1,119 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef SLEEP_MANAGER
+#error This class is not to be included by the user directly. Use SleepManagerd.h or SleepManagerf.h instead.
+#endif
+
+/// Puts bodies that have come to rest to sleep and freezes resting subtrees of articulated bodies
+/**
+ * update() is to be called once per integration step. A body (or a link) is
+ * quiescent when the linear and angular speeds of its center-of-mass and 
+ * its kinetic energy per unit mass are below the thresholds; a joint is
+ * quiescent when all of its speeds are below joint_velocity_threshold. A
+ * rigid body, or an articulated body whose links and joints are all
+ * quiescent, that remains quiescent for time_to_sleep is put to sleep (see
+ * RIGIDBODY::sleep() and RC_ARTICULATED_BODY::sleep()), so that its forward 
+ * dynamics is no longer computed. Otherwise, each maximal subtree of an
+ * articulated body whose joints have all been quiescent for time_to_sleep
+ * is frozen (see RC_ARTICULATED_BODY::freeze()). 
+ *
+ * Sleeping bodies and frozen subtrees wake when the forces applied to them
+ * change by more than wake_force_threshold or when an impulse (or the user, 
+ * by setting the velocity) moves them faster than wake_factor times the
+ * velocity thresholds. Since a body must then remain quiescent below the
+ * (smaller) velocity thresholds for time_to_sleep before it sleeps again, 
+ * bodies do not alternate between sleeping and waking on every step.
+ */
+class SLEEP_MANAGER
+{
+  public:
+    /// Counts of bodies at rest and of the work skipped
+    struct Statistics
+    {
+      /// The number of bodies asleep
+      unsigned bodies_asleep;
+
+      /// The number of joint DOF in frozen subtrees
+      unsigned frozen_dof;
+
+      /// The number of forward dynamics computations skipped by sleeping bodies
+      unsigned long skipped_dynamics;
+
+      /// The number of (generalized coordinate) DOF removed from forward dynamics computations by sleeping and freezing
+      unsigned long skipped_dof;
+
+      /// The number of times that bodies have been put to sleep and woken
+      unsigned long sleeps, wakes;
+
+      /// The number of times that subtrees have been frozen and thawed
+      unsigned long freezes, thaws;
+    };
+
+    SLEEP_MANAGER();
+    void add_body(boost::shared_ptr<RIGIDBODY> body);
+    void add_body(boost::shared_ptr<RC_ARTICULATED_BODY> body);
+    void remove_body(boost::shared_ptr<DYNAMIC_BODY> body);
+    void update(REAL dt);
+    Statistics get_statistics() const;
+
+    /// The linear speed of a center-of-mass below which a body is quiescent
+    REAL linear_velocity_threshold;
+
+    /// The angular speed below which a body is quiescent
+    REAL angular_velocity_threshold;
+
+    /// The kinetic energy per unit mass below which a body is quiescent
+    REAL kinetic_energy_threshold;
+
+    /// The joint speed below which a joint is quiescent
+    REAL joint_velocity_threshold;
+
+    /// The time that a body or subtree must remain quiescent before it sleeps or freezes
+    REAL time_to_sleep;
+
+    /// The multiple of the velocity thresholds at which sleeping bodies and frozen subtrees wake (greater than one)
+    REAL wake_factor;
+
+    /// The change in applied force at which sleeping bodies and frozen subtrees wake
+    REAL wake_force_threshold;
+
+    /// Whether resting subtrees of awake articulated bodies are frozen
+    bool freeze_subtrees;
+
+  private:
+    /// A body managed for sleeping
+    struct Entry
+    {
+      /// The body (exactly one is non-null)
+      boost::shared_ptr<RIGIDBODY> rb;
+      boost::shared_ptr<RC_ARTICULATED_BODY> ab;
+
+      /// The time that the body has been quiescent
+      REAL rest_time;
+
+      /// The time that the inner joint of each link has been quiescent
+      std::vector<REAL> joint_rest_time;
+
+      /// Whether the body was asleep after the last update
+      bool asleep;
+
+      /// Whether each link was frozen after the last update
+      std::vector<bool> frozen;
+    };
+
+    void update(Entry& e, REAL dt);
+    bool is_quiescent(boost::shared_ptr<RIGIDBODY> link, REAL scale) const;
+    REAL calc_subtree_rest_time(const Entry& e, boost::shared_ptr<RIGIDBODY> link) const;
+    void freeze_resting_subtrees(Entry& e);
+
+    /// The managed bodies
+    std::vector<Entry> _entries;
+
+    /// Counts of sleeping, waking, freezing, and thawing
+    unsigned long _sleeps, _wakes, _freezes, _thaws;
+}; // end class
+
@@ -0,0 +1,24 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_SLEEP_MANAGERD_H
+#define _RAVELIN_SLEEP_MANAGERD_H
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <Ravelin/RigidBodyd.h>
+#include <Ravelin/RCArticulatedBodyd.h>
+
+namespace Ravelin {
+
+#include "ddefs.h"
+#include "SleepManager.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
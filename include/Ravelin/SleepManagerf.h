@@ -0,0 +1,24 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_SLEEP_MANAGERF_H
+#define _RAVELIN_SLEEP_MANAGERF_H
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <Ravelin/RigidBodyf.h>
+#include <Ravelin/RCArticulatedBodyf.h>
+
+namespace Ravelin {
+
+#include "fdefs.h"
+#include "SleepManager.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
@@ -10,6 +10,12 @@ class SPARSEMATRIXN
     SPARSEMATRIXN(StorageType s, unsigned m, unsigned n, boost::shared_array<unsigned> ptr, boost::shared_array<unsigned> indices, boost::shared_array<REAL> data);
     SPARSEMATRIXN(const MATRIXN& m, REAL tol=EPS);
     SPARSEMATRIXN(StorageType s, const MATRIXN& m, REAL tol=EPS);
+    SPARSEMATRIXN(const SPARSEMATRIXN& m);
+    #if __cplusplus >= 201103L
+    SPARSEMATRIXN(SPARSEMATRIXN&& m) noexcept;
+    SPARSEMATRIXN& operator=(SPARSEMATRIXN&& m) noexcept;
+    #endif
+    SPARSEMATRIXN& swap(SPARSEMATRIXN& m);
     REAL norm_inf() const;
     static SPARSEMATRIXN identity(unsigned n);
     static SPARSEMATRIXN identity(StorageType stype, unsigned n);
@@ -77,6 +83,7 @@ class SPARSEMATRIXN
     StorageType _stype;                      // the storage capacity
 
   private:
+    void set_minor(unsigned idx, const VECTORN& v);
     void set(unsigned rows, unsigned columns, const std::map<std::pair<unsigned, unsigned>, REAL>& values);
 }; // end class
 
@@ -0,0 +1,69 @@
+/****************************************************************************
+ * Copyright 2013 Evan Drumwright
+ * This library is distributed under the terms of the GNU  General Public 
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef SPARSESYMMATRIXN
+#error This class is not to be included by the user directly. Use SparseSymMatrixNf.h or SparseSymMatrixNd.h instead. 
+#endif
+
+/// A sparse symmetric matrix that stores only one triangle
+/**
+ * Nonzeros of the stored triangle are kept in compressed column format:
+ * column j holds rows i <= j (upper triangle) or i >= j (lower triangle),
+ * with row indices sorted in increasing order. Because the matrix is
+ * symmetric, the upper triangle in compressed column format is identical
+ * to the lower triangle in compressed row format (and vice versa).
+ */
+class SPARSESYMMATRIXN
+{
+  public:
+    enum Triangle { eUpper, eLower };
+
+    SPARSESYMMATRIXN();
+    SPARSESYMMATRIXN(Triangle t);
+    SPARSESYMMATRIXN(Triangle t, unsigned n, const std::map<std::pair<unsigned, unsigned>, REAL>& values);
+    SPARSESYMMATRIXN(Triangle t, const SPARSEMATRIXN& m);
+    SPARSESYMMATRIXN(Triangle t, const MATRIXN& m, REAL tol=EPS);
+    REAL norm_inf() const;
+    static SPARSESYMMATRIXN identity(Triangle t, unsigned n);
+    VECTORN& mult(const VECTORN& x, VECTORN& result) const;
+    MATRIXN& mult(const MATRIXN& m, MATRIXN& result) const;
+    unsigned rows() const { return _n; }
+    unsigned columns() const { return _n; }
+    const unsigned* get_indices() const { return _indices.get(); }
+    const unsigned* get_ptr() const { return _ptr.get(); }
+    const REAL* get_data() const { return _data.get(); }
+    unsigned* get_indices() { return _indices.get(); }
+    unsigned* get_ptr() { return _ptr.get(); }
+    REAL* get_data() { return _data.get(); }
+    SPARSESYMMATRIXN& operator*=(REAL scalar);
+    SPARSESYMMATRIXN& negate();
+    static SPARSESYMMATRIXN& outer_square(const VECTORN& g, SPARSESYMMATRIXN& result);
+    static SPARSESYMMATRIXN& outer_square(const SPARSEVECTORN& v, SPARSESYMMATRIXN& result);
+    MATRIXN& to_dense(MATRIXN& m) const;
+    SPARSEMATRIXN& to_full(SPARSEMATRIXN::StorageType stype, SPARSEMATRIXN& m) const;
+    SPARSESYMMATRIXN& to_triangle(Triangle t, SPARSESYMMATRIXN& m) const;
+    void get_values(std::map<std::pair<unsigned, unsigned>, REAL>& values) const;
+
+    /// Gets which triangle of the matrix is stored
+    Triangle get_triangle() const { return _tri; }
+
+    /// Gets the number of stored nonzeros (those in the stored triangle)
+    unsigned get_nnz() const { return _nnz; }
+
+  protected:
+    void set(Triangle t, unsigned n, const std::map<std::pair<unsigned, unsigned>, REAL>& values);
+    void allocate(unsigned n, unsigned nnz);
+
+    boost::shared_array<unsigned> _indices;  // row indices of nonzeros
+    boost::shared_array<unsigned> _ptr;      // starting indices for column j 
+    boost::shared_array<REAL> _data;         // actual data (nonzeros)
+    unsigned _nnz;                           // the number of stored nonzeros
+    unsigned _n;                             // the matrix dimension
+    Triangle _tri;                           // the triangle stored
+}; // end class
+
+std::ostream& operator<<(std::ostream& out, const SPARSESYMMATRIXN& s);
+
@@ -0,0 +1,26 @@
+/****************************************************************************
+ * Copyright 2013 Evan Drumwright
+ * This library is distributed under the terms of the GNU  General Public 
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _SPARSE_SYM_MATRIX_NF_H_
+#define _SPARSE_SYM_MATRIX_NF_H_
+
+#include <map>
+#include <boost/shared_ptr.hpp>
+#include <Ravelin/SparseVectorNf.h>
+#include <Ravelin/SparseMatrixNf.h>
+#include <Ravelin/MatrixNf.h>
+#include <Ravelin/VectorNf.h>
+
+namespace Ravelin {
+
+#include "fdefs.h"
+#include "SparseSymMatrixN.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
@@ -13,6 +13,7 @@ class SPHERICALJOINT : public virtual JOINT
   public:
     enum Axis { eAxis1, eAxis2, eAxis3 };
     SPHERICALJOINT();
+    virtual boost::shared_ptr<JOINT> clone(const PoseMap& poses) const;
     virtual void update_spatial_axes();    
     virtual void determine_q(VECTORN& q);
     virtual boost::shared_ptr<const POSE3> get_induced_pose();
@@ -0,0 +1,75 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_THREAD_POOL_H
+#define _RAVELIN_THREAD_POOL_H
+
+#include <pthread.h>
+#include <vector>
+#include <boost/exception_ptr.hpp>
+
+namespace Ravelin {
+
+/// A fixed-size pool of threads for executing independent tasks in parallel
+/**
+ * run() executes a set of tasks on the threads of the pool (the calling
+ * thread executes tasks as well) and returns once all tasks have completed.
+ * Tasks are handed out one at a time, so a task should represent a
+ * reasonable amount of work. run() must not be called concurrently (or from
+ * within a task) for the same pool. If a task throws, no further tasks are
+ * started and run() rethrows the (first) exception once the tasks already
+ * started have finished.
+ */
+class ThreadPool
+{
+  public:
+    /// The type of a task: called with the user data and the task index
+    typedef void (*Task)(void* data, unsigned i);
+
+    ThreadPool(unsigned nthreads = 0);
+    ~ThreadPool();
+    void run(unsigned ntasks, Task task, void* data);
+    static unsigned num_processors();
+
+    /// Gets the number of threads that execute tasks (including the calling thread)
+    unsigned size() const { return _threads.size() + 1; }
+
+  private:
+    ThreadPool(const ThreadPool&) {}
+    static void* work(void* arg);
+    void execute();
+
+    /// The worker threads
+    std::vector<pthread_t> _threads;
+
+    /// Synchronization between run() and the worker threads
+    pthread_mutex_t _mutex;
+    pthread_cond_t _start, _finish;
+
+    /// The task being executed and its data
+    Task _task;
+    void* _data;
+
+    /// The number of tasks and the index of the next task to execute
+    unsigned _ntasks, _next;
+
+    /// The number of worker threads still executing tasks
+    unsigned _busy;
+
+    /// The first exception thrown by a task during the current call to run()
+    boost::exception_ptr _exception;
+
+    /// Incremented every time that run() is called
+    unsigned _generation;
+
+    /// Signals the worker threads to exit
+    bool _stop;
+}; // end class
+
+} // end namespace
+
+#endif
+
@@ -0,0 +1,201 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef TRAJECTORY_WRITER
+#error This class is not to be included by the user directly. Use Trajectoryd.h or Trajectoryf.h instead.
+#endif
+
+class RC_ARTICULATED_BODY;
+
+/// Writes the generalized state of an articulated body to a binary trajectory file
+/**
+ * A trajectory file consists of a header followed by fixed-size records.
+ * The header identifies the body (with a hash of the body's model; see
+ * calc_model_hash()) and its degree-of-freedom layout. Each record holds
+ * time, the generalized coordinates q (Euler), the generalized velocity qd,
+ * the generalized acceleration qdd, and the generalized force tau (all
+ * spatial). Data is stored in the native byte order and floating point type.
+ *
+ * Records are buffered and written to disk by a separate thread, so write()
+ * only copies the record into memory. Values may optionally be quantized to
+ * a given resolution: eQuantized stores 32-bit values and eQuantizedDelta
+ * stores 16-bit differences from the previous record (the resolution must
+ * then be chosen so that the change in any value between successive records
+ * is no larger than 32767 times the resolution; larger changes are spread
+ * over subsequent records). Time is never quantized.
+ * \sa TRAJECTORY_READER
+ */
+class TRAJECTORY_WRITER
+{
+  public:
+    enum Compression { eNone, eQuantized, eQuantizedDelta };
+
+    /// The fixed portion of the header of a trajectory file
+    /**
+     * The header is followed by the number of degrees-of-freedom of each
+     * explicit joint (one 32-bit unsigned integer per joint), the initial
+     * quantized values of the first record (one 64-bit integer per value,
+     * used by eQuantizedDelta only), and padding to header_size bytes.
+     */
+    struct Header
+    {
+      char magic[8];
+      uint32_t version;
+      uint32_t real_size;
+      uint32_t compression;
+      uint32_t nq;
+      uint32_t nv;
+      uint32_t njoints;
+      uint32_t floating_base;
+      uint32_t record_size;
+      uint32_t header_size;
+      uint32_t reserved;
+      uint64_t model_hash;
+      double resolution;
+    };
+
+    TRAJECTORY_WRITER();
+    ~TRAJECTORY_WRITER();
+    void open(const std::string& fname, boost::shared_ptr<RC_ARTICULATED_BODY> body, Compression compression = eNone, REAL resolution = (REAL) 1e-6, unsigned buffer_records = 1024);
+    void open(const std::string& fname, uint64_t model_hash, unsigned nq, unsigned nv, const std::vector<unsigned>& joint_dofs, bool floating_base, Compression compression = eNone, REAL resolution = (REAL) 1e-6, unsigned buffer_records = 1024);
+    void write(REAL t, const VECTORN& q, const VECTORN& qd, const VECTORN& qdd, const VECTORN& tau);
+    void write(REAL t, boost::shared_ptr<RC_ARTICULATED_BODY> body);
+    void flush();
+    void close();
+    static uint64_t calc_model_hash(boost::shared_ptr<const RC_ARTICULATED_BODY> body);
+    static unsigned calc_record_size(Compression compression, unsigned nvalues);
+
+    /// Gets whether a file is open for writing
+    bool is_open() const { return _fp != NULL; }
+
+    /// Gets the number of records written
+    unsigned size() const { return _nrecords; }
+
+  private:
+    TRAJECTORY_WRITER(const TRAJECTORY_WRITER&) {}
+    static void* write_thread(void* arg);
+    void write_header();
+    void encode(REAL t, const VECTORN& q, const VECTORN& qd, const VECTORN& qdd, const VECTORN& tau);
+    void submit();
+    void wait_idle();
+
+    /// The file being written
+    FILE* _fp;
+
+    /// The header and DOF layout
+    Header _header;
+    std::vector<unsigned> _joint_dofs;
+
+    /// Whether the header has been written
+    bool _header_written;
+
+    /// The number of records written
+    unsigned _nrecords;
+
+    /// The quantized values of the last record (for eQuantizedDelta)
+    std::vector<int64_t> _last;
+
+    /// The buffer being filled and the buffer being written by the thread
+    std::vector<unsigned char> _fill, _drain;
+
+    /// The number of bytes used in the buffer being filled
+    unsigned _fill_bytes, _drain_bytes;
+
+    /// Thread data
+    pthread_t _thread;
+    pthread_mutex_t _mutex;
+    pthread_cond_t _cond;
+    bool _pending, _done, _error;
+
+    /// Temporaries for writing the state of a body
+    VECTORN _q, _qd, _qdd, _tau;
+}; // end class
+
+/// Reads a binary trajectory file written by TRAJECTORY_WRITER
+/**
+ * The file is memory mapped. For uncompressed files, the values of each
+ * record are available as SHAREDVECTORN views into the mapped file, so no
+ * data is copied; the views remain valid after the reader is closed. The
+ * mapping is private: modifying a view does not modify the file. All files
+ * (including compressed files) can be read using get_record(). Records of
+ * eQuantizedDelta files are decoded sequentially; reading records in
+ * increasing order is fastest.
+ */
+class TRAJECTORY_READER
+{
+  public:
+    TRAJECTORY_READER();
+    ~TRAJECTORY_READER() { close(); }
+    void open(const std::string& fname);
+    void close();
+    REAL get_time(unsigned i) const;
+    SHAREDVECTORN get_q(unsigned i);
+    SHAREDVECTORN get_qd(unsigned i);
+    SHAREDVECTORN get_qdd(unsigned i);
+    SHAREDVECTORN get_tau(unsigned i);
+    REAL get_record(unsigned i, VECTORN& q, VECTORN& qd, VECTORN& qdd, VECTORN& tau);
+    unsigned find(REAL t) const;
+
+    /// Gets whether a file is open
+    bool is_open() const { return _base != NULL; }
+
+    /// Gets the number of records in the file
+    unsigned size() const { return _nrecords; }
+
+    /// Gets the number of generalized coordinates (Euler) stored per record
+    unsigned num_generalized_coordinates() const { return _header.nq; }
+
+    /// Gets the number of generalized velocities stored per record
+    unsigned num_generalized_velocities() const { return _header.nv; }
+
+    /// Gets the hash of the model of the body that was recorded
+    uint64_t get_model_hash() const { return _header.model_hash; }
+
+    /// Gets the number of degrees-of-freedom of each explicit joint of the body that was recorded
+    const std::vector<unsigned>& get_joint_dofs() const { return _joint_dofs; }
+
+    /// Gets whether the body that was recorded has a floating base
+    bool is_floating_base() const { return _header.floating_base != 0; }
+
+    /// Gets the compression used in the file
+    TRAJECTORY_WRITER::Compression get_compression() const { return (TRAJECTORY_WRITER::Compression) _header.compression; }
+
+    /// Gets the resolution of quantized values
+    REAL get_resolution() const { return (REAL) _header.resolution; }
+
+  private:
+    TRAJECTORY_READER(const TRAJECTORY_READER&) {}
+    SHAREDVECTORN get_view(unsigned i, unsigned offset, unsigned len);
+    const unsigned char* get_record_data(unsigned i) const;
+    void decode_delta(unsigned i);
+
+    /// Unmaps the file when the last view of it is destroyed
+    struct Unmapper
+    {
+      size_t length;
+      Unmapper(size_t len) : length(len) { }
+      void operator()(REAL* data) const;
+    };
+
+    /// The mapped file and its length
+    unsigned char* _base;
+    size_t _length;
+
+    /// The mapped file as shared storage for views
+    SharedResizable<REAL> _data;
+
+    /// The header and DOF layout
+    TRAJECTORY_WRITER::Header _header;
+    std::vector<unsigned> _joint_dofs;
+
+    /// The number of records
+    unsigned _nrecords;
+
+    /// The initial quantized values and the decoded values of record _decoded_idx (for eQuantizedDelta)
+    std::vector<int64_t> _initial, _decoded;
+    unsigned _decoded_idx;
+}; // end class
+
@@ -0,0 +1,29 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0 
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#ifndef _RAVELIN_TRAJECTORYF_H
+#define _RAVELIN_TRAJECTORYF_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <Ravelin/VectorNf.h>
+#include <Ravelin/SharedVectorNf.h>
+#include <Ravelin/RCArticulatedBodyf.h>
+
+namespace Ravelin {
+
+#include "fdefs.h"
+#include "Trajectory.h"
+#include "undefs.h"
+
+} // end namespace
+
+#endif
+
@@ -11,6 +11,12 @@
 class POSE3;
 
 /// A transformation between two rigid body poses 
+/**
+ * No quantities derived from q and x are stored, so a transform may be
+ * applied from several threads at once. The std::vector overloads of
+ * transform() and inverse_transform() compute the rotation matrix and
+ * offsets once for the entire batch.
+ */
 class TRANSFORM3
 {
   public:
@@ -48,6 +54,17 @@ class TRANSFORM3
     SPATIAL_RB_INERTIA inverse_transform(const SPATIAL_RB_INERTIA& j) const;
     SPATIAL_AB_INERTIA transform(const SPATIAL_AB_INERTIA& j) const;
     SPATIAL_AB_INERTIA inverse_transform(const SPATIAL_AB_INERTIA& j) const;
+    std::vector<SFORCE>& transform(const std::vector<SFORCE>& w, std::vector<SFORCE>& result) const;
+    std::vector<SFORCE>& inverse_transform(const std::vector<SFORCE>& w, std::vector<SFORCE>& result) const;
+    std::vector<SMOMENTUM>& transform(const std::vector<SMOMENTUM>& t, std::vector<SMOMENTUM>& result) const;
+    std::vector<SMOMENTUM>& inverse_transform(const std::vector<SMOMENTUM>& t, std::vector<SMOMENTUM>& result) const;
+    std::vector<SVELOCITY>& transform(const std::vector<SVELOCITY>& t, std::vector<SVELOCITY>& result) const;
+    std::vector<SVELOCITY>& inverse_transform(const std::vector<SVELOCITY>& t, std::vector<SVELOCITY>& result) const;
+    std::vector<SACCEL>& transform(const std::vector<SACCEL>& t, std::vector<SACCEL>& result) const;
+    std::vector<SACCEL>& inverse_transform(const std::vector<SACCEL>& t, std::vector<SACCEL>& result) const;
+    MATRIX3 get_rotation() const;
+    ORIGIN3 get_r() const;
+    MATRIX3 get_rx() const;
     TRANSFORM3& set_identity();
     TRANSFORM3& invert();
     TRANSFORM3 inverse() const { return invert(*this); }
@@ -78,6 +95,8 @@ class TRANSFORM3
   private:
     void transform_spatial(const SVECTOR6& w, SVECTOR6& result) const;
     void inverse_transform_spatial(const SVECTOR6& w, SVECTOR6& result) const;
+    void transform_spatial(const SVECTOR6& w, const MATRIX3& E, const MATRIX3& rx, boost::shared_ptr<const POSE3> pose, SVECTOR6& result) const;
+    void inverse_transform_spatial(const SVECTOR6& w, const MATRIX3& E, const MATRIX3& rx, boost::shared_ptr<const POSE3> pose, SVECTOR6& result) const;
 }; // end class
 
 std::ostream& operator<<(std::ostream& out, const TRANSFORM3& m);
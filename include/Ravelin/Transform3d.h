@@ -7,6 +7,7 @@
 #ifndef _TRANSFORM3D_H
 #define _TRANSFORM3D_H
 
+#include <vector>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/shared_ptr.hpp>
 #include <Ravelin/FrameException.h>
@@ -18,6 +19,7 @@
 #include <Ravelin/SForced.h>
 #include <Ravelin/SAcceld.h> 
 #include <Ravelin/SVelocityd.h>
+#include <Ravelin/SMomentumd.h>
 #include <Ravelin/SpatialRBInertiad.h>
 #include <Ravelin/SpatialABInertiad.h>
 
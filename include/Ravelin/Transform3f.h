@@ -7,6 +7,7 @@
 #ifndef _TRANSFORM3F_H
 #define _TRANSFORM3F_H
 
+#include <vector>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/shared_ptr.hpp>
 #include <Ravelin/FrameException.h>
@@ -18,6 +19,7 @@
 #include <Ravelin/SForcef.h>
 #include <Ravelin/SAccelf.h> 
 #include <Ravelin/SVelocityf.h>
+#include <Ravelin/SMomentumf.h>
 #include <Ravelin/SpatialRBInertiaf.h>
 #include <Ravelin/SpatialABInertiaf.h>
 
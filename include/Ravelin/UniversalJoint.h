@@ -13,6 +13,7 @@ class UNIVERSALJOINT : public virtual JOINT
   public:
     enum Axis { eAxis1, eAxis2 };
     UNIVERSALJOINT();
+    virtual boost::shared_ptr<JOINT> clone(const PoseMap& poses) const;
     VECTOR3 get_axis(Axis a) const;
     void set_axis(const VECTOR3& axis, Axis a);
     virtual void update_spatial_axes();    
@@ -22,6 +22,11 @@ class VECTORN
     VECTORN();
     VECTORN(unsigned N);
     VECTORN(const VECTORN& source);
+    #if __cplusplus >= 201103L
+    VECTORN(VECTORN&& source);
+    VECTORN& operator=(VECTORN&& source);
+    #endif
+    VECTORN& swap(VECTORN& v);
     VECTORN(const SHAREDVECTORN& source);
     VECTORN(const CONST_SHAREDVECTORN& source);
     VECTORN(const VECTOR2& v);
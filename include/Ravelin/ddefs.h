@@ -33,6 +33,10 @@
 #define LINALG LinAlgd
 #define SPARSEMATRIXN SparseMatrixNd
 #define SPARSEVECTORN SparseVectorNd
+#define SPARSESYMMATRIXN SparseSymMatrixNd
+#define MUTABLESPARSEMATRIXN MutableSparseMatrixNd
+#define FIXEDVECTORN FixedVectorNd
+#define FIXEDMATRIXN FixedMatrixNd
 #define ROT2 Rot2d
 #define POSE2 Pose2d
 #define ORIGIN2 Origin2d
@@ -56,6 +60,18 @@
 #define SPARITH SpArithd 
 #define CRB_ALGORITHM CRBAlgorithmd
 #define FSAB_ALGORITHM FSABAlgorithmd
+#define DCA_ALGORITHM DCAAlgorithmd
 #define RNE_ALGORITHM RNEAlgorithmd
 #define URDFREADER URDFReaderd 
+#define TRAJECTORY_WRITER TrajectoryWriterd
+#define TRAJECTORY_READER TrajectoryReaderd
+#define DYNAMICS_AUTOTUNER DynamicsAutotunerd
+#define FRAMED_VECTOR3 FramedVector3d
+#define FRAMED_SPATIAL FramedSpatiald
+#define FRAMED_TRANSFORM3 FramedTransform3d
+#define CONTACT_SOLVER ContactSolverd
+#define ACTIVE_SET_QP ActiveSetQPd
+#define SLEEP_MANAGER SleepManagerd
+#define PLANAR_ARTICULATED_BODY PlanarArticulatedBodyd
+#define SIMD3 SIMD3d
 
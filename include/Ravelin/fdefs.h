@@ -33,6 +33,10 @@
 #define LINALG LinAlgf
 #define SPARSEMATRIXN SparseMatrixNf
 #define SPARSEVECTORN SparseVectorNf
+#define SPARSESYMMATRIXN SparseSymMatrixNf
+#define MUTABLESPARSEMATRIXN MutableSparseMatrixNf
+#define FIXEDVECTORN FixedVectorNf
+#define FIXEDMATRIXN FixedMatrixNf
 #define ROT2 Rot2f
 #define POSE2 Pose2f
 #define ORIGIN2 Origin2f
@@ -56,7 +60,19 @@
 #define SPARITH SpArithf 
 #define CRB_ALGORITHM CRBAlgorithmf
 #define FSAB_ALGORITHM FSABAlgorithmf
+#define DCA_ALGORITHM DCAAlgorithmf
 #define RNE_ALGORITHM RNEAlgorithmf
 #define URDFREADER URDFReaderf 
+#define TRAJECTORY_WRITER TrajectoryWriterf
+#define TRAJECTORY_READER TrajectoryReaderf
+#define DYNAMICS_AUTOTUNER DynamicsAutotunerf
+#define FRAMED_VECTOR3 FramedVector3f
+#define FRAMED_SPATIAL FramedSpatialf
+#define FRAMED_TRANSFORM3 FramedTransform3f
+#define CONTACT_SOLVER ContactSolverf
+#define ACTIVE_SET_QP ActiveSetQPf
+#define SLEEP_MANAGER SleepManagerf
+#define PLANAR_ARTICULATED_BODY PlanarArticulatedBodyf
+#define SIMD3 SIMD3f
 
  
@@ -33,6 +33,10 @@
 #undef LINALG 
 #undef SPARSEMATRIXN
 #undef SPARSEVECTORN
+#undef SPARSESYMMATRIXN
+#undef MUTABLESPARSEMATRIXN
+#undef FIXEDVECTORN
+#undef FIXEDMATRIXN
 #undef POSE2
 #undef ROT2
 #undef ORIGIN2
@@ -56,6 +60,18 @@
 #undef SPARITH
 #undef CRB_ALGORITHM 
 #undef FSAB_ALGORITHM 
+#undef DCA_ALGORITHM
 #undef RNE_ALGORITHM 
 #undef URDFREADER 
+#undef TRAJECTORY_WRITER
+#undef TRAJECTORY_READER
+#undef DYNAMICS_AUTOTUNER
+#undef FRAMED_VECTOR3
+#undef FRAMED_SPATIAL
+#undef FRAMED_TRANSFORM3
+#undef CONTACT_SOLVER
+#undef ACTIVE_SET_QP
+#undef SLEEP_MANAGER
+#undef PLANAR_ARTICULATED_BODY
+#undef SIMD3
 
@@ -0,0 +1,318 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+using std::vector;
+
+ACTIVE_SET_QP::ACTIVE_SET_QP()
+{
+  max_iterations = 1000;
+  tolerance = (REAL) 1e-8;
+  warm_start = true;
+  _A = _M = NULL;
+  _iterations = 0;
+}
+
+/// Computes the residual of a constraint (A*x - b or M*x - q) at x
+REAL ACTIVE_SET_QP::calc_residual(unsigned index, const VECTORN& b, const VECTORN& q, const VECTORN& x) const
+{
+  const unsigned ME = _A->rows();
+  const unsigned N = x.size();
+  const MATRIXN& C = (index < ME) ? *_A : *_M;
+  const unsigned row = (index < ME) ? index : index - ME;
+  const unsigned LD = C.leading_dim();
+  const REAL* c = C.data() + row;
+  REAL r = (index < ME) ? -b[row] : -q[row];
+  for (unsigned j=0; j< N; j++)
+    r += c[j*LD]*x[j];
+  return r;
+}
+
+/// Adds a constraint (row 'row' of C) to the active set, with a zero multiplier
+/**
+ * \return <b>false</b> if the constraint normal is linearly dependent on
+ *         the normals of the active constraints (and the constraint was not
+ *         added)
+ */
+bool ACTIVE_SET_QP::add_constraint(const MATRIXN& C, unsigned row, unsigned index)
+{
+  const unsigned K = _active.size();
+
+  // insert inv(U')*n as the last column of the factorization
+  C.get_row(row, _v);
+  LINALG::solve_tri_fast(_U, true, true, _v);
+  const REAL vnorm = _v.norm();
+  _workM.resize(_v.size(), 1);
+  _workM.set_column(0, _v);
+  _LA.update_QR_insert_cols(_Q, _R, _workM, K);
+
+  // a (near) zero diagonal element indicates linear dependence
+  if (K >= _R.rows() || std::fabs(_R(K,K)) <= EPS*vnorm)
+  {
+    _LA.update_QR_delete_cols(_Q, _R, K, 1);
+    return false;
+  }
+
+  _active.push_back(index);
+  _u.resize(K+1, true);
+  _u[K] = (REAL) 0.0;
+  return true;
+}
+
+/// Removes the j'th active constraint from the active set
+void ACTIVE_SET_QP::drop_constraint(unsigned j)
+{
+  const unsigned K = _active.size();
+  _LA.update_QR_delete_cols(_Q, _R, j, 1);
+  _active.erase(_active.begin()+j);
+  for (unsigned i=j+1; i< K; i++)
+    _u[i-1] = _u[i];
+  _u.resize(K-1, true);
+}
+
+/// Computes the solution and the multipliers with the active constraints treated as equalities
+/**
+ * With x0 = -inv(G)*c and inv(U')*N = Q1*R, the multipliers u satisfy
+ * R'*R*u = w, where w is the residual of the active constraints at x0, and
+ * the solution is x = x0 + inv(U)*Q1*(R*u).
+ */
+void ACTIVE_SET_QP::solve_active_set(const VECTORN& c, const VECTORN& b, const VECTORN& q, VECTORN& x)
+{
+  const unsigned N = c.size();
+  const unsigned K = _active.size();
+
+  // compute the unconstrained minimum
+  x = c;
+  x.negate();
+  LINALG::solve_chol_fast(_U, x);
+
+  // compute w, then solve R'*y = w by forward substitution
+  _d.resize(K);
+  for (unsigned i=0; i< K; i++)
+  {
+    REAL y = -calc_residual(_active[i], b, q, x);
+    for (unsigned k=0; k< i; k++)
+      y -= _R(k,i)*_d[k];
+    _d[i] = y/_R(i,i);
+  }
+
+  // solve R*u = y by back substitution
+  for (unsigned i=K; i> 0; i--)
+  {
+    REAL u = _d[i-1];
+    for (unsigned k=i; k< K; k++)
+      u -= _R(i-1,k)*_u[k];
+    _u[i-1] = u/_R(i-1,i-1);
+  }
+
+  // update x using Q1*y
+  _z.set_zero(N);
+  for (unsigned k=0; k< K; k++)
+  {
+    const REAL* qk = _Q.data() + k*N;
+    for (unsigned i=0; i< N; i++)
+      _z[i] += qk[i]*_d[k];
+  }
+  LINALG::solve_tri_fast(_U, true, false, _z);
+  x += _z;
+}
+
+/// Solves the quadratic program
+/**
+ * \param G the n x n symmetric, positive definite Hessian
+ * \param c the linear term
+ * \param A the equality constraint matrix (may have zero rows)
+ * \param b the equality constraint right hand side
+ * \param M the inequality constraint matrix (may have zero rows)
+ * \param q the inequality constraint right hand side
+ * \param x the solution on return
+ * \return eOptimal on success; eNotConvex if G is not positive definite;
+ *         eInfeasible if the constraints are inconsistent; eMaxIterations if
+ *         the solution was not found within max_iterations active-set
+ *         changes (x then satisfies the active constraints only)
+ */
+ACTIVE_SET_QP::Status ACTIVE_SET_QP::solve(const MATRIXN& G, const VECTORN& c, const MATRIXN& A, const VECTORN& b, const MATRIXN& M, const VECTORN& q, VECTORN& x)
+{
+  const unsigned N = G.rows();
+  const unsigned ME = A.rows();
+  const unsigned MI = M.rows();
+  const REAL INF = std::numeric_limits<REAL>::max();
+
+  #ifndef NEXCEPT
+  if (G.columns() != N || c.size() != N || b.size() != ME || q.size() != MI)
+    throw MissizeException();
+  if ((ME > 0 && A.columns() != N) || (MI > 0 && M.columns() != N))
+    throw MissizeException();
+  #endif
+
+  _A = &A;
+  _M = &M;
+  _iterations = 0;
+
+  // reserve space so that the active set can grow without allocating
+  _R.resize(N, N+1);
+  _u.resize(N+1);
+  _d.resize(N+1);
+  _r.resize(N+1);
+  _active.reserve(N+1);
+  _warm.reserve(N+1);
+
+  // factor G
+  _U = G;
+  if (!LINALG::factor_chol(_U))
+    return eNotConvex;
+
+  // start with an empty active set
+  _Q.set_identity(N);
+  _R.resize(N, 0);
+  _u.resize(0);
+  _active.clear();
+
+  // make the equality constraints (and, when warm starting, the inequality
+  // constraints that were active at the last solution) active
+  for (unsigned i=0; i< ME; i++)
+    add_constraint(A, i, i);
+  if (warm_start)
+    for (unsigned i=0; i< _warm.size(); i++)
+      if (_warm[i] < MI)
+        add_constraint(M, _warm[i], ME + _warm[i]);
+
+  // compute the solution, removing inequality constraints with negative
+  // multipliers until the solution is optimal for the active set
+  while (true)
+  {
+    solve_active_set(c, b, q, x);
+    unsigned jmin = _active.size();
+    REAL umin = -tolerance;
+    for (unsigned j=0; j< _active.size(); j++)
+      if (_active[j] >= ME && _u[j] < umin)
+      {
+        jmin = j;
+        umin = _u[j];
+      }
+    if (jmin == _active.size())
+      break;
+    drop_constraint(jmin);
+    _iterations++;
+  }
+
+  // equality constraints that were not added are linearly dependent; they
+  // must be satisfied now (and remain so)
+  for (unsigned i=0; i< ME; i++)
+    if (std::fabs(calc_residual(i, b, q, x)) > tolerance)
+      return eInfeasible;
+
+  // add violated inequality constraints until there are none
+  while (true)
+  {
+    // find the most violated inequality constraint
+    if (MI == 0)
+      break;
+    M.mult(x, _slack) -= q;
+    for (unsigned j=0; j< _active.size(); j++)
+      if (_active[j] >= ME)
+        _slack[_active[j] - ME] = (REAL) 0.0;
+    unsigned p = 0;
+    for (unsigned i=1; i< MI; i++)
+      if (_slack[i] < _slack[p])
+        p = i;
+    if (_slack[p] >= -tolerance)
+      break;
+
+    // add it, dropping active constraints as necessary
+    M.get_row(p, _n);
+    REAL up = (REAL) 0.0;
+    while (true)
+    {
+      if (++_iterations > max_iterations)
+        return eMaxIterations;
+      const unsigned K = _active.size();
+
+      // compute d = Q'*inv(U')*n
+      _v = _n;
+      LINALG::solve_tri_fast(_U, true, true, _v);
+      _Q.transpose_mult(_v, _d);
+
+      // compute the step in the primal variables, z = inv(U)*Q2*d2
+      _z.set_zero(N);
+      REAL d2sq = (REAL) 0.0;
+      for (unsigned k=K; k< N; k++)
+      {
+        const REAL* qk = _Q.data() + k*N;
+        for (unsigned i=0; i< N; i++)
+          _z[i] += qk[i]*_d[k];
+        d2sq += _d[k]*_d[k];
+      }
+      LINALG::solve_tri_fast(_U, true, false, _z);
+
+      // compute the step in the multipliers, r = inv(R1)*d1
+      _r.resize(K);
+      for (unsigned i=K; i> 0; i--)
+      {
+        REAL r = _d[i-1];
+        for (unsigned k=i; k< K; k++)
+          r -= _R(i-1,k)*_r[k];
+        _r[i-1] = r/_R(i-1,i-1);
+      }
+
+      // compute the largest step that keeps the multipliers nonnegative
+      REAL t1 = INF;
+      unsigned l = K;
+      for (unsigned j=0; j< K; j++)
+        if (_active[j] >= ME && _r[j] > (REAL) 0.0 && _u[j]/_r[j] < t1)
+        {
+          t1 = _u[j]/_r[j];
+          l = j;
+        }
+
+      // compute the step that satisfies the constraint (z'*n = |d2|^2); the
+      // step is only taken in the multipliers if n depends on the active normals
+      REAL t2 = INF;
+      if (d2sq > EPS*EPS*_v.norm_sq())
+        t2 = -calc_residual(ME + p, b, q, x)/d2sq;
+
+      if (t1 == INF && t2 == INF)
+        return eInfeasible;
+
+      // take the step
+      const REAL t = std::min(t1, t2);
+      if (t2 < INF)
+        x += (_z *= t);
+      for (unsigned j=0; j< K; j++)
+        _u[j] -= t*_r[j];
+      up += t;
+
+      // add the constraint (full step) or drop the blocking one (partial step)
+      if (t2 <= t1)
+      {
+        if (add_constraint(M, p, ME + p))
+          _u[K] = up;
+        break;
+      }
+      else
+        drop_constraint(l);
+    }
+  }
+
+  // store the multipliers and the active set
+  _lambda.set_zero(ME);
+  _mu.set_zero(MI);
+  _warm.clear();
+  for (unsigned j=0; j< _active.size(); j++)
+  {
+    if (_active[j] < ME)
+      _lambda[_active[j]] = _u[j];
+    else
+    {
+      _mu[_active[j] - ME] = _u[j];
+      _warm.push_back(_active[j] - ME);
+    }
+  }
+
+  FILE_LOG(LOG_OPTIMIZATION) << "ActiveSetQP::solve() - " << _iterations << " active-set changes, " << _warm.size() << " active inequalities" << std::endl;
+
+  return eOptimal;
+}
+
@@ -0,0 +1,19 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#include <cmath>
+#include <limits>
+#include <Ravelin/Log.h>
+#include <Ravelin/Constants.h>
+#include <Ravelin/MissizeException.h>
+#include <Ravelin/ActiveSetQPd.h>
+
+using namespace Ravelin;
+
+#include <Ravelin/ddefs.h>
+#include "ActiveSetQP.cpp"
+#include <Ravelin/undefs.h>
+
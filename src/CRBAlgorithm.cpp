@@ -14,6 +14,8 @@ using boost::shared_ptr;
 
 CRB_ALGORITHM::CRB_ALGORITHM()
 {
+  _locked = false;
+  _rank_deficient_locked = false;
 }
 
 /// Computes the parent array for sparse Cholesky factorization
@@ -182,6 +184,11 @@ void CRB_ALGORITHM::calc_generalized_inertia(shared_ptr<RC_ARTICULATED_BODY> bod
   // set appropriate part of H
   M.set_sub_mat(0, 0, _H);
 
+  // add the joint-space inertia from implicit joint springs and dampers
+  if (body->_implicit_inertia.size() == body->num_joint_dof_explicit())
+    for (unsigned i=0; i< body->_implicit_inertia.size(); i++)
+      M(i,i) += body->_implicit_inertia[i];
+
   // see whether we are done
   if (!body->is_floating_base())
     return;
@@ -406,21 +413,22 @@ void CRB_ALGORITHM::calc_joint_space_inertia(shared_ptr<RC_ARTICULATED_BODY> bod
   // compute H
   // ************************************************************************
 
-  // compute the forces
+  // compute the forces (the composite inertias are in the link computation
+  // frames, as are the cached spatial axes)
+  const RC_ARTICULATED_BODY::Kinematics& kin = body->get_kinematics();
   _momenta.resize(links.size());
   for (unsigned i=0; i < ejoints.size(); i++)
   {
     shared_ptr<RIGIDBODY> outboard = ejoints[i]->get_outboard_link(); 
     unsigned oidx = outboard->get_index();
-    const std::vector<SVELOCITY>& s = ejoints[i]->get_spatial_axes();
-    POSE3::transform(Ic[oidx].pose, s, _sprime);
-    SPARITH::mult(Ic[oidx], _sprime, _momenta[oidx]);
-    if (_sprime.size() > 0)
+    const std::vector<SVELOCITY>& sprime = kin.s[oidx];
+    SPARITH::mult(Ic[oidx], sprime, _momenta[oidx]);
+    if (sprime.size() > 0)
     {
       FILE_LOG(LOG_DYNAMICS) << "Jacobian / momentum for " << ejoints[i]->joint_id << " (explicit joint index " << ejoints[i]->get_coord_index() << ")" << std::endl;
       for (unsigned j=0; j< ejoints[i]->num_dof(); j++)
       {
-        FILE_LOG(LOG_DYNAMICS) << "s[ " << j << "]: " << _sprime[j] << std::endl;
+        FILE_LOG(LOG_DYNAMICS) << "s[ " << j << "]: " << sprime[j] << std::endl;
         FILE_LOG(LOG_DYNAMICS) << "Is[" << j << "]: " << _momenta[oidx][j] << std::endl;
       }
     }
@@ -572,9 +580,9 @@ void CRB_ALGORITHM::precalc(shared_ptr<RC_ARTICULATED_BODY> body)
   const vector<shared_ptr<JOINT> >& joints = body->get_explicit_joints();
 
   // get the generalized coordinates
-  static VECTORN gc, tmpv;
+  VECTORN& gc = _gc;
   body->get_generalized_coordinates_euler(gc);
-  if (_gc_last.size() == 0 || ((tmpv = gc) -= _gc_last).norm_inf() > REFACTOR_TOL)
+  if (_gc_last.size() == 0 || ((_gc_delta = gc) -= _gc_last).norm_inf() > REFACTOR_TOL)
   {
     // compute spatial isolated inertias and generalized inertia matrix
     // do the calculations
@@ -614,6 +622,88 @@ void CRB_ALGORITHM::calc_fwd_dyn()
   update_link_accelerations(body);
 }
 
+/// Executes the composite rigid-body method with some generalized coordinates locked
+/**
+ * The accelerations of the locked coordinates are held at zero, as if the
+ * corresponding joints were welded, and the accelerations of the remaining
+ * coordinates are computed by factorizing only the rows and columns of the
+ * generalized inertia matrix that correspond to them.
+ * \param unlocked a vector of size equal to the number of rows in the
+ *        generalized inertia matrix (the explicit joint coordinates, 
+ *        followed by the six base coordinates for floating bases, which must
+ *        be <b>true</b>) in which locked coordinates are <b>false</b>
+ */
+void CRB_ALGORITHM::calc_fwd_dyn_locked(const vector<bool>& unlocked)
+{
+  // get the body
+  shared_ptr<RC_ARTICULATED_BODY> body(_body);
+
+  // do necessary pre-calculations
+  _unlocked = unlocked;
+  precalc_locked(body);
+
+  // execute the appropriate algorithm
+  _locked = true;
+  if (body->is_floating_base())
+    calc_fwd_dyn_floating_base(body);
+  else
+    calc_fwd_dyn_fixed_base(body);
+  _locked = false;
+   
+  // update the link accelerations
+  update_link_accelerations(body);
+}
+
+/// Performs necessary pre-computations for computing accelerations with locked coordinates
+void CRB_ALGORITHM::precalc_locked(shared_ptr<RC_ARTICULATED_BODY> body)
+{
+  // tolerance for not recomputing/refactorizing inertia matrix
+  const double REFACTOR_TOL = 1e-8;
+
+  // get the generalized coordinates
+  VECTORN& gc = _gc;
+  body->get_generalized_coordinates_euler(gc);
+  if (_gc_locked_last.size() == 0 || _unlocked != _unlocked_last || ((_gc_delta = gc) -= _gc_locked_last).norm_inf() > REFACTOR_TOL)
+  {
+    // compute the generalized inertia matrix
+    calc_generalized_inertia(body);
+
+    // attempt to do a Cholesky factorization of the unlocked part of M
+    _M.select_square(_unlocked, _fM_locked);
+    if ((_rank_deficient_locked = !_LA->factor_chol(_fM_locked)))
+    {
+      std::cerr << "CRBAlgorithm::precalc_locked() warning- Cholesky factorization of generalized inertia matrix failed" << std::endl;
+      _M.select_square(_unlocked, _fM_locked);
+      _LA->svd(_fM_locked, _uM_locked, _sM_locked, _vM_locked);
+    }
+
+    _gc_locked_last = gc;
+    _unlocked_last = _unlocked;
+  }
+}
+
+/// Solves for acceleration using the rows and columns of the body inertia matrix that are not locked
+/**
+ * \param xb the right hand side on entry (of size equal to the number of
+ *        rows in the generalized inertia matrix); the solution on return, with
+ *        zeros for the locked coordinates
+ */
+VECTORN& CRB_ALGORITHM::M_solve_locked(VECTORN& xb)
+{
+  // solve for the unlocked coordinates
+  xb.select(_unlocked, _x_locked);
+  if (_rank_deficient_locked)
+    _LA->solve_LS_fast(_uM_locked, _sM_locked, _vM_locked, _x_locked);
+  else
+    _LA->solve_chol_fast(_fM_locked, _x_locked);
+
+  // scatter the solution
+  for (unsigned i=0, j=0; i< xb.size(); i++)
+    xb[i] = (_unlocked[i]) ? _x_locked[j++] : (REAL) 0.0;
+
+  return xb;
+}
+
 /// Executes the composite rigid-body method without computing and factorizing inertia matrix
 /**
  * This method is useful when the inertia matrix has already been computed-
@@ -759,7 +849,8 @@ void CRB_ALGORITHM::calc_fwd_dyn_fixed_base(shared_ptr<RC_ARTICULATED_BODY> body
   for (unsigned i=0; i< ejoints.size(); i++)
   {
     unsigned j = ejoints[i]->get_coord_index();
-    _Q.set_sub_vec(j, ejoints[i]->force);
+    ejoints[i]->calc_spring_damper_force(body->get_implicit_step_size(), _workv);
+    _Q.set_sub_vec(j, _workv += ejoints[i]->force);
   }
 
   FILE_LOG(LOG_DYNAMICS) << "H: " << std::endl << _M;
@@ -773,7 +864,10 @@ void CRB_ALGORITHM::calc_fwd_dyn_fixed_base(shared_ptr<RC_ARTICULATED_BODY> body
   VECTORN& qdd = this->_qdd;
 
   // compute joint accelerations
-  M_solve_noprecalc(qdd = _Q);
+  if (_locked)
+    M_solve_locked(qdd = _Q);
+  else
+    M_solve_noprecalc(qdd = _Q);
 
   FILE_LOG(LOG_DYNAMICS) << "qdd: " << qdd << std::endl;
 
@@ -824,7 +918,8 @@ void CRB_ALGORITHM::calc_fwd_dyn_floating_base(shared_ptr<RC_ARTICULATED_BODY> b
   for (unsigned i=0; i< ejoints.size(); i++)
   {
      unsigned j = ejoints[i]->get_coord_index();
-    _Q.set_sub_vec(j, ejoints[i]->force);
+    ejoints[i]->calc_spring_damper_force(body->get_implicit_step_size(), _workv);
+    _Q.set_sub_vec(j, _workv += ejoints[i]->force);
   }
 
   if (LOGGING(LOG_DYNAMICS))
@@ -843,7 +938,10 @@ void CRB_ALGORITHM::calc_fwd_dyn_floating_base(shared_ptr<RC_ARTICULATED_BODY> b
   FILE_LOG(LOG_DYNAMICS) << "link + external forces on base: " << f0x << std::endl;
 
   // solve for accelerations
-  M_solve_noprecalc(_augV = _b); 
+  if (_locked)
+    M_solve_locked(_augV = _b);
+  else
+    M_solve_noprecalc(_augV = _b); 
   FILE_LOG(LOG_DYNAMICS) << "b: " << _b << std::endl;
 
   // get pointers to a0 and qdd vectors
@@ -903,86 +1001,19 @@ void CRB_ALGORITHM::calc_generalized_forces(SFORCE& f0, VECTORN& C)
   }
 
   // **************************************************************************
-  // first, compute forward dynamics using RNE algorithm; we copy the algorithm
-  // here, because we need some data out of it
+  // first, compute inverse dynamics using the RNE algorithm 
   // **************************************************************************
 
   FILE_LOG(LOG_DYNAMICS) << "CRBAlgorithm::calc_generalized_forces() entered" << std::endl;
 
-  // ** STEP 1: compute accelerations
-
-  // get the base link
-  shared_ptr<RIGIDBODY> base = links.front();
+  // ** STEP 1: compute accelerations due to the joint and base velocities
+  body->propagate_link_motion(NULL, VECTOR3::zero(), true);
 
-  // setup the map of link accelerations
+  // put the accelerations into the link computation frames (the frames of the
+  // link velocities)
   _a.resize(links.size());
-
-  // setup the acceleration for the base
-  _a[base->get_index()].set_zero(base->get_velocity().pose);
-  
-  // add all child links of the base to the processing queue
-  list<shared_ptr<RIGIDBODY> > children;
-  base->get_child_links(std::back_inserter(children));
-  BOOST_FOREACH(shared_ptr<RIGIDBODY> rb, children)
-    link_queue.push(rb);
-    
-  // mark all links as not processed
   for (unsigned i=0; i< links.size(); i++)
-    body->_processed[i] = false;
-  body->_processed[base->get_index()] = true;
-
-  // process all links
-  while (!link_queue.empty())
-  {
-    // get the link off of the front of the queue
-    shared_ptr<RIGIDBODY> link = link_queue.front();
-    link_queue.pop();  
-    unsigned i = link->get_index();
-    body->_processed[i] = true;
-
-    // push all children of the link onto the queue, unless they were already
-    // processed  
-    list<shared_ptr<RIGIDBODY> > child_links;
-    link->get_child_links(std::back_inserter(child_links)); 
-    BOOST_FOREACH(shared_ptr<RIGIDBODY> rb, child_links)
-      if (!body->_processed[rb->get_index()])
-        link_queue.push(rb);
-
-    // get the link's parent
-    shared_ptr<RIGIDBODY> parent(link->get_parent_link());
-    unsigned h = parent->get_index();
-
-    // get the joint for this link
-    shared_ptr<JOINT> joint(link->get_inner_joint_explicit());
-
-    // get the spatial link velocity
-    const SVELOCITY& vx = link->get_velocity(); 
-
-    // get spatial axes and derivative for this link's inner joint
-    const std::vector<SVELOCITY>& s = joint->get_spatial_axes();
-    const std::vector<SVELOCITY>& sdot = joint->get_spatial_axes_dot();
-
-    // get the current joint velocity
-    const VECTORN& qd = joint->qd;
-    FILE_LOG(LOG_DYNAMICS) << "Joint " << joint->joint_id << " velocity: " << qd << std::endl;
-
-    // **** compute acceleration
-
-    // add this link's contribution
-    POSE3::transform(vx.pose, s, _sprime);
-    if (_sprime.empty())
-      _a[i].set_zero(vx.pose);
-    else
-    {
-      SVELOCITY sqd = SPARITH::mult(_sprime, qd);
-      _a[i] = vx.cross(sqd);
-    }
-    if (!sdot.empty())
-      _a[i] += SACCEL(SPARITH::mult(POSE3::transform(_a[i].pose, sdot, _sprime), qd)); 
-
-    // now add parent's contribution
-    _a[i] += SPARITH::transform_accel(_a[i].pose, _a[h]);
-  }
+    _a[i] = SPARITH::transform_accel(links[i]->get_velocity().pose, body->_link_a[i]);
   
   // ** STEP 2: compute link forces -- backward recursion
   // use a map to determine which links have been processed
@@ -1077,7 +1108,7 @@ void CRB_ALGORITHM::calc_generalized_forces(SFORCE& f0, VECTORN& C)
     // compute appropriate components of C
     SHAREDVECTORN Csub = C.segment(jidx, jidx+joint->num_dof()); 
     const std::vector<SVELOCITY>& s = joint->get_spatial_axes();
-    transform_and_transpose_mult(s, _w[oidx], Csub);
+    SPARITH::transpose_mult(body->_kinematics.s[oidx], _w[oidx], Csub);
 
     FILE_LOG(LOG_DYNAMICS) << " -- computing C for link " << ob->body_id << std::endl;
     if (LOGGING(LOG_DYNAMICS))
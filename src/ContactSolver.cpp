@@ -0,0 +1,479 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+using boost::shared_ptr;
+using boost::dynamic_pointer_cast;
+using std::vector;
+using std::map;
+
+CONTACT_SOLVER::CONTACT_SOLVER()
+{
+  solver_type = ePGS;
+  max_iterations = 100;
+  tolerance = (REAL) 1e-6;
+  relaxation = (REAL) 1.0;
+  rho = (REAL) 0.0;
+  max_cg_iterations = 10;
+  warm_start_factor = (REAL) 1.0;
+}
+
+/// Projects an impulse [normal; tangent; tangent] onto the friction cone with coefficient mu
+ORIGIN3 CONTACT_SOLVER::project_friction_cone(const ORIGIN3& lambda, REAL mu)
+{
+  const REAL N = lambda[0];
+  const REAL T = std::sqrt(lambda[1]*lambda[1] + lambda[2]*lambda[2]);
+
+  // inside the cone
+  if (T <= mu*N)
+    return lambda;
+
+  // inside the polar cone
+  if (mu*T <= -N)
+    return ORIGIN3::zero();
+
+  // project onto the boundary of the cone
+  const REAL NPROJ = (N + mu*T)/(1 + mu*mu);
+  const REAL SCAL = mu*NPROJ/T;
+  return ORIGIN3(NPROJ, lambda[1]*SCAL, lambda[2]*SCAL);
+}
+
+/// Computes the 3 x n contact Jacobian for a point on a link of a body
+/**
+ * \param body the body (a rigid body or an articulated body)
+ * \param link the link of the body that the point is on (the body itself for a rigid body)
+ * \param point the contact point
+ * \param normal the contact normal (pointing toward the body for the first body of a contact)
+ * \param J on return, the matrix that maps the spatial generalized velocity of
+ *        the body to the velocity of the point, projected onto the normal and
+ *        two tangent directions
+ */
+MATRIXN& CONTACT_SOLVER::calc_contact_jacobian(shared_ptr<DYNAMIC_BODY> body, shared_ptr<RIGIDBODY> link, const VECTOR3& point, const VECTOR3& normal, MATRIXN& J)
+{
+  const shared_ptr<const POSE3> GLOBAL;
+  const unsigned LINEAR = 0;
+  MATRIXN J6;
+
+  // setup a frame at the contact point, aligned with the global frame
+  shared_ptr<POSE3> P(new POSE3);
+  P->rpose = GLOBAL;
+  P->x = ORIGIN3(POSE3::transform_point(GLOBAL, point));
+
+  // compute the Jacobian for the spatial velocity of the link at the point
+  shared_ptr<ARTICULATED_BODY> ab = dynamic_pointer_cast<ARTICULATED_BODY>(body);
+  if (ab)
+    ab->calc_jacobian(P, link, J6);
+  else
+    body->calc_jacobian(body->get_gc_pose(), P, link, J6);
+
+  // get the contact directions (in the global frame)
+  VECTOR3 n = POSE3::transform_vector(GLOBAL, normal), t1, t2;
+  n.normalize();
+  VECTOR3::determine_orthonormal_basis(n, t1, t2);
+
+  // project the linear velocity rows (the Jacobian maps to [linear; angular]) onto
+  // the contact directions
+  const unsigned NGC = J6.columns();
+  J.resize(3, NGC);
+  for (unsigned j=0; j< NGC; j++)
+  {
+    ORIGIN3 xd(J6(LINEAR,j), J6(LINEAR+1,j), J6(LINEAR+2,j));
+    J(0,j) = ORIGIN3(n).dot(xd);
+    J(1,j) = ORIGIN3(t1).dot(xd);
+    J(2,j) = ORIGIN3(t2).dot(xd);
+  }
+
+  return J;
+}
+
+/// Adds a body to the set of bodies in contact (if it can move), returning its index or -1
+int CONTACT_SOLVER::add_body(shared_ptr<DYNAMIC_BODY> body, map<shared_ptr<DYNAMIC_BODY>, unsigned>& index)
+{
+  if (!body || !body->is_enabled() || body->num_generalized_coordinates(DYNAMIC_BODY::eSpatial) == 0)
+    return -1;
+
+  map<shared_ptr<DYNAMIC_BODY>, unsigned>::const_iterator i = index.find(body);
+  if (i != index.end())
+    return (int) i->second;
+
+  const unsigned IDX = _bodies.size();
+  index[body] = IDX;
+  _bodies.push_back(Body());
+  _bodies.back().body = body;
+  return (int) IDX;
+}
+
+/// Sets up the stacked Jacobians, inv(M)*J', the Delassus diagonal blocks, and the unconstrained relative velocities
+void CONTACT_SOLVER::setup(vector<Contact>& contacts)
+{
+  const unsigned NC = contacts.size();
+  map<shared_ptr<DYNAMIC_BODY>, unsigned> index;
+  vector<unsigned> nrows;
+
+  // determine the bodies and the rows of the stacked Jacobians
+  _bodies.clear();
+  for (unsigned k=0; k< 2; k++)
+    _sides[k].resize(NC);
+  for (unsigned i=0; i< NC; i++)
+  {
+    for (unsigned k=0; k< 2; k++)
+    {
+      Side& side = _sides[k][i];
+      side.body = add_body((k == 0) ? contacts[i].body1 : contacts[i].body2, index);
+      if (side.body < 0)
+        continue;
+      if (nrows.size() < _bodies.size())
+        nrows.resize(_bodies.size(), 0);
+      side.row = nrows[side.body];
+      nrows[side.body] += 3;
+
+      #ifndef NEXCEPT
+      const MATRIXN& Jk = (k == 0) ? contacts[i].J1 : contacts[i].J2;
+      if (Jk.rows() != 3 || Jk.columns() != _bodies[side.body].body->num_generalized_coordinates(DYNAMIC_BODY::eSpatial))
+        throw std::runtime_error("CONTACT_SOLVER::solve() - contact Jacobian has incorrect size");
+      #endif
+    }
+  }
+
+  // stack the (signed) Jacobians for each body
+  for (unsigned b=0; b< _bodies.size(); b++)
+  {
+    const unsigned NGC = _bodies[b].body->num_generalized_coordinates(DYNAMIC_BODY::eSpatial);
+    _bodies[b].J.set_zero(nrows[b], NGC);
+    _bodies[b].body->get_generalized_velocity(DYNAMIC_BODY::eSpatial, _bodies[b].v);
+  }
+  for (unsigned i=0; i< NC; i++)
+    for (unsigned k=0; k< 2; k++)
+    {
+      const Side& side = _sides[k][i];
+      if (side.body < 0)
+        continue;
+      const MATRIXN& Jk = (k == 0) ? contacts[i].J1 : contacts[i].J2;
+      const REAL SIGN = (k == 0) ? (REAL) 1.0 : (REAL) -1.0;
+      MATRIXN& J = _bodies[side.body].J;
+      for (unsigned j=0; j< J.columns(); j++)
+        for (unsigned r=0; r< 3; r++)
+          J(side.row+r, j) = SIGN*Jk(r, j);
+    }
+
+  // compute inv(M)*J' for each body
+  for (unsigned b=0; b< _bodies.size(); b++)
+    _bodies[b].body->transpose_solve_generalized_inertia(_bodies[b].J, _bodies[b].W);
+
+  // compute the diagonal blocks of the Delassus operator and the unconstrained relative velocities
+  _D.resize(NC);
+  _b.resize(NC);
+  for (unsigned i=0; i< NC; i++)
+  {
+    _D[i].set_zero();
+    _b[i] = calc_velocity(i);
+    _b[i][0] += contacts[i].bias;
+    for (unsigned k=0; k< 2; k++)
+    {
+      const Side& side = _sides[k][i];
+      if (side.body < 0)
+        continue;
+      const MATRIXN& J = _bodies[side.body].J;
+      const MATRIXN& W = _bodies[side.body].W;
+      for (unsigned r=0; r< 3; r++)
+        for (unsigned c=0; c< 3; c++)
+        {
+          REAL sum = (REAL) 0.0;
+          for (unsigned j=0; j< J.columns(); j++)
+            sum += J(side.row+r, j)*W(j, side.row+c);
+          _D[i](r,c) += sum;
+        }
+    }
+  }
+}
+
+/// Computes the relative velocity (without bias) of contact i from the current body velocities
+ORIGIN3 CONTACT_SOLVER::calc_velocity(unsigned i) const
+{
+  ORIGIN3 u = ORIGIN3::zero();
+  for (unsigned k=0; k< 2; k++)
+  {
+    const Side& side = _sides[k][i];
+    if (side.body < 0)
+      continue;
+    const MATRIXN& J = _bodies[side.body].J;
+    const VECTORN& v = _bodies[side.body].v;
+    for (unsigned j=0; j< J.columns(); j++)
+      for (unsigned r=0; r< 3; r++)
+        u[r] += J(side.row+r, j)*v[j];
+  }
+
+  return u;
+}
+
+/// Updates the body velocities for a change in the impulse of contact i
+void CONTACT_SOLVER::apply_impulse_change(unsigned i, const ORIGIN3& dlambda)
+{
+  for (unsigned k=0; k< 2; k++)
+  {
+    const Side& side = _sides[k][i];
+    if (side.body < 0)
+      continue;
+    const MATRIXN& W = _bodies[side.body].W;
+    VECTORN& v = _bodies[side.body].v;
+    for (unsigned j=0; j< W.rows(); j++)
+      v[j] += W(j, side.row)*dlambda[0] + W(j, side.row+1)*dlambda[1] + W(j, side.row+2)*dlambda[2];
+  }
+}
+
+/// Computes y = A*x using the stacked Jacobians and inv(M)*J'
+void CONTACT_SOLVER::mult_delassus(const vector<ORIGIN3>& x, vector<ORIGIN3>& y)
+{
+  const unsigned NC = x.size();
+
+  // compute inv(M)*J'*x for each body
+  _workv.resize(_bodies.size());
+  for (unsigned b=0; b< _bodies.size(); b++)
+    _workv[b].set_zero(_bodies[b].W.rows());
+  for (unsigned i=0; i< NC; i++)
+    for (unsigned k=0; k< 2; k++)
+    {
+      const Side& side = _sides[k][i];
+      if (side.body < 0)
+        continue;
+      const MATRIXN& W = _bodies[side.body].W;
+      VECTORN& w = _workv[side.body];
+      for (unsigned j=0; j< W.rows(); j++)
+        w[j] += W(j, side.row)*x[i][0] + W(j, side.row+1)*x[i][1] + W(j, side.row+2)*x[i][2];
+    }
+
+  // compute J*inv(M)*J'*x
+  y.resize(NC);
+  for (unsigned i=0; i< NC; i++)
+  {
+    y[i].set_zero();
+    for (unsigned k=0; k< 2; k++)
+    {
+      const Side& side = _sides[k][i];
+      if (side.body < 0)
+        continue;
+      const MATRIXN& J = _bodies[side.body].J;
+      const VECTORN& w = _workv[side.body];
+      for (unsigned j=0; j< J.columns(); j++)
+        for (unsigned r=0; r< 3; r++)
+          y[i][r] += J(side.row+r, j)*w[j];
+    }
+  }
+}
+
+/// Computes the contact impulses and applies them to the bodies
+/**
+ * On return, the impulse of each contact is stored in Contact::impulse and
+ * the generalized velocities of the bodies have been updated.
+ * \return the number of iterations
+ */
+unsigned CONTACT_SOLVER::solve(vector<Contact>& contacts)
+{
+  const unsigned NC = contacts.size();
+
+  _telemetry.clear();
+  if (NC == 0)
+    return 0;
+
+  // setup the problem
+  setup(contacts);
+
+  // warm start
+  _lambda.resize(NC);
+  for (unsigned i=0; i< NC; i++)
+  {
+    map<uint64_t, ORIGIN3>::const_iterator j = _warm.find(contacts[i].key);
+    if (contacts[i].key != 0 && j != _warm.end() && warm_start_factor > (REAL) 0.0)
+      _lambda[i] = project_friction_cone(j->second*warm_start_factor, contacts[i].mu);
+    else
+      _lambda[i].set_zero();
+  }
+
+  // solve
+  unsigned iter = (solver_type == ePGS) ? solve_pgs(contacts) : solve_admm(contacts);
+
+  // store the impulses and update the velocities of the bodies
+  _warm.clear();
+  for (unsigned i=0; i< NC; i++)
+  {
+    contacts[i].impulse = _lambda[i];
+    if (contacts[i].key != 0)
+      _warm[contacts[i].key] = _lambda[i];
+  }
+  for (unsigned b=0; b< _bodies.size(); b++)
+    _bodies[b].body->set_generalized_velocity(DYNAMIC_BODY::eSpatial, _bodies[b].v);
+
+  FILE_LOG(LOG_DYNAMICS) << "CONTACT_SOLVER::solve() - " << NC << " contacts solved in " << iter << " iterations" << std::endl;
+
+  return iter;
+}
+
+/// Solves for the impulses using projected Gauss-Seidel
+/**
+ * Each contact's impulse is updated in turn by a projected gradient step
+ * (Tasora and Anitescu, 2011). The step must be a scalar multiple of the
+ * relative velocity for the fixed point to solve the cone complementarity
+ * problem; it is the inverse of the mean eigenvalue of the contact's
+ * Delassus block (of its normal entry for frictionless contacts, for which
+ * the tangential impulses are always projected to zero).
+ */
+unsigned CONTACT_SOLVER::solve_pgs(vector<Contact>& contacts)
+{
+  const unsigned NC = contacts.size();
+
+  // apply the warm-start impulses to the body velocities
+  for (unsigned i=0; i< NC; i++)
+    apply_impulse_change(i, _lambda[i]);
+
+  // compute the step sizes
+  vector<REAL> eta(NC);
+  for (unsigned i=0; i< NC; i++)
+  {
+    const REAL D = (contacts[i].mu > (REAL) 0.0) ? (_D[i](0,0) + _D[i](1,1) + _D[i](2,2))/3 : _D[i](0,0);
+    eta[i] = (D > (REAL) 0.0) ? relaxation/D : (REAL) 0.0;
+  }
+
+  for (unsigned iter=0; iter< max_iterations; iter++)
+  {
+    REAL change = (REAL) 0.0;
+    for (unsigned i=0; i< NC; i++)
+    {
+      // compute the relative velocity
+      ORIGIN3 u = calc_velocity(i);
+      u[0] += contacts[i].bias;
+
+      // take a projected step
+      ORIGIN3 lambda = project_friction_cone(_lambda[i] - u*eta[i], contacts[i].mu);
+      ORIGIN3 dlambda = lambda - _lambda[i];
+      _lambda[i] = lambda;
+      apply_impulse_change(i, dlambda);
+      change = std::max(change, dlambda.norm_inf());
+    }
+
+    // record convergence information
+    Iteration info;
+    info.impulse_change = change;
+    info.primal_residual = info.dual_residual = (REAL) 0.0;
+    _telemetry.push_back(info);
+    if (change <= tolerance)
+      return iter+1;
+  }
+
+  return max_iterations;
+}
+
+/// Solves for the impulses using the alternating direction method of multipliers
+/**
+ * The problem is split as min 1/2 x'*A*x + x'*b subject to x = z, z in K.
+ * The x update solves (A + rho*I)*x = rho*(z - y) - b using (warm-started)
+ * conjugate gradients with A applied matrix-free; the z update projects onto
+ * the friction cones. rho is adapted to balance the primal and dual
+ * residuals.
+ */
+unsigned CONTACT_SOLVER::solve_admm(vector<Contact>& contacts)
+{
+  const unsigned NC = contacts.size();
+
+  // choose the penalty parameter
+  REAL r = rho;
+  if (r <= (REAL) 0.0)
+  {
+    r = (REAL) 0.0;
+    for (unsigned i=0; i< NC; i++)
+      r += (_D[i](0,0) + _D[i](1,1) + _D[i](2,2))/(3*NC);
+    if (r <= (REAL) 0.0)
+      r = (REAL) 1.0;
+  }
+
+  // initialize the split and scaled dual variables
+  _z = _lambda;
+  _y.assign(NC, ORIGIN3::zero());
+
+  unsigned iter = 0;
+  for (; iter< max_iterations; iter++)
+  {
+    // x update: compute the initial residual of (A + rho*I)*x = rho*(z - y) - b
+    mult_delassus(_lambda, _Ap);
+    _r.resize(NC);
+    REAL rr = (REAL) 0.0;
+    for (unsigned i=0; i< NC; i++)
+    {
+      _r[i] = (_z[i] - _y[i])*r - _b[i] - _Ap[i] - _lambda[i]*r;
+      rr += _r[i].norm_sq();
+    }
+    _p = _r;
+
+    // do conjugate gradient iterations
+    for (unsigned k=0; k< max_cg_iterations && std::sqrt(rr) > tolerance*r*(REAL) 1e-2; k++)
+    {
+      mult_delassus(_p, _Ap);
+      REAL pAp = (REAL) 0.0;
+      for (unsigned i=0; i< NC; i++)
+      {
+        _Ap[i] += _p[i]*r;
+        pAp += _p[i].dot(_Ap[i]);
+      }
+      if (pAp <= (REAL) 0.0)
+        break;
+      const REAL ALPHA = rr/pAp;
+      REAL rr_new = (REAL) 0.0;
+      for (unsigned i=0; i< NC; i++)
+      {
+        _lambda[i] += _p[i]*ALPHA;
+        _r[i] -= _Ap[i]*ALPHA;
+        rr_new += _r[i].norm_sq();
+      }
+      const REAL BETA = rr_new/rr;
+      for (unsigned i=0; i< NC; i++)
+        _p[i] = _r[i] + _p[i]*BETA;
+      rr = rr_new;
+    }
+
+    // z and y updates
+    _zprev = _z;
+    REAL primal = (REAL) 0.0, change = (REAL) 0.0;
+    for (unsigned i=0; i< NC; i++)
+    {
+      _z[i] = project_friction_cone(_lambda[i] + _y[i], contacts[i].mu);
+      _y[i] += _lambda[i] - _z[i];
+      primal = std::max(primal, (_lambda[i] - _z[i]).norm_inf());
+      change = std::max(change, (_z[i] - _zprev[i]).norm_inf());
+    }
+
+    // record convergence information
+    Iteration info;
+    info.impulse_change = change;
+    info.primal_residual = primal;
+    info.dual_residual = r*change;
+    _telemetry.push_back(info);
+    if (primal <= tolerance && change <= tolerance)
+    {
+      iter++;
+      break;
+    }
+
+    // adapt the penalty parameter (the scaled dual variable scales inversely)
+    if (primal > 10*info.dual_residual)
+    {
+      r *= 2;
+      for (unsigned i=0; i< NC; i++)
+        _y[i] *= (REAL) 0.5;
+    }
+    else if (info.dual_residual > 10*primal)
+    {
+      r *= (REAL) 0.5;
+      for (unsigned i=0; i< NC; i++)
+        _y[i] *= 2;
+    }
+  }
+
+  // use the (feasible) split variable as the solution and update the body velocities
+  _lambda = _z;
+  for (unsigned i=0; i< NC; i++)
+    apply_impulse_change(i, _lambda[i]);
+
+  return iter;
+}
+
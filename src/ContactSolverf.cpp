@@ -0,0 +1,21 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <Ravelin/Log.h>
+#include <Ravelin/Pose3f.h>
+#include <Ravelin/ArticulatedBodyf.h>
+#include <Ravelin/RigidBodyf.h>
+#include <Ravelin/ContactSolverf.h>
+
+using namespace Ravelin;
+
+#include <Ravelin/fdefs.h>
+#include "ContactSolver.cpp"
+#include <Ravelin/undefs.h>
+
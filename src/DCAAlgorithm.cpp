@@ -0,0 +1,504 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+using boost::shared_ptr;
+using std::vector;
+using std::endl;
+
+DCA_ALGORITHM::DCA_ALGORITHM()
+{
+  _nthreads = 0;
+  _root = -1;
+}
+
+/// Sets the number of threads used to process the assembly tree
+/**
+ * \param nthreads the number of threads (including the calling thread); zero
+ *        indicates that the number of processors should be used
+ */
+void DCA_ALGORITHM::set_num_threads(unsigned nthreads)
+{
+  if (nthreads == _nthreads)
+    return;
+  _nthreads = nthreads;
+  _pool.reset();
+  _chain.clear();
+}
+
+/// Gets the links of the body as a serial chain (from the base outward) and builds the assembly tree
+/**
+ * \return <b>false</b> if the body is not a serial chain
+ */
+bool DCA_ALGORITHM::build_chain(shared_ptr<RC_ARTICULATED_BODY> body)
+{
+  const vector<shared_ptr<RIGIDBODY> >& links = body->get_links();
+
+  // walk from the base outward
+  _chain.clear();
+  shared_ptr<RIGIDBODY> link = links.front();
+  while (true)
+  {
+    _chain.push_back(link);
+    if (link->num_child_links() == 0)
+      break;
+    if (link->num_child_links() > 1)
+    {
+      _chain.clear();
+      return false;
+    }
+    link = (*link->get_outer_joints().begin())->get_outboard_link();
+  }
+
+  // verify that all links were visited
+  if (_chain.size() != links.size())
+  {
+    _chain.clear();
+    return false;
+  }
+
+  // create the thread pool
+  if (!_pool)
+    _pool = shared_ptr<ThreadPool>(new ThreadPool(_nthreads));
+
+  // the base is not part of the tree unless it is floating
+  const unsigned FIRST = (body->is_floating_base()) ? 0 : 1;
+  const unsigned N = _chain.size() - FIRST;
+
+  // split the tree into (at least) one subtree per thread
+  unsigned seg_depth = 0;
+  while ((1u << seg_depth) < _pool->size() && (2u << seg_depth) <= N)
+    seg_depth++;
+
+  // create the frames of the handles
+  _frames.resize(_chain.size());
+  for (unsigned i=0; i< _frames.size(); i++)
+    if (!_frames[i])
+      _frames[i] = shared_ptr<POSE3>(new POSE3);
+
+  // build the tree
+  _links.resize(_chain.size());
+  _nodes.clear();
+  _segments.clear();
+  _top.clear();
+  _root = (N > 0) ? build_tree(FIRST, _chain.size()-1, 0, seg_depth, _top) : -1;
+
+  return true;
+}
+
+/// Builds the (balanced) subtree of the assembly tree for the given links
+/**
+ * \param first the index of the first link in the chain
+ * \param last the index of the last link in the chain
+ * \param depth the depth of the subtree root
+ * \param seg_depth the depth at which subtrees are processed by single threads
+ * \param order the processing order of the nodes (children before parents)
+ * \return the index of the root of the subtree
+ */
+int DCA_ALGORITHM::build_tree(unsigned first, unsigned last, unsigned depth, unsigned seg_depth, vector<unsigned>& order)
+{
+  // start a subtree that is processed by a single thread
+  if (depth == seg_depth)
+  {
+    vector<unsigned> segment;
+    int idx = build_tree(first, last, depth+1, seg_depth, segment);
+    _segments.push_back(segment);
+    return idx;
+  }
+
+  Subassembly node;
+  node.first = first;
+  node.last = last;
+  node.left = node.right = -1;
+  node.singular = false;
+  if (first < last)
+  {
+    const unsigned MID = (first + last)/2;
+    node.left = build_tree(first, MID, depth+1, seg_depth, order);
+    node.right = build_tree(MID+1, last, depth+1, seg_depth, order);
+  }
+
+  const unsigned IDX = _nodes.size();
+  _nodes.push_back(node);
+  order.push_back(IDX);
+  return (int) IDX;
+}
+
+/// Gets the location of a handle (in the global frame)
+/**
+ * Handle k is located at the inner joint of link k of the chain; handle 0 (the
+ * inner handle of the base) is located at the base and the last handle (the
+ * outer handle of the last link) at the last link.
+ */
+ORIGIN3 DCA_ALGORITHM::get_handle_location(unsigned k) const
+{
+  const shared_ptr<const POSE3> GLOBAL;
+  if (k == 0)
+    return ORIGIN3(POSE3::transform_point(GLOBAL, VECTOR3(0.0, 0.0, 0.0, _chain.front()->get_pose())));
+  if (k == _chain.size())
+    return ORIGIN3(POSE3::transform_point(GLOBAL, VECTOR3(0.0, 0.0, 0.0, _chain.back()->get_pose())));
+  shared_ptr<JOINT> joint(_chain[k]->get_inner_joint_explicit());
+  return ORIGIN3(POSE3::transform_point(GLOBAL, joint->get_location()));
+}
+
+/// Gathers the quantities of a link of the chain from the body
+/**
+ * Only the given link, its inner joint, and the frame of its inner handle are
+ * modified, so different links may be gathered concurrently.
+ */
+void DCA_ALGORITHM::gather(unsigned k)
+{
+  vector<SVELOCITY> sprime, sdotprime;
+  VECTORN workv;
+
+  shared_ptr<RC_ARTICULATED_BODY> body(_body);
+  shared_ptr<RIGIDBODY> link = _chain[k];
+  LinkData& L = _links[k];
+
+  // place the frame of the inner handle
+  const shared_ptr<POSE3>& frame = _frames[k];
+  frame->x = get_handle_location(k);
+
+  // compute the isolated zero acceleration force
+  const SVELOCITY& v = link->get_velocity();
+  SFORCE Z = POSE3::transform(frame, v.cross(link->get_inertia() * v) - link->sum_forces());
+  L.f.resize(6);
+  L.f[0] = -Z[3];  L.f[1] = -Z[4];  L.f[2] = -Z[5];
+  L.f[3] = -Z[0];  L.f[4] = -Z[1];  L.f[5] = -Z[2];
+
+  // compute the inertia matrix a column at a time
+  SPATIAL_RB_INERTIA I = POSE3::transform(frame, link->get_inertia());
+  L.M.resize(6,6);
+  for (unsigned j=0; j< 6; j++)
+  {
+    SACCEL e = SACCEL::zero(frame);
+    e[j] = (REAL) 1.0;
+    SFORCE w = I * e;
+    L.M(0,j) = w[3];  L.M(1,j) = w[4];  L.M(2,j) = w[5];
+    L.M(3,j) = w[0];  L.M(4,j) = w[1];  L.M(5,j) = w[2];
+  }
+
+  // the base has no inner joint
+  if (k == 0)
+    return;
+
+  // get the spatial axes
+  shared_ptr<JOINT> joint(link->get_inner_joint_explicit());
+  POSE3::transform(frame, joint->get_spatial_axes(), sprime);
+  POSE3::transform(frame, joint->get_spatial_axes_dot(), sdotprime);
+  const unsigned NDOF = sprime.size();
+  L.S.resize(6, NDOF);
+  for (unsigned j=0; j< NDOF; j++)
+    for (unsigned r=0; r< 6; r++)
+      L.S(r,j) = sprime[j][r];
+
+  // compute the velocity-product acceleration across the joint
+  SACCEL c = SACCEL::zero(frame);
+  if (NDOF > 0)
+    c = POSE3::transform(frame, v).cross(SPARITH::mult(sprime, joint->qd));
+  if (!sdotprime.empty())
+    c += SACCEL(SPARITH::mult(sdotprime, joint->qd));
+  L.c.resize(6);
+  for (unsigned r=0; r< 6; r++)
+    L.c[r] = c[r];
+
+  // get the generalized force and implicit inertia
+  L.tau = joint->force;
+  L.tau += joint->calc_spring_damper_force(body->get_implicit_step_size(), workv);
+  L.H.set_zero(NDOF);
+  if (body->_implicit_inertia.size() == body->num_joint_dof_explicit())
+  {
+    const unsigned JIDX = joint->get_coord_index();
+    for (unsigned j=0; j< NDOF; j++)
+      L.H[j] = body->_implicit_inertia[JIDX+j];
+  }
+}
+
+/// Computes the inverse inertias and bias accelerations of a single link
+/**
+ * A force f at the outer handle, which is offset from the inner handle by d,
+ * is equivalent to the force f and the moment d x f at the inner handle, i.e.,
+ * to X*f where X = [I [d]; 0 I] (forces in [torque; force] order), and the
+ * acceleration of the outer handle is X'*a, where a is the acceleration of
+ * the inner handle. Hence Phi12 = inv(M)*X and Phi22 = X'*inv(M)*X.
+ */
+void DCA_ALGORITHM::calc_leaf(Subassembly& node)
+{
+  // gather the link quantities
+  gather(node.first);
+  const LinkData& L = _links[node.first];
+
+  // invert the inertia matrix
+  node.Phi11 = L.M;
+  node.singular = !LINALG::factor_chol(node.Phi11);
+  if (node.singular)
+    return;
+  node.Phi12.set_identity(6);
+  LINALG::solve_chol_fast(node.Phi11, node.Phi12);
+  node.Phi11 = node.Phi12;
+
+  // compute the bias acceleration of the inner handle
+  node.Phi11.mult(L.f, node.b1);
+
+  // form X
+  const ORIGIN3 d = get_handle_location(node.first+1) - _frames[node.first]->x;
+  node.workM.set_identity(6);
+  node.workM(0,4) = -d[2];  node.workM(0,5) = d[1];
+  node.workM(1,3) = d[2];   node.workM(1,5) = -d[0];
+  node.workM(2,3) = -d[1];  node.workM(2,4) = d[0];
+
+  // compute the remaining inverse inertias and the bias acceleration of the outer handle
+  node.Phi11.mult(node.workM, node.Phi12);
+  node.workM.transpose_mult(node.Phi12, node.Phi22);
+  node.workM.transpose_mult(node.b1, node.b2);
+}
+
+/// Assembles two neighboring subassemblies
+/**
+ * The outer handle of A is connected to the inner handle of B by joint J.
+ * The joint force f applied to B (and -f to A) satisfies
+ * W*f = S*qdd + r and S'*f = tau - H*qdd, where W = Phi22(A) + Phi11(B) and
+ * r = Phi21(A)*f1 - Phi12(B)*f2 + b2(A) - b1(B) + c, so that
+ * f = P*r + beta and D*qdd = tau - G'*r, where G = inv(W)*S, D = S'*G + H,
+ * P = inv(W) - G*inv(D)*G', and beta = G*inv(D)*tau.
+ */
+void DCA_ALGORITHM::assemble(Subassembly& node, const Subassembly& A, const Subassembly& B, const LinkData& J)
+{
+  node.singular = A.singular || B.singular;
+  if (node.singular)
+    return;
+
+  // compute inv(W) and G = inv(W)*S
+  node.workM = A.Phi22;
+  node.workM += B.Phi11;
+  if (!LINALG::factor_chol(node.workM))
+  {
+    node.singular = true;
+    return;
+  }
+  node.P.set_identity(6);
+  LINALG::solve_chol_fast(node.workM, node.P);
+  node.G = J.S;
+  LINALG::solve_chol_fast(node.workM, node.G);
+
+  // factorize D
+  J.S.transpose_mult(node.G, node.D);
+  for (unsigned i=0; i< J.H.size(); i++)
+    node.D(i,i) += J.H[i];
+  if (!LINALG::factor_chol(node.D))
+  {
+    node.singular = true;
+    return;
+  }
+
+  // compute P and beta
+  if (J.S.columns() > 0)
+  {
+    node.workM = node.G;
+    node.workM.transpose();
+    LINALG::solve_chol_fast(node.D, node.workM);
+    node.G.mult(node.workM, node.P, (REAL) -1.0, (REAL) 1.0);
+  }
+  node.workv = J.tau;
+  LINALG::solve_chol_fast(node.D, node.workv);
+  node.G.mult(node.workv, node.beta);
+
+  // compute the bias term e
+  node.e = A.b2;
+  node.e -= B.b1;
+  node.e += J.c;
+
+  // compute the inverse inertias of the assembly
+  node.P.mult_transpose(A.Phi12, node.workM);
+  node.Phi11 = A.Phi11;
+  A.Phi12.mult(node.workM, node.Phi11, (REAL) -1.0, (REAL) 1.0);
+  node.P.mult(B.Phi12, node.workM);
+  A.Phi12.mult(node.workM, node.Phi12);
+  node.Phi22 = B.Phi22;
+  B.Phi12.transpose_mult(node.workM, node.Phi22, (REAL) -1.0, (REAL) 1.0);
+
+  // compute the bias accelerations of the assembly
+  node.workv2 = node.beta;
+  node.P.mult(node.e, node.workv2, (REAL) 1.0, (REAL) 1.0);
+  node.b1 = A.b1;
+  A.Phi12.mult(node.workv2, node.b1, (REAL) -1.0, (REAL) 1.0);
+  node.b2 = B.b2;
+  B.Phi12.transpose_mult(node.workv2, node.b2, (REAL) 1.0, (REAL) 1.0);
+}
+
+/// Computes the joint force and acceleration of the joint connecting the children of a node and the forces applied to the children
+void DCA_ALGORITHM::disassemble(Subassembly& node, Subassembly& A, Subassembly& B, LinkData& J)
+{
+  // compute r
+  node.workv = node.e;
+  A.Phi12.transpose_mult(node.f1, node.workv, (REAL) 1.0, (REAL) 1.0);
+  B.Phi12.mult(node.f2, node.workv, (REAL) -1.0, (REAL) 1.0);
+
+  // compute the joint acceleration
+  J.qdd = J.tau;
+  node.G.transpose_mult(node.workv, J.qdd, (REAL) -1.0, (REAL) 1.0);
+  LINALG::solve_chol_fast(node.D, J.qdd);
+
+  // compute the joint force and the forces on the children
+  B.f1 = node.beta;
+  node.P.mult(node.workv, B.f1, (REAL) 1.0, (REAL) 1.0);
+  B.f2 = node.f2;
+  A.f1 = node.f1;
+  A.f2 = B.f1;
+  A.f2.negate();
+}
+
+/// Computes the spatial acceleration of a single link and sets the link and joint accelerations
+void DCA_ALGORITHM::calc_leaf_accel(Subassembly& node)
+{
+  LinkData& L = _links[node.first];
+  L.a = node.b1;
+  node.Phi11.mult(node.f1, L.a, (REAL) 1.0, (REAL) 1.0);
+  node.Phi12.mult(node.f2, L.a, (REAL) 1.0, (REAL) 1.0);
+
+  // set the accelerations
+  shared_ptr<RIGIDBODY> link = _chain[node.first];
+  SACCEL a = SACCEL::zero(_frames[node.first]);
+  for (unsigned r=0; r< 6; r++)
+    a[r] = L.a[r];
+  link->set_accel(a);
+  if (node.first > 0)
+  {
+    shared_ptr<JOINT> joint(link->get_inner_joint_explicit());
+    joint->qdd = L.qdd;
+  }
+}
+
+/// Assembles the nodes of a subtree processed by a single thread
+void DCA_ALGORITHM::assemble_segment(unsigned i)
+{
+  const vector<unsigned>& segment = _segments[i];
+  for (unsigned j=0; j< segment.size(); j++)
+  {
+    Subassembly& node = _nodes[segment[j]];
+    if (node.left < 0)
+      calc_leaf(node);
+    else
+      assemble(node, _nodes[node.left], _nodes[node.right], _links[_nodes[node.right].first]);
+  }
+}
+
+/// Disassembles the nodes of a subtree processed by a single thread
+void DCA_ALGORITHM::disassemble_segment(unsigned i)
+{
+  const vector<unsigned>& segment = _segments[i];
+  for (unsigned j=segment.size(); j> 0; j--)
+  {
+    Subassembly& node = _nodes[segment[j-1]];
+    if (node.left < 0)
+      calc_leaf_accel(node);
+    else
+      disassemble(node, _nodes[node.left], _nodes[node.right], _links[_nodes[node.right].first]);
+  }
+}
+
+/// Task executed by the thread pool for assembly
+void DCA_ALGORITHM::assemble_segment_task(void* data, unsigned i)
+{
+  ((DCA_ALGORITHM*) data)->assemble_segment(i);
+}
+
+/// Task executed by the thread pool for disassembly
+void DCA_ALGORITHM::disassemble_segment_task(void* data, unsigned i)
+{
+  ((DCA_ALGORITHM*) data)->disassemble_segment(i);
+}
+
+/// Computes the joint accelerations (forward dynamics) for an articulated body
+void DCA_ALGORITHM::calc_fwd_dyn()
+{
+  FILE_LOG(LOG_DYNAMICS) << "DCA_ALGORITHM::calc_fwd_dyn() entered" << endl;
+
+  // get the body
+  shared_ptr<RC_ARTICULATED_BODY> body(_body);
+  if (!body->_ijoints.empty())
+    throw std::runtime_error("DCA_ALGORITHM cannot process bodies with kinematic loops!");
+
+  // build the chain and the tree if necessary
+  if (_chain.empty() && !build_chain(body))
+  {
+    FILE_LOG(LOG_DYNAMICS) << " -- body is not a serial chain; using Featherstone's algorithm" << endl;
+    body->_fsab.calc_fwd_dyn();
+    return;
+  }
+
+  // get the base link
+  shared_ptr<RIGIDBODY> base = _chain.front();
+
+  // nothing to do if the chain consists of a fixed base only
+  if (_root < 0)
+  {
+    base->set_accel(SACCEL::zero(base->get_computation_frame()));
+    return;
+  }
+
+  // assemble the subtrees in parallel, then the top of the tree
+  _pool->run(_segments.size(), &assemble_segment_task, this);
+  for (unsigned i=0; i< _top.size(); i++)
+  {
+    Subassembly& node = _nodes[_top[i]];
+    if (node.left < 0)
+      calc_leaf(node);
+    else
+      assemble(node, _nodes[node.left], _nodes[node.right], _links[_nodes[node.right].first]);
+  }
+
+  // for a fixed base, connect the chain to the ground
+  Subassembly& root = _nodes[_root];
+  if (!body->is_floating_base())
+  {
+    _ground.Phi11.set_zero(6,6);
+    _ground.Phi12.set_zero(6,6);
+    _ground.Phi22.set_zero(6,6);
+    _ground.b1.set_zero(6);
+    _ground.b2.set_zero(6);
+    _ground.singular = false;
+    assemble(_fixed_root, _ground, root, _links[root.first]);
+  }
+
+  // use Featherstone's algorithm if the joint equations are rank deficient
+  if (root.singular || (!body->is_floating_base() && _fixed_root.singular))
+  {
+    FILE_LOG(LOG_DYNAMICS) << " -- singular assembly; using Featherstone's algorithm" << endl;
+    body->_fsab.calc_fwd_dyn();
+    return;
+  }
+
+  // no forces are applied at the handles of the entire chain
+  if (!body->is_floating_base())
+  {
+    _fixed_root.f1.set_zero(6);
+    _fixed_root.f2.set_zero(6);
+    disassemble(_fixed_root, _ground, root, _links[root.first]);
+  }
+  else
+  {
+    root.f1.set_zero(6);
+    root.f2.set_zero(6);
+  }
+
+  // disassemble the top of the tree, then the subtrees in parallel
+  for (unsigned i=_top.size(); i> 0; i--)
+  {
+    Subassembly& node = _nodes[_top[i-1]];
+    if (node.left < 0)
+      calc_leaf_accel(node);
+    else
+      disassemble(node, _nodes[node.left], _nodes[node.right], _links[_nodes[node.right].first]);
+  }
+  _pool->run(_segments.size(), &disassemble_segment_task, this);
+
+  // set the base acceleration
+  if (!body->is_floating_base())
+    base->set_accel(SACCEL::zero(base->get_computation_frame()));
+
+  FILE_LOG(LOG_DYNAMICS) << "DCA_ALGORITHM::calc_fwd_dyn() exited" << endl;
+}
+
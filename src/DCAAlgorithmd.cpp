@@ -0,0 +1,21 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#include <stdexcept>
+#include <Ravelin/Log.h>
+#include <Ravelin/RCArticulatedBodyd.h>
+#include <Ravelin/RigidBodyd.h>
+#include <Ravelin/Jointd.h>
+#include <Ravelin/SpatialArithmeticd.h>
+#include <Ravelin/LinAlgd.h>
+#include <Ravelin/DCAAlgorithmd.h>
+
+using namespace Ravelin;
+
+#include <Ravelin/ddefs.h>
+#include "DCAAlgorithm.cpp"
+#include <Ravelin/undefs.h>
+
@@ -0,0 +1,21 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#include <stdexcept>
+#include <Ravelin/Log.h>
+#include <Ravelin/RCArticulatedBodyf.h>
+#include <Ravelin/RigidBodyf.h>
+#include <Ravelin/Jointf.h>
+#include <Ravelin/SpatialArithmeticf.h>
+#include <Ravelin/LinAlgf.h>
+#include <Ravelin/DCAAlgorithmf.h>
+
+using namespace Ravelin;
+
+#include <Ravelin/fdefs.h>
+#include "DCAAlgorithm.cpp"
+#include <Ravelin/undefs.h>
+
@@ -0,0 +1,276 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+using boost::shared_ptr;
+using std::vector;
+using std::string;
+using std::endl;
+
+/// Gets the current time in seconds
+static double get_current_time()
+{
+  timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (double) t.tv_sec + (double) t.tv_nsec*1e-9;
+}
+
+DYNAMICS_AUTOTUNER::DYNAMICS_AUTOTUNER()
+{
+  num_states = 10;
+  num_repetitions = 5;
+  perturbation = (REAL) 0.5;
+  tolerance = (REAL) 1e-6;
+  seed = 1;
+  _rng = seed;
+  _best = 0;
+}
+
+/// Gets a uniformly distributed random number in [lo, hi]
+REAL DYNAMICS_AUTOTUNER::random(REAL lo, REAL hi)
+{
+  _rng = _rng*1664525u + 1013904223u;
+  return lo + (hi - lo)*(REAL) (_rng >> 8)/(REAL) (1u << 24);
+}
+
+/// Gets the name of a forward dynamics algorithm
+const char* DYNAMICS_AUTOTUNER::get_name(RC_ARTICULATED_BODY::ForwardDynamicsAlgorithmType algorithm)
+{
+  switch (algorithm)
+  {
+    case RC_ARTICULATED_BODY::eFeatherstone:     return "eFeatherstone";
+    case RC_ARTICULATED_BODY::eCRB:              return "eCRB";
+    case RC_ARTICULATED_BODY::eDivideAndConquer: return "eDivideAndConquer";
+  }
+
+  return "";
+}
+
+/// Gets the name of a computation frame
+const char* DYNAMICS_AUTOTUNER::get_name(ReferenceFrameType frame)
+{
+  switch (frame)
+  {
+    case eGlobal:  return "eGlobal";
+    case eLink:    return "eLink";
+    case eLinkCOM: return "eLinkCOM";
+    case eJoint:   return "eJoint";
+  }
+
+  return "";
+}
+
+/// Finds the fastest configuration for a body, applies it to the body, and records it
+/**
+ * The state (and configuration) of the body is restored before the fastest
+ * configuration is applied; the factorized generalized inertia is not
+ * retained.
+ * \return the timing of the fastest configuration
+ */
+const DYNAMICS_AUTOTUNER::Timing& DYNAMICS_AUTOTUNER::tune(shared_ptr<RC_ARTICULATED_BODY> body)
+{
+  const RC_ARTICULATED_BODY::ForwardDynamicsAlgorithmType ALGORITHMS[3] = { RC_ARTICULATED_BODY::eCRB, RC_ARTICULATED_BODY::eFeatherstone, RC_ARTICULATED_BODY::eDivideAndConquer };
+  const ReferenceFrameType FRAMES[4] = { eGlobal, eLink, eLinkCOM, eJoint };
+  VECTORN gv, qdd;
+
+  #ifndef NEXCEPT
+  if (num_states == 0 || num_repetitions == 0)
+    throw std::runtime_error("DYNAMICS_AUTOTUNER::tune() - at least one state and repetition are required");
+  #endif
+
+  // save the state and configuration of the body
+  RC_ARTICULATED_BODY::State state0;
+  body->save_state(state0);
+  const RC_ARTICULATED_BODY::ForwardDynamicsAlgorithmType ALGORITHM0 = body->algorithm_type;
+  const ReferenceFrameType FRAME0 = body->get_computation_frame_type();
+
+  // generate the randomized states
+  _rng = seed;
+  const vector<shared_ptr<JOINT> >& joints = body->get_explicit_joints();
+  vector<RC_ARTICULATED_BODY::State> states(num_states);
+  for (unsigned i=0; i< num_states; i++)
+  {
+    for (unsigned j=0; j< joints.size(); j++)
+    {
+      for (unsigned k=0; k< joints[j]->q.size(); k++)
+        joints[j]->q[k] += random(-perturbation, perturbation);
+      for (unsigned k=0; k< joints[j]->force.size(); k++)
+        joints[j]->force[k] = random((REAL) -1.0, (REAL) 1.0);
+    }
+    body->update_link_poses();
+    body->get_generalized_velocity(DYNAMIC_BODY::eSpatial, gv);
+    for (unsigned k=0; k< gv.size(); k++)
+      gv[k] = random((REAL) -1.0, (REAL) 1.0);
+    body->set_generalized_velocity(DYNAMIC_BODY::eSpatial, gv);
+    body->save_state(states[i]);
+    body->restore_state(state0);
+  }
+
+  // compute the reference accelerations using the configuration of the body
+  vector<VECTORN> ref(num_states);
+  for (unsigned i=0; i< num_states; i++)
+  {
+    body->restore_state(states[i]);
+    body->calc_fwd_dyn();
+    body->get_generalized_acceleration(ref[i]);
+  }
+
+  // time all configurations
+  _timings.clear();
+  _best = 0;
+  for (unsigned a=0; a< 3; a++)
+    for (unsigned f=0; f< 4; f++)
+    {
+      Timing timing;
+      timing.algorithm = ALGORITHMS[a];
+      timing.frame = FRAMES[f];
+      timing.time = (REAL) 0.0;
+      timing.error = (REAL) 0.0;
+      timing.agrees = true;
+      body->algorithm_type = ALGORITHMS[a];
+      body->set_computation_frame_type(FRAMES[f]);
+
+      try
+      {
+        double elapsed = 0.0;
+        for (unsigned r=0; r< num_repetitions; r++)
+          for (unsigned i=0; i< num_states; i++)
+          {
+            // position dependent quantities are recomputed after restoring
+            body->restore_state(states[i]);
+            double start = get_current_time();
+            body->calc_fwd_dyn();
+            elapsed += get_current_time() - start;
+
+            // compare against the reference
+            if (r > 0)
+              continue;
+            body->get_generalized_acceleration(qdd);
+            qdd -= ref[i];
+            const REAL ERR = qdd.norm_inf()/std::max((REAL) 1.0, ref[i].norm_inf());
+            if (!(ERR <= timing.error))
+              timing.error = ERR;
+          }
+        timing.time = (REAL) (elapsed/(num_repetitions*num_states));
+        timing.agrees = (timing.error <= tolerance);
+      }
+      catch (std::exception& e)
+      {
+        FILE_LOG(LOG_DYNAMICS) << "DYNAMICS_AUTOTUNER::tune() - " << get_name(ALGORITHMS[a]) << "/" << get_name(FRAMES[f]) << " failed: " << e.what() << endl;
+        timing.agrees = false;
+      }
+
+      // see whether this is the fastest so far
+      _timings.push_back(timing);
+      const Timing& best = _timings[_best];
+      if (timing.agrees && (!best.agrees || timing.time < best.time))
+        _best = _timings.size()-1;
+    }
+
+  // restore the state of the body
+  body->algorithm_type = ALGORITHM0;
+  body->set_computation_frame_type(FRAME0);
+  body->restore_state(state0);
+
+  // apply and record the fastest configuration
+  const Timing& best = _timings[_best];
+  if (best.agrees)
+  {
+    body->algorithm_type = best.algorithm;
+    body->set_computation_frame_type(best.frame);
+    _choices[TRAJECTORY_WRITER::calc_model_hash(body)] = std::make_pair(best.algorithm, best.frame);
+  }
+
+  return best;
+}
+
+/// Applies the recorded configuration for the body's model to the body
+/**
+ * \return <b>true</b> if a configuration was recorded for the model
+ */
+bool DYNAMICS_AUTOTUNER::apply(shared_ptr<RC_ARTICULATED_BODY> body) const
+{
+  std::map<uint64_t, std::pair<RC_ARTICULATED_BODY::ForwardDynamicsAlgorithmType, ReferenceFrameType> >::const_iterator i;
+  i = _choices.find(TRAJECTORY_WRITER::calc_model_hash(body));
+  if (i == _choices.end())
+    return false;
+
+  body->algorithm_type = i->second.first;
+  body->set_computation_frame_type(i->second.second);
+  return true;
+}
+
+/// Saves the recorded configurations to a text file
+/**
+ * Each line of the file holds a model hash (in hexadecimal), an algorithm,
+ * and a computation frame, e.g., "7f3a9c0e12b4d5e6 eCRB eLinkCOM".
+ */
+void DYNAMICS_AUTOTUNER::save(const string& fname) const
+{
+  std::ofstream out(fname.c_str());
+  if (!out)
+    throw std::runtime_error("DYNAMICS_AUTOTUNER::save() - unable to open " + fname);
+
+  std::map<uint64_t, std::pair<RC_ARTICULATED_BODY::ForwardDynamicsAlgorithmType, ReferenceFrameType> >::const_iterator i;
+  for (i = _choices.begin(); i != _choices.end(); i++)
+    out << std::hex << i->first << std::dec << " " << get_name(i->second.first) << " " << get_name(i->second.second) << endl;
+
+  if (!out)
+    throw std::runtime_error("DYNAMICS_AUTOTUNER::save() - error writing " + fname);
+}
+
+/// Loads recorded configurations from a text file written by save()
+/**
+ * Loaded configurations are added to (and replace) those already recorded.
+ */
+void DYNAMICS_AUTOTUNER::load(const string& fname)
+{
+  const RC_ARTICULATED_BODY::ForwardDynamicsAlgorithmType ALGORITHMS[3] = { RC_ARTICULATED_BODY::eCRB, RC_ARTICULATED_BODY::eFeatherstone, RC_ARTICULATED_BODY::eDivideAndConquer };
+  const ReferenceFrameType FRAMES[4] = { eGlobal, eLink, eLinkCOM, eJoint };
+
+  std::ifstream in(fname.c_str());
+  if (!in)
+    throw std::runtime_error("DYNAMICS_AUTOTUNER::load() - unable to open " + fname);
+
+  uint64_t hash;
+  string algorithm, frame;
+  while (in >> std::hex >> hash >> std::dec >> algorithm >> frame)
+  {
+    unsigned a = 0, f = 0;
+    while (a < 3 && algorithm != get_name(ALGORITHMS[a]))
+      a++;
+    while (f < 4 && frame != get_name(FRAMES[f]))
+      f++;
+    if (a == 3 || f == 4)
+      throw std::runtime_error("DYNAMICS_AUTOTUNER::load() - invalid configuration in " + fname);
+    _choices[hash] = std::make_pair(ALGORITHMS[a], FRAMES[f]);
+  }
+
+  if (!in.eof())
+    throw std::runtime_error("DYNAMICS_AUTOTUNER::load() - error reading " + fname);
+}
+
+/// Writes the timings from the last call to tune() as a table
+void DYNAMICS_AUTOTUNER::report(std::ostream& out) const
+{
+  out << std::setw(18) << std::left << "algorithm" << std::setw(10) << "frame" << std::right << std::setw(14) << "time (us)" << std::setw(14) << "rel. error" << endl;
+  for (unsigned i=0; i< _timings.size(); i++)
+  {
+    const Timing& t = _timings[i];
+    out << std::setw(18) << std::left << get_name(t.algorithm) << std::setw(10) << get_name(t.frame) << std::right;
+    if (t.time > (REAL) 0.0)
+      out << std::setw(14) << std::fixed << std::setprecision(2) << t.time*1e6;
+    else
+      out << std::setw(14) << "-";
+    out << std::setw(14) << std::scientific << std::setprecision(2) << t.error;
+    out.unsetf(std::ios_base::floatfield);
+    if (!t.agrees)
+      out << "  (disagrees)";
+    else if (i == _best)
+      out << "  (fastest)";
+    out << endl;
+  }
+}
+
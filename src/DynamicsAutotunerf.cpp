@@ -0,0 +1,24 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#include <time.h>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <algorithm>
+#include <Ravelin/Log.h>
+#include <Ravelin/Jointf.h>
+#include <Ravelin/RigidBodyf.h>
+#include <Ravelin/RCArticulatedBodyf.h>
+#include <Ravelin/Trajectoryf.h>
+#include <Ravelin/DynamicsAutotunerf.h>
+
+using namespace Ravelin;
+
+#include <Ravelin/fdefs.h>
+#include "DynamicsAutotuner.cpp"
+#include <Ravelin/undefs.h>
+
@@ -14,6 +14,7 @@ using std::endl;
 
 FSAB_ALGORITHM::FSAB_ALGORITHM()
 {
+  _hybrid = false;
 }
 
 /// Solves the equation MX = B, where M is the generalized inertia matrix
@@ -375,8 +376,6 @@ void FSAB_ALGORITHM::apply_generalized_impulse(unsigned index, VECTORN& vgj)
 /// Applies a generalized impulse using the algorithm of Drumwright
 void FSAB_ALGORITHM::apply_generalized_impulse(const VECTORN& gj)
 {
-  static VECTORN tmp, tmp2;
-  static vector<VECTORN> mu;
   queue<shared_ptr<RIGIDBODY> > link_queue;
   vector<SVELOCITY> sprime;
 
@@ -459,14 +458,14 @@ void FSAB_ALGORITHM::apply_generalized_impulse(const VECTORN& gj)
     
     // compute the qm subexpression
     POSE3::transform(_Y[i].pose, s, sprime);
-    _mu[i] -= SPARITH::transpose_mult(sprime, _Y[i], tmp2);
+    _mu[i] -= SPARITH::transpose_mult(sprime, _Y[i], _workv2);
 
     // get Is
     const vector<SMOMENTUM>& Is = _Is[i];
 
     // prepare to update parent Y
     solve_sIs(i, _mu[i], _sIsmu);
-    SMOMENTUM uY = _Y[i] + SMOMENTUM::from_vector(SPARITH::mult(Is, _sIsmu, tmp), _Y[i].pose);
+    SMOMENTUM uY = _Y[i] + SMOMENTUM::from_vector(SPARITH::mult(Is, _sIsmu, _workv), _Y[i].pose);
 
     FILE_LOG(LOG_DYNAMICS) << "  *** Backward recursion processing link " << link << endl;
     FILE_LOG(LOG_DYNAMICS) << "    I: " << I << endl;
@@ -568,9 +567,9 @@ void FSAB_ALGORITHM::apply_generalized_impulse(const VECTORN& gj)
     // determine the joint and link velocity updates
     POSE3::transform(_Y[i].pose, s, sprime);
     SMOMENTUM w1 = _I[i] * POSE3::transform(_Y[i].pose, _dv[h]);
-    SPARITH::transpose_mult(sprime, w1 + _Y[i], tmp2).negate();
-    tmp2 += _Qi;
-    solve_sIs(i, tmp2, _qd_delta);
+    SPARITH::transpose_mult(sprime, w1 + _Y[i], _workv2).negate();
+    _workv2 += _Qi;
+    solve_sIs(i, _workv2, _qd_delta);
     _dv[i] = POSE3::transform(_Y[i].pose, _dv[h]);
     if (joint->num_dof() > 0)
       _dv[i] += SPARITH::mult(sprime, _qd_delta);
@@ -599,10 +598,10 @@ void FSAB_ALGORITHM::apply_generalized_impulse(const VECTORN& gj)
 void FSAB_ALGORITHM::calc_spatial_coriolis_vectors(shared_ptr<RC_ARTICULATED_BODY> body)
 {
   FILE_LOG(LOG_DYNAMICS) << "calc_spatial_coriolis_vectors() entered" << endl;
-  vector<SVELOCITY> sprime;
 
-  // get the set of links
+  // get the set of links and their (cached) kinematics
   const vector<shared_ptr<RIGIDBODY> >& links = body->get_links();
+  const RC_ARTICULATED_BODY::Kinematics& kin = body->get_kinematics();
 
   // clear spatial values for all links
   _c.resize(links.size());
@@ -617,9 +616,8 @@ void FSAB_ALGORITHM::calc_spatial_coriolis_vectors(shared_ptr<RC_ARTICULATED_BOD
     // get the link's joint
     boost::shared_ptr<JOINT> joint(link->get_inner_joint_explicit());
 
-    // get the spatial axis and transform it
-    const vector<SVELOCITY>& s = joint->get_spatial_axes();
-    POSE3::transform(link->get_computation_frame(), s, sprime);
+    // get the spatial axis in the link computation frame
+    const vector<SVELOCITY>& sprime = kin.s[idx];
 
     // compute the coriolis vector
     if (sprime.empty())
@@ -627,10 +625,10 @@ void FSAB_ALGORITHM::calc_spatial_coriolis_vectors(shared_ptr<RC_ARTICULATED_BOD
     else
     {
       SVELOCITY sqd = SPARITH::mult(sprime, joint->qd);
-      _c[idx] = link->get_velocity().cross(sqd);
+      _c[idx] = kin.v[idx].cross(sqd);
 
       FILE_LOG(LOG_DYNAMICS) << "processing link: " << link << endl;
-      FILE_LOG(LOG_DYNAMICS) << "v: " << link->get_velocity() << endl;
+      FILE_LOG(LOG_DYNAMICS) << "v: " << kin.v[idx] << endl;
       FILE_LOG(LOG_DYNAMICS) << "s * qdot: " << sqd << endl;
       FILE_LOG(LOG_DYNAMICS) << "c: " << _c[idx] << endl;
     }
@@ -643,7 +641,7 @@ void FSAB_ALGORITHM::calc_spatial_zero_accelerations(shared_ptr<RC_ARTICULATED_B
   VECTORN tmp, workv;
   MATRIXN workM;
   queue<shared_ptr<RIGIDBODY> > link_queue;
-  vector<SVELOCITY> sprime;
+  const RC_ARTICULATED_BODY::Kinematics& kin = body->get_kinematics();
 
   FILE_LOG(LOG_DYNAMICS) << "calc_spatial_zero_accelerations() entered" << endl;
 
@@ -715,16 +713,40 @@ void FSAB_ALGORITHM::calc_spatial_zero_accelerations(shared_ptr<RC_ARTICULATED_B
 
     // get the inner joint and the spatial axis
     boost::shared_ptr<JOINT> joint(link->get_inner_joint_explicit());
-    const vector<SVELOCITY>& s = joint->get_spatial_axes();
-    POSE3::transform(link->get_computation_frame(), s, sprime);
+    const vector<SVELOCITY>& sprime = kin.s[i];
 
     // get I, c, and Z
     const SPATIAL_AB_INERTIA& I = _I[i];
     const SACCEL& c = _c[i];
     const SFORCE& Z = _Z[i];
+
+    // joints with prescribed accelerations transmit the full bias force
+    if (_hybrid && joint->is_acceleration_prescribed())
+    {
+      // compute the known part of the link acceleration relative to parent
+      const vector<SVELOCITY>& sdotprime = kin.sdot[i];
+      SACCEL ak = c;
+      if (!sprime.empty())
+        ak += SACCEL(SPARITH::mult(sprime, joint->qdd));
+      if (!sdotprime.empty())
+        ak += SACCEL(SPARITH::mult(sdotprime, joint->qd));
+
+      FILE_LOG(LOG_DYNAMICS) << "  *** Backward recursion processing link " << link << " (prescribed acceleration)" << endl;
+      FILE_LOG(LOG_DYNAMICS) << "    known relative acceleration: " << ak << endl;
+
+      // don't update Z for direct descendants of the base if the base is 
+      // not floating
+      if (!body->is_floating_base() && parent->is_base())
+        continue;
+
+      // update the parent zero acceleration
+      _Z[h] += POSE3::transform(_Z[h].pose, Z + I*ak);
+      continue;
+    }
     
     // compute the qm subexpression
     _mu[i] = joint->force;
+    _mu[i] += joint->calc_spring_damper_force(body->get_implicit_step_size(), workv);
     _mu[i] -= SPARITH::transpose_mult(sprime, Z + I*c, workv);
 
     // get Is
@@ -768,7 +790,7 @@ void FSAB_ALGORITHM::calc_spatial_zero_accelerations(shared_ptr<RC_ARTICULATED_B
 void FSAB_ALGORITHM::calc_spatial_inertias(shared_ptr<RC_ARTICULATED_BODY> body)
 {
   FILE_LOG(LOG_DYNAMICS) << "calc_spatial_zero_accelerations() entered" << endl;
-  vector<SVELOCITY> sprime;
+  const RC_ARTICULATED_BODY::Kinematics& kin = body->get_kinematics();
   MATRIXN tmp, tmp2, tmp3;
 
   // get the set of links
@@ -852,11 +874,23 @@ FILE_LOG(LOG_DYNAMICS) << "added link " << parent << " to queue for processing"
 
     // get the inner joint and the spatial axis
     boost::shared_ptr<JOINT> joint(link->get_inner_joint_explicit());
-    const vector<SVELOCITY>& s = joint->get_spatial_axes();
-    POSE3::transform(_I[i].pose, s, sprime);
+    const vector<SVELOCITY>& sprime = kin.s[i];
 
     // get I
     const SPATIAL_AB_INERTIA& I = _I[i];
+
+    // joints with prescribed accelerations transmit the full inertia
+    if (_hybrid && joint->is_acceleration_prescribed())
+    {
+      FILE_LOG(LOG_DYNAMICS) << "  *** Backward recursion processing link " << link << " (prescribed acceleration)" << endl;
+      FILE_LOG(LOG_DYNAMICS) << "    I: " << I << endl;
+      _Is[i].clear();
+      _sIs[i].resize(0,0);
+      if (!body->is_floating_base() && parent->is_base())
+        continue;
+      _I[h] += POSE3::transform(_I[h].pose, I);
+      continue;
+    }
     
     // compute Is
     SPARITH::mult(I, sprime, _Is[i]);
@@ -864,6 +898,14 @@ FILE_LOG(LOG_DYNAMICS) << "added link " << parent << " to queue for processing"
     // compute sIs
     SPARITH::transpose_mult(sprime, _Is[i], _sIs[i]);
 
+    // add the joint-space inertia from implicit joint springs and dampers
+    if (body->_implicit_inertia.size() == body->num_joint_dof_explicit())
+    {
+      const unsigned jidx = joint->get_coord_index();
+      for (unsigned k=0; k< _sIs[i].rows(); k++)
+        _sIs[i](k,k) += body->_implicit_inertia[jidx+k];
+    }
+
     // get whether s is rank deficient
     _rank_deficient[i] = joint->is_singular_config();
 
@@ -916,7 +958,7 @@ void FSAB_ALGORITHM::calc_spatial_accelerations(shared_ptr<RC_ARTICULATED_BODY>
 {
   queue<shared_ptr<RIGIDBODY> > link_queue;
   VECTORN result;
-  vector<SVELOCITY> sprime, sdotprime;
+  const RC_ARTICULATED_BODY::Kinematics& kin = body->get_kinematics();
 
   // get the links
   const vector<shared_ptr<RIGIDBODY> >& links = body->get_links();
@@ -968,26 +1010,28 @@ void FSAB_ALGORITHM::calc_spatial_accelerations(shared_ptr<RC_ARTICULATED_BODY>
     const unsigned h = parent->get_index();
     
     // compute transformed parent link acceleration
-    SACCEL ah = SPARITH::transform_accel(link->get_computation_frame(), parent->get_accel()); 
+    // (the parent acceleration need not be in the frame that the cached
+    // transform is defined from, e.g., with joint computation frames)
+    SACCEL ah = SPARITH::transform_accel(link->get_computation_frame(), parent->get_accel());
 
-    // get the spatial axis and its derivative
-    const vector<SVELOCITY>& s = joint->get_spatial_axes();
-    const vector<SVELOCITY>& sdot = joint->get_spatial_axes_dot();
-
-    // transform spatial axes
-    POSE3::transform(link->get_computation_frame(), s, sprime);
-    POSE3::transform(link->get_computation_frame(), sdot, sdotprime);
+    // get the spatial axis and its derivative (in the link computation frame)
+    const vector<SVELOCITY>& sprime = kin.s[i];
+    const vector<SVELOCITY>& sdotprime = kin.sdot[i];
 
     // get the Is and qm subexpressions
     const VECTORN& mu = _mu[i];    
     const SACCEL& c = _c[i];
 
-    // compute joint i acceleration
-    SFORCE w = _I[i] * ah;
-    SPARITH::transpose_mult(sprime, w, result);
-    result.negate();
-    result += mu;
-    solve_sIs(i, result, joint->qdd);
+    // compute joint i acceleration (unless it is prescribed)
+    const bool prescribed = (_hybrid && joint->is_acceleration_prescribed());
+    if (!prescribed)
+    {
+      SFORCE w = _I[i] * ah;
+      SPARITH::transpose_mult(sprime, w, result);
+      result.negate();
+      result += mu;
+      solve_sIs(i, result, joint->qdd);
+    }
     
     // compute link i spatial acceleration
     SACCEL ai = ah + c;
@@ -997,6 +1041,23 @@ void FSAB_ALGORITHM::calc_spatial_accelerations(shared_ptr<RC_ARTICULATED_BODY>
       ai += SACCEL(SPARITH::mult(sdotprime, joint->qd));
     link->set_accel(ai);
 
+    // compute the force necessary to realize a prescribed acceleration
+    if (prescribed)
+    {
+      SFORCE w = _I[i] * ai + _Z[i];
+      SPARITH::transpose_mult(sprime, w, joint->force);
+
+      // account for implicit joint springs and dampers
+      joint->force -= joint->calc_spring_damper_force(body->get_implicit_step_size(), result);
+      if (body->_implicit_inertia.size() == body->num_joint_dof_explicit())
+      {
+        const unsigned jidx = joint->get_coord_index();
+        for (unsigned k=0; k< joint->force.size(); k++)
+          joint->force[k] += body->_implicit_inertia[jidx+k]*joint->qdd[k];
+      }
+      FILE_LOG(LOG_DYNAMICS) << "    computed joint force: " << joint->force << endl;
+    }
+
     FILE_LOG(LOG_DYNAMICS) << endl << endl << "  *** Forward recursion processing link " << link << endl;  
     FILE_LOG(LOG_DYNAMICS) << "    a[h]: " << ah << endl;
     FILE_LOG(LOG_DYNAMICS) << "    qm(subexp): " << mu << endl;
@@ -1035,6 +1096,9 @@ void FSAB_ALGORITHM::calc_fwd_dyn()
 {
   FILE_LOG(LOG_DYNAMICS) << "FSABAlgorith::calc_fwd_dyn() entered" << endl;
 
+  // all joints are force driven
+  _hybrid = false;
+
   // get the body and the reference frame
   shared_ptr<RC_ARTICULATED_BODY> body(_body);
   if (!body->_ijoints.empty())
@@ -1072,6 +1136,9 @@ void FSAB_ALGORITHM::calc_fwd_dyn_special()
 {
   FILE_LOG(LOG_DYNAMICS) << "FSABAlgorith::calc_fwd_dyn() entered" << endl;
 
+  // all joints are force driven
+  _hybrid = false;
+
   // get the body and the reference frame
   shared_ptr<RC_ARTICULATED_BODY> body(_body);
   if (!body->_ijoints.empty())
@@ -1096,6 +1163,47 @@ void FSAB_ALGORITHM::calc_fwd_dyn_special()
   FILE_LOG(LOG_DYNAMICS) << "FSABAlgorith::calc_fwd_dyn() exited" << endl;
 }
 
+/// Computes hybrid dynamics for an articulated body
+/**
+ * Joints for which JOINT::is_acceleration_prescribed() is true are treated
+ * as acceleration-driven: their qdd is taken as input and the joint force
+ * required to realize that acceleration is written to JOINT::force. All
+ * other joints are treated as force-driven, as in calc_fwd_dyn(), and their
+ * qdd is computed. Runs in O(n) time. The inertias computed by this method
+ * are specific to the prescribed joint set, so they cannot be reused for 
+ * (pure) forward dynamics or for solving with the generalized inertia matrix.
+ */
+void FSAB_ALGORITHM::calc_hybrid_dyn()
+{
+  FILE_LOG(LOG_DYNAMICS) << "FSABAlgorith::calc_hybrid_dyn() entered" << endl;
+
+  // get the body and the reference frame
+  shared_ptr<RC_ARTICULATED_BODY> body(_body);
+  if (!body->_ijoints.empty())
+    throw std::runtime_error("FSAB_ALGORITHM cannot process bodies with kinematic loops!");
+
+  // prescribed joints are handled in all recursions
+  _hybrid = true;
+
+  // compute spatial coriolis vectors
+  calc_spatial_coriolis_vectors(body);
+
+  // compute spatial articulated body inertias
+  calc_spatial_inertias(body);
+
+  // compute spatial ZAs
+  calc_spatial_zero_accelerations(body);
+    
+  // compute spatial accelerations
+  calc_spatial_accelerations(body);
+
+  // reset the hybrid flag so that calc_spatial_inertias() called for 
+  // generalized inertia solves treats all joints as force driven
+  _hybrid = false;
+
+  FILE_LOG(LOG_DYNAMICS) << "FSABAlgorith::calc_hybrid_dyn() exited" << endl;
+}
+
 /// Signum function with NEAR_ZERO cutoff
 REAL FSAB_ALGORITHM::sgn(REAL x)
 {
@@ -1125,8 +1233,6 @@ void FSAB_ALGORITHM::push_children(shared_ptr<RIGIDBODY> link, queue<shared_ptr<
  */
 void FSAB_ALGORITHM::apply_impulse(const SMOMENTUM& w, shared_ptr<RIGIDBODY> link)
 {
-  static MATRIXN tmp;
-  static VECTORN tmp2, workv;
   vector<SVELOCITY> sprime;
 
   FILE_LOG(LOG_DYNAMICS) << "FSAB_ALGORITHM::apply_impulse() entered" << endl;
@@ -1184,11 +1290,11 @@ void FSAB_ALGORITHM::apply_impulse(const SMOMENTUM& w, shared_ptr<RIGIDBODY> lin
     
       // compute Is * inv(sIs) * s'
       transpose_solve_sIs(i, sprime, _sIss);
-      SPARITH::mult(Is, _sIss, tmp); 
-      tmp.mult(_Y[i], workv);
+      SPARITH::mult(Is, _sIss, _workM); 
+      _workM.mult(_Y[i], _workv);
 
       // compute impulse for h in i's frame (or global frame)
-      SMOMENTUM Yi = _Y[i] - SMOMENTUM::from_vector(workv,  _Y[i].pose);
+      SMOMENTUM Yi = _Y[i] - SMOMENTUM::from_vector(_workv,  _Y[i].pose);
 
       // transform the spatial impulse, if necessary
       _Y[h] = POSE3::transform(_Y[h].pose, Yi);
@@ -1268,8 +1374,8 @@ void FSAB_ALGORITHM::apply_impulse(const SMOMENTUM& w, shared_ptr<RIGIDBODY> lin
     // determine the joint and link velocity updates
     SVELOCITY dvh = POSE3::transform(_dv[i].pose, _dv[h]);
     SMOMENTUM f = (I * dvh) + _Y[i];
-    SPARITH::transpose_mult(sprime, (I * dvh) + _Y[i], tmp2);
-    solve_sIs(i, tmp2, _qd_delta).negate();
+    SPARITH::transpose_mult(sprime, (I * dvh) + _Y[i], _workv2);
+    solve_sIs(i, _workv2, _qd_delta).negate();
     _dv[i] = dvh + SPARITH::mult(s, _qd_delta);
 
     FILE_LOG(LOG_DYNAMICS) << "    -- I * dv[parent]: " << _dv[h] << endl;
@@ -20,6 +20,26 @@ FIXEDJOINT::FIXEDJOINT() : JOINT()
   _F2 = shared_ptr<POSE3>(new POSE3);
 }
 
+/// Makes a copy of this joint that uses the given frames (see JOINT::clone())
+shared_ptr<JOINT> FIXEDJOINT::clone(const PoseMap& poses) const
+{
+  shared_ptr<FIXEDJOINT> joint(new FIXEDJOINT(*this));
+
+  // point the frames and axes of the copy to the copied frames
+  joint->remap_poses(poses);
+  remap(joint->_rconst.pose, poses);
+  remap(joint->_ui.pose, poses);
+  remap(joint->_s_dot, poses);
+
+  // the copy gets its own temporary frames
+  if (_T)
+    joint->_T = shared_ptr<POSE3>(new POSE3(*_T));
+  joint->_F1 = shared_ptr<POSE3>(new POSE3);
+  joint->_F2 = shared_ptr<POSE3>(new POSE3);
+
+  return joint;
+}
+
 /// Sets spatial axes to zero 
 void FIXEDJOINT::update_spatial_axes()
 {
@@ -20,6 +20,12 @@ JOINT::JOINT()
 
   // initialize the constraint type to unknown
   _constraint_type = eUnknown;
+
+  // joint is force-driven by default
+  _accel_prescribed = false;
+
+  // no geometry changes yet
+  _geometry_version = 0;
 }
 
 /// Gets the articulated body
@@ -73,8 +79,9 @@ void JOINT::set_outboard_link(shared_ptr<RIGIDBODY> outboard, bool update_pose)
   if (!outboard)
     return;
 
-  // get the outboard pose
-  if (outboard->_F->rpose)
+  // get the outboard pose; it may only be relative to this joint (as it is
+  // once the joint is part of a reduced-coordinate articulated body)
+  if (outboard->_F->rpose && outboard->_F->rpose != _Fprime)
     throw std::runtime_error("Joint::set_outboard_link() - relative pose on inboard link already set");
 
   // setup Fb's pose relative to the outboard 
@@ -107,10 +114,75 @@ void JOINT::init_data()
   qdd.set_zero(NDOF);
   force.set_zero(NDOF);
   lambda.set_zero(NEQ);
+  stiffness.set_zero(NDOF);
+  damping.set_zero(NDOF);
+  q_rest.set_zero(NDOF);
   _q_tare.set_zero(NDOF);
   _s.resize(NDOF);
 }
 
+/// Computes the generalized force from the joint spring and damper over a step
+/**
+ * The spring and damper forces are evaluated implicitly, at the end of a 
+ * (semi-implicit Euler) step of size h:
+ * f = -K(q - q_rest + h*qd) - D*qd - (h*D + h^2*K)*qdd. This method 
+ * computes the portion of f that does not depend on qdd; the remaining term 
+ * is folded into the joint-space inertia (see calc_spring_damper_inertia()).
+ * \param h the step size (zero for explicit treatment)
+ * \param f the generalized force (on return)
+ */
+VECTORN& JOINT::calc_spring_damper_force(REAL h, VECTORN& f) const
+{
+  const unsigned NDOF = num_dof();
+
+  // a stiffness or damping vector that is not sized to the number of
+  // degrees-of-freedom is treated as zero
+  f.set_zero(NDOF);
+  const bool SPRING = (stiffness.size() == NDOF);
+  const bool DAMPER = (damping.size() == NDOF);
+
+  // compute the force
+  for (unsigned i=0; i< NDOF; i++)
+  {
+    if (SPRING)
+    {
+      const REAL qr = (q_rest.size() == NDOF) ? q_rest[i] : (REAL) 0.0;
+      f[i] -= stiffness[i]*(q[i] - qr + h*qd[i]);
+    }
+    if (DAMPER)
+      f[i] -= damping[i]*qd[i];
+  }
+
+  return f;
+}
+
+/// Computes the joint-space inertia contributed by an implicit joint spring and damper
+/**
+ * \param h the step size (zero for explicit treatment)
+ * \param d the diagonal terms h*D + h^2*K (on return)
+ */
+VECTORN& JOINT::calc_spring_damper_inertia(REAL h, VECTORN& d) const
+{
+  const unsigned NDOF = num_dof();
+
+  // a stiffness or damping vector that is not sized to the number of
+  // degrees-of-freedom is treated as zero
+  d.set_zero(NDOF);
+  const bool SPRING = (stiffness.size() == NDOF);
+  const bool DAMPER = (damping.size() == NDOF);
+
+  // compute the terms
+  for (unsigned i=0; i< NDOF; i++)
+  {
+    if (SPRING)
+      d[i] += h*h*stiffness[i];
+    if (DAMPER)
+      d[i] += h*damping[i];
+  }
+
+  return d;
+}
+
 /// Sets the inboard pose on the joint
 void JOINT::set_inboard_pose(shared_ptr<const POSE3> pose, bool update_joint_pose) 
 {
@@ -123,6 +195,7 @@ void JOINT::set_inboard_pose(shared_ptr<const POSE3> pose, bool update_joint_pos
   }
   else
     _F->rpose = pose;
+  _geometry_version++;
 
   // update spatial axes if both poses are set
   if (_F->rpose && _Fb->rpose)
@@ -144,6 +217,7 @@ void JOINT::set_outboard_pose(shared_ptr<POSE3> pose, bool update_joint_pose)
   }
   else
     _Fb->rpose = pose;
+  _geometry_version++;
 
   // update spatial axes if both poses are set
   if (_F->rpose && _Fb->rpose)
@@ -151,6 +225,11 @@ void JOINT::set_outboard_pose(shared_ptr<POSE3> pose, bool update_joint_pose)
 }
 
 /// Sets the location of this joint while simultaneously setting the inboard and outboard links
+/**
+ * If the pose of the outboard link is already defined relative to this joint
+ * (i.e., the joint is part of a reduced-coordinate articulated body), the
+ * outboard link moves with the joint.
+ */
 void JOINT::set_location(const VECTOR3& point, shared_ptr<RIGIDBODY> inboard, shared_ptr<RIGIDBODY> outboard) 
 {
   assert(inboard && outboard);
@@ -161,7 +240,9 @@ void JOINT::set_location(const VECTOR3& point, shared_ptr<RIGIDBODY> inboard, sh
 
   // set _F's and Fb's origins
   _F->x = ORIGIN3(pi);
-  _Fb->x = ORIGIN3(po);
+  if (outboard->get_pose()->rpose != _Fprime)
+    _Fb->x = ORIGIN3(po);
+  _geometry_version++;
 
   // invalidate all outboard pose vectors
   outboard->invalidate_pose_vectors();
@@ -197,6 +278,47 @@ VECTOR3 JOINT::get_location(bool use_outboard) const
   }
 }
 
+/// Makes a copy of this joint that uses the given frames
+/**
+ * \param poses maps the frames of the articulated body containing this joint
+ *        to the frames of the copy of the body; must contain the frames of
+ *        this joint
+ * \return the copy; the inboard and outboard links of the copy must be set 
+ *         by the caller
+ * \note joint types that do not support copying throw an exception
+ */
+shared_ptr<JOINT> JOINT::clone(const PoseMap&) const
+{
+  throw std::runtime_error("JOINT::clone() - copying is not supported for this joint type");
+}
+
+/// Points the frames of this (copied) joint to the corresponding copied frames
+void JOINT::remap_poses(const PoseMap& poses)
+{
+  assert(poses.find(_F) != poses.end());
+  assert(poses.find(_Fb) != poses.end());
+  assert(poses.find(_Fprime) != poses.end());
+  _F = poses.find(_F)->second;
+  _Fb = poses.find(_Fb)->second;
+  _Fprime = poses.find(_Fprime)->second;
+  remap(_s, poses);
+}
+
+/// Points a frame to its copy (frames without a copy are left unchanged)
+void JOINT::remap(shared_ptr<const POSE3>& pose, const PoseMap& poses)
+{
+  PoseMap::const_iterator i = poses.find(pose);
+  if (i != poses.end())
+    pose = i->second;
+}
+
+/// Points the frames of a vector of spatial axes to their copies
+void JOINT::remap(vector<SVELOCITY>& s, const PoseMap& poses)
+{
+  for (unsigned i=0; i< s.size(); i++)
+    remap(s[i].pose, poses);
+}
+
 /// Gets the spatial axes for this joint
 /**
  * Spatial axes describe the motion of the joint. Note that for rftype = eLink,
@@ -10,6 +10,9 @@ void LINALG::free_memory()
   workv().resize(0);
   workv2().resize(0);
   iworkv().resize(0);
+  tauQR().resize(0);
+  tauRZ().resize(0);
+  pivCOD().resize(0);
   compress();
 }
 
@@ -24,6 +27,8 @@ void LINALG::compress()
   S().compress();
   workv().compress();
   workv2().compress();
+  tauQR().compress();
+  tauRZ().compress();
 //  iworkv().shrink_to_fit();
 }
 
@@ -131,6 +136,88 @@ MATRIXN& LINALG::pseudo_invert(MATRIXN& A, REAL tol)
   return A;
 }
 
+/// Computes the pseudo-inverse of a matrix using the requested decomposition
+/**
+ * The complete orthogonal decomposition is typically several times faster
+ * than the SVD for tall and rank-deficient matrices. eLSAuto uses the
+ * complete orthogonal decomposition unless the numerical rank of A is 
+ * ambiguous, in which case the SVD is used.
+ * \param A the matrix on input; the pseudo-inverse on return
+ * \param method the decomposition to use
+ * \param tol the tolerance for determining the rank of A; if tol < 0.0,
+ *        tol is computed using machine epsilon
+ */
+MATRIXN& LINALG::pseudo_invert(MATRIXN& A, LSMethod method, REAL tol)
+{
+  // get the dimensionality of A
+  const unsigned m = A.rows();
+  const unsigned n = A.columns();
+  const unsigned minmn = std::min(m, n);
+
+  // check for SVD or easy out
+  if (method == eLSSVD || minmn == 0)
+    return pseudo_invert(A, tol);
+
+  // backup A, if necessary 
+  MATRIXN& A_backup = workM2();
+  if (method == eLSAuto)
+    A_backup = A;
+
+  // compute the complete orthogonal decomposition
+  bool ambiguous;
+  std::vector<INTEGER>& PI = pivCOD();
+  VECTORN& tQR = tauQR();
+  VECTORN& tRZ = tauRZ();
+  const unsigned r = factor_COD(A, PI, tQR, tRZ, ambiguous, tol);
+
+  // fall back to the SVD if the rank is numerically ambiguous
+  if (ambiguous && method == eLSAuto)
+  {
+    A = A_backup;
+    return pseudo_invert(A, tol);
+  }
+
+  // look for zero rank
+  if (r == 0)
+    return A.set_zero(n, m);
+
+  // the transpose of the pseudo-inverse of AP is Q*[inv(T)' 0; 0 0]*Z; 
+  // start by computing inv(T)' 
+  MATRIXN& W = workM2();
+  W.set_zero(m, n);
+  for (unsigned i=0; i< r; i++)
+    W(i,i) = (REAL) 1.0;
+  char UPLO = 'U', TRANS = 'T';
+  INTEGER R = r, LDA = A.leading_dim(), LDW = W.leading_dim(), INFO;
+  trtrs_(&UPLO, &TRANS, &R, &R, A.data(), &LDA, W.data(), &LDW, &INFO);
+  if (INFO > 0)
+    throw SingularException();
+
+  // multiply [inv(T)' 0] by Z
+  if (r < n)
+  {
+    char SIDE = 'R', NOTRANS = 'N';
+    INTEGER N = n, L = n - r;
+    ormrz_(&SIDE, &NOTRANS, &R, &N, &R, &L, A.data(), &LDA, tRZ.data(), W.data(), &LDW, &INFO);
+  }
+
+  // multiply by Q
+  char SIDE = 'L', NOTRANS = 'N';
+  INTEGER M = m, N = n, K = minmn;
+  ormqr_(&SIDE, &NOTRANS, &M, &N, &K, A.data(), &LDA, tQR.data(), W.data(), &LDW, &INFO);
+
+  // transpose and undo the column permutation 
+  A.resize(n, m);
+  for (unsigned i=0; i< n; i++)
+  {
+    const unsigned pi = (unsigned) PI[i] - 1;
+    for (unsigned j=0; j< m; j++)
+      A(pi,j) = W(j,i);
+  }
+
+  return A;
+}
+
 /// Less robust least squares solver (solves Ax = b)
 /**
  * \note this method does not work!
@@ -226,269 +313,110 @@ void LINALG::update_QR_rank1(MATRIXN& Q, MATRIXN& R, const VECTORN& u, const VEC
   throw std::runtime_error("This method not currently implemented/working");
 }
 
-/// Updates a QR factorization by deleting p columns starting at column idx k
+/// Restores the upper triangular form of R after a column update, applying the Givens rotations to Q
 /**
- * \param Q a m x min(m,n) matrix
- * \param R a min(m,n) x n matrix
- * \param k the column index to start deleting at
- * \parma p the number of columns to delete
+ * Entries below the diagonal of columns k, k+1, ... of R are zeroed from
+ * the bottom up using rotations of adjacent rows, so that Q*R is unchanged.
+ * \param Q a m x m orthogonal matrix
+ * \param R a m x n matrix that is upper triangular in columns 0..k-1
  */
-void LINALG::update_QR_delete_cols(MATRIXN& Q, MATRIXN& R, unsigned k, unsigned p)
+void LINALG::triangularize_QR(MATRIXN& Q, MATRIXN& R, unsigned k)
 {
-  throw std::runtime_error("This method not currently implemented/working");
-/*
-  VECTORN workv, workv2;
-  MATRIXN workM, workM2, workM3;
-  vector<REAL> c, s, tau;
-  vector<unsigned> select;
-  vector<VECTORN> V;
-
-  const int m = Q.rows();
-  const int n = R.columns();
-  const int lim = std::min(m-1,n-(int) p);
-  assert(k + p <= n);
-
-  // make k one indexed to work with our 1-indexed algorithm
-  k++;
-
-  // simplest case
-  if (k == n-p+1)
-  {
-    R.get_sub_mat(0,m,0,k-1,workM);
-    R = workM;
-    Q.get_sub_mat(0,m,0,m,workM);
-    Q = workM;
-    return;
-  }
-
-  // next simplest case
-  if (k > std::min(m-1,(int) (n-p)))
-  {
-    // get relevant indices of R
-    select.clear();
-    for (int i=1; i<= n; i++)
-      if (i < k || i >= k+p)
-        select.push_back(i-1);
-    R.select_columns(select.begin(), select.end(), workM);
-    R = workM;
-    Q.get_sub_mat(0,m,0,R.rows(),workM);
-    Q = workM;
-    return;
-  }
-
-  // setup c, s
-  c.resize(std::max(m,n)+1);
-  s.resize(std::max(m,n)+1);
-
-  // shift R
-  R.get_sub_mat(0,m,k+p-1,n,workM);
-  R.set_sub_mat(0,k-1,workM);
-
-  // third simplest case: p = 1 and m >= n
-  if (p == 1 && m >= n)
-  {
-    for (int j=k; j<= n-1; j++)
+  const unsigned m = R.rows();
+  const unsigned n = R.columns();
+  const unsigned LDR = R.leading_dim(), LDQ = Q.leading_dim();
+  REAL* r = R.data();
+  REAL* q = Q.data();
+  REAL c, s;
+
+  for (unsigned j=k; j< n && j+1 < m; j++)
+    for (unsigned i=m-1; i> j; i--)
     {
-      // compute Givens rotation
-      givens(R(j-1,j-1), R(j,j-1), c[j], s[j]);
-
-      // update R
-      R(j-1,j-1) = c[j]*R(j-1,j-1) - s[j]*R(j,j-1);
-      R.get_sub_mat(j-1,j+1,j-1,n-1,workM);
-      givens(c[j], s[j]).transpose_mult(workM, workM2);
-      R.set_sub_mat(j-1,j-1,workM2);
-    }
-
-    // compute upper triangular part of R
-    R.get_sub_mat(0,m,0,n-1,workM);
-    for (int i=1; i<= workM.rows(); i++)
-      for (int j=1; j<= std::min(i-1,(int) workM.columns()); j++)
-        workM(i-1,j-1) = (REAL) 0.0;
-    R = workM;
+      // nothing to do if the entry is already zero
+      REAL b = r[j*LDR+i];
+      if (b == (REAL) 0.0)
+        continue;
+
+      // zero the entry using rows i-1 and i
+      givens(r[j*LDR+i-1], b, c, s);
+      for (unsigned l=j; l< n; l++)
+      {
+        REAL x = r[l*LDR+i-1], y = r[l*LDR+i];
+        r[l*LDR+i-1] = c*x - s*y;
+        r[l*LDR+i] = s*x + c*y;
+      }
+      r[j*LDR+i] = (REAL) 0.0;
 
-    // update Q
-    for (int j=k; j<= n-1; j++)
-    {
-      Q.get_sub_mat(0,m,j-1,j+1,workM);
-      workM.mult(givens(c[j], s[j]), workM2);
-      Q.set_sub_mat(0,j-1, workM2);
+      // apply the transposed rotation to columns i-1 and i of Q
+      REAL* qa = q + (i-1)*LDQ;
+      REAL* qb = q + i*LDQ;
+      for (unsigned l=0; l< m; l++)
+      {
+        REAL x = qa[l], y = qb[l];
+        qa[l] = c*x - s*y;
+        qb[l] = s*x + c*y;
+      }
     }
+}
 
-    return;
-  }
+/// Updates a QR factorization by deleting p columns starting at column idx k
+/**
+ * \param Q a m x m orthogonal matrix
+ * \param R a m x n upper triangular matrix
+ * \param k the column index to start deleting at
+ * \param p the number of columns to delete
+ * \note no memory is allocated
+ */
+void LINALG::update_QR_delete_cols(MATRIXN& Q, MATRIXN& R, unsigned k, unsigned p)
+{
+  const unsigned m = R.rows();
+  const unsigned n = R.columns();
 
-  // householder case (p > 1)
-  tau.resize(lim+1);
-  V.resize(lim+1);
-  for (int j=k; j<= lim; j++)
-  {
-    // compute householder vector/scalar
-    int last = std::min(j+(int) p, m);
-    R.get_sub_mat(j, last, j-1, j, workv2);
-    householder(R(j-1,j-1), workv2, tau[j], V[j]);
-
-    // update R
-    R(j-1,j-1) -= tau[j]*(R(j-1,j-1) + V[j].dot(workv2));
-    if (j < n-p)
-    {
-      R.get_sub_mat(j-1,last,j,n-p, workM);
-      workv.resize(V[j].size()+1);
-      workv.set_sub_vec(1, V[j]);
-      workv[0] = (REAL) 1.0;
-      workM.transpose_mult(workv, workv2);
-      workv *= tau[j];
-      outer_prod(workv, workv2, workM2);
-      workM -= workM2;
-      R.set_sub_mat(j-1,j,workM);
-    }
-  }
+  #ifndef NEXCEPT
+  if (k + p > n || Q.rows() != m || Q.columns() != m)
+    throw MissizeException();
+  #endif
 
-  // setup upper triangular R
-  R.get_sub_mat(0,m,0,n-p,workM);
-  R = workM;
-  for (int i=1; i<= workM.rows(); i++)
-    for (int j=1; j<= std::min(i-1,(int) workM.columns()); j++)
-      R(i-1,j-1) = (REAL) 0.0;
+  // shift the columns to the right of the deleted ones left
+  REAL* r = R.data();
+  std::copy(r + (k+p)*m, r + n*m, r + k*m);
+  R.resize(m, n-p, true);
 
-  // setup Q
-  for (int j=k; j<= lim; j++)
-  {
-    int last = std::min(j+(int) p,m);
-    Q.get_sub_mat(0,m,j-1,last,workM);
-    workv.resize(V[j].size()+1);
-    workv.set_sub_vec(1, V[j]);
-    workv[0] = (REAL) 1.0;
-    workv2 = workv;
-    workv2 *= tau[j];
-    outer_prod(workv, workv2, workM2);
-    workM.mult(workM2, workM3);
-    workM -= workM3;
-    Q.set_sub_mat(0,j-1,workM);
-  }
-//  Q.get_sub_mat(0,m,0,std::min(lim+(int) p, m), workM);
-  Q.get_sub_mat(0,m,0,m, workM);
-  Q = workM;
-*/
+  // the shifted columns now have p subdiagonals; zero them
+  triangularize_QR(Q, R, k);
 }
 
 /// Updates a QR factorization by inserting one or more columns at column idx k
 /**
- * \param Q a m x min(m,n) matrix
- * \param R a min(m,n) x n matrix
+ * \param Q a m x m orthogonal matrix
+ * \param R a m x n upper triangular matrix
  * \param U a m x p matrix, destroyed on return
+ * \param k the index to insert at
+ * \note no memory is allocated once R has the capacity for the new columns
  */
 void LINALG::update_QR_insert_cols(MATRIXN& Q, MATRIXN& R, MATRIXN& U, unsigned k)
 {
-  throw std::runtime_error("This method not currently implemented/working");
-/*
-  SAFESTATIC VECTORN workv;
-  SAFESTATIC MATRIXN workM, workM2, Qu;
-  SAFESTATIC MATRIXN c, s;
-
-  const int m = Q.rows();
-  const int n = R.columns();
-  const int p = U.columns();
-  assert(U.rows() == m);
-
-  // make k one indexed to work with our 1-indexed algorithm
-  k++;
-
-  // setup c, s
-  c.resize(std::max(m,n)+1,std::max(m,n)+1);
-  s.resize(std::max(m,n)+1,std::max(m,n)+1);
-
-  // setup U
-  Q.transpose_mult(U, workM);
-  U = workM;
-  if (m > n+1)
-  {
-    // do a QR factorization
-    U.get_sub_mat(n,m,0,p,workM);
-    LINALG::factor_QR(workM, Qu);
-  }
+  const unsigned m = R.rows();
+  const unsigned n = R.columns();
+  const unsigned p = U.columns();
 
-  if (k <= n)
-  {
-    // zero out the rest with givens, stop at last column of U or last row that
-    // is reached first
-    int jstop = std::min((int) p,m-(int) k-2);
-    for (int j=1; j<= jstop; j++)
-    {
-      int istart = std::min(n+j,m);
-      int upfirst = std::max(istart-j,1);
-      for (int i=istart; i> j; i--)
-      {
-        givens(U(i-2,j-1),U(i-1,j-1), c(i,j), s(i,j));
-
-        // update U
-        U(i-2,j-1) = c(i,j)*U(i-2,j-1) - s(i,j)*U(i-1,j-1);
-        if (j < p)
-        {
-          U.get_sub_mat(i-2,i,j,p,workM);
-          givens(c(i,j), s(i,j)).transpose_mult(workM, workM2);
-          U.set_sub_mat(i-2,j,workM2);
-        }
-
-        // update R
-        R.get_sub_mat(i-2,i,upfirst-1,n,workM);
-        givens(c(i,j), s(i,j)).transpose_mult(workM, workM2);
-        R.set_sub_mat(i-2,upfirst-1,workM2);
-
-        // update one more column next i step
-        upfirst--;
-      }
-    }
-  }
+  #ifndef NEXCEPT
+  if (k > n || U.rows() != m || Q.rows() != m || Q.columns() != m)
+    throw MissizeException();
+  #endif
 
-  // finish R
-  workM.resize(U.rows(), U.columns()+R.columns());
-  if (k == 1)
-  {
-    workM.set_sub_mat(0, 0, U);
-    workM.set_sub_mat(0, U.columns(), R);
-  }
-  else if (k == n+1)
-  {
-    workM.set_sub_mat(0, 0, R);
-    workM.set_sub_mat(0, R.columns(), U);
-  }
-  else
-  {
-    R.get_sub_mat(0,m,0,k-1,workM2);
-    workM.set_sub_mat(0,0,workM2);
-    workM.set_sub_mat(0,workM2.columns(),U);
-    R.get_sub_mat(0,m,k-1,n,workM2);
-    workM.set_sub_mat(0,U.columns()+k-1,workM2);
-  }
-  R = workM;
+  // the new columns of R are Q'*U
+  MATRIXN& QtU = workM();
+  Q.transpose_mult(U, QtU);
 
-  // finally, make R upper triangular
-  for (int i=1; i<= (int) R.rows(); i++)
-    for (int j=1; j<= std::min((int) R.columns(),i-1); j++)
-      R(i-1,j-1) = (REAL) 0.0;
+  // shift the columns at and to the right of k right, and insert Q'*U
+  R.resize(m, n+p, true);
+  REAL* r = R.data();
+  std::copy_backward(r + k*m, r + n*m, r + (n+p)*m);
+  std::copy(QtU.data(), QtU.data() + m*p, r + k*m);
 
-  // compute Q
-  if (m > n+1)
-  {
-    Q.get_sub_mat(0,m,n,m,workM);
-    workM.mult(Qu, workM2);
-    Q.set_sub_mat(0,n,workM2);
-  }
-  if (k <= n)
-  {
-    int jstop = std::min((int) p,m-(int) k-2);
-    for (int j=1; j<= jstop; j++)
-    {
-      int istart = std::min(n+j,m);
-      for (int i=istart; i>= j+1; i--)
-      {
-        Q.get_sub_mat(0,m,i-2,i,workM);
-        workM.mult(givens(c(i,j), s(i,j)), workM2);
-        Q.set_sub_mat(0,i-2,workM2);
-      }
-    }
-  }
-*/
+  // zero the new columns (and the subdiagonals this creates to their right)
+  triangularize_QR(Q, R, k);
 }
 
 /// Updates a QR factorization by inserting a block of rows, starting at index k
@@ -834,3 +762,230 @@ void LINALG::update_QR_delete_rows(MATRIXN& Q, MATRIXN& R, unsigned k, unsigned
 }
 
 
+
+/// Computes the nonzero pattern of row k of a sparse Cholesky factor
+/**
+ * \param Ap the column pointers of the upper triangle of A
+ * \param Ai the row indices of the upper triangle of A
+ * \param parent the elimination tree of A
+ * \param stack on return, contains the pattern (topologically ordered) in
+ *        elements [top, n)
+ * \param mark work vector; entries equal to k are marked
+ * \return the index top
+ */
+unsigned LINALG::ereach(unsigned k, const unsigned* Ap, const unsigned* Ai, const vector<unsigned>& parent, vector<unsigned>& stack, vector<unsigned>& mark)
+{
+  const unsigned n = stack.size();
+  unsigned top = n;
+  mark[k] = k;
+  for (unsigned p=Ap[k]; p< Ap[k+1]; p++)
+  {
+    unsigned i = Ai[p], len = 0;
+    if (i > k)
+      continue;
+    for (; mark[i] != k; i = parent[i])
+    {
+      stack[len++] = i;
+      mark[i] = k;
+    }
+    while (len > 0)
+      stack[--top] = stack[--len];
+  }
+
+  return top;
+}
+
+/// Computes the sparse Cholesky factorization of a symmetric, positive-definite matrix
+/**
+ * Uses an up-looking factorization driven by the elimination tree of A 
+ * (no fill-reducing ordering is applied).
+ * \param A the sparse symmetric matrix to factorize
+ * \param L on return, the lower triangular factor (A = LL') in CSC format;
+ *        the diagonal entry is the first entry of each column
+ * \return <b>true</b> if successful, <b>false</b> if A is not positive-definite
+ */
+bool LINALG::factor_chol(const SPARSESYMMATRIXN& A, SPARSEMATRIXN& L)
+{
+  const unsigned n = A.rows();
+
+  // the factorization works with the upper triangle in compressed columns
+  SPARSESYMMATRIXN Aup;
+  const SPARSESYMMATRIXN& U = (A.get_triangle() == SPARSESYMMATRIXN::eUpper) ? A : A.to_triangle(SPARSESYMMATRIXN::eUpper, Aup);
+  const unsigned* Ap = U.get_ptr();
+  const unsigned* Ai = U.get_indices();
+  const REAL* Ax = U.get_data();
+
+  // compute the elimination tree
+  const unsigned NONE = std::numeric_limits<unsigned>::max();
+  vector<unsigned> parent(n, NONE), ancestor(n, NONE);
+  for (unsigned k=0; k< n; k++)
+    for (unsigned p=Ap[k]; p< Ap[k+1]; p++)
+      for (unsigned i=Ai[p], inext; i != NONE && i < k; i = inext)
+      {
+        inext = ancestor[i];
+        ancestor[i] = k;
+        if (inext == NONE)
+          parent[i] = k;
+      }
+
+  // setup work vectors for computing row patterns of L
+  vector<unsigned> stack(n), mark(n, NONE);
+
+  // determine the column counts of L
+  vector<unsigned> c(n, 1);
+  for (unsigned k=0; k< n; k++)
+    for (unsigned top = ereach(k, Ap, Ai, parent, stack, mark); top < n; top++)
+      c[stack[top]]++;
+
+  // setup L
+  shared_array<unsigned> Lp(new unsigned[n+1]);
+  Lp[0] = 0;
+  for (unsigned j=0; j< n; j++)
+    Lp[j+1] = Lp[j] + c[j];
+  shared_array<unsigned> Li(new unsigned[Lp[n]]);
+  shared_array<REAL> Lx(new REAL[Lp[n]]);
+  std::copy(Lp.get(), Lp.get()+n, c.begin());
+
+  // compute L(k,:) for k = 0..n-1
+  vector<REAL> x(n, (REAL) 0.0);
+  std::fill(mark.begin(), mark.end(), NONE);
+  for (unsigned k=0; k< n; k++)
+  {
+    // scatter column k of the upper triangle of A into x
+    unsigned top = ereach(k, Ap, Ai, parent, stack, mark);
+    x[k] = (REAL) 0.0;
+    for (unsigned p=Ap[k]; p< Ap[k+1]; p++)
+      if (Ai[p] <= k)
+        x[Ai[p]] = Ax[p];
+    REAL d = x[k];
+    x[k] = (REAL) 0.0;
+
+    // solve L(0:k-1,0:k-1) * x = A(0:k-1,k)
+    for (; top < n; top++)
+    {
+      const unsigned i = stack[top];
+      const REAL lki = x[i]/Lx[Lp[i]];
+      x[i] = (REAL) 0.0;
+      for (unsigned p=Lp[i]+1; p< c[i]; p++)
+        x[Li[p]] -= Lx[p]*lki;
+      d -= lki*lki;
+      const unsigned p = c[i]++;
+      Li[p] = k;
+      Lx[p] = lki;
+    }
+
+    // verify positive-definiteness 
+    if (d <= (REAL) 0.0)
+      return false;
+
+    // store the diagonal
+    const unsigned p = c[k]++;
+    Li[p] = k;
+    Lx[p] = std::sqrt(d);
+  }
+
+  L = SPARSEMATRIXN(SPARSEMATRIXN::eCSC, n, n, Lp, Li, Lx);
+  return true;
+}
+
+/// Solves a system of equations using a sparse Cholesky factor
+/**
+ * \param L the lower triangular factor computed by factor_chol()
+ * \param xb the right hand side on input; the solution on return
+ */
+VECTORN& LINALG::solve_chol_fast(const SPARSEMATRIXN& L, VECTORN& xb)
+{
+  #ifndef NEXCEPT
+  if (L.rows() != xb.rows())
+    throw MissizeException();
+  #endif
+
+  const unsigned n = L.columns();
+  const unsigned* Lp = L.get_ptr();
+  const unsigned* Li = L.get_indices();
+  const REAL* Lx = L.get_data();
+  REAL* x = xb.data();
+
+  // solve Ly = b
+  for (unsigned j=0; j< n; j++)
+  {
+    x[j] /= Lx[Lp[j]];
+    for (unsigned p=Lp[j]+1; p< Lp[j+1]; p++)
+      x[Li[p]] -= Lx[p]*x[j];
+  }
+
+  // solve L'x = y
+  for (unsigned j=n; j > 0; j--)
+  {
+    for (unsigned p=Lp[j-1]+1; p< Lp[j]; p++)
+      x[j-1] -= Lx[p]*x[Li[p]];
+    x[j-1] /= Lx[Lp[j-1]];
+  }
+
+  return xb;
+}
+
+/// Solves a system of equations with multiple right hand sides using a sparse Cholesky factor
+MATRIXN& LINALG::solve_chol_fast(const SPARSEMATRIXN& L, MATRIXN& XB)
+{
+  #ifndef NEXCEPT
+  if (L.rows() != XB.rows())
+    throw MissizeException();
+  #endif
+
+  VECTORN x;
+  for (unsigned i=0; i< XB.columns(); i++)
+  {
+    XB.get_column(i, x);
+    solve_chol_fast(L, x);
+    XB.set_column(i, x);
+  }
+
+  return XB;
+}
+
+/// Solves a sparse symmetric system of linear equations
+/**
+ * A sparse Cholesky factorization is attempted first; if A is not 
+ * positive-definite, the full matrix is formed and solved using LU
+ * factorization.
+ */
+VECTORN& LINALG::solve_sparse_direct(const SPARSESYMMATRIXN& A, const VECTORN& b, VECTORN& x)
+{
+  #ifndef NEXCEPT
+  if (A.rows() != b.rows())
+    throw MissizeException();
+  #endif
+
+  SPARSEMATRIXN L;
+  if (factor_chol(A, L))
+  {
+    x = b;
+    return solve_chol_fast(L, x);
+  }
+
+  return solve_sparse_direct(A.to_full(SPARSEMATRIXN::eCSR, L), b, eNoTranspose, x);
+}
+
+/// Solves a sparse symmetric system of linear equations with multiple right hand sides
+/**
+ * A sparse Cholesky factorization is attempted first; if A is not 
+ * positive-definite, the full matrix is formed and solved using LU
+ * factorization.
+ */
+MATRIXN& LINALG::solve_sparse_direct(const SPARSESYMMATRIXN& A, const MATRIXN& B, MATRIXN& X)
+{
+  #ifndef NEXCEPT
+  if (A.rows() != B.rows())
+    throw MissizeException();
+  #endif
+
+  SPARSEMATRIXN L;
+  if (factor_chol(A, L))
+  {
+    X = B;
+    return solve_chol_fast(L, X);
+  }
+
+  return solve_sparse_direct(A.to_full(SPARSEMATRIXN::eCSR, L), B, eNoTranspose, X);
+}
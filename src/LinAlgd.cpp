@@ -328,6 +328,40 @@ void LinAlgd::orgqr_(INTEGER* M, INTEGER* N, INTEGER* K, DOUBLE* A, INTEGER* LDA
   dorgqr_(M, N, K, A, LDA, TAU, workv().data(), &LWORK, INFO);
 }
 
+/// Calls LAPACK function for reducing an upper trapezoidal matrix to upper triangular form
+void LinAlgd::tzrzf_(INTEGER* M, INTEGER* N, DOUBLE* A, INTEGER* LDA, DOUBLE* TAU, INTEGER* INFO)
+{
+  // do a workspace query
+  INTEGER LWORK = -1;
+  DOUBLE WORK_QUERY;
+  dtzrzf_(M, N, A, LDA, TAU, &WORK_QUERY, &LWORK, INFO);
+
+  // initialize the work array
+  LWORK = std::max((INTEGER) 1, (INTEGER) WORK_QUERY);
+  workv().resize(LWORK);
+
+  // call the function for real
+  dtzrzf_(M, N, A, LDA, TAU, workv().data(), &LWORK, INFO);
+}
+
+/// Calls LAPACK function for multiplying by the orthogonal matrix from an RZ factorization
+void LinAlgd::ormrz_(char* SIDE, char* TRANS, INTEGER* M, INTEGER* N, INTEGER* K, INTEGER* L, DOUBLE* A, INTEGER* LDA, DOUBLE* TAU, DOUBLE* C, INTEGER* LDC, INTEGER* INFO)
+{
+  // determine workspace size
+  INTEGER LWORK = -1;
+  DOUBLE WORK_QUERY;
+  dormrz_(SIDE, TRANS, M, N, K, L, A, LDA, TAU, C, LDC, &WORK_QUERY, &LWORK, INFO);
+  assert(*INFO == 0);
+
+  // declare memory
+  LWORK = std::max((INTEGER) 1, (INTEGER) WORK_QUERY);
+  workv().resize(LWORK);
+
+  // do the real call now
+  dormrz_(SIDE, TRANS, M, N, K, L, A, LDA, TAU, C, LDC, workv().data(), &LWORK, INFO);
+  assert(*INFO == 0);
+}
+
 #include <Ravelin/ddefs.h>
 #include "LinAlg.cpp"
 #include <Ravelin/undefs.h>
@@ -391,7 +425,7 @@ MatrixNd& LinAlgd::solve_sparse_direct(const SparseMatrixNd& A, const MatrixNd&
   int* row_ptr = (int*) A.get_ptr();
 
   // check info
-  int info = solve_superlu(trans == eNoTranspose, A.get_storage_type() == SparseMatrixNd::eCSR, m, n, nrhs, nnz, col_indices, row_ptr, nz_val, X.data(), (double*) X.data());
+  int info = solve_superlu(trans == eNoTranspose, A.get_storage_type() == SparseMatrixNd::eCSR, m, n, nrhs, nnz, col_indices, row_ptr, nz_val, X.data(), (double*) B.data());
   if (info > 0)
     throw SingularException();
   #else
@@ -330,6 +330,40 @@ void LinAlgf::orgqr_(INTEGER* M, INTEGER* N, INTEGER* K, SINGLE* A, INTEGER* LDA
   sorgqr_(M, N, K, A, LDA, TAU, workv().data(), &LWORK, INFO);
 }
 
+/// Calls LAPACK function for reducing an upper trapezoidal matrix to upper triangular form
+void LinAlgf::tzrzf_(INTEGER* M, INTEGER* N, SINGLE* A, INTEGER* LDA, SINGLE* TAU, INTEGER* INFO)
+{
+  // do a workspace query
+  INTEGER LWORK = -1;
+  SINGLE WORK_QUERY;
+  stzrzf_(M, N, A, LDA, TAU, &WORK_QUERY, &LWORK, INFO);
+
+  // initialize the work array
+  LWORK = std::max((INTEGER) 1, (INTEGER) WORK_QUERY);
+  workv().resize(LWORK);
+
+  // call the function for real
+  stzrzf_(M, N, A, LDA, TAU, workv().data(), &LWORK, INFO);
+}
+
+/// Calls LAPACK function for multiplying by the orthogonal matrix from an RZ factorization
+void LinAlgf::ormrz_(char* SIDE, char* TRANS, INTEGER* M, INTEGER* N, INTEGER* K, INTEGER* L, SINGLE* A, INTEGER* LDA, SINGLE* TAU, SINGLE* C, INTEGER* LDC, INTEGER* INFO)
+{
+  // determine workspace size
+  INTEGER LWORK = -1;
+  SINGLE WORK_QUERY;
+  sormrz_(SIDE, TRANS, M, N, K, L, A, LDA, TAU, C, LDC, &WORK_QUERY, &LWORK, INFO);
+  assert(*INFO == 0);
+
+  // declare memory
+  LWORK = std::max((INTEGER) 1, (INTEGER) WORK_QUERY);
+  workv().resize(LWORK);
+
+  // do the real call now
+  sormrz_(SIDE, TRANS, M, N, K, L, A, LDA, TAU, C, LDC, workv().data(), &LWORK, INFO);
+  assert(*INFO == 0);
+}
+
 #include <Ravelin/fdefs.h>
 #include "LinAlg.cpp"
 #include <Ravelin/undefs.h>
@@ -393,7 +427,7 @@ MatrixNf& LinAlgf::solve_sparse_direct(const SparseMatrixNf& A, const MatrixNf&
   int* row_ptr = (int*) A.get_ptr();
 
   // check info
-  int info = solve_superlu(trans == eNoTranspose, A.get_storage_type() == SparseMatrixNf::eCSR, m, n, nrhs, nnz, col_indices, row_ptr, nz_val, X.data(), (float*) X.data());
+  int info = solve_superlu(trans == eNoTranspose, A.get_storage_type() == SparseMatrixNf::eCSR, m, n, nrhs, nnz, col_indices, row_ptr, nz_val, X.data(), (float*) B.data());
   if (info > 0)
     throw SingularException();
   #else
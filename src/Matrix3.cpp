@@ -118,9 +118,7 @@ MATRIX3::MATRIX3(REAL m00, REAL m01, REAL m02, REAL m10, REAL m11, REAL m12, REA
 ORIGIN3 MATRIX3::transpose_mult(const ORIGIN3& o) const
 {
   ORIGIN3 result;
-  result.x() = _data[0]*o.x() + _data[1]*o.y() + _data[2]*o.z();
-  result.y() = _data[3]*o.x() + _data[4]*o.y() + _data[5]*o.z();  
-  result.z() = _data[6]*o.x() + _data[7]*o.y() + _data[8]*o.z();  
+  SIMD3::transpose_mult_vector(_data, o.data(), result.data());
   return result;
 }
 
@@ -128,22 +126,7 @@ ORIGIN3 MATRIX3::transpose_mult(const ORIGIN3& o) const
 MATRIX3 MATRIX3::transpose_mult(const MATRIX3& m) const
 {
   MATRIX3 result;
-
-  // do first column
-  result.xx() = _data[0]*m.xx() + _data[1]*m.yx() + _data[2]*m.zx();
-  result.yx() = _data[3]*m.xx() + _data[4]*m.yx() + _data[5]*m.zx();  
-  result.zx() = _data[6]*m.xx() + _data[7]*m.yx() + _data[8]*m.zx();  
-
-  // do second column
-  result.xy() = _data[0]*m.xy() + _data[1]*m.yy() + _data[2]*m.zy();
-  result.yy() = _data[3]*m.xy() + _data[4]*m.yy() + _data[5]*m.zy();  
-  result.zy() = _data[6]*m.xy() + _data[7]*m.yy() + _data[8]*m.zy();  
-
-  // do third column
-  result.xz() = _data[0]*m.xz() + _data[1]*m.yz() + _data[2]*m.zz();
-  result.yz() = _data[3]*m.xz() + _data[4]*m.yz() + _data[5]*m.zz();  
-  result.zz() = _data[6]*m.xz() + _data[7]*m.yz() + _data[8]*m.zz();  
-
+  SIMD3::transpose_mult(_data, m._data, result._data);
   return result;
 }
 
@@ -151,9 +134,7 @@ MATRIX3 MATRIX3::transpose_mult(const MATRIX3& m) const
 ORIGIN3 MATRIX3::mult(const ORIGIN3& o) const
 {
   ORIGIN3 result;
-  result.x() = _data[0]*o.x() + _data[3]*o.y() + _data[6]*o.z();
-  result.y() = _data[1]*o.x() + _data[4]*o.y() + _data[7]*o.z();  
-  result.z() = _data[2]*o.x() + _data[5]*o.y() + _data[8]*o.z();  
+  SIMD3::mult_vector(_data, o.data(), result.data());
   return result;
 }
 
@@ -161,22 +142,7 @@ ORIGIN3 MATRIX3::mult(const ORIGIN3& o) const
 MATRIX3 MATRIX3::mult(const MATRIX3& m) const
 {
   MATRIX3 result;
-
-  // setup first column
-  result.xx() = _data[0]*m.xx() + _data[3]*m.yx() + _data[6]*m.zx();
-  result.yx() = _data[1]*m.xx() + _data[4]*m.yx() + _data[7]*m.zx();  
-  result.zx() = _data[2]*m.xx() + _data[5]*m.yx() + _data[8]*m.zx();  
-
-  // setup second column
-  result.xy() = _data[0]*m.xy() + _data[3]*m.yy() + _data[6]*m.zy();
-  result.yy() = _data[1]*m.xy() + _data[4]*m.yy() + _data[7]*m.zy();  
-  result.zy() = _data[2]*m.xy() + _data[5]*m.yy() + _data[8]*m.zy();  
-
-  // setup third column
-  result.xz() = _data[0]*m.xz() + _data[3]*m.yz() + _data[6]*m.zz();
-  result.yz() = _data[1]*m.xz() + _data[4]*m.yz() + _data[7]*m.zz();  
-  result.zz() = _data[2]*m.xz() + _data[5]*m.yz() + _data[8]*m.zz();  
-
+  SIMD3::mult(_data, m._data, result._data);
   return result;
 } 
 
@@ -184,22 +150,7 @@ MATRIX3 MATRIX3::mult(const MATRIX3& m) const
 MATRIX3 MATRIX3::mult_transpose(const MATRIX3& m) const
 {
   MATRIX3 result;
-
-  // setup first column
-  result.xx() = _data[0]*m.xx() + _data[3]*m.xy() + _data[6]*m.xz();
-  result.yx() = _data[1]*m.xx() + _data[4]*m.xy() + _data[7]*m.xz();  
-  result.zx() = _data[2]*m.xx() + _data[5]*m.xy() + _data[8]*m.xz();  
-
-  // setup second column
-  result.xy() = _data[0]*m.yx() + _data[3]*m.yy() + _data[6]*m.yz();
-  result.yy() = _data[1]*m.yx() + _data[4]*m.yy() + _data[7]*m.yz();  
-  result.zy() = _data[2]*m.yx() + _data[5]*m.yy() + _data[8]*m.yz();  
-
-  // setup third column
-  result.xz() = _data[0]*m.zx() + _data[3]*m.zy() + _data[6]*m.zz();
-  result.yz() = _data[1]*m.zx() + _data[4]*m.zy() + _data[7]*m.zz();  
-  result.zz() = _data[2]*m.zx() + _data[5]*m.zy() + _data[8]*m.zz();  
-
+  SIMD3::mult_transpose(_data, m._data, result._data);
   return result;
 }
 
@@ -207,22 +158,7 @@ MATRIX3 MATRIX3::mult_transpose(const MATRIX3& m) const
 MATRIX3 MATRIX3::transpose_mult_transpose(const MATRIX3& m) const
 {
   MATRIX3 result;
-
-  // setup first column
-  result.xx() = _data[0]*m.xx() + _data[1]*m.xy() + _data[2]*m.xz();
-  result.yx() = _data[3]*m.xx() + _data[4]*m.xy() + _data[5]*m.xz();  
-  result.zx() = _data[6]*m.xx() + _data[7]*m.xy() + _data[8]*m.xz();  
-
-  // setup second column
-  result.xy() = _data[0]*m.yx() + _data[1]*m.yy() + _data[2]*m.yz();
-  result.yy() = _data[3]*m.yx() + _data[4]*m.yy() + _data[5]*m.yz();  
-  result.zy() = _data[6]*m.yx() + _data[7]*m.yy() + _data[8]*m.yz();  
-
-  // setup third column
-  result.xz() = _data[0]*m.zx() + _data[1]*m.zy() + _data[2]*m.zz();
-  result.yz() = _data[3]*m.zx() + _data[4]*m.zy() + _data[5]*m.zz();  
-  result.zz() = _data[6]*m.zx() + _data[7]*m.zy() + _data[8]*m.zz();  
-
+  SIMD3::transpose_mult_transpose(_data, m._data, result._data);
   return result;
 }
 
@@ -286,7 +222,15 @@ MATRIX3 MATRIX3::skew_symmetric(const ORIGIN3& v)
   return skew_symmetric(v.x(), v.y(), v.z());
 }
 
-/// Inverts this matrix 
+/// Computes skew_symmetric(o)*m without forming the skew symmetric matrix
+MATRIX3 MATRIX3::skew_symmetric_mult(const ORIGIN3& o, const MATRIX3& m)
+{
+  MATRIX3 result;
+  SIMD3::skew_symmetric_mult(o.data(), m._data, result._data);
+  return result;
+}
+
+/// Inverts this matrix
 MATRIX3& MATRIX3::invert()
 {
   *this = invert(*this);
@@ -17,6 +17,7 @@
 #include <Ravelin/Opsd.h>
 #include <Ravelin/MatrixNd.h>
 #include <Ravelin/Matrix3d.h>
+#include <Ravelin/SIMD3d.h>
 
 using namespace Ravelin;
 
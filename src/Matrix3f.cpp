@@ -17,6 +17,7 @@
 #include <Ravelin/AAnglef.h>
 #include <Ravelin/MatrixNf.h>
 #include <Ravelin/Matrix3f.h>
+#include <Ravelin/SIMD3f.h>
 
 using namespace Ravelin;
 
@@ -87,6 +87,85 @@ MATRIXN::MATRIXN(const MATRIXN& source)
   MATRIXN::operator=(source);
 }
 
+#if __cplusplus >= 201103L
+/// Move constructor
+/**
+ * Takes the storage of source (no data is copied); source becomes a 0x0 
+ * matrix. If the storage of source is not owned (e.g., source is a
+ * FIXEDMATRIXN), the elements are copied instead and source is left
+ * unchanged.
+ * \note not noexcept: copying the elements allocates memory
+ */
+MATRIXN::MATRIXN(MATRIXN&& source)
+{
+  _rows = source._rows;
+  _columns = source._columns;
+  if (source._data.is_owned())
+  {
+    _data = std::move(source._data);
+    source._rows = source._columns = 0;
+  }
+  else
+  {
+    _data.resize(_rows*_columns);
+    std::copy(source.data(), source.data()+_rows*_columns, data());
+  }
+}
+
+/// Move assignment operator
+/**
+ * Takes the storage of source (no data is copied); source becomes a 0x0 
+ * matrix. If the storage of either matrix is not owned (e.g., either is a
+ * FIXEDMATRIXN), the elements are copied instead and source is left
+ * unchanged.
+ * \note not noexcept: copying the elements may allocate memory
+ */
+MATRIXN& MATRIXN::operator=(MATRIXN&& source)
+{
+  if (this != &source)
+  {
+    _rows = source._rows;
+    _columns = source._columns;
+    if (source._data.is_owned() && _data.is_owned())
+    {
+      _data = std::move(source._data);
+      source._rows = source._columns = 0;
+    }
+    else
+    {
+      _data.resize(_rows*_columns);
+      std::copy(source.data(), source.data()+_rows*_columns, data());
+    }
+  }
+
+  return *this;
+}
+#endif
+
+/// Swaps the contents of this matrix with m
+/**
+ * Only the underlying storage is exchanged; no elements are copied, unless
+ * the storage of either matrix is not owned (e.g., either is a FIXEDMATRIXN),
+ * in which case the elements are copied through a temporary matrix (memory
+ * is allocated).
+ */
+MATRIXN& MATRIXN::swap(MATRIXN& m)
+{
+  if (_data.is_owned() && m._data.is_owned())
+  {
+    _data.swap(m._data);
+    std::swap(_rows, m._rows);
+    std::swap(_columns, m._columns);
+  }
+  else
+  {
+    MATRIXN tmp(m);
+    m = *this;
+    operator=(tmp);
+  }
+  return *this;
+}
+
 /// Copy constructor
 MATRIXN::MATRIXN(const SHAREDMATRIXN& source)
 {
@@ -0,0 +1,608 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+/// Constructs an empty matrix with the given storage type
+MUTABLESPARSEMATRIXN::MUTABLESPARSEMATRIXN(SPARSEMATRIXN::StorageType stype)
+{
+  _stype = stype;
+  set_zero(0, 0);
+}
+
+/// Constructs a m x n zero matrix with the given storage type
+MUTABLESPARSEMATRIXN::MUTABLESPARSEMATRIXN(SPARSEMATRIXN::StorageType stype, unsigned m, unsigned n)
+{
+  _stype = stype;
+  set_zero(m, n);
+}
+
+/// Constructs a matrix from a sparse matrix, using the same storage type
+/**
+ * \param m the sparse matrix
+ * \param slack the number of additional nonzeros to make room for in each
+ *        row (column, if CSC)
+ */
+MUTABLESPARSEMATRIXN::MUTABLESPARSEMATRIXN(const SPARSEMATRIXN& m, unsigned slack)
+{
+  set(m, slack);
+}
+
+/// Sets this matrix to a sparse matrix, using the same storage type
+/**
+ * \param m the sparse matrix
+ * \param slack the number of additional nonzeros to make room for in each
+ *        row (column, if CSC)
+ */
+MUTABLESPARSEMATRIXN& MUTABLESPARSEMATRIXN::set(const SPARSEMATRIXN& m, unsigned slack)
+{
+  _stype = m.get_storage_type();
+  _rows = m.rows();
+  _columns = m.columns();
+  _nnz = m.get_nnz();
+  _unused = 0;
+
+  // setup the rows (columns)
+  const unsigned N = num_lines();
+  const unsigned* ptr = m.get_ptr();
+  _start.resize(N);
+  _len.resize(N);
+  _cap.resize(N);
+  for (unsigned i=0, start=0; i< N; i++)
+  {
+    _start[i] = start;
+    _len[i] = ptr[i+1] - ptr[i];
+    _cap[i] = _len[i] + slack;
+    start += _cap[i];
+  }
+
+  // copy the nonzeros
+  const unsigned SZ = _nnz + N*slack;
+  _indices.resize(SZ);
+  _data.resize(SZ);
+  for (unsigned i=0; i< N; i++)
+  {
+    std::copy(m.get_indices()+ptr[i], m.get_indices()+ptr[i+1], _indices.begin()+_start[i]);
+    std::copy(m.get_data()+ptr[i], m.get_data()+ptr[i+1], _data.begin()+_start[i]);
+  }
+
+  return *this;
+}
+
+/// Sets this to a m x n zero matrix
+MUTABLESPARSEMATRIXN& MUTABLESPARSEMATRIXN::set_zero(unsigned m, unsigned n)
+{
+  _rows = m;
+  _columns = n;
+  _nnz = 0;
+  _unused = 0;
+  _start.assign(num_lines(), 0);
+  _len.assign(num_lines(), 0);
+  _cap.assign(num_lines(), 0);
+  _indices.clear();
+  _data.clear();
+
+  return *this;
+}
+
+/// Gets the nonzeros of a dense vector into _vindices and _vdata
+void MUTABLESPARSEMATRIXN::get_nonzeros(const VECTORN& v)
+{
+  _vindices.clear();
+  _vdata.clear();
+  for (unsigned i=0; i< v.size(); i++)
+    if (v[i] > EPS || v[i] < -EPS)
+    {
+      _vindices.push_back(i);
+      _vdata.push_back(v[i]);
+    }
+}
+
+/// Gets the nonzeros of a sparse vector into _vindices and _vdata
+void MUTABLESPARSEMATRIXN::get_nonzeros(const SPARSEVECTORN& v)
+{
+  _vindices.assign(v.get_indices(), v.get_indices()+v.num_elements());
+  _vdata.assign(v.get_data(), v.get_data()+v.num_elements());
+}
+
+/// Removes unused storage, keeping the capacity of each row (column)
+void MUTABLESPARSEMATRIXN::pack()
+{
+  const unsigned N = num_lines();
+  const unsigned SZ = std::accumulate(_cap.begin(), _cap.end(), 0U);
+  vector<unsigned> indices(SZ);
+  vector<REAL> data(SZ);
+  for (unsigned i=0, start=0; i< N; i++)
+  {
+    std::copy(_indices.begin()+_start[i], _indices.begin()+_start[i]+_len[i], indices.begin()+start);
+    std::copy(_data.begin()+_start[i], _data.begin()+_start[i]+_len[i], data.begin()+start);
+    _start[i] = start;
+    start += _cap[i];
+  }
+  _indices.swap(indices);
+  _data.swap(data);
+  _unused = 0;
+}
+
+/// Removes unused storage
+/**
+ * \param slack the number of additional nonzeros to make room for in each
+ *        row (column, if CSC)
+ */
+void MUTABLESPARSEMATRIXN::compact(unsigned slack)
+{
+  const unsigned N = num_lines();
+  for (unsigned i=0; i< N; i++)
+    _cap[i] = _len[i] + slack;
+  pack();
+}
+
+/// Makes room for (at least) len nonzeros in row (column) i
+void MUTABLESPARSEMATRIXN::reserve_line(unsigned i, unsigned len)
+{
+  if (_cap[i] >= len)
+    return;
+
+  // move the row (column) to the end of the storage, leaving room to grow
+  const unsigned CAP = std::max(len, _cap[i]*2);
+  const unsigned START = _indices.size();
+  _indices.resize(START + CAP);
+  _data.resize(START + CAP);
+  std::copy(_indices.begin()+_start[i], _indices.begin()+_start[i]+_len[i], _indices.begin()+START);
+  std::copy(_data.begin()+_start[i], _data.begin()+_start[i]+_len[i], _data.begin()+START);
+  _unused += _cap[i];
+  _start[i] = START;
+  _cap[i] = CAP;
+
+  // compact the storage once at least half of it is unused
+  if (_unused*2 >= _indices.size())
+    pack();
+}
+
+/// Replaces row (column, if CSC) i with the nonzeros in _vindices and _vdata
+void MUTABLESPARSEMATRIXN::set_line(unsigned i)
+{
+  const unsigned NNZ = _vindices.size();
+  reserve_line(i, NNZ);
+  std::copy(_vindices.begin(), _vindices.end(), _indices.begin()+_start[i]);
+  std::copy(_vdata.begin(), _vdata.end(), _data.begin()+_start[i]);
+  _nnz += NNZ;
+  _nnz -= _len[i];
+  _len[i] = NNZ;
+}
+
+/// Inserts row (column, if CSC) i with the nonzeros in _vindices and _vdata
+void MUTABLESPARSEMATRIXN::insert_line(unsigned i)
+{
+  _start.insert(_start.begin()+i, _indices.size());
+  _len.insert(_len.begin()+i, 0);
+  _cap.insert(_cap.begin()+i, 0);
+  set_line(i);
+}
+
+/// Removes row (column, if CSC) i
+void MUTABLESPARSEMATRIXN::remove_line(unsigned i)
+{
+  _nnz -= _len[i];
+  _unused += _cap[i];
+  _start.erase(_start.begin()+i);
+  _len.erase(_len.begin()+i);
+  _cap.erase(_cap.begin()+i);
+}
+
+/// Replaces column (row, if CSC) j with the nonzeros in _vindices and _vdata
+void MUTABLESPARSEMATRIXN::set_cross(unsigned j)
+{
+  const unsigned N = num_lines();
+  for (unsigned i=0, k=0; i< N; i++)
+  {
+    // find the nonzero in row (column) i
+    vector<unsigned>::iterator indices = _indices.begin() + _start[i];
+    const unsigned POS = std::lower_bound(indices, indices+_len[i], j) - indices;
+    const bool EXISTS = (POS < _len[i] && indices[POS] == j);
+    const bool NONZERO = (k < _vindices.size() && _vindices[k] == i);
+
+    if (NONZERO)
+    {
+      if (!EXISTS)
+      {
+        // make room for the new nonzero
+        reserve_line(i, _len[i]+1);
+        const unsigned START = _start[i];
+        std::copy_backward(_indices.begin()+START+POS, _indices.begin()+START+_len[i], _indices.begin()+START+_len[i]+1);
+        std::copy_backward(_data.begin()+START+POS, _data.begin()+START+_len[i], _data.begin()+START+_len[i]+1);
+        _indices[START+POS] = j;
+        _len[i]++;
+        _nnz++;
+      }
+      _data[_start[i]+POS] = _vdata[k++];
+    }
+    else if (EXISTS)
+    {
+      // remove the nonzero
+      const unsigned START = _start[i];
+      std::copy(_indices.begin()+START+POS+1, _indices.begin()+START+_len[i], _indices.begin()+START+POS);
+      std::copy(_data.begin()+START+POS+1, _data.begin()+START+_len[i], _data.begin()+START+POS);
+      _len[i]--;
+      _nnz--;
+    }
+  }
+}
+
+/// Inserts column (row, if CSC) j with the nonzeros in _vindices and _vdata
+void MUTABLESPARSEMATRIXN::insert_cross(unsigned j)
+{
+  const unsigned N = num_lines();
+  for (unsigned i=0, k=0; i< N; i++)
+  {
+    // shift the indices of the subsequent nonzeros in row (column) i
+    vector<unsigned>::iterator indices = _indices.begin() + _start[i];
+    const unsigned POS = std::lower_bound(indices, indices+_len[i], j) - indices;
+    for (unsigned m=POS; m< _len[i]; m++)
+      indices[m]++;
+
+    // insert the nonzero
+    if (k < _vindices.size() && _vindices[k] == i)
+    {
+      reserve_line(i, _len[i]+1);
+      const unsigned START = _start[i];
+      std::copy_backward(_indices.begin()+START+POS, _indices.begin()+START+_len[i], _indices.begin()+START+_len[i]+1);
+      std::copy_backward(_data.begin()+START+POS, _data.begin()+START+_len[i], _data.begin()+START+_len[i]+1);
+      _indices[START+POS] = j;
+      _data[START+POS] = _vdata[k++];
+      _len[i]++;
+      _nnz++;
+    }
+  }
+}
+
+/// Removes column (row, if CSC) j
+void MUTABLESPARSEMATRIXN::remove_cross(unsigned j)
+{
+  const unsigned N = num_lines();
+  for (unsigned i=0; i< N; i++)
+  {
+    // remove the nonzero from row (column) i
+    vector<unsigned>::iterator indices = _indices.begin() + _start[i];
+    vector<REAL>::iterator data = _data.begin() + _start[i];
+    unsigned pos = std::lower_bound(indices, indices+_len[i], j) - indices;
+    if (pos < _len[i] && indices[pos] == j)
+    {
+      std::copy(indices+pos+1, indices+_len[i], indices+pos);
+      std::copy(data+pos+1, data+_len[i], data+pos);
+      _len[i]--;
+      _nnz--;
+    }
+
+    // shift the indices of the subsequent nonzeros
+    for (; pos < _len[i]; pos++)
+      indices[pos]--;
+  }
+}
+
+/// Replaces row i
+void MUTABLESPARSEMATRIXN::set_row(unsigned i, const VECTORN& v)
+{
+  #ifndef NEXCEPT
+  if (i >= _rows)
+    throw InvalidIndexException();
+  if (v.size() != _columns)
+    throw MissizeException();
+  #endif
+
+  get_nonzeros(v);
+  if (_stype == SPARSEMATRIXN::eCSR)
+    set_line(i);
+  else
+    set_cross(i);
+}
+
+/// Replaces row i
+void MUTABLESPARSEMATRIXN::set_row(unsigned i, const SPARSEVECTORN& v)
+{
+  #ifndef NEXCEPT
+  if (i >= _rows)
+    throw InvalidIndexException();
+  if (v.size() != _columns)
+    throw MissizeException();
+  #endif
+
+  get_nonzeros(v);
+  if (_stype == SPARSEMATRIXN::eCSR)
+    set_line(i);
+  else
+    set_cross(i);
+}
+
+/// Replaces column i
+void MUTABLESPARSEMATRIXN::set_column(unsigned i, const VECTORN& v)
+{
+  #ifndef NEXCEPT
+  if (i >= _columns)
+    throw InvalidIndexException();
+  if (v.size() != _rows)
+    throw MissizeException();
+  #endif
+
+  get_nonzeros(v);
+  if (_stype == SPARSEMATRIXN::eCSC)
+    set_line(i);
+  else
+    set_cross(i);
+}
+
+/// Replaces column i
+void MUTABLESPARSEMATRIXN::set_column(unsigned i, const SPARSEVECTORN& v)
+{
+  #ifndef NEXCEPT
+  if (i >= _columns)
+    throw InvalidIndexException();
+  if (v.size() != _rows)
+    throw MissizeException();
+  #endif
+
+  get_nonzeros(v);
+  if (_stype == SPARSEMATRIXN::eCSC)
+    set_line(i);
+  else
+    set_cross(i);
+}
+
+/// Inserts a row before row i (or after the last row, if i = rows())
+void MUTABLESPARSEMATRIXN::insert_row(unsigned i, const VECTORN& v)
+{
+  #ifndef NEXCEPT
+  if (i > _rows)
+    throw InvalidIndexException();
+  if (v.size() != _columns)
+    throw MissizeException();
+  #endif
+
+  get_nonzeros(v);
+  if (_stype == SPARSEMATRIXN::eCSR)
+    insert_line(i);
+  else
+    insert_cross(i);
+  _rows++;
+}
+
+/// Inserts a row before row i (or after the last row, if i = rows())
+void MUTABLESPARSEMATRIXN::insert_row(unsigned i, const SPARSEVECTORN& v)
+{
+  #ifndef NEXCEPT
+  if (i > _rows)
+    throw InvalidIndexException();
+  if (v.size() != _columns)
+    throw MissizeException();
+  #endif
+
+  get_nonzeros(v);
+  if (_stype == SPARSEMATRIXN::eCSR)
+    insert_line(i);
+  else
+    insert_cross(i);
+  _rows++;
+}
+
+/// Inserts a column before column i (or after the last column, if i = columns())
+void MUTABLESPARSEMATRIXN::insert_column(unsigned i, const VECTORN& v)
+{
+  #ifndef NEXCEPT
+  if (i > _columns)
+    throw InvalidIndexException();
+  if (v.size() != _rows)
+    throw MissizeException();
+  #endif
+
+  get_nonzeros(v);
+  if (_stype == SPARSEMATRIXN::eCSC)
+    insert_line(i);
+  else
+    insert_cross(i);
+  _columns++;
+}
+
+/// Inserts a column before column i (or after the last column, if i = columns())
+void MUTABLESPARSEMATRIXN::insert_column(unsigned i, const SPARSEVECTORN& v)
+{
+  #ifndef NEXCEPT
+  if (i > _columns)
+    throw InvalidIndexException();
+  if (v.size() != _rows)
+    throw MissizeException();
+  #endif
+
+  get_nonzeros(v);
+  if (_stype == SPARSEMATRIXN::eCSC)
+    insert_line(i);
+  else
+    insert_cross(i);
+  _columns++;
+}
+
+/// Removes row i
+void MUTABLESPARSEMATRIXN::remove_row(unsigned i)
+{
+  #ifndef NEXCEPT
+  if (i >= _rows)
+    throw InvalidIndexException();
+  #endif
+
+  if (_stype == SPARSEMATRIXN::eCSR)
+    remove_line(i);
+  else
+    remove_cross(i);
+  _rows--;
+}
+
+/// Removes column i
+void MUTABLESPARSEMATRIXN::remove_column(unsigned i)
+{
+  #ifndef NEXCEPT
+  if (i >= _columns)
+    throw InvalidIndexException();
+  #endif
+
+  if (_stype == SPARSEMATRIXN::eCSC)
+    remove_line(i);
+  else
+    remove_cross(i);
+  _columns--;
+}
+
+/// Gets row i as a dense vector
+VECTORN& MUTABLESPARSEMATRIXN::get_row(unsigned i, VECTORN& row) const
+{
+  #ifndef NEXCEPT
+  if (i >= _rows)
+    throw InvalidIndexException();
+  #endif
+
+  row.set_zero(_columns);
+  if (_stype == SPARSEMATRIXN::eCSR)
+  {
+    for (unsigned k=_start[i]; k< _start[i]+_len[i]; k++)
+      row[_indices[k]] = _data[k];
+  }
+  else
+  {
+    for (unsigned j=0; j< _columns; j++)
+    {
+      vector<unsigned>::const_iterator indices = _indices.begin() + _start[j];
+      vector<unsigned>::const_iterator pos = std::lower_bound(indices, indices+_len[j], i);
+      if (pos != indices+_len[j] && *pos == i)
+        row[j] = _data[_start[j] + (pos - indices)];
+    }
+  }
+
+  return row;
+}
+
+/// Gets column i as a dense vector
+VECTORN& MUTABLESPARSEMATRIXN::get_column(unsigned i, VECTORN& column) const
+{
+  #ifndef NEXCEPT
+  if (i >= _columns)
+    throw InvalidIndexException();
+  #endif
+
+  column.set_zero(_rows);
+  if (_stype == SPARSEMATRIXN::eCSC)
+  {
+    for (unsigned k=_start[i]; k< _start[i]+_len[i]; k++)
+      column[_indices[k]] = _data[k];
+  }
+  else
+  {
+    for (unsigned j=0; j< _rows; j++)
+    {
+      vector<unsigned>::const_iterator indices = _indices.begin() + _start[j];
+      vector<unsigned>::const_iterator pos = std::lower_bound(indices, indices+_len[j], i);
+      if (pos != indices+_len[j] && *pos == i)
+        column[j] = _data[_start[j] + (pos - indices)];
+    }
+  }
+
+  return column;
+}
+
+/// Multiplies this matrix by a vector
+VECTORN& MUTABLESPARSEMATRIXN::mult(const VECTORN& x, VECTORN& result) const
+{
+  #ifndef NEXCEPT
+  if (x.size() != _columns)
+    throw MissizeException();
+  #endif
+
+  result.set_zero(_rows);
+  if (_stype == SPARSEMATRIXN::eCSR)
+  {
+    for (unsigned i=0; i< _rows; i++)
+    {
+      REAL dot = (REAL) 0.0;
+      for (unsigned k=_start[i]; k< _start[i]+_len[i]; k++)
+        dot += _data[k] * x[_indices[k]];
+      result[i] = dot;
+    }
+  }
+  else
+  {
+    for (unsigned j=0; j< _columns; j++)
+      for (unsigned k=_start[j]; k< _start[j]+_len[j]; k++)
+        result[_indices[k]] += _data[k] * x[j];
+  }
+
+  return result;
+}
+
+/// Multiplies the transpose of this matrix by a vector
+VECTORN& MUTABLESPARSEMATRIXN::transpose_mult(const VECTORN& x, VECTORN& result) const
+{
+  #ifndef NEXCEPT
+  if (x.size() != _rows)
+    throw MissizeException();
+  #endif
+
+  result.set_zero(_columns);
+  if (_stype == SPARSEMATRIXN::eCSC)
+  {
+    for (unsigned j=0; j< _columns; j++)
+    {
+      REAL dot = (REAL) 0.0;
+      for (unsigned k=_start[j]; k< _start[j]+_len[j]; k++)
+        dot += _data[k] * x[_indices[k]];
+      result[j] = dot;
+    }
+  }
+  else
+  {
+    for (unsigned i=0; i< _rows; i++)
+      for (unsigned k=_start[i]; k< _start[i]+_len[i]; k++)
+        result[_indices[k]] += _data[k] * x[i];
+  }
+
+  return result;
+}
+
+/// Compacts this matrix into a sparse matrix with the same storage type
+SPARSEMATRIXN& MUTABLESPARSEMATRIXN::to_sparse(SPARSEMATRIXN& m) const
+{
+  const unsigned N = num_lines();
+  shared_array<unsigned> ptr(new unsigned[N+1]);
+  shared_array<unsigned> indices(new unsigned[_nnz]);
+  shared_array<REAL> data(new REAL[_nnz]);
+
+  // copy the rows (columns)
+  ptr[0] = 0;
+  for (unsigned i=0; i< N; i++)
+  {
+    std::copy(_indices.begin()+_start[i], _indices.begin()+_start[i]+_len[i], indices.get()+ptr[i]);
+    std::copy(_data.begin()+_start[i], _data.begin()+_start[i]+_len[i], data.get()+ptr[i]);
+    ptr[i+1] = ptr[i] + _len[i];
+  }
+
+  m = SPARSEMATRIXN(_stype, _rows, _columns, ptr, indices, data);
+  return m;
+}
+
+/// Gets this matrix as a dense matrix
+MATRIXN& MUTABLESPARSEMATRIXN::to_dense(MATRIXN& m) const
+{
+  m.set_zero(_rows, _columns);
+  if (_stype == SPARSEMATRIXN::eCSR)
+  {
+    for (unsigned i=0; i< _rows; i++)
+      for (unsigned k=_start[i]; k< _start[i]+_len[i]; k++)
+        m(i, _indices[k]) = _data[k];
+  }
+  else
+  {
+    for (unsigned j=0; j< _columns; j++)
+      for (unsigned k=_start[j]; k< _start[j]+_len[j]; k++)
+        m(_indices[k], j) = _data[k];
+  }
+
+  return m;
+}
+
@@ -0,0 +1,21 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#include <numeric>
+#include <algorithm>
+#include <Ravelin/Constants.h>
+#include <Ravelin/MissizeException.h>
+#include <Ravelin/InvalidIndexException.h>
+#include <Ravelin/MutableSparseMatrixNf.h>
+
+using boost::shared_array;
+using std::vector;
+using namespace Ravelin;
+
+#include <Ravelin/fdefs.h>
+#include "MutableSparseMatrixN.cpp"
+#include <Ravelin/undefs.h>
+
@@ -0,0 +1,438 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+using std::vector;
+
+/// Constructs a planar articulated body with no links
+PLANAR_ARTICULATED_BODY::PLANAR_ARTICULATED_BODY()
+{
+  _ndof = 0;
+  gravity = ORIGIN2((REAL) 0.0, (REAL) -9.81);
+}
+
+/// Adds a link to the body
+/**
+ * \param parent the index of the parent link (-1 to connect the link to the
+ *        world frame); the parent must already have been added
+ * \param type the type of joint connecting the link to its parent
+ * \param placement the pose of the joint frame relative to the parent link
+ *        frame (or to the world frame): placement.x is its origin and
+ *        placement.r.theta is its counter-clockwise rotation. The link frame
+ *        coincides with the joint frame when the joint position is zero.
+ * \param mass the mass of the link
+ * \param com the center-of-mass of the link (in the link frame)
+ * \param inertia the moment of inertia of the link about its center-of-mass
+ * \param axis the direction of motion of a prismatic joint (in the joint
+ *        frame); the direction is normalized
+ * \return the index of the link
+ */
+unsigned PLANAR_ARTICULATED_BODY::add_link(int parent, JointType type, const POSE2& placement, REAL mass, const ORIGIN2& com, REAL inertia, const ORIGIN2& axis)
+{
+  #ifndef NEXCEPT
+  if (parent < -1 || parent >= (int) _parent.size())
+    throw std::runtime_error("PLANAR_ARTICULATED_BODY::add_link() - parent link has not been added");
+  if (type == ePrismatic && axis.norm() < EPS)
+    throw std::runtime_error("PLANAR_ARTICULATED_BODY::add_link() - prismatic joint axis is zero");
+  #endif
+
+  const unsigned IDX = _parent.size();
+
+  // set the joint
+  _parent.push_back(parent);
+  _type.push_back(type);
+  _coord.push_back(_ndof);
+  _nq.push_back((type == ePlanar) ? 3 : 1);
+  _ndof += _nq.back();
+  _placement.push_back(placement);
+  _placement.back().rpose.reset();
+  _Xtree.push_back(calc_transform(placement.r.theta, placement.x.x(), placement.x.y()));
+  _axis.push_back((type == ePrismatic) ? axis/axis.norm() : axis);
+
+  // set the spatial inertia about the link frame origin:
+  // [ J + m*c'*c   -m*cy   m*cx ]
+  // [   -m*cy        m       0  ]
+  // [    m*cx        0       m  ]
+  const REAL CX = com.x(), CY = com.y();
+  _I.push_back(MATRIX3(inertia + mass*(CX*CX + CY*CY), -mass*CY, mass*CX,
+                       -mass*CY, mass, (REAL) 0.0,
+                       mass*CX, (REAL) 0.0, mass));
+
+  // resize temporaries
+  _Xup.resize(IDX+1);
+  _S.resize(IDX+1);
+  _cJ.resize(IDX+1);
+  _vJ.resize(IDX+1);
+  _v.resize(IDX+1);
+  _a.resize(IDX+1);
+  _c.resize(IDX+1);
+  _f.resize(IDX+1);
+  _pA.resize(IDX+1);
+  _IA.resize(IDX+1);
+  _U.resize(IDX+1);
+  _Dinv.resize(IDX+1);
+  _u.resize(IDX+1);
+
+  // the motion subspace of revolute and prismatic joints is constant
+  _S[IDX].set_zero();
+  if (type == eRevolute)
+    _S[IDX](0,0) = (REAL) 1.0;
+  else if (type == ePrismatic)
+  {
+    _S[IDX](1,0) = _axis[IDX].x();
+    _S[IDX](2,0) = _axis[IDX].y();
+  }
+
+  return IDX;
+}
+
+/// Gets the planar spatial transform (for motions) from a frame to a frame located at (x,y) and rotated by theta relative to it
+/**
+ * Forces are transformed in the opposite direction by the transpose.
+ */
+MATRIX3 PLANAR_ARTICULATED_BODY::calc_transform(REAL theta, REAL x, REAL y)
+{
+  const REAL C = std::cos(theta), S = std::sin(theta);
+  return MATRIX3((REAL) 1.0, (REAL) 0.0, (REAL) 0.0,
+                 S*x - C*y, C, S,
+                 C*x + S*y, -S, C);
+}
+
+/// Computes the planar spatial cross product of a velocity and a motion vector
+ORIGIN3 PLANAR_ARTICULATED_BODY::cross_motion(const ORIGIN3& v, const ORIGIN3& m)
+{
+  return ORIGIN3((REAL) 0.0, v[2]*m[0] - v[0]*m[2], v[0]*m[1] - v[1]*m[0]);
+}
+
+/// Computes the planar spatial cross product of a velocity and a force vector
+ORIGIN3 PLANAR_ARTICULATED_BODY::cross_force(const ORIGIN3& v, const ORIGIN3& f)
+{
+  return ORIGIN3(v[1]*f[2] - v[2]*f[1], -v[0]*f[2], v[0]*f[1]);
+}
+
+/// Transforms an inertia from a link frame to its parent frame (X'*I*X)
+MATRIX3 PLANAR_ARTICULATED_BODY::transform_inertia(const MATRIX3& X, const MATRIX3& I)
+{
+  return X.transpose_mult(I.mult(X));
+}
+
+/// Computes the transforms to each link from its parent and the joint motion subspaces
+void PLANAR_ARTICULATED_BODY::calc_joint_kinematics(const VECTORN& q)
+{
+  #ifndef NEXCEPT
+  if (q.size() != _ndof)
+    throw MissizeException();
+  #endif
+
+  for (unsigned i=0; i< _parent.size(); i++)
+  {
+    const unsigned CIDX = _coord[i];
+    switch (_type[i])
+    {
+      case eRevolute:
+        _Xup[i] = calc_transform(q[CIDX], (REAL) 0.0, (REAL) 0.0).mult(_Xtree[i]);
+        break;
+
+      case ePrismatic:
+        _Xup[i] = calc_transform((REAL) 0.0, q[CIDX]*_axis[i].x(), q[CIDX]*_axis[i].y()).mult(_Xtree[i]);
+        break;
+
+      case ePlanar:
+      {
+        // the translation is expressed in the joint frame, so the motion
+        // subspace (in the link frame) depends on the rotation
+        const REAL C = std::cos(q[CIDX+2]), S = std::sin(q[CIDX+2]);
+        _Xup[i] = calc_transform(q[CIDX+2], q[CIDX], q[CIDX+1]).mult(_Xtree[i]);
+        _S[i] = MATRIX3((REAL) 0.0, (REAL) 0.0, (REAL) 1.0,
+                        C, S, (REAL) 0.0,
+                        -S, C, (REAL) 0.0);
+        break;
+      }
+    }
+  }
+}
+
+/// Computes the velocity across the joint of a link and its velocity product acceleration
+void PLANAR_ARTICULATED_BODY::calc_joint_velocity(unsigned i, const VECTORN& qd)
+{
+  const unsigned CIDX = _coord[i];
+  if (_nq[i] == 1)
+  {
+    _vJ[i] = _S[i].get_column(0)*qd[CIDX];
+    _cJ[i] = ORIGIN3::zero();
+  }
+  else
+  {
+    const MATRIX3& S = _S[i];
+    _vJ[i] = S.mult(ORIGIN3(qd[CIDX], qd[CIDX+1], qd[CIDX+2]));
+
+    // derivative of the motion subspace (w.r.t. the rotation) times qd
+    const REAL THD = qd[CIDX+2];
+    _cJ[i] = ORIGIN3((REAL) 0.0, THD*(S(2,0)*qd[CIDX] + S(2,1)*qd[CIDX+1]), -THD*(S(1,0)*qd[CIDX] + S(1,1)*qd[CIDX+1]));
+  }
+}
+
+/// Computes the joint forces necessary to realize the given accelerations (recursive Newton-Euler algorithm)
+/**
+ * \param q the generalized coordinates
+ * \param qd the generalized velocities
+ * \param qdd the generalized accelerations
+ * \param tau the generalized forces (on return)
+ * \return a reference to tau
+ */
+VECTORN& PLANAR_ARTICULATED_BODY::calc_inverse_dynamics(const VECTORN& q, const VECTORN& qd, const VECTORN& qdd, VECTORN& tau)
+{
+  #ifndef NEXCEPT
+  if (qd.size() != _ndof || qdd.size() != _ndof)
+    throw MissizeException();
+  #endif
+
+  // gravity is treated as an acceleration of the world frame
+  const ORIGIN3 A0((REAL) 0.0, -gravity.x(), -gravity.y());
+
+  // compute link velocities and accelerations and the net force on each link
+  calc_joint_kinematics(q);
+  for (unsigned i=0; i< _parent.size(); i++)
+  {
+    const int P = _parent[i];
+    const unsigned CIDX = _coord[i];
+    calc_joint_velocity(i, qd);
+
+    ORIGIN3 aJ = _cJ[i];
+    for (unsigned j=0; j< _nq[i]; j++)
+      aJ += _S[i].get_column(j)*qdd[CIDX+j];
+
+    if (P < 0)
+    {
+      _v[i] = _vJ[i];
+      _a[i] = _Xup[i].mult(A0) + aJ;
+    }
+    else
+    {
+      _v[i] = _Xup[i].mult(_v[P]) + _vJ[i];
+      _a[i] = _Xup[i].mult(_a[P]) + aJ + cross_motion(_v[i], _vJ[i]);
+    }
+    _f[i] = _I[i].mult(_a[i]) + cross_force(_v[i], _I[i].mult(_v[i]));
+  }
+
+  // project forces onto the joints, accumulating them toward the roots
+  tau.resize(_ndof);
+  for (unsigned i=_parent.size(); i-- > 0; )
+  {
+    const int P = _parent[i];
+    const unsigned CIDX = _coord[i];
+    for (unsigned j=0; j< _nq[i]; j++)
+      tau[CIDX+j] = _S[i].get_column(j).dot(_f[i]);
+    if (P >= 0)
+      _f[P] += _Xup[i].transpose_mult(_f[i]);
+  }
+
+  return tau;
+}
+
+/// Computes the joint space inertia matrix (composite rigid body algorithm)
+/**
+ * \param q the generalized coordinates
+ * \param H the joint space inertia matrix (on return)
+ * \return a reference to H
+ */
+MATRIXN& PLANAR_ARTICULATED_BODY::calc_joint_space_inertia(const VECTORN& q, MATRIXN& H)
+{
+  // compute the composite inertias
+  calc_joint_kinematics(q);
+  for (unsigned i=0; i< _parent.size(); i++)
+    _IA[i] = _I[i];
+  for (unsigned i=_parent.size(); i-- > 0; )
+    if (_parent[i] >= 0)
+      _IA[_parent[i]] += transform_inertia(_Xup[i], _IA[i]);
+
+  // compute the entries of H
+  H.set_zero(_ndof, _ndof);
+  for (unsigned i=0; i< _parent.size(); i++)
+  {
+    const unsigned CIDX = _coord[i];
+    for (unsigned k=0; k< _nq[i]; k++)
+    {
+      ORIGIN3 F = _IA[i].mult(_S[i].get_column(k));
+      for (unsigned l=0; l< _nq[i]; l++)
+        H(CIDX+l, CIDX+k) = _S[i].get_column(l).dot(F);
+
+      // move up the tree
+      for (unsigned j=i; _parent[j] >= 0; )
+      {
+        F = _Xup[j].transpose_mult(F);
+        j = _parent[j];
+        const unsigned CJDX = _coord[j];
+        for (unsigned l=0; l< _nq[j]; l++)
+          H(CJDX+l, CIDX+k) = H(CIDX+k, CJDX+l) = _S[j].get_column(l).dot(F);
+      }
+    }
+  }
+
+  return H;
+}
+
+/// Computes the generalized accelerations resulting from the given joint forces (articulated body algorithm)
+/**
+ * \param q the generalized coordinates
+ * \param qd the generalized velocities
+ * \param tau the generalized forces
+ * \param qdd the generalized accelerations (on return)
+ * \return a reference to qdd
+ */
+VECTORN& PLANAR_ARTICULATED_BODY::calc_fwd_dyn(const VECTORN& q, const VECTORN& qd, const VECTORN& tau, VECTORN& qdd)
+{
+  #ifndef NEXCEPT
+  if (qd.size() != _ndof || tau.size() != _ndof)
+    throw MissizeException();
+  #endif
+
+  // gravity is treated as an acceleration of the world frame
+  const ORIGIN3 A0((REAL) 0.0, -gravity.x(), -gravity.y());
+
+  // compute link velocities, velocity product accelerations, and bias forces
+  calc_joint_kinematics(q);
+  for (unsigned i=0; i< _parent.size(); i++)
+  {
+    const int P = _parent[i];
+    calc_joint_velocity(i, qd);
+    _v[i] = (P < 0) ? _vJ[i] : _Xup[i].mult(_v[P]) + _vJ[i];
+    _c[i] = _cJ[i] + cross_motion(_v[i], _vJ[i]);
+    _IA[i] = _I[i];
+    _pA[i] = cross_force(_v[i], _I[i].mult(_v[i]));
+  }
+
+  // compute articulated body inertias and bias forces
+  MATRIX3 Ia;
+  for (unsigned i=_parent.size(); i-- > 0; )
+  {
+    const int P = _parent[i];
+    const unsigned CIDX = _coord[i];
+    ORIGIN3 pa;
+    if (_nq[i] == 1)
+    {
+      // U = IA*s, D = s'*U, u = tau - s'*pA
+      const ORIGIN3 S = _S[i].get_column(0);
+      const ORIGIN3 U = _IA[i].mult(S);
+      const REAL DINV = (REAL) 1.0/S.dot(U);
+      const REAL u = tau[CIDX] - S.dot(_pA[i]);
+      _U[i].set_column(0, U);
+      _Dinv[i](0,0) = DINV;
+      _u[i][0] = u;
+      if (P < 0)
+        continue;
+
+      // Ia = IA - U*U'/D, pa = pA + Ia*c + U*u/D
+      Ia = _IA[i];
+      for (unsigned r=0; r< 3; r++)
+        for (unsigned s=0; s< 3; s++)
+          Ia(r,s) -= U[r]*U[s]*DINV;
+      pa = _pA[i] + Ia.mult(_c[i]) + U*(u*DINV);
+    }
+    else
+    {
+      // U = IA*S, D = S'*U, u = tau - S'*pA
+      _U[i] = _IA[i].mult(_S[i]);
+      _Dinv[i] = MATRIX3::invert(_S[i].transpose_mult(_U[i]));
+      _u[i] = ORIGIN3(tau[CIDX], tau[CIDX+1], tau[CIDX+2]) - _S[i].transpose_mult(_pA[i]);
+      if (P < 0)
+        continue;
+
+      // Ia = IA - U*inv(D)*U', pa = pA + Ia*c + U*inv(D)*u
+      Ia = _IA[i] - _U[i].mult(_Dinv[i].mult_transpose(_U[i]));
+      pa = _pA[i] + Ia.mult(_c[i]) + _U[i].mult(_Dinv[i].mult(_u[i]));
+    }
+
+    // accumulate into the parent
+    _IA[P] += transform_inertia(_Xup[i], Ia);
+    _pA[P] += _Xup[i].transpose_mult(pa);
+  }
+
+  // compute accelerations
+  qdd.resize(_ndof);
+  for (unsigned i=0; i< _parent.size(); i++)
+  {
+    const int P = _parent[i];
+    const unsigned CIDX = _coord[i];
+    ORIGIN3 a = _Xup[i].mult((P < 0) ? A0 : _a[P]) + _c[i];
+    if (_nq[i] == 1)
+    {
+      const ORIGIN3 U = _U[i].get_column(0);
+      qdd[CIDX] = _Dinv[i](0,0)*(_u[i][0] - U.dot(a));
+      _a[i] = a + _S[i].get_column(0)*qdd[CIDX];
+    }
+    else
+    {
+      ORIGIN3 qdd_i = _Dinv[i].mult(_u[i] - _U[i].transpose_mult(a));
+      qdd[CIDX] = qdd_i[0];
+      qdd[CIDX+1] = qdd_i[1];
+      qdd[CIDX+2] = qdd_i[2];
+      _a[i] = a + _S[i].mult(qdd_i);
+    }
+  }
+
+  return qdd;
+}
+
+/// Computes the poses of the link frames relative to the world frame
+/**
+ * \param q the generalized coordinates
+ * \param poses the poses of the links (on return); the orientation of each
+ *        pose (r.theta) is its counter-clockwise rotation
+ * \return a reference to poses
+ */
+vector<POSE2>& PLANAR_ARTICULATED_BODY::calc_link_poses(const VECTORN& q, vector<POSE2>& poses)
+{
+  #ifndef NEXCEPT
+  if (q.size() != _ndof)
+    throw MissizeException();
+  #endif
+
+  poses.resize(_parent.size());
+  for (unsigned i=0; i< _parent.size(); i++)
+  {
+    const POSE2& P0 = _placement[i];
+    const unsigned CIDX = _coord[i];
+
+    // get the pose of the link relative to its parent
+    REAL theta = P0.r.theta, x = P0.x.x(), y = P0.x.y(), dx = (REAL) 0.0, dy = (REAL) 0.0;
+    if (_type[i] == eRevolute)
+      theta += q[CIDX];
+    else if (_type[i] == ePrismatic)
+    {
+      dx = q[CIDX]*_axis[i].x();
+      dy = q[CIDX]*_axis[i].y();
+    }
+    else
+    {
+      dx = q[CIDX];
+      dy = q[CIDX+1];
+      theta += q[CIDX+2];
+    }
+    REAL C = std::cos(P0.r.theta), S = std::sin(P0.r.theta);
+    x += C*dx - S*dy;
+    y += S*dx + C*dy;
+
+    // compose with the pose of the parent
+    if (_parent[i] >= 0)
+    {
+      const POSE2& PP = poses[_parent[i]];
+      C = std::cos(PP.r.theta);
+      S = std::sin(PP.r.theta);
+      REAL xw = PP.x.x() + C*x - S*y;
+      REAL yw = PP.x.y() + S*x + C*y;
+      x = xw;
+      y = yw;
+      theta += PP.r.theta;
+    }
+
+    poses[i].rpose.reset();
+    poses[i].r.theta = theta;
+    poses[i].x = ORIGIN2(x, y);
+  }
+
+  return poses;
+}
+
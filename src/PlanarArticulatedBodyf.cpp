@@ -0,0 +1,17 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#include <cmath>
+#include <stdexcept>
+#include <Ravelin/MissizeException.h>
+#include <Ravelin/PlanarArticulatedBodyf.h>
+
+using namespace Ravelin;
+
+#include <Ravelin/fdefs.h>
+#include "PlanarArticulatedBody.cpp"
+#include <Ravelin/undefs.h>
+
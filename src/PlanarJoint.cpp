@@ -27,10 +27,28 @@ PLANARJOINT::PLANARJOINT() : JOINT()
   }
 }
 
+/// Makes a copy of this joint that uses the given frames (see JOINT::clone())
+shared_ptr<JOINT> PLANARJOINT::clone(const PoseMap& poses) const
+{
+  shared_ptr<PLANARJOINT> joint(new PLANARJOINT(*this));
+
+  // point the frames and axes of the copy to the copied frames
+  joint->remap_poses(poses);
+  remap(joint->_vi.pose, poses);
+  remap(joint->_vj.pose, poses);
+  remap(joint->_normal.pose, poses);
+  remap(joint->_tan1.pose, poses);
+  remap(joint->_tan2.pose, poses);
+  remap(joint->_s_dot, poses);
+
+  return joint;
+}
+
 /// Sets the normal vector to the plane
 void PLANARJOINT::set_normal(const VECTOR3& normal)
 {
   _normal = normal;
+  _geometry_version++;
   update_spatial_axes();
 }
 
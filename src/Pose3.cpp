@@ -366,22 +366,10 @@ std::vector<SFORCE>& POSE3::transform(boost::shared_ptr<const POSE3> target, con
   if (source == target)
     return (result = w);
 
-  // compute the relative transform
+  // compute the relative transform and apply it to all vectors at once; the
+  // transform sets up E and r only once
   TRANSFORM3 Tx = calc_transform(source, target);
-
-  // setup r and E
-  VECTOR3 r;
-  MATRIX3 E;
-  get_r_E(Tx, r, E);
-
-  // resize the result vector
-  result.resize(w.size());
-
-  // look over all forcees
-  for (unsigned i=0; i< w.size(); i++)
-    transform_spatial(target, w[i], r, E, result[i]);
-
-  return result;
+  return Tx.transform(w, result);
 }
 
 /// transforms a spatial vector using precomputation
@@ -528,37 +516,10 @@ std::vector<SACCEL>& POSE3::transform(boost::shared_ptr<const POSE3> target, con
   if (source == target)
     return (result = t);
 
-  // compute the relative transform
+  // compute the relative transform and apply it to all vectors at once; the
+  // transform sets up E and r only once
   TRANSFORM3 Tx = calc_transform(source, target);
-
-  // setup r and E
-  VECTOR3 r;
-  MATRIX3 E;
-  get_r_E(Tx, r, E);
-
-  // the spatial transformation is:
-  // | E    0 |
-  // | Erx' E |
-
-  // resize the result vector
-  result.resize(t.size());
-
-  // transform 
-  for (unsigned i=0; i< t.size(); i++)
-  {
-    // get the components of t[i]
-    VECTOR3 ttop = t[i].get_upper();
-    VECTOR3 tbottom = t[i].get_lower();
-
-    // do the calculations
-    VECTOR3 Etop(E * ORIGIN3(ttop), target);
-    VECTOR3 cross = VECTOR3::cross(r, ttop);
-    result[i].set_upper(Etop);
-    result[i].set_lower(VECTOR3(E * ORIGIN3(tbottom - cross), target));
-    result[i].pose = target;
-  }
-
-  return result;
+  return Tx.transform(t, result);
 }
 
 /// Transforms a velocity from one pose to another 
@@ -614,22 +575,10 @@ std::vector<SVELOCITY>& POSE3::transform(boost::shared_ptr<const POSE3> target,
   if (source == target)
     return (result = t);
 
-  // compute the relative transform
+  // compute the relative transform and apply it to all vectors at once; the
+  // transform sets up E and r only once
   TRANSFORM3 Tx = calc_transform(source, target);
-
-  // setup r and E
-  VECTOR3 r;
-  MATRIX3 E;
-  get_r_E(Tx, r, E);
-
-  // resize the result vector
-  result.resize(t.size());
-
-  // transform the individual vectors 
-  for (unsigned i=0; i< t.size(); i++)
-    transform_spatial(target, t[i], r, E, result[i]);
-
-  return result;
+  return Tx.transform(t, result);
 }
 
 /// Transforms a momentum from one pose to another 
@@ -685,22 +634,10 @@ std::vector<SMOMENTUM>& POSE3::transform(boost::shared_ptr<const POSE3> target,
       throw FrameException();
   #endif
 
-  // compute the relative transform
+  // compute the relative transform and apply it to all vectors at once; the
+  // transform sets up E and r only once
   TRANSFORM3 Tx = calc_transform(source, target);
-
-  // setup r and E
-  VECTOR3 r;
-  MATRIX3 E;
-  get_r_E(Tx, r, E);
-
-  // resize the result vector
-  result.resize(t.size());
-
-  // transform all momenta 
-  for (unsigned i=0; i< t.size(); i++)
-    transform_spatial(target, t[i], r, E, result[i]);
-
-  return result;
+  return Tx.transform(t, result);
 }
 
 /// Transforms a rigid body inertia from one pose to another 
@@ -760,8 +697,8 @@ void POSE3::get_r_E(const TRANSFORM3& T, VECTOR3& r, MATRIX3& E)
 
   // note that x is translation from relative pose to this pose
   // q is rotation from vectors in this pose to relative pose 
-  E = T.q;
-  r = VECTOR3(E.transpose_mult(-T.x), T.source);
+  E = T.get_rotation();
+  r = VECTOR3(T.get_r(), T.source);
 }
 
 /// Gets r and E from the current pose only
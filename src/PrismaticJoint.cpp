@@ -31,6 +31,24 @@ PRISMATICJOINT::PRISMATICJOINT() : JOINT()
   _s_dot.clear();
 }
 
+/// Makes a copy of this joint that uses the given frames (see JOINT::clone())
+shared_ptr<JOINT> PRISMATICJOINT::clone(const PoseMap& poses) const
+{
+  shared_ptr<PRISMATICJOINT> joint(new PRISMATICJOINT(*this));
+
+  // point the frames and axes of the copy to the copied frames
+  joint->remap_poses(poses);
+  remap(joint->_u.pose, poses);
+  remap(joint->_ui.pose, poses);
+  remap(joint->_uj.pose, poses);
+  remap(joint->_v1i.pose, poses);
+  remap(joint->_v1j.pose, poses);
+  remap(joint->_v2.pose, poses);
+  remap(joint->_s_dot, poses);
+
+  return joint;
+}
+
 /// Sets the axis of translation for this joint (MUST BE CALLED AFTER set_location(.))
 /**
  * The local axis for this joint does not take the orientation of the 
@@ -51,6 +69,7 @@ void PRISMATICJOINT::set_axis(const VECTOR3& axis)
 
   // transform axis to joint frame
   _u = POSE3::transform_vector(get_pose(), naxis);
+  _geometry_version++;
 
   // setup v1i and v1j 
   VECTOR3::determine_orthonormal_basis(_u, _v1i, _v1j);
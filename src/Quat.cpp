@@ -541,14 +541,11 @@ QUAT QUAT::operator/(const QUAT& q) const
 /// Multiplies <b>this</b> by q and returns the result
 QUAT QUAT::operator*(const QUAT& q) const
 {
-  QUAT qm;
-
-  qm.w = w * q.w - x * q.x - y * q.y - z * q.z;
-  qm.x = w * q.x + x * q.w + y * q.z - z * q.y;
-  qm.y = w * q.y + y * q.w + z * q.x - x * q.z;
-  qm.z = w * q.z + z * q.w + x * q.y - y * q.x;
-
-  return qm;
+  const REAL q1[4] = { x, y, z, w };
+  const REAL q2[4] = { q.x, q.y, q.z, q.w };
+  REAL qm[4];
+  SIMD3::quat_mult(q1, q2, qm);
+  return QUAT(qm[0], qm[1], qm[2], qm[3]);
 }
 
 /// Multiplies a quaternion by a scalar
@@ -575,17 +572,10 @@ QUAT& QUAT::operator*=(REAL scalar)
 /// Multiplies the 3x3 matrix corresponding to this quaternion by a 3D origin and returns the result in a new 3D origin
 ORIGIN3 QUAT::operator*(const ORIGIN3& o) const
 {
-  const REAL w2 = w*w;
-  const REAL x2 = x*x;
-  const REAL y2 = y*y;
-  const REAL z2 = z*z;
-  const REAL xy = x*y;
-  const REAL xz = x*z;
-  const REAL yz = y*z;
-  const REAL xw = x*w;
-  const REAL yw = y*w;
-  const REAL zw = z*w;
-  return ORIGIN3((-1.0+2.0*(w2+x2))*o.x() + 2.0*((xy-zw)*o.y() + (yw+xz)*o.z()), 2.0*((xy+zw)*o.x() + (-xw+yz)*o.z()) + (-1.0+2.0*(w2+y2))*o.y(), 2.0*((-yw+xz)*o.x() + (xw+yz)*o.y()) + (-1.0+2.0*(w2+z2))*o.z());
+  const REAL q[4] = { x, y, z, w };
+  ORIGIN3 result;
+  SIMD3::quat_rotate(q, o.data(), result.data());
+  return result;
 }
 
 /// Multiplies <b>this</b> by q and stores the result in <b>this</b>
@@ -13,6 +13,7 @@
 #include <Ravelin/Opsd.h>
 #include <Ravelin/VectorNd.h>
 #include <Ravelin/Quatd.h>
+#include <Ravelin/SIMD3d.h>
 
 using namespace Ravelin;
 
@@ -13,6 +13,7 @@
 #include <Ravelin/Opsf.h>
 #include <Ravelin/VectorNf.h>
 #include <Ravelin/Quatf.h>
+#include <Ravelin/SIMD3f.h>
 
 using namespace Ravelin;
 
@@ -32,8 +32,21 @@ RC_ARTICULATED_BODY::RC_ARTICULATED_BODY()
   algorithm_type = eCRB;
   set_computation_frame_type(eLinkCOM);
 
+  // joint springs and dampers are treated explicitly by default
+  _implicit_h = (REAL) 0.0;
+
   // invalidate position quanitites
   _position_invalidated = true;
+  _gravity_vector_valid = false;
+  _pose_version = _velocity_version = 1;
+  _poses_applied_valid = false;
+
+  // setup the frame used for computing Jacobian columns
+  _jacobian_target = shared_ptr<POSE3>(new POSE3);
+
+  // the body is awake, with no frozen links
+  _asleep = false;
+  _nskipped = _nskipped_dof = 0;
 }
 
 /// Validates position variables
@@ -58,13 +71,68 @@ void RC_ARTICULATED_BODY::set_computation_frame_type(ReferenceFrameType rftype)
   _rftype = rftype;
 
   // invalidate
-  _position_invalidated = true;
+  invalidate_link_poses();
 
   // set the reference frame type for all links
   for (unsigned i=0; i< _links.size(); i++)
     _links[i]->set_computation_frame_type(rftype);
 }
 
+/// Sets the step size used to treat joint springs and dampers implicitly
+/**
+ * Joint spring and damper forces (see JOINT::stiffness and JOINT::damping) 
+ * are evaluated at the end of a semi-implicit Euler step of size h, which
+ * adds the terms h*D + h^2*K to the diagonal of the joint-space inertia used
+ * by the dynamics algorithms (including solves with the generalized inertia
+ * matrix; get_generalized_inertia() still returns the unmodified inertia).
+ * Very stiff springs then remain stable at step sizes well above their 
+ * natural period. A step size of zero treats the springs and dampers
+ * explicitly.
+ */
+void RC_ARTICULATED_BODY::set_implicit_step_size(REAL h)
+{
+  #ifndef NEXCEPT
+  if (h < (REAL) 0.0)
+    throw std::runtime_error("RC_ARTICULATED_BODY::set_implicit_step_size() - step size must be non-negative");
+  #endif
+
+  _implicit_h = h;
+  update_implicit_joint_inertia();
+}
+
+/// Recomputes the joint-space inertia terms of the joint springs and dampers
+/**
+ * Invalidates the factorized inertia if any of the terms have changed
+ */
+void RC_ARTICULATED_BODY::update_implicit_joint_inertia()
+{
+  FIXEDVECTORN<6> d;
+
+  // compute the new terms
+  VECTORN& implicit_inertia = _implicit_inertia_new;
+  implicit_inertia.set_zero(_n_joint_DOF_explicit);
+  for (unsigned i=0; i< _ejoints.size(); i++)
+  {
+    _ejoints[i]->calc_spring_damper_inertia(_implicit_h, d);
+    implicit_inertia.set_sub_vec(_ejoints[i]->get_coord_index(), d);
+  }
+
+  // see whether anything has changed
+  if (implicit_inertia.size() == _implicit_inertia.size())
+  {
+    bool changed = false;
+    for (unsigned i=0; i< implicit_inertia.size() && !changed; i++)
+      changed = (implicit_inertia[i] != _implicit_inertia[i]);
+    if (!changed)
+      return;
+  }
+
+  // store the terms and invalidate the inertias
+  _implicit_inertia.swap(implicit_inertia);
+  _position_invalidated = true;
+  _crb._gc_last.resize(0);
+}
+
 /// Determines whether all of the children of a link have been processed
 bool RC_ARTICULATED_BODY::all_children_processed(shared_ptr<RIGIDBODY> link) const
 {
@@ -99,6 +167,9 @@ unsigned RC_ARTICULATED_BODY::num_generalized_coordinates(DYNAMIC_BODY::Generali
 /// Updates inverse generalized inertia matrix, as necessary
 void RC_ARTICULATED_BODY::update_factorized_generalized_inertia()
 {
+  // check whether joint spring and damper terms have changed
+  update_implicit_joint_inertia();
+
   // see whether we need to update
   if (!_position_invalidated)
     return;
@@ -107,7 +178,7 @@ void RC_ARTICULATED_BODY::update_factorized_generalized_inertia()
   shared_ptr<RC_ARTICULATED_BODY> body = dynamic_pointer_cast<RC_ARTICULATED_BODY>(shared_from_this());
 
   // do precalculation on the body
-  if (algorithm_type == eFeatherstone)
+  if (algorithm_type == eFeatherstone || algorithm_type == eDivideAndConquer)
     _fsab.calc_spatial_inertias(body);
   else
     _crb.precalc(body);
@@ -126,7 +197,7 @@ SHAREDVECTORN& RC_ARTICULATED_BODY::solve_generalized_inertia(const SHAREDVECTOR
   if (rftype != eLinkCOM && is_floating_base())
     set_computation_frame_type(eLinkCOM);
 
-  if (algorithm_type == eFeatherstone)
+  if (algorithm_type == eFeatherstone || algorithm_type == eDivideAndConquer)
   {
     // update the inverse / factorized inertia (if necessary)
     update_factorized_generalized_inertia();
@@ -166,7 +237,7 @@ SHAREDMATRIXN& RC_ARTICULATED_BODY::transpose_solve_generalized_inertia(const SH
   if (rftype != eLinkCOM && is_floating_base())
     set_computation_frame_type(eLinkCOM);
 
-  if (algorithm_type == eFeatherstone)
+  if (algorithm_type == eFeatherstone || algorithm_type == eDivideAndConquer)
   {
     // update the inverse / factorized inertia (if necessary)
     update_factorized_generalized_inertia();
@@ -206,7 +277,7 @@ SHAREDMATRIXN& RC_ARTICULATED_BODY::solve_generalized_inertia(const SHAREDMATRIX
   if (rftype != eLinkCOM && is_floating_base())
     set_computation_frame_type(eLinkCOM);
 
-  if (algorithm_type == eFeatherstone)
+  if (algorithm_type == eFeatherstone || algorithm_type == eDivideAndConquer)
   {
     // update the inverse / factorized inertia (if necessary)
     update_factorized_generalized_inertia();
@@ -241,24 +312,33 @@ void RC_ARTICULATED_BODY::apply_generalized_impulse(const SHAREDVECTORN& gj)
 {
   if (algorithm_type == eFeatherstone)
     _fsab.apply_generalized_impulse(gj);
+  else if (algorithm_type == eDivideAndConquer)
+  {
+    // the divide-and-conquer algorithm does not compute articulated inertias
+    update_factorized_generalized_inertia();
+    _fsab.apply_generalized_impulse(gj);
+  }
   else
   {
     assert(algorithm_type == eCRB);
 
-    // setup work variables
-    static VECTORN gv, gv_delta;
-
     // get the current generalized velocity
-    get_generalized_velocity(DYNAMIC_BODY::eSpatial, gv);
+    get_generalized_velocity(DYNAMIC_BODY::eSpatial, _gv);
 
     // we'll solve for the change in generalized velocity
-    DYNAMIC_BODY::solve_generalized_inertia(gj, gv_delta);
+    DYNAMIC_BODY::solve_generalized_inertia(gj, _gv_delta);
 
     // apply the change in generalized velocity
-    gv += gv_delta;
-    set_generalized_velocity(DYNAMIC_BODY::eSpatial, gv);
+    _gv += _gv_delta;
+    set_generalized_velocity(DYNAMIC_BODY::eSpatial, _gv);
   }
 
+  // the link velocities have changed
+  _velocity_version++;
+
+  // wake the body (or thaw subtrees) if the impulse was large enough
+  settle_resting_velocities();
+
   // reset the force and torque accumulators
   reset_accumulators();
 }
@@ -363,6 +443,25 @@ void RC_ARTICULATED_BODY::compile()
 
   // update processed vector size
   _processed.resize(_links.size());
+  _gravity_vector_valid = false;
+
+  // determine the order in which to sweep the links (parents before children)
+  const unsigned BASE = _links.front()->get_index();
+  _link_order.assign(1, BASE);
+  _parent_index.resize(_links.size());
+  _parent_index[BASE] = BASE;
+  for (unsigned i=0; i< _link_order.size(); i++)
+  {
+    shared_ptr<RIGIDBODY> link = _links[_link_order[i]];
+    const std::set<shared_ptr<JOINT> >& outer = link->get_outer_joints();
+    for (std::set<shared_ptr<JOINT> >::const_iterator j = outer.begin(); j != outer.end(); j++)
+      if ((*j)->get_constraint_type() == JOINT::eExplicit)
+      {
+        const unsigned CHILD = (*j)->get_outboard_link()->get_index();
+        _parent_index[CHILD] = link->get_index();
+        _link_order.push_back(CHILD);
+      }
+  }
 
   // setup explicit joint generalized coordinate and constraint indices
   for (unsigned i=0, cidx = 0, ridx = 0; i< _ejoints.size(); i++)
@@ -409,11 +508,16 @@ void RC_ARTICULATED_BODY::compile()
     _ejoints[i]->set_q_tare(q_tare_save[i]);
   }
 
-  // point both algorithms to this body
+  // point all algorithms to this body
   _crb.set_body(get_this());
   _fsab.set_body(get_this());
+  _dca.set_body(get_this());
+
+  // no links are frozen
+  reset_rest_data();
 
-  // update link transforms and velocities
+  // update link transforms (all of them) and velocities
+  invalidate_link_poses();
   update_link_poses();
   update_link_velocities();
 }
@@ -591,23 +695,99 @@ SHAREDVECTORN& RC_ARTICULATED_BODY::get_generalized_acceleration(SHAREDVECTORN&
 
 /// Updates the transforms of the links based on the current joint positions
 /**
+ * Only the joints whose coordinates, frames, or axes have changed since the
+ * last call (see JOINT::get_geometry_version()), and the links outboard of
+ * them, or all links if the base has moved, are updated; if nothing has
+ * moved, no pose-dependent quantities are invalidated. See invalidate_link_poses().
  * \note this doesn't actually calculate other than the joint positions; all
  *       links are defined with respect to the joints, which are defined
  *       with respect to their inner link
  */
 void RC_ARTICULATED_BODY::update_link_poses()
 {
-  // indicate factorized inertia matrix is no longer valid
+  const unsigned NLINKS = _links.size(), NJOINTS = _joints.size();
+
+  // all poses must be recomputed if the applied coordinates are unknown
+  const bool FULL = (!_poses_applied_valid || _q_applied.size() != NJOINTS || 
+                     _link_pose_version.size() != NLINKS);
+  _link_moved.assign(NLINKS, FULL);
+  _link_pose_version.resize(NLINKS);
+  _q_applied.resize(NJOINTS);
+  _q_tare_applied.resize(NJOINTS);
+  _geometry_version_applied.resize(NJOINTS);
+  bool moved = FULL;
+
+  // update the induced poses of joints whose coordinates (or frames or axes)
+  // have changed
+  for (unsigned i=0; i< NJOINTS; i++)
+  {
+    JOINT& joint = *_joints[i];
+    const bool RESHAPED = (joint.get_geometry_version() != _geometry_version_applied[i]);
+    if (!FULL && !RESHAPED && coords_equal(joint.q, _q_applied[i]) && 
+        coords_equal(joint.get_q_tare(), _q_tare_applied[i]))
+      continue;
+    joint.get_induced_pose();
+    _q_applied[i] = joint.q;
+    _q_tare_applied[i] = joint.get_q_tare();
+    _geometry_version_applied[i] = joint.get_geometry_version();
+
+    // the CRB algorithm only refactors when the coordinates change
+    if (RESHAPED)
+      _crb._gc_last.resize(0);
+
+    // implicit joints do not determine link poses
+    if (joint.get_constraint_type() == JOINT::eExplicit)
+    {
+      _link_moved[joint.get_outboard_link()->get_index()] = true;
+      moved = true;
+    }
+  }
+
+  // see whether the base has moved
+  if (!_links.empty())
+  {
+    const unsigned BASE = _links.front()->get_index();
+    const POSE3& P = *_links.front()->get_pose();
+    const POSE3& Q = _base_pose_applied;
+    if (FULL || P.rpose != Q.rpose || P.x[0] != Q.x[0] || P.x[1] != Q.x[1] || 
+        P.x[2] != Q.x[2] || P.q.x != Q.q.x || P.q.y != Q.q.y || 
+        P.q.z != Q.q.z || P.q.w != Q.q.w)
+    {
+      _link_moved[BASE] = true;
+      _base_pose_applied = P;
+      moved = true;
+    }
+  }
+  _poses_applied_valid = true;
+
+  // look for easy exit: nothing depending on the link poses is invalidated
+  if (!moved)
+  {
+    FILE_LOG(LOG_DYNAMICS) << "RC_ARTICULATED_BODY::update_link_poses() - no link has moved" << std::endl;
+    return;
+  }
+
+  // indicate factorized inertia matrix and gravity vector are no longer valid
   _position_invalidated = true;
+  _gravity_vector_valid = false;
+  _pose_version++;
 
-  // update all joint poses
-  for (unsigned i=0; i< _joints.size(); i++){
-    _joints[i]->get_induced_pose();
+  // links move with their parents (parents precede children)
+  for (unsigned k=1; k< _link_order.size(); k++)
+  {
+    const unsigned i = _link_order[k];
+    if (_link_moved[_parent_index[i]])
+      _link_moved[i] = true;
   }
 
   // update the center-of-mass centered / global aligned frame in all links
-  for (unsigned i=0; i< _links.size(); i++){
+  // that have moved
+  for (unsigned i=0; i< NLINKS; i++)
+  {
+    if (!_link_moved[i])
+      continue;
     _links[i]->update_mixed_pose();
+    _link_pose_version[i] = _pose_version;
   }
 
   // print all link poses and joint poses
@@ -629,19 +809,54 @@ void RC_ARTICULATED_BODY::update_link_poses()
   FILE_LOG(LOG_DYNAMICS) << "RC_ARTICULATED_BODY::update_link_poses() exited" << std::endl;
 }
 
+/// Forces update_link_poses() to recompute the poses of all links
+/**
+ * update_link_poses() only recomputes the poses of links whose inner joint
+ * coordinates, frames, or axes (or those of an ancestor), or the base pose,
+ * have changed since its last call. This must be called after link or joint
+ * frames are modified in any other way.
+ */
+void RC_ARTICULATED_BODY::invalidate_link_poses()
+{
+  _poses_applied_valid = false;
+  _position_invalidated = true;
+  _gravity_vector_valid = false;
+  _crb._gc_last.resize(0);
+  _pose_version++;
+  _link_pose_version.assign(_links.size(), _pose_version);
+}
+
+/// Invalidates the quantities that depend on the link inertias
+/**
+ * Called by RIGIDBODY::set_inertia() for links of this body; the 
+ * factorized generalized inertia matrix and the gravity vector are 
+ * recomputed when next needed.
+ */
+void RC_ARTICULATED_BODY::invalidate_inertias()
+{
+  _position_invalidated = true;
+  _gravity_vector_valid = false;
+  _crb._gc_last.resize(0);
+}
+
+/// Determines whether two coordinate vectors are identical
+bool RC_ARTICULATED_BODY::coords_equal(const VECTORN& a, const VECTORN& b)
+{
+  if (a.size() != b.size())
+    return false;
+  for (unsigned i=0; i< a.size(); i++)
+    if (a[i] != b[i])
+      return false;
+  return true;
+}
+
 /// Updates the link velocities
 void RC_ARTICULATED_BODY::update_link_velocities()
 {
-  queue<shared_ptr<RIGIDBODY> > link_queue;
-  vector<SVELOCITY> sprime;
-
   // look for easy exit
   if (_links.empty() || _joints.empty())
     return;
 
-  // get the base link
-  shared_ptr<RIGIDBODY> base = _links.front();
-
   FILE_LOG(LOG_DYNAMICS) << "RC_ARTICULATED_BODY::update_link_velocities() entered" << std::endl;
   if (LOGGING(LOG_DYNAMICS))
   {
@@ -651,54 +866,22 @@ void RC_ARTICULATED_BODY::update_link_velocities()
       FILE_LOG(LOG_DYNAMICS) << " joint " << i << " " <<  _joints[i]->joint_id << std::endl;
   }
 
-  // add all children of the base to the link queue
-  list<shared_ptr<RIGIDBODY> > child_links;
-  base->get_child_links(std::back_inserter(child_links));
-  BOOST_FOREACH(shared_ptr<RIGIDBODY> rb, child_links)
-    link_queue.push(rb);
+  // get the (transformed) spatial axes and the transforms between links
+  update_pose_kinematics();
+  const Kinematics& kin = _kinematics;
 
-  // reset processed vector
-  for (unsigned i=0; i< _links.size(); i++)
-    _processed[i] = false;
-  _processed[base->get_index()] = true;
-
-  // propagate link velocities
-  while (!link_queue.empty())
-  {
-    // get the link off of the front of the queue
-    shared_ptr<RIGIDBODY> outboard = link_queue.front();
-    shared_ptr<const POSE3> opose = outboard->get_computation_frame();
-    link_queue.pop();
-    unsigned i = outboard->get_index();
-
-    // and push all children of the link onto the queue
-    list<shared_ptr<RIGIDBODY> > child_links;
-    outboard->get_child_links(std::back_inserter(child_links));
-    BOOST_FOREACH(shared_ptr<RIGIDBODY> rb, child_links)
-      if (!_processed[rb->get_index()])
-        link_queue.push(rb);
-
-    // get the inner joint and the inboard link
-    boost::shared_ptr<JOINT> joint(outboard->get_inner_joint_explicit());
-    shared_ptr<RIGIDBODY> inboard(joint->get_inboard_link());
-    shared_ptr<const POSE3> ipose = inboard->get_computation_frame();
-    unsigned h = inboard->get_index();
-
-    // set this link's velocity to the parent's link velocity
-    outboard->set_velocity(POSE3::transform(opose, inboard->get_velocity()));
-
-    // get the (transformed) link spatial axis
-    const vector<SVELOCITY>& s = joint->get_spatial_axes();
-    POSE3::transform(opose, s, sprime);
+  // propagate link velocities, parents before children
+  for (unsigned k=1; k< _link_order.size(); k++)
+  {
+    const unsigned i = _link_order[k], h = _parent_index[i];
+    shared_ptr<RIGIDBODY> outboard = _links[i], inboard = _links[h];
+    shared_ptr<JOINT> joint = outboard->get_inner_joint_explicit();
 
     // determine the link velocity due to the parent velocity + joint velocity
-    if (sprime.empty())
-      outboard->set_velocity(outboard->get_velocity());
-    else
-      outboard->set_velocity(outboard->get_velocity() + SPARITH::mult(sprime, joint->qd));
-
-    // indicate that the link has been processed
-    _processed[i] = true;
+    SVELOCITY v = kin.X[i].transform(inboard->get_velocity());
+    if (!kin.s[i].empty())
+      v += SPARITH::mult(kin.s[i], joint->qd);
+    outboard->set_velocity(v);
 
     FILE_LOG(LOG_DYNAMICS) << "    -- updating link " << outboard->body_id << std::endl;
     FILE_LOG(LOG_DYNAMICS) << "      -- parent velocity: " << inboard->get_velocity() << std::endl;
@@ -706,9 +889,100 @@ void RC_ARTICULATED_BODY::update_link_velocities()
     FILE_LOG(LOG_DYNAMICS) << "      -- link velocity : " << outboard->get_velocity()  << std::endl;
   }
 
+  // the link velocities have changed
+  _velocity_version++;
+
   FILE_LOG(LOG_DYNAMICS) << "RC_ARTICULATED_BODY::update_link_velocities() exited" << std::endl;
 }
 
+/// Gets the kinematic quantities shared by the dynamics algorithms, recomputing any that are stale
+/**
+ * \sa RC_ARTICULATED_BODY::Kinematics
+ */
+const RC_ARTICULATED_BODY::Kinematics& RC_ARTICULATED_BODY::get_kinematics()
+{
+  update_pose_kinematics();
+  update_velocity_kinematics();
+  return _kinematics;
+}
+
+/// Recomputes the pose-dependent kinematic quantities if they are stale
+void RC_ARTICULATED_BODY::update_pose_kinematics()
+{
+  Kinematics& kin = _kinematics;
+  if (kin._pose_version == _pose_version)
+    return;
+
+  FILE_LOG(LOG_DYNAMICS) << "RC_ARTICULATED_BODY::update_pose_kinematics() - recomputing for pose version " << _pose_version << std::endl;
+
+  // entries for links that have not moved are still valid 
+  const unsigned NLINKS = _links.size();
+  if (_link_pose_version.size() != NLINKS)
+    _link_pose_version.assign(NLINKS, _pose_version);
+  if (kin._link_version.size() != NLINKS)
+    kin._link_version.assign(NLINKS, 0);
+  kin.s.resize(NLINKS);
+  kin.X.resize(NLINKS);
+
+  // setup the base entries
+  if (!_links.empty())
+  {
+    const unsigned BASE = _links.front()->get_index();
+    if (kin._link_version[BASE] != _link_pose_version[BASE])
+    {
+      kin.s[BASE].clear();
+      kin.X[BASE] = POSE3::calc_relative_pose(_links[BASE]->get_computation_frame(), _links[BASE]->get_computation_frame());
+      kin._link_version[BASE] = _link_pose_version[BASE];
+    }
+  }
+
+  // transform the spatial axes into the link frames and compute the 
+  // transforms from the parent frames
+  for (unsigned k=1; k< _link_order.size(); k++)
+  {
+    const unsigned i = _link_order[k];
+    if (kin._link_version[i] == _link_pose_version[i])
+      continue;
+    shared_ptr<const POSE3> P = _links[i]->get_computation_frame();
+    POSE3::transform(P, _links[i]->get_inner_joint_explicit()->get_spatial_axes(), kin.s[i]);
+    kin.X[i] = POSE3::calc_relative_pose(_links[_parent_index[i]]->get_computation_frame(), P);
+    kin._link_version[i] = _link_pose_version[i];
+  }
+
+  // velocity-dependent quantities are expressed in the link frames too
+  kin._pose_version = _pose_version;
+  kin._velocity_version = 0;
+}
+
+/// Recomputes the velocity-dependent kinematic quantities if they are stale
+void RC_ARTICULATED_BODY::update_velocity_kinematics()
+{
+  Kinematics& kin = _kinematics;
+  if (kin._velocity_version == _velocity_version && kin._pose_version == _pose_version)
+    return;
+
+  FILE_LOG(LOG_DYNAMICS) << "RC_ARTICULATED_BODY::update_velocity_kinematics() - recomputing for velocity version " << _velocity_version << std::endl;
+
+  // get the link velocities and the time derivatives of the spatial axes 
+  const unsigned NLINKS = _links.size();
+  kin.v.resize(NLINKS);
+  kin.sdot.resize(NLINKS);
+  for (unsigned i=0; i< NLINKS; i++)
+  {
+    kin.v[_links[i]->get_index()] = _links[i]->get_velocity();
+    kin.sdot[i].clear();
+  }
+  for (unsigned k=1; k< _link_order.size(); k++)
+  {
+    const unsigned i = _link_order[k];
+    const vector<SVELOCITY>& sdot = _links[i]->get_inner_joint_explicit()->get_spatial_axes_dot();
+    if (!sdot.empty())
+      POSE3::transform(_links[i]->get_computation_frame(), sdot, kin.sdot[i]);
+  }
+
+  kin._velocity_version = _velocity_version;
+}
+
 /// Calculates the column of a Jacobian matrix for a floating base with respect to a given point
 /**
  * \param point the point in 3D space which the Jacobian is calculated against
@@ -719,8 +993,8 @@ void RC_ARTICULATED_BODY::update_link_velocities()
 MATRIXN& RC_ARTICULATED_BODY::calc_jacobian_floating_base(const VECTOR3& point, MATRIXN& J)
 {
   const unsigned SPATIAL_DIM = 6;
-  static vector<SVELOCITY> sbase, sbase_prime;
-  static shared_ptr<POSE3> P(new POSE3);
+  vector<SVELOCITY> sbase, sbase_prime;
+  shared_ptr<POSE3> P(new POSE3);
 
   // get the base link and the base pose
   shared_ptr<RIGIDBODY> base = get_base_link();
@@ -752,7 +1026,7 @@ MATRIXN& RC_ARTICULATED_BODY::calc_jacobian_floating_base(const VECTOR3& point,
 MATRIXN& RC_ARTICULATED_BODY::calc_jacobian(const VECTOR3& p, shared_ptr<RIGIDBODY> link, MATRIXN& J)
 {
   const unsigned SPATIAL_DIM = 6;
-  static MATRIXN Jsub;
+  MATRIXN Jsub;
 
   // resize the Jacobian
   J.set_zero(SPATIAL_DIM, num_generalized_coordinates(DYNAMIC_BODY::eSpatial));
@@ -849,8 +1123,8 @@ MATRIXN& RC_ARTICULATED_BODY::calc_jacobian(const VECTOR3& point, const POSE3& b
 MATRIXN& RC_ARTICULATED_BODY::calc_jacobian_column(boost::shared_ptr<JOINT> joint, const VECTOR3& point, MATRIXN& Jc)
 {
   const unsigned SPATIAL_DIM = 6;
-  static shared_ptr<POSE3> target(new POSE3);
-  static vector<SVELOCITY> sprime;
+  const shared_ptr<POSE3>& target = _jacobian_target;
+  vector<SVELOCITY>& sprime = _jacobian_sprime;
 
   // NOTE: spatial algebra provides us with a simple means to compute the
   // Jacobian of a joint with respect to a point.  The spatial axis of the
@@ -920,8 +1194,6 @@ REAL RC_ARTICULATED_BODY::sgn(REAL x)
  */
 void RC_ARTICULATED_BODY::calc_fwd_dyn()
 {
-  static VECTORN ff;
-
   FILE_LOG(LOG_DYNAMICS) << "RC_ARTICULATED_BODY::calc_fwd_dyn() entered" << std::endl;
   FILE_LOG(LOG_DYNAMICS) << "  computing forward dynamics in ";
   if (get_computation_frame_type() == eGlobal)
@@ -934,6 +1206,56 @@ void RC_ARTICULATED_BODY::calc_fwd_dyn()
     FILE_LOG(LOG_DYNAMICS) << "joint ";
   FILE_LOG(LOG_DYNAMICS) << "coordinate system" << std::endl;
 
+  // a sleeping body does not accelerate unless the applied forces change
+  if (_asleep)
+  {
+    if (!rest_forces_changed(_links.front()))
+    {
+      for (unsigned i=0; i< _ejoints.size(); i++)
+        _ejoints[i]->qdd.set_zero();
+      for (unsigned i=0; i< _links.size(); i++)
+        _links[i]->set_accel(SACCEL::zero(_links[i]->get_computation_frame()));
+      _nskipped++;
+      _nskipped_dof += num_generalized_coordinates(DYNAMIC_BODY::eSpatial);
+      FILE_LOG(LOG_DYNAMICS) << "RC_ARTICULATED_BODY::calc_fwd_dyn() exited (body asleep)" << std::endl;
+      return;
+    }
+
+    FILE_LOG(LOG_DYNAMICS) << "  applied forces woke the body" << std::endl;
+    wake();
+  }
+
+  // check whether joint spring and damper terms have changed
+  update_implicit_joint_inertia();
+
+  // thaw frozen subtrees whose applied forces have changed
+  for (unsigned i=1; i< _frozen.size(); i++)
+    if (_frozen[i] && !_frozen[_links[i]->get_parent_link()->get_index()] && rest_forces_changed(_links[i]))
+    {
+      FILE_LOG(LOG_DYNAMICS) << "  applied forces thawed subtree at " << _links[i]->body_id << std::endl;
+      thaw(_links[i]);
+    }
+
+  // frozen joints are locked, which only the CRB algorithm supports
+  const unsigned NFROZEN = num_frozen_dof();
+  if (NFROZEN > 0)
+  {
+    const unsigned SPATIAL_DIM = 6;
+    _unlocked.resize(_n_joint_DOF_explicit + ((_floating_base) ? SPATIAL_DIM : 0));
+    std::fill(_unlocked.begin(), _unlocked.end(), true);
+    for (unsigned i=0; i< _ejoints.size(); i++)
+      if (_frozen[_ejoints[i]->get_outboard_link()->get_index()])
+      {
+        unsigned idx = _ejoints[i]->get_coord_index();
+        std::fill(_unlocked.begin()+idx, _unlocked.begin()+idx+_ejoints[i]->num_dof(), false);
+      }
+    _crb.calc_fwd_dyn_locked(_unlocked);
+    _nskipped_dof += NFROZEN;
+
+    FILE_LOG(LOG_DYNAMICS) << "RC_ARTICULATED_BODY::calc_fwd_dyn() exited (" << NFROZEN << " DOF frozen)" << std::endl;
+    return;
+  }
+
   // use the proper dynamics algorithm
   switch (algorithm_type)
   {
@@ -951,6 +1273,10 @@ void RC_ARTICULATED_BODY::calc_fwd_dyn()
         _crb.calc_fwd_dyn();
       break;
 
+    case eDivideAndConquer:
+      _dca.calc_fwd_dyn();
+      break;
+
     default:
       assert(false);
   }
@@ -958,15 +1284,409 @@ void RC_ARTICULATED_BODY::calc_fwd_dyn()
   FILE_LOG(LOG_DYNAMICS) << "RC_ARTICULATED_BODY::calc_fwd_dyn() exited" << std::endl;
 }
 
+/// Computes hybrid dynamics for this body
+/**
+ * Joints marked with JOINT::set_acceleration_prescribed() have their
+ * accelerations (qdd) taken as given; the joint forces necessary to realize 
+ * those accelerations are computed and stored in JOINT::force. The remaining 
+ * joints have their accelerations computed from the applied forces, as in
+ * calc_fwd_dyn(). Featherstone's algorithm is always used, regardless of 
+ * algorithm_type.
+ */
+void RC_ARTICULATED_BODY::calc_hybrid_dyn()
+{
+  FILE_LOG(LOG_DYNAMICS) << "RC_ARTICULATED_BODY::calc_hybrid_dyn() entered" << std::endl;
+
+  // hybrid dynamics is not supported for bodies with kinematic loops
+  if (!_ijoints.empty())
+    throw std::runtime_error("RC_ARTICULATED_BODY::calc_hybrid_dyn() cannot process bodies with kinematic loops");
+
+  // check whether joint spring and damper terms have changed
+  update_implicit_joint_inertia();
+
+  // compute the hybrid dynamics
+  _fsab.calc_hybrid_dyn();
+
+  // inertias stored in the algorithm are no longer the articulated body
+  // inertias for forward dynamics
+  _position_invalidated = true;
+
+  FILE_LOG(LOG_DYNAMICS) << "RC_ARTICULATED_BODY::calc_hybrid_dyn() exited" << std::endl;
+}
+
+/// Makes a deep copy of this body
+/**
+ * The copy has its own links, joints, and frames, with the same topology, 
+ * indices, parameters, and state as this body, and can be used independently
+ * of this body (e.g., one copy per thread). Copying is much faster than 
+ * reading and compiling the body again. Links are copied as RIGIDBODY 
+ * objects and joints are copied using JOINT::clone(). Cached dynamics 
+ * quantities (e.g., the factorized generalized inertia) are not copied, and
+ * the copy is awake, with no frozen links. 
+ */
+shared_ptr<RC_ARTICULATED_BODY> RC_ARTICULATED_BODY::clone() const
+{
+  shared_ptr<RC_ARTICULATED_BODY> body(new RC_ARTICULATED_BODY);
+
+  // copy the frames of the links and joints
+  JOINT::PoseMap poses;
+  for (unsigned i=0; i< _links.size(); i++)
+  {
+    const RIGIDBODY& link = *_links[i];
+    poses[link._F] = shared_ptr<POSE3>(new POSE3(*link._F));
+    poses[link._F2] = shared_ptr<POSE3>(new POSE3(*link._F2));
+  }
+  for (unsigned i=0; i< _joints.size(); i++)
+  {
+    const JOINT& joint = *_joints[i];
+    poses[joint._F] = shared_ptr<POSE3>(new POSE3(*joint._F));
+    poses[joint._Fb] = shared_ptr<POSE3>(new POSE3(*joint._Fb));
+    poses[joint._Fprime] = shared_ptr<POSE3>(new POSE3(*joint._Fprime));
+  }
+
+  // point the copied frames to one another; frames outside of this body 
+  // (e.g., the global frame) are shared
+  for (JOINT::PoseMap::const_iterator i = poses.begin(); i != poses.end(); i++)
+    JOINT::remap(i->second->rpose, poses);
+
+  // copy the links
+  body->_links.resize(_links.size());
+  for (unsigned i=0; i< _links.size(); i++)
+  {
+    shared_ptr<RIGIDBODY> link(new RIGIDBODY(*_links[i]));
+    link->_F = poses[_links[i]->_F];
+    link->_F2 = poses[_links[i]->_F2];
+    JOINT::remap(link->_J0.pose, poses);
+    JOINT::remap(link->_xd0.pose, poses);
+    JOINT::remap(link->_xdd0.pose, poses);
+    JOINT::remap(link->_force0.pose, poses);
+    JOINT::remap(link->_Ji.pose, poses);
+    JOINT::remap(link->_xdi.pose, poses);
+    JOINT::remap(link->_xddi.pose, poses);
+    JOINT::remap(link->_forcei.pose, poses);
+    JOINT::remap(link->_Jj.pose, poses);
+    JOINT::remap(link->_xdj.pose, poses);
+    JOINT::remap(link->_xddj.pose, poses);
+    JOINT::remap(link->_forcej.pose, poses);
+    JOINT::remap(link->_Jcom.pose, poses);
+    JOINT::remap(link->_xdcom.pose, poses);
+    JOINT::remap(link->_xddcom.pose, poses);
+    JOINT::remap(link->_forcecom.pose, poses);
+    link->_inner_joints.clear();
+    link->_outer_joints.clear();
+    link->_abody = body;
+    body->_links[link->get_index()] = link;
+  }
+
+  // copy the joints and connect them to the copied links
+  body->_joints.resize(_joints.size());
+  for (unsigned i=0; i< _joints.size(); i++)
+  {
+    shared_ptr<JOINT> joint = _joints[i]->clone(poses);
+    shared_ptr<RIGIDBODY> inboard = body->_links[_joints[i]->get_inboard_link()->get_index()];
+    shared_ptr<RIGIDBODY> outboard = body->_links[_joints[i]->get_outboard_link()->get_index()];
+    joint->_inboard_link = inboard;
+    joint->_outboard_link = outboard;
+    inboard->_outer_joints.insert(joint);
+    outboard->_inner_joints.insert(joint);
+    body->_joints[joint->get_index()] = joint;
+  }
+  body->_ejoints.resize(_ejoints.size());
+  for (unsigned i=0; i< _ejoints.size(); i++)
+    body->_ejoints[i] = body->_joints[_ejoints[i]->get_index()];
+  body->_ijoints.resize(_ijoints.size());
+  for (unsigned i=0; i< _ijoints.size(); i++)
+    body->_ijoints[i] = body->_joints[_ijoints[i]->get_index()];
+
+  // copy the remaining data
+  body->body_id = body_id;
+  body->algorithm_type = algorithm_type;
+  body->_rftype = _rftype;
+  body->_floating_base = _floating_base;
+  body->_n_joint_DOF_explicit = _n_joint_DOF_explicit;
+  body->_implicit_h = _implicit_h;
+  body->_implicit_inertia = _implicit_inertia;
+  body->_processed.resize(_processed.size());
+  body->_link_order = _link_order;
+  body->_parent_index = _parent_index;
+  body->_position_invalidated = true;
+  body->reset_rest_data();
+
+  // point all algorithms to the copy
+  body->_crb.set_body(body);
+  body->_fsab.set_body(body);
+  body->_dca.set_body(body);
+  body->_dca.set_num_threads(_dca.get_num_threads());
+
+  return body;
+}
+
+/// Saves the state of this body into a snapshot
+/**
+ * The snapshot holds everything necessary to return this body to its current
+ * state with restore_state() without updating the link poses and velocities.
+ * Saving into the same snapshot repeatedly reuses its buffers.
+ * \param state the snapshot (on return)
+ * \param save_factorizations if <b>true</b>, the factorized generalized 
+ *        inertia (as computed by the current forward dynamics algorithm) is 
+ *        saved as well, so that forward dynamics need not refactorize after
+ *        the state is restored; the factorization is updated first, if 
+ *        necessary
+ * \return a reference to state
+ */
+RC_ARTICULATED_BODY::State& RC_ARTICULATED_BODY::save_state(State& state, bool save_factorizations)
+{
+  const unsigned NJOINTS = _joints.size(), NLINKS = _links.size();
+  const unsigned POSE_SIZE = 7;
+
+  // save the joint quantities
+  unsigned njoint_data = 0;
+  state._joint_sizes.resize(NJOINTS*4);
+  for (unsigned i=0, k=0; i< NJOINTS; i++)
+  {
+    const JOINT& joint = *_joints[i];
+    njoint_data += (state._joint_sizes[k++] = joint.q.size());
+    njoint_data += (state._joint_sizes[k++] = joint.qd.size());
+    njoint_data += (state._joint_sizes[k++] = joint.qdd.size());
+    njoint_data += (state._joint_sizes[k++] = joint.force.size());
+  }
+  state._joint_data.resize(njoint_data);
+  REAL* data = (njoint_data > 0) ? &state._joint_data[0] : NULL;
+  for (unsigned i=0; i< NJOINTS; i++)
+  {
+    const JOINT& joint = *_joints[i];
+    data = std::copy(joint.q.begin(), joint.q.end(), data);
+    data = std::copy(joint.qd.begin(), joint.qd.end(), data);
+    data = std::copy(joint.qdd.begin(), joint.qdd.end(), data);
+    data = std::copy(joint.force.begin(), joint.force.end(), data);
+  }
+
+  // save the induced poses, the link poses, and the link mixed poses
+  state._pose_data.resize((NJOINTS + NLINKS*2)*POSE_SIZE);
+  REAL* pose_data = &state._pose_data[0];
+  for (unsigned i=0; i< NJOINTS; i++)
+    pose_data = save_pose(*_joints[i]->_Fprime, pose_data);
+  for (unsigned i=0; i< NLINKS; i++)
+  {
+    pose_data = save_pose(*_links[i]->_F, pose_data);
+    pose_data = save_pose(*_links[i]->_F2, pose_data);
+  }
+
+  // save the data that update_link_poses() uses to detect moved links
+  state._q_applied = _q_applied;
+  state._q_tare_applied = _q_tare_applied;
+  state._geometry_version_applied = _geometry_version_applied;
+  state._base_pose_applied = _base_pose_applied;
+  state._poses_applied_valid = _poses_applied_valid;
+  state._link_pose_version = _link_pose_version;
+  state._body = this;
+
+  // save the link velocities, accelerations, and forces
+  state._xd.resize(NLINKS);
+  state._xdd.resize(NLINKS);
+  state._f.resize(NLINKS);
+  for (unsigned i=0; i< NLINKS; i++)
+  {
+    const RIGIDBODY& link = *_links[i];
+    state._xd[i] = link._xdcom;
+    state._xdd[i] = link._xddcom;
+    state._f[i] = link._forcecom;
+  }
+
+  // save the factorizations, if desired
+  if (save_factorizations)
+    update_factorized_generalized_inertia();
+  state._position_invalidated = _position_invalidated;
+  state._has_factorizations = save_factorizations;
+  if (!save_factorizations)
+    return state;
+  state._algorithm_type = algorithm_type;
+  state._rftype = _rftype;
+  state._implicit_inertia = _implicit_inertia;
+  if (algorithm_type == eCRB)
+  {
+    state._M = _crb._M;
+    state._fM = _crb._fM;
+    state._uM = _crb._uM;
+    state._vM = _crb._vM;
+    state._sM = _crb._sM;
+    state._gc_last = _crb._gc_last;
+    state._rank_deficient = _crb._rank_deficient;
+  }
+  else
+  {
+    state._I = _fsab._I;
+    state._Is = _fsab._Is;
+    state._sIs = _fsab._sIs;
+    state._usIs = _fsab._usIs;
+    state._vsIs = _fsab._vsIs;
+    state._ssIs = _fsab._ssIs;
+    state._fsab_rank_deficient = _fsab._rank_deficient;
+  }
+
+  return state;
+}
+
+/// Saves the orientation and origin of a pose into seven values
+REAL* RC_ARTICULATED_BODY::save_pose(const POSE3& P, REAL* data)
+{
+  *data++ = P.q.x;
+  *data++ = P.q.y;
+  *data++ = P.q.z;
+  *data++ = P.q.w;
+  *data++ = P.x[0];
+  *data++ = P.x[1];
+  *data++ = P.x[2];
+  return data;
+}
+
+/// Restores the orientation and origin of a pose from seven values
+const REAL* RC_ARTICULATED_BODY::restore_pose(const REAL* data, POSE3& P)
+{
+  P.q.x = *data++;
+  P.q.y = *data++;
+  P.q.z = *data++;
+  P.q.w = *data++;
+  P.x[0] = *data++;
+  P.x[1] = *data++;
+  P.x[2] = *data++;
+  return data;
+}
+
+/// Restores the state of this body from a snapshot 
+/**
+ * The link poses and velocities are restored directly from the snapshot; 
+ * neither update_link_poses() nor update_link_velocities() need be called.
+ * Pose-dependent quantities are only invalidated for links whose poses have
+ * changed since the snapshot was saved; if no link has moved, none are.
+ * If the snapshot holds the factorized generalized inertia (and the 
+ * forward dynamics algorithm and computation frame are unchanged since the
+ * snapshot was saved), forward dynamics will not refactorize the inertia.
+ * \param state a snapshot of this body saved using save_state()
+ */
+void RC_ARTICULATED_BODY::restore_state(const State& state)
+{
+  const unsigned NJOINTS = _joints.size(), NLINKS = _links.size();
+
+  #ifndef NEXCEPT
+  if (state._joint_sizes.size() != NJOINTS*4 || state._xd.size() != NLINKS)
+    throw std::runtime_error("RC_ARTICULATED_BODY::restore_state() - state was not saved from this body");
+  #endif
+
+  // the link velocities (generally) change
+  _velocity_version++;
+
+  // restore the joint quantities
+  const REAL* data = (state._joint_data.empty()) ? NULL : &state._joint_data[0];
+  for (unsigned i=0, k=0; i< NJOINTS; i++)
+  {
+    JOINT& joint = *_joints[i];
+    joint.q.resize(state._joint_sizes[k++]);
+    std::copy(data, data + joint.q.size(), joint.q.begin());
+    data += joint.q.size();
+    joint.qd.resize(state._joint_sizes[k++]);
+    std::copy(data, data + joint.qd.size(), joint.qd.begin());
+    data += joint.qd.size();
+    joint.qdd.resize(state._joint_sizes[k++]);
+    std::copy(data, data + joint.qdd.size(), joint.qdd.begin());
+    data += joint.qdd.size();
+    joint.force.resize(state._joint_sizes[k++]);
+    std::copy(data, data + joint.force.size(), joint.force.begin());
+    data += joint.force.size();
+  }
+
+  // restore the induced poses, the link poses, and the link mixed poses
+  const REAL* pose_data = &state._pose_data[0];
+  for (unsigned i=0; i< NJOINTS; i++)
+    pose_data = restore_pose(pose_data, *_joints[i]->_Fprime);
+  for (unsigned i=0; i< NLINKS; i++)
+  {
+    pose_data = restore_pose(pose_data, *_links[i]->_F);
+    pose_data = restore_pose(pose_data, *_links[i]->_F2);
+  }
+
+  // a link has moved since the snapshot was saved iff its pose version has
+  // changed; moved links get a new version (a saved version is not reused,
+  // as quantities cached for it may since have become stale)
+  bool moved = (state._body != this || _link_pose_version.size() != NLINKS ||
+                state._link_pose_version.size() != NLINKS);
+  _link_moved.assign(NLINKS, moved);
+  for (unsigned i=0; i< NLINKS && !moved; i++)
+    if (_link_pose_version[i] != state._link_pose_version[i])
+      _link_moved[i] = true;
+  for (unsigned i=0; i< NLINKS && !moved; i++)
+    moved = _link_moved[i];
+  if (moved)
+  {
+    _pose_version++;
+    _link_pose_version.resize(NLINKS);
+    for (unsigned i=0; i< NLINKS; i++)
+      if (_link_moved[i])
+        _link_pose_version[i] = _pose_version;
+    _position_invalidated = true;
+    _gravity_vector_valid = false;
+  }
+
+  // restore the data that update_link_poses() uses to detect moved links
+  _q_applied = state._q_applied;
+  _q_tare_applied = state._q_tare_applied;
+  _geometry_version_applied = state._geometry_version_applied;
+  _base_pose_applied = state._base_pose_applied;
+  _poses_applied_valid = state._poses_applied_valid && state._body == this;
+
+  // restore the link velocities, accelerations, and forces; pose 
+  // dependent quantities are recomputed as needed
+  for (unsigned i=0; i< NLINKS; i++)
+  {
+    RIGIDBODY& link = *_links[i];
+    link._xdcom = state._xd[i];
+    link._xddcom = state._xdd[i];
+    link._forcecom = state._f[i];
+    link._xdi_valid = link._xdj_valid = link._xd0_valid = false;
+    link._xddi_valid = link._xddj_valid = link._xdd0_valid = false;
+    link._forcei_valid = link._forcej_valid = link._force0_valid = false;
+    if (_link_moved[i])
+      link._Jj_valid = link._J0_valid = link._Jcom_valid = false;
+  }
+
+  // restore the factorizations, if possible; otherwise, the current
+  // factorizations remain valid only if no link has moved
+  if (!state._has_factorizations || state._algorithm_type != algorithm_type ||
+      state._rftype != _rftype)
+    return;
+  _implicit_inertia = state._implicit_inertia;
+  if (algorithm_type == eCRB)
+  {
+    _crb._M = state._M;
+    _crb._fM = state._fM;
+    _crb._uM = state._uM;
+    _crb._vM = state._vM;
+    _crb._sM = state._sM;
+    _crb._gc_last = state._gc_last;
+    _crb._rank_deficient = state._rank_deficient;
+  }
+  else
+  {
+    _fsab._I = state._I;
+    _fsab._Is = state._Is;
+    _fsab._sIs = state._sIs;
+    _fsab._usIs = state._usIs;
+    _fsab._vsIs = state._vsIs;
+    _fsab._ssIs = state._ssIs;
+    _fsab._rank_deficient = state._fsab_rank_deficient;
+  }
+  _position_invalidated = state._position_invalidated;
+}
+
 /// Computes the forward dynamics with loops
 /*
 void RC_ARTICULATED_BODY::calc_fwd_dyn_loops()
 {
   REAL Cx[6];
-  static MATRIXN Jx_iM_JxT, U, V;
-  static MATRIXN Jx_dot, iM_JxT;
-  static VECTORN v, fext, C, alpha_x, beta_x, Dx_v, Jx_v, Jx_dot_v, workv;
-  static VECTORN iM_fext, a, S;
+  MATRIXN Jx_iM_JxT, U, V;
+  MATRIXN Jx_dot, iM_JxT;
+  VECTORN v, fext, C, alpha_x, beta_x, Dx_v, Jx_v, Jx_dot_v, workv;
+  VECTORN iM_fext, a, S;
 
   // get the generalized velocity, generalized forces, and inverse generalized
   // inertia matrix
@@ -1142,15 +1862,13 @@ void RC_ARTICULATED_BODY::determine_implicit_constraint_jacobian_dot(MATRIXN& J)
 /// Sets the generalized acceleration for this body
 void RC_ARTICULATED_BODY::set_generalized_acceleration(const SHAREDVECTORN& a)
 {
-  static VECTORN base_a;
-
   if (_floating_base)
   {
-    a.get_sub_vec(num_joint_dof_explicit(), a.size(), base_a);
+    const unsigned BASE_START = num_joint_dof_explicit();
     shared_ptr<RIGIDBODY> base = _links.front();
     SACCEL xdd;
-    xdd.set_linear(VECTOR3(base_a[0], base_a[1], base_a[2]));
-    xdd.set_angular(VECTOR3(base_a[3], base_a[4], base_a[5]));
+    xdd.set_linear(VECTOR3(a[BASE_START+0], a[BASE_START+1], a[BASE_START+2]));
+    xdd.set_angular(VECTOR3(a[BASE_START+3], a[BASE_START+4], a[BASE_START+5]));
     base->set_accel(xdd);
   }
 
@@ -1183,9 +1901,21 @@ void RC_ARTICULATED_BODY::apply_impulse(const SMOMENTUM& w, shared_ptr<RIGIDBODY
       _crb.apply_impulse(w, link);
       break;
 
+    case eDivideAndConquer:
+      // the divide-and-conquer algorithm does not compute articulated inertias
+      update_factorized_generalized_inertia();
+      _fsab.apply_impulse(w, link);
+      break;
+
     default:
       assert(false);
   }
+
+  // the link velocities have changed
+  _velocity_version++;
+
+  // wake the body (or thaw subtrees) if the impulse was large enough
+  settle_resting_velocities();
 }
 
 /// Gets the generalized coordinates of this body
@@ -1268,58 +1998,116 @@ SHAREDVECTORN& RC_ARTICULATED_BODY::get_generalized_forces(SHAREDVECTORN& f)
 }
 
 /// Converts a force to a generalized force
+/**
+ * Only the joints between the link and the base are affected, so the
+ * generalized force is computed by walking from the link to the base.
+ */
 SHAREDVECTORN& RC_ARTICULATED_BODY::convert_to_generalized_force(shared_ptr<SINGLE_BODY> body, const SFORCE& w, SHAREDVECTORN& gf)
 {
-  const unsigned SPATIAL_DIM = 6;
-  static vector<SVELOCITY> J;
-  static vector<SVELOCITY> sprime;
-
   // get the body as a rigid body
   shared_ptr<RIGIDBODY> link = dynamic_pointer_cast<RIGIDBODY>(body);
   assert(link);
 
-  // get the gc frame
-  shared_ptr<const POSE3> P = _links.front()->get_gc_pose();
+  // resize gf
+  gf.resize(num_generalized_coordinates(DYNAMIC_BODY::eSpatial));
+  gf.set_zero();
+
+  // get the torque on the joints between the link and the base; the spatial
+  // dot product is computed in the frame of each joint's spatial axes
+  for (shared_ptr<JOINT> joint = link->get_inner_joint_explicit(); joint; joint = joint->get_inboard_link()->get_inner_joint_explicit())
+  {
+    const vector<SVELOCITY>& s = joint->get_spatial_axes();
+    if (s.empty())
+      continue;
+    const unsigned CIDX = joint->get_coord_index();
+    SHAREDVECTORN jf = gf.segment(CIDX, CIDX+s.size());
+    SPARITH::transpose_mult(s, POSE3::transform(s.front().pose, w), jf);
+  }
+
+  // determine the generalized force on the base, if the base is floating
+  if (_floating_base)
+  {
+    SHAREDVECTORN gfbase = gf.segment(num_joint_dof_explicit(), gf.size());
+    POSE3::transform(_links.front()->get_gc_pose(), w).to_vector(gfbase);
+  }
+
+  // return the generalized force vector
+  return gf;
+}
 
-  // get w in the mixed frame
-  SFORCE wP = POSE3::transform(P, w);
+/// Converts forces on any number of links to a single generalized force
+/**
+ * \param links the links to which the forces are applied (a link may appear
+ *        any number of times)
+ * \param w the forces (w[i] is applied to links[i])
+ * \param gf the sum of the generalized forces, on return
+ * The result is the sum of the generalized forces computed by
+ * convert_to_generalized_force() for each force, but the forces are summed
+ * on each link and then from the leaves toward the base, so the
+ * computation is linear in the number of links plus the number of forces.
+ * \note uses the current generalized coordinates
+ */
+SHAREDVECTORN& RC_ARTICULATED_BODY::convert_to_generalized_force(const vector<shared_ptr<RIGIDBODY> >& links, const vector<SFORCE>& w, SHAREDVECTORN& gf)
+{
+  #ifndef NEXCEPT
+  if (links.size() != w.size())
+    throw MissizeException();
+  #endif
 
-  // clear the Jacobian
-  J.resize(num_joint_dof_explicit());
-  for (unsigned i=0; i< J.size(); i++)
-    J[i] = SVELOCITY::zero(P);
+  // get the gc frame
+  shared_ptr<const POSE3> P = _links.front()->get_gc_pose();
 
-  // compute the Jacobian in w's frame
-  for (unsigned i=0; i< _ejoints.size(); i++)
+  // sum the forces on each link in the gc frame
+  _subtree_forces.resize(_links.size());
+  for (unsigned i=0; i< _links.size(); i++)
+    _subtree_forces[i] = SFORCE::zero(P);
+  for (unsigned i=0; i< links.size(); i++)
   {
-    // if link is not a descendent of this joint's outboard, keep looping
-    shared_ptr<RIGIDBODY> outboard = _ejoints[i]->get_outboard_link();
-    if (!outboard->is_descendant_link(link))
-      continue;
+    #ifndef NEXCEPT
+    if (links[i]->get_articulated_body() != get_this())
+      throw std::runtime_error("RC_ARTICULATED_BODY::convert_to_generalized_force() - link does not belong to this body");
+    #endif
+    _subtree_forces[links[i]->get_index()] += POSE3::transform(P, w[i]);
+  }
 
-    // transform the Jacobian
-    const vector<SVELOCITY>& s = _ejoints[i]->get_spatial_axes();
-    POSE3::transform(P, s, sprime);
-    for (unsigned j=0, k=_ejoints[i]->get_coord_index(); j < s.size(); j++, k++)
-      J[k] = sprime[j];
+  // sum the forces on each subtree, from the leaves toward the base
+  for (unsigned i=_link_order.size()-1; i > 0; i--)
+  {
+    const unsigned LINK = _link_order[i];
+    _subtree_forces[_parent_index[LINK]] += _subtree_forces[LINK];
   }
 
   // resize gf
   gf.resize(num_generalized_coordinates(DYNAMIC_BODY::eSpatial));
 
-  // get the torque on the joints
-  SHAREDVECTORN jf = gf.segment(0, J.size());
-  SPARITH::transpose_mult(J, wP, jf);
+  // the torque on each joint is due to the force on its outboard subtree
+  for (unsigned i=0; i< _ejoints.size(); i++)
+  {
+    const vector<SVELOCITY>& s = _ejoints[i]->get_spatial_axes();
+    if (s.empty())
+      continue;
+    const unsigned CIDX = _ejoints[i]->get_coord_index();
+    const SFORCE& wsub = _subtree_forces[_ejoints[i]->get_outboard_link()->get_index()];
+    SHAREDVECTORN jf = gf.segment(CIDX, CIDX+s.size());
+    SPARITH::transpose_mult(s, POSE3::transform(s.front().pose, wsub), jf);
+  }
 
-  // determine the generalized force on the base, if the base is floating
+  // the generalized force on a floating base is the total force on the body
   if (_floating_base)
   {
-    shared_ptr<RIGIDBODY> base = _links.front();
-    SHAREDVECTORN gfbase = gf.segment(J.size(), gf.size());
-    wP.to_vector(gfbase);
+    SHAREDVECTORN gfbase = gf.segment(num_joint_dof_explicit(), gf.size());
+    _subtree_forces[_link_order.front()].to_vector(gfbase);
   }
 
-  // return the generalized force vector
+  return gf;
+}
+
+/// Converts forces on any number of links to a single generalized force
+VECTORN& RC_ARTICULATED_BODY::convert_to_generalized_force(const vector<shared_ptr<RIGIDBODY> >& links, const vector<SFORCE>& w, VECTORN& gf)
+{
+  gf.resize(num_generalized_coordinates(DYNAMIC_BODY::eSpatial));
+  SHAREDVECTORN gf_shared = gf.segment(0, gf.size());
+  convert_to_generalized_force(links, w, gf_shared);
   return gf;
 }
 
@@ -1348,3 +2136,787 @@ bool RC_ARTICULATED_BODY::supports(boost::shared_ptr<JOINT> joint, shared_ptr<RI
 
 
 
+/// Gets the inertial parameters of the links (excluding the base)
+/**
+ * Each link contributes ten parameters, [m, m*cx, m*cy, m*cz, Ixx, Ixy, Ixz,
+ * Iyy, Iyz, Izz], where c is the center-of-mass and I is the inertia about
+ * the link origin, both expressed in the link frame. The parameters of the 
+ * link with index i begin at 10*(i-1). The inverse dynamics are linear in 
+ * these parameters (see calc_regressor()).
+ */
+VECTORN& RC_ARTICULATED_BODY::get_inertial_parameters(VECTORN& pi) const
+{
+  pi.resize(10*(_links.size()-1));
+  for (unsigned i=1; i< _links.size(); i++)
+  {
+    SPATIAL_RB_INERTIA J = POSE3::transform(_links[i]->get_pose(), _links[i]->get_inertia());
+    MATRIX3 hx = MATRIX3::skew_symmetric(J.h);
+    MATRIX3 Io = J.J - hx*hx*J.m;
+    REAL* p = pi.data() + 10*(i-1);
+    p[0] = J.m;
+    p[1] = J.m*J.h[0];
+    p[2] = J.m*J.h[1];
+    p[3] = J.m*J.h[2];
+    p[4] = Io(0,0);
+    p[5] = Io(0,1);
+    p[6] = Io(0,2);
+    p[7] = Io(1,1);
+    p[8] = Io(1,2);
+    p[9] = Io(2,2);
+  }
+
+  return pi;
+}
+
+/// Sets the inertial parameters of the links (excluding the base)
+/**
+ * \param pi the parameters, laid out as described in get_inertial_parameters()
+ */
+void RC_ARTICULATED_BODY::set_inertial_parameters(const VECTORN& pi)
+{
+  #ifndef NEXCEPT
+  if (pi.size() != 10*(_links.size()-1))
+    throw MissizeException();
+  #endif
+
+  for (unsigned i=1; i< _links.size(); i++)
+  {
+    const REAL* p = pi.data() + 10*(i-1);
+    const REAL m = p[0];
+    ORIGIN3 c = ORIGIN3::zero();
+    if (m > (REAL) 0.0)
+      c = ORIGIN3(p[1]/m, p[2]/m, p[3]/m);
+    MATRIX3 Io(p[4], p[5], p[6], p[5], p[7], p[8], p[6], p[8], p[9]);
+    MATRIX3 cx = MATRIX3::skew_symmetric(c);
+    shared_ptr<const POSE3> P = _links[i]->get_pose();
+    _links[i]->set_inertia(SPATIAL_RB_INERTIA(m, VECTOR3(c, P), Io + cx*cx*m, P));
+  }
+}
+
+/// Computes the regressor that maps the inertial parameters of the links to joint forces
+/**
+ * The regressor Y satisfies Y*pi = tau, where pi are the inertial parameters
+ * (see get_inertial_parameters()) and tau are the joint forces that produce
+ * the joint accelerations qdd at the current joint positions and velocities
+ * under gravity (and no other external forces). Link velocities and 
+ * accelerations are computed in a single outward pass (see 
+ * propagate_link_motion()); the ten parameter-wise link forces of each link
+ * are then propagated inward to the base, projecting onto the axes of each 
+ * joint along the way, for O(n^2) work in all. Gravity is included by accelerating the base by -gravity.
+ * \param qdd the joint accelerations
+ * \param gravity the gravitational acceleration
+ * \param Y the num_joint_dof_explicit() x 10*(number of links - 1) regressor
+ *        on return
+ * \note only fixed-base bodies without implicit joints are supported
+ */
+MATRIXN& RC_ARTICULATED_BODY::calc_regressor(const VECTORN& qdd, const VECTOR3& gravity, MATRIXN& Y)
+{
+  const unsigned NLINKS = _links.size();
+  vector<SFORCE> F(10);
+
+  #ifndef NEXCEPT
+  if (_floating_base || !_ijoints.empty())
+    throw std::runtime_error("RC_ARTICULATED_BODY::calc_regressor() only supports fixed-base bodies without implicit joints");
+  if (qdd.size() != num_joint_dof_explicit())
+    throw MissizeException();
+  #endif
+
+  // compute velocities and accelerations outward from the base
+  propagate_link_motion(&qdd, gravity, true);
+
+  // put the link velocities and accelerations and the link spatial axes
+  // into the link frames, and get the transforms from links to their parents
+  vector<SVELOCITY> v(NLINKS);
+  vector<SACCEL> a(NLINKS);
+  vector<vector<SVELOCITY> > s(NLINKS);
+  vector<TRANSFORM3> Xup(NLINKS);
+  shared_ptr<RIGIDBODY> base = _links.front();
+  for (unsigned i=0; i< NLINKS; i++)
+  {
+    if (_links[i] == base)
+      continue;
+    shared_ptr<const POSE3> P = _links[i]->get_pose();
+    v[i] = POSE3::transform(P, _link_v[i]);
+    a[i] = SPARITH::transform_accel(P, _link_a[i]);
+    POSE3::transform(P, _kinematics.s[i], s[i]);
+    Xup[i] = POSE3::calc_relative_pose(P, _links[i]->get_parent_link()->get_pose());
+  }
+
+  // compute the regressor one link (ten columns) at a time
+  Y.set_zero(num_joint_dof_explicit(), 10*(NLINKS-1));
+  for (unsigned i=1; i< NLINKS; i++)
+  {
+    // the link force is I*a + v x I*v; compute the (link frame) force 
+    // contributed by each parameter
+    shared_ptr<const POSE3> P = _links[i]->get_pose();
+    VECTOR3 omega = v[i].get_angular(), alpha = a[i].get_angular();
+    VECTOR3 abar = a[i].get_linear() + VECTOR3::cross(omega, v[i].get_linear());
+    VECTOR3 zero = VECTOR3::zero(P);
+    F[0] = SFORCE(abar, zero, P);
+    for (unsigned k=0; k< 3; k++)
+    {
+      VECTOR3 e = zero;
+      e[k] = (REAL) 1.0;
+      VECTOR3 f = VECTOR3::cross(alpha, e) + VECTOR3::cross(omega, VECTOR3::cross(omega, e));
+      F[k+1] = SFORCE(f, VECTOR3::cross(e, abar), P);
+    }
+
+    // the inertia contributes I*alpha + omega x I*omega; the six columns
+    // follow [Ixx, Ixy, Ixz, Iyy, Iyz, Izz]
+    const unsigned ROW[6] = { 0, 0, 0, 1, 1, 2 }, COL[6] = { 0, 1, 2, 1, 2, 2 };
+    for (unsigned k=0; k< 6; k++)
+    {
+      VECTOR3 Ia = zero, Iw = zero;
+      Ia[ROW[k]] += alpha[COL[k]];
+      Iw[ROW[k]] += omega[COL[k]];
+      if (ROW[k] != COL[k])
+      {
+        Ia[COL[k]] += alpha[ROW[k]];
+        Iw[COL[k]] += omega[ROW[k]];
+      }
+      F[k+4] = SFORCE(zero, Ia + VECTOR3::cross(omega, Iw), P);
+    }
+
+    // project the forces onto the axes of the link's inner joint and those
+    // of all of its ancestors
+    for (shared_ptr<RIGIDBODY> link = _links[i]; link != base; link = link->get_parent_link())
+    {
+      const unsigned j = link->get_index();
+      shared_ptr<JOINT> joint = link->get_inner_joint_explicit();
+      const unsigned CIDX = joint->get_coord_index();
+      for (unsigned r=0; r< s[j].size(); r++)
+        for (unsigned k=0; k< F.size(); k++)
+          Y(CIDX+r, 10*(i-1)+k) = s[j][r].dot(F[k]);
+      if (link->get_parent_link() != base)
+        for (unsigned k=0; k< F.size(); k++)
+          F[k] = Xup[j].transform(F[k]);
+    }
+  }
+
+  return Y;
+}
+
+/// Computes link velocities and accelerations in a single outward pass from the base
+/**
+ * The link velocities and accelerations are stored in _link_v and _link_a,
+ * in the link computation frames. The base moves with its current velocity
+ * (zero for a fixed base) and is accelerated by -gravity, so that gravity 
+ * acts on every link without external forces. The spatial axes, transforms,
+ * and link velocities are taken from the kinematics cache (see 
+ * get_kinematics()). This single propagation is shared by the CRB and RNE 
+ * algorithms, calc_regressor(), and the gravity and Coriolis/centrifugal 
+ * computations.
+ * \param qdd the joint accelerations, or NULL to use zero joint accelerations
+ * \param gravity the gravitational acceleration
+ * \param use_velocities if false, the joint and base velocities are treated
+ *        as zero
+ */
+void RC_ARTICULATED_BODY::propagate_link_motion(const VECTORN* qdd, const VECTOR3& gravity, bool use_velocities)
+{
+  const unsigned NLINKS = _links.size();
+  VECTORN qdd_i;
+
+  // get the kinematic quantities
+  update_pose_kinematics();
+  if (use_velocities)
+    update_velocity_kinematics();
+  const Kinematics& kin = _kinematics;
+
+  // setup the outputs
+  _link_v.resize(NLINKS);
+  _link_a.resize(NLINKS);
+
+  // setup the base velocity and acceleration
+  shared_ptr<RIGIDBODY> base = _links.front();
+  shared_ptr<const POSE3> P0 = base->get_computation_frame();
+  const unsigned BASE = base->get_index();
+  if (use_velocities && _floating_base)
+    _link_v[BASE] = kin.v[BASE];
+  else
+    _link_v[BASE] = SVELOCITY::zero(P0);
+  _link_a[BASE] = SACCEL(VECTOR3::zero(P0), -POSE3::transform_vector(P0, gravity), P0);
+
+  // process the links, parents before children
+  for (unsigned k=1; k< _link_order.size(); k++)
+  {
+    const unsigned i = _link_order[k], h = _parent_index[i];
+    const vector<SVELOCITY>& s = kin.s[i];
+
+    // get the parent's contributions
+    _link_v[i] = (use_velocities) ? kin.v[i] : kin.X[i].transform(_link_v[h]);
+    _link_a[i] = kin.X[i].transform(_link_a[h]);
+
+    // joints without degrees of freedom (e.g., fixed joints) contribute 
+    // nothing 
+    if (s.empty())
+      continue;
+
+    // add the contribution of the joint acceleration
+    shared_ptr<JOINT> joint = _links[i]->get_inner_joint_explicit();
+    if (qdd)
+    {
+      const unsigned CIDX = joint->get_coord_index();
+      qdd->get_sub_vec(CIDX, CIDX+joint->num_dof(), qdd_i);
+      _link_a[i] += SACCEL(SPARITH::mult(s, qdd_i));
+    }
+
+    // add the velocity-product contributions of the joint
+    if (!use_velocities)
+      continue;
+    SVELOCITY sqd = SPARITH::mult(s, joint->qd);
+    if (!kin.sdot[i].empty())
+      _link_a[i] += SACCEL(SPARITH::mult(kin.sdot[i], joint->qd));
+    _link_a[i] += SACCEL(_link_v[i].cross(sqd));
+  }
+}
+
+/// Computes the joint forces due to gravity and (optionally) the joint and base velocities
+/**
+ * Runs the recursive Newton-Euler algorithm with zero joint accelerations
+ * and no external forces.
+ */
+VECTORN& RC_ARTICULATED_BODY::calc_bias_forces(const VECTOR3& gravity, bool use_velocities, VECTORN& tau)
+{
+  const unsigned NLINKS = _links.size();
+  tau.set_zero(num_joint_dof_explicit());
+  if (NLINKS == 0)
+    return tau;
+
+  // compute velocities and accelerations outward from the base
+  propagate_link_motion(NULL, gravity, use_velocities);
+
+  // compute the force on each link necessary to realize its motion
+  _link_f.resize(NLINKS);
+  for (unsigned i=0; i< NLINKS; i++)
+  {
+    const SPATIAL_RB_INERTIA& J = _links[i]->get_inertia();
+    _link_f[i] = J * _link_a[i];
+    if (use_velocities)
+      _link_f[i] += _link_v[i].cross(J * _link_v[i]);
+  }
+
+  // propagate the forces inward, projecting them onto the joint axes
+  const unsigned BASE = _link_order.front();
+  for (unsigned k=_link_order.size()-1; k > 0; k--)
+  {
+    const unsigned i = _link_order[k], h = _parent_index[i];
+    if (!_kinematics.s[i].empty())
+    {
+      shared_ptr<JOINT> joint = _links[i]->get_inner_joint_explicit();
+      const unsigned CIDX = joint->get_coord_index();
+      SHAREDVECTORN tau_i = tau.segment(CIDX, CIDX+joint->num_dof());
+      SPARITH::transpose_mult(_kinematics.s[i], _link_f[i], tau_i);
+    }
+    if (h != BASE)
+      _link_f[h] += POSE3::transform(_link_f[h].pose, _link_f[i]);
+  }
+
+  return tau;
+}
+
+/// Computes the gravity vector g(q), the joint forces that statically balance gravity 
+/**
+ * The gravity vector is cached; it is recomputed only after the link poses
+ * (see update_link_poses() and invalidate_link_poses()) or the link 
+ * inertias (see set_inertial_parameters() and RIGIDBODY::set_inertia()) 
+ * change, the state is restored, or a different gravity vector is given. 
+ * \param gravity the gravitational acceleration
+ * \param g the num_joint_dof_explicit() dimensional gravity vector on return
+ * \note only fixed-base bodies without implicit joints are supported
+ */
+VECTORN& RC_ARTICULATED_BODY::calc_gravity_vector(const VECTOR3& gravity, VECTORN& g)
+{
+  #ifndef NEXCEPT
+  if (_floating_base || !_ijoints.empty())
+    throw std::runtime_error("RC_ARTICULATED_BODY::calc_gravity_vector() only supports fixed-base bodies without implicit joints");
+  #endif
+
+  // see whether the cached vector can be used
+  if (!_gravity_vector_valid || gravity.pose != _gravity_last.pose || 
+      gravity[0] != _gravity_last[0] || gravity[1] != _gravity_last[1] ||
+      gravity[2] != _gravity_last[2])
+  {
+    calc_bias_forces(gravity, false, _gravity_vector);
+    _gravity_last = gravity;
+    _gravity_vector_valid = true;
+  }
+
+  g = _gravity_vector;
+  return g;
+}
+
+/// Computes the Coriolis and centrifugal joint forces C(q, qd)*qd
+/**
+ * Runs the recursive Newton-Euler algorithm with the current joint 
+ * velocities, zero joint accelerations, and no gravity, for O(n) work.
+ * \param Cqd the num_joint_dof_explicit() dimensional vector on return
+ * \note only fixed-base bodies without implicit joints are supported
+ */
+VECTORN& RC_ARTICULATED_BODY::calc_coriolis_vector(VECTORN& Cqd)
+{
+  #ifndef NEXCEPT
+  if (_floating_base || !_ijoints.empty())
+    throw std::runtime_error("RC_ARTICULATED_BODY::calc_coriolis_vector() only supports fixed-base bodies without implicit joints");
+  #endif
+
+  return calc_bias_forces(VECTOR3::zero(), true, Cqd);
+}
+
+/// Multiplies a 6x6 matrix mapping spatial velocities to spatial forces by a spatial velocity 
+SFORCE RC_ARTICULATED_BODY::mult_bias_matrix(const MATRIXN& B, const SVELOCITY& v)
+{
+  SFORCE f = SFORCE::zero(v.pose);
+  for (unsigned j=0; j< 6; j++)
+  {
+    const REAL* Bj = B.data() + j*B.leading_dim();
+    for (unsigned i=0; i< 6; i++)
+      f[i] += Bj[i]*v[j];
+  }
+  return f;
+}
+
+/// Computes the Coriolis matrix C(q, qd)
+/**
+ * C satisfies C*qd = calc_coriolis_vector() and is chosen (using the 
+ * Christoffel-consistent factorization) so that dM/dt - 2C is skew-symmetric,
+ * as required by passivity-based controllers. Each link contributes 
+ * J'(I*dJ/dt + B*J) to C, where J is the link Jacobian and 
+ * B(v) = 1/2 (v x* I + (I*v) x- - I*(v x)) for link velocity v; composite 
+ * inertias and composite B matrices are accumulated inward from the leaves 
+ * and projected onto the joint axes of each link and its ancestors, for 
+ * O(n^2) work in all.
+ * \param C the num_joint_dof_explicit() x num_joint_dof_explicit() matrix on
+ *        return
+ * \note only fixed-base bodies without implicit joints are supported
+ */
+MATRIXN& RC_ARTICULATED_BODY::calc_coriolis_matrix(MATRIXN& C)
+{
+  const unsigned NLINKS = _links.size(), SPATIAL_DIM = 6;
+
+  #ifndef NEXCEPT
+  if (_floating_base || !_ijoints.empty())
+    throw std::runtime_error("RC_ARTICULATED_BODY::calc_coriolis_matrix() only supports fixed-base bodies without implicit joints");
+  #endif
+
+  C.set_zero(num_joint_dof_explicit(), num_joint_dof_explicit());
+  if (NLINKS == 0)
+    return C;
+
+  // compute link velocities outward from the base
+  propagate_link_motion(NULL, VECTOR3::zero(), true);
+
+  // everything is computed in the (fixed) frame of the base
+  const unsigned BASE = _link_order.front();
+  shared_ptr<const POSE3> P = _links[BASE]->get_pose();
+
+  // compute the spatial axes and their time derivatives, the link inertias, 
+  // and the link B matrices, all in the base frame
+  vector<vector<SVELOCITY> > s(NLINKS), sdot(NLINKS);
+  vector<SPATIAL_RB_INERTIA> IC(NLINKS);
+  vector<MATRIXN> BC(NLINKS);
+  vector<SVELOCITY> sdot_local;
+  for (unsigned k=1; k< _link_order.size(); k++)
+  {
+    const unsigned i = _link_order[k];
+    SVELOCITY v = POSE3::transform(P, _link_v[i]);
+
+    // the axes move with the link
+    POSE3::transform(P, _kinematics.s[i], s[i]);
+    sdot[i].resize(s[i].size());
+    for (unsigned r=0; r< s[i].size(); r++)
+      sdot[i][r] = v.cross(s[i][r]);
+    if (!_kinematics.sdot[i].empty())
+    {
+      POSE3::transform(P, _kinematics.sdot[i], sdot_local);
+      for (unsigned r=0; r< s[i].size(); r++)
+        sdot[i][r] += sdot_local[r];
+    }
+
+    // compute the inertia and B(v), one column at a time
+    IC[i] = POSE3::transform(P, _links[i]->get_inertia());
+    SMOMENTUM Iv = IC[i] * v;
+    BC[i].resize(SPATIAL_DIM, SPATIAL_DIM);
+    for (unsigned j=0; j< SPATIAL_DIM; j++)
+    {
+      SVELOCITY e = SVELOCITY::zero(P);
+      e[j] = (REAL) 1.0;
+      SFORCE Be = v.cross(IC[i] * e) + e.cross(Iv) - IC[i] * SACCEL(v.cross(e));
+      Be *= (REAL) 0.5;
+      std::copy(Be.data(), Be.data()+SPATIAL_DIM, BC[i].data()+j*SPATIAL_DIM);
+    }
+  }
+
+  // process the links, children before parents
+  for (unsigned k=_link_order.size()-1; k > 0; k--)
+  {
+    const unsigned j = _link_order[k], h = _parent_index[j];
+    const unsigned CJ = _links[j]->get_inner_joint_explicit()->get_coord_index();
+    for (unsigned r=0; r< s[j].size(); r++)
+    {
+      // compute the composite force terms for this axis
+      SFORCE F1 = IC[j] * SACCEL(sdot[j][r]) + mult_bias_matrix(BC[j], s[j][r]);
+      SMOMENTUM F2 = IC[j] * s[j][r];
+
+      // compute the block of C for the joint
+      for (unsigned c=0; c< s[j].size(); c++)
+        C(CJ+c, CJ+r) = s[j][c].dot(F1);
+
+      // compute the blocks of C for the joint and each of its ancestors 
+      for (unsigned i = h; i != BASE; i = _parent_index[i])
+      {
+        const unsigned CI = _links[i]->get_inner_joint_explicit()->get_coord_index();
+        for (unsigned c=0; c< s[i].size(); c++)
+        {
+          C(CI+c, CJ+r) = s[i][c].dot(F1);
+          C(CJ+r, CI+c) = sdot[i][c].dot(F2) + s[j][r].dot(mult_bias_matrix(BC[j], s[i][c]));
+        }
+      }
+    }
+
+    // update the parent's composite terms
+    if (h != BASE)
+    {
+      IC[h] += IC[j];
+      BC[h] += BC[j];
+    }
+  }
+
+  return C;
+}
+
+/// Data for computing the normal equations of a batch of samples in parallel 
+struct RC_ARTICULATED_BODY::RegressorBatch
+{
+  const MATRIXN* q;
+  const MATRIXN* qd;
+  const MATRIXN* qdd;
+  const MATRIXN* tau;
+  const VECTOR3* gravity;
+  unsigned ntasks;
+
+  // one copy of the body and one set of partial sums per task 
+  vector<shared_ptr<RC_ARTICULATED_BODY> > bodies;
+  vector<MATRIXN> YtY;
+  vector<VECTORN> Ytau;
+};
+
+/// Accumulates the normal equations for one contiguous range of samples
+void RC_ARTICULATED_BODY::calc_regressor_normal_equations_task(void* data, unsigned i)
+{
+  RegressorBatch& batch = *((RegressorBatch*) data);
+  RC_ARTICULATED_BODY& body = *batch.bodies[i];
+  const unsigned NSAMPLES = batch.q->columns();
+  const unsigned START = NSAMPLES*i/batch.ntasks;
+  const unsigned END = NSAMPLES*(i+1)/batch.ntasks;
+  VECTORN q, qd, qdd, tau, workv;
+  MATRIXN Y, workM;
+
+  for (unsigned j=START; j< END; j++)
+  {
+    // set the state
+    body.set_generalized_coordinates_euler(batch.q->get_column(j, q));
+    body.set_generalized_velocity(DYNAMIC_BODY::eSpatial, batch.qd->get_column(j, qd));
+
+    // compute the regressor and add this sample's contribution
+    body.calc_regressor(batch.qdd->get_column(j, qdd), *batch.gravity, Y);
+    batch.YtY[i] += Y.transpose_mult(Y, workM);
+    batch.Ytau[i] += Y.transpose_mult(batch.tau->get_column(j, tau), workv);
+  }
+}
+
+/// Computes the normal equations for identifying inertial parameters from a batch of samples
+/**
+ * Computes Y'*Y and Y'*tau, where Y is the regressor (see calc_regressor())
+ * of all samples stacked and tau are the measured joint forces stacked, so
+ * that the least-squares estimate of the inertial parameters solves 
+ * Y'*Y*pi = Y'*tau. Only the normal equations are formed, so memory is 
+ * independent of the number of samples. The samples are divided among 
+ * nthreads threads, each of which uses its own copy of this body (this body 
+ * is not modified).
+ * \param q the joint positions (one sample per column)
+ * \param qd the joint velocities (one sample per column)
+ * \param qdd the joint accelerations (one sample per column)
+ * \param tau the measured joint forces (one sample per column)
+ * \param gravity the gravitational acceleration
+ * \param YtY Y'*Y on return
+ * \param Ytau Y'*tau on return
+ * \param nthreads the number of threads to use; if zero, the number of 
+ *        processors is used
+ */
+void RC_ARTICULATED_BODY::calc_regressor_normal_equations(const MATRIXN& q, const MATRIXN& qd, const MATRIXN& qdd, const MATRIXN& tau, const VECTOR3& gravity, MATRIXN& YtY, VECTORN& Ytau, unsigned nthreads) const
+{
+  const unsigned NDOF = num_joint_dof_explicit();
+  const unsigned NSAMPLES = q.columns();
+  const unsigned NPARAMS = 10*(_links.size()-1);
+
+  #ifndef NEXCEPT
+  if (q.rows() != NDOF || qd.rows() != NDOF || qdd.rows() != NDOF || tau.rows() != NDOF)
+    throw MissizeException();
+  if (qd.columns() != NSAMPLES || qdd.columns() != NSAMPLES || tau.columns() != NSAMPLES)
+    throw MissizeException();
+  #endif
+
+  // setup the batch
+  RegressorBatch batch;
+  batch.q = &q;
+  batch.qd = &qd;
+  batch.qdd = &qdd;
+  batch.tau = &tau;
+  batch.gravity = &gravity;
+  if (nthreads == 0)
+    nthreads = ThreadPool::num_processors();
+  batch.ntasks = std::max((unsigned) 1, std::min(nthreads, NSAMPLES));
+  batch.bodies.resize(batch.ntasks);
+  batch.YtY.resize(batch.ntasks);
+  batch.Ytau.resize(batch.ntasks);
+  for (unsigned i=0; i< batch.ntasks; i++)
+  {
+    batch.bodies[i] = clone();
+    batch.YtY[i].set_zero(NPARAMS, NPARAMS);
+    batch.Ytau[i].set_zero(NPARAMS);
+  }
+
+  // compute the partial sums
+  if (batch.ntasks == 1)
+    calc_regressor_normal_equations_task(&batch, 0);
+  else
+  {
+    ThreadPool pool(batch.ntasks);
+    pool.run(batch.ntasks, &calc_regressor_normal_equations_task, &batch);
+  }
+
+  // sum the partial sums
+  YtY = batch.YtY[0];
+  Ytau = batch.Ytau[0];
+  for (unsigned i=1; i< batch.ntasks; i++)
+  {
+    YtY += batch.YtY[i];
+    Ytau += batch.Ytau[i];
+  }
+}
+
+/// Resets the data for sleeping and frozen links (called when the links change)
+void RC_ARTICULATED_BODY::reset_rest_data()
+{
+  _asleep = false;
+  _frozen.assign(_links.size(), false);
+  _rest_valid.assign(_links.size(), false);
+  _rest_forces.resize(_links.size());
+  _rest_joint_forces.resize(_links.size());
+  _wake_force.assign(_links.size(), (REAL) 0.0);
+  _wake_speed.assign(_links.size(), (REAL) 0.0);
+}
+
+/// Gets the links in the subtree rooted at the given link (connected by explicit joints), root first
+void RC_ARTICULATED_BODY::get_subtree(shared_ptr<RIGIDBODY> root, vector<shared_ptr<RIGIDBODY> >& subtree) const
+{
+  subtree.clear();
+  subtree.push_back(root);
+  for (unsigned i=0; i< subtree.size(); i++)
+  {
+    const std::set<shared_ptr<JOINT> >& outer = subtree[i]->get_outer_joints();
+    BOOST_FOREACH(shared_ptr<JOINT> joint, outer)
+      if (joint->get_constraint_type() == JOINT::eExplicit)
+        subtree.push_back(joint->get_outboard_link());
+  }
+}
+
+/// Puts this body to sleep
+/**
+ * A sleeping body is held at rest: its generalized velocity is zeroed and 
+ * calc_fwd_dyn() sets all accelerations to zero without computing dynamics.
+ * The forces applied to the links and joints on the first call to 
+ * calc_fwd_dyn() after this call (e.g., gravity and holding torques) are
+ * taken as the forces at rest. The body wakes when calc_fwd_dyn() finds that
+ * the force applied to any link (in its c.o.m. frame) or joint differs from 
+ * the force at rest by more than wake_force in any component, or when an 
+ * impulse changes any component of the generalized velocity by more than 
+ * wake_speed; smaller impulses are absorbed. Any frozen subtrees are thawed.
+ * \sa freeze()
+ * \sa SLEEP_MANAGER
+ */
+void RC_ARTICULATED_BODY::sleep(REAL wake_force, REAL wake_speed)
+{
+  // zero the generalized velocity
+  VECTORN gv;
+  get_generalized_velocity(DYNAMIC_BODY::eSpatial, gv);
+  gv.set_zero();
+  set_generalized_velocity(DYNAMIC_BODY::eSpatial, gv);
+
+  // every link rests 
+  _asleep = true;
+  std::fill(_frozen.begin(), _frozen.end(), false);
+  std::fill(_rest_valid.begin(), _rest_valid.end(), false);
+  std::fill(_wake_force.begin(), _wake_force.end(), wake_force);
+  std::fill(_wake_speed.begin(), _wake_speed.end(), wake_speed);
+}
+
+/// Wakes this body
+void RC_ARTICULATED_BODY::wake()
+{
+  _asleep = false;
+}
+
+/// Freezes the subtree rooted at the given link
+/**
+ * The joints of the subtree (the inner joint of link and all joints outboard
+ * of it) are locked: their speeds are zeroed and calc_fwd_dyn() holds their 
+ * accelerations at zero, so that the subtree moves as a single rigid body 
+ * with its parent. Forward dynamics for the remaining joints is computed 
+ * using the CRB algorithm (regardless of algorithm_type) by factorizing 
+ * only the rows and columns of the generalized inertia matrix that 
+ * correspond to them. As with sleep(), the subtree thaws when the forces 
+ * applied to its links or joints change by more than wake_force from those
+ * at the first call to calc_fwd_dyn(), or when an impulse moves one of its
+ * joints faster than wake_speed. Freezing is not supported for bodies with
+ * kinematic loops. 
+ * \param link a link other than the base
+ * \sa thaw()
+ */
+void RC_ARTICULATED_BODY::freeze(shared_ptr<RIGIDBODY> link, REAL wake_force, REAL wake_speed)
+{
+  #ifndef NEXCEPT
+  if (link->get_articulated_body() != get_this())
+    throw std::runtime_error("RC_ARTICULATED_BODY::freeze() - link does not belong to this body");
+  if (link->is_base())
+    throw std::runtime_error("RC_ARTICULATED_BODY::freeze() - the base cannot be frozen (use sleep() instead)");
+  if (!_ijoints.empty())
+    throw std::runtime_error("RC_ARTICULATED_BODY::freeze() - freezing is not supported for bodies with kinematic loops");
+  #endif
+
+  // lock the joints of the subtree
+  vector<shared_ptr<RIGIDBODY> > subtree;
+  get_subtree(link, subtree);
+  for (unsigned i=0; i< subtree.size(); i++)
+  {
+    unsigned idx = subtree[i]->get_index();
+    _frozen[idx] = true;
+    _rest_valid[idx] = false;
+    _wake_force[idx] = wake_force;
+    _wake_speed[idx] = wake_speed;
+    subtree[i]->get_inner_joint_explicit()->qd.set_zero();
+  }
+
+  // update the link velocities
+  update_link_velocities();
+}
+
+/// Thaws the frozen subtree that contains the given link
+/**
+ * \sa freeze()
+ */
+void RC_ARTICULATED_BODY::thaw(shared_ptr<RIGIDBODY> link)
+{
+  if (!is_frozen(link))
+    return;
+
+  // find the root of the frozen subtree
+  while (is_frozen(link->get_parent_link()))
+    link = link->get_parent_link();
+
+  // unlock its joints
+  vector<shared_ptr<RIGIDBODY> > subtree;
+  get_subtree(link, subtree);
+  for (unsigned i=0; i< subtree.size(); i++)
+    _frozen[subtree[i]->get_index()] = false;
+}
+
+/// Gets the number of joint DOF that are frozen
+unsigned RC_ARTICULATED_BODY::num_frozen_dof() const
+{
+  unsigned ndof = 0;
+  for (unsigned i=0; i< _ejoints.size(); i++)
+    if (is_frozen(_ejoints[i]->get_outboard_link()))
+      ndof += _ejoints[i]->num_dof();
+
+  return ndof;
+}
+
+/// Determines whether the forces applied to a resting subtree have changed
+/**
+ * Forces applied to links whose forces at rest have not been recorded are
+ * recorded instead.
+ */
+bool RC_ARTICULATED_BODY::rest_forces_changed(shared_ptr<RIGIDBODY> root)
+{
+  vector<shared_ptr<RIGIDBODY> > subtree;
+  get_subtree(root, subtree);
+  for (unsigned i=0; i< subtree.size(); i++)
+  {
+    shared_ptr<RIGIDBODY> link = subtree[i];
+    const unsigned IDX = link->get_index();
+    shared_ptr<JOINT> joint = (link->is_base()) ? shared_ptr<JOINT>() : link->get_inner_joint_explicit();
+
+    // record forces at rest
+    if (!_rest_valid[IDX])
+    {
+      _rest_forces[IDX] = link->_forcecom;
+      if (joint)
+        _rest_joint_forces[IDX] = joint->force;
+      _rest_valid[IDX] = true;
+      continue;
+    }
+
+    // compare the link force
+    for (unsigned j=0; j< 6; j++)
+      if (std::fabs(link->_forcecom[j] - _rest_forces[IDX][j]) > _wake_force[IDX])
+        return true;
+
+    // compare the joint force
+    if (joint)
+      for (unsigned j=0; j< joint->force.size(); j++)
+        if (std::fabs(joint->force[j] - _rest_joint_forces[IDX][j]) > _wake_force[IDX])
+          return true;
+  }
+
+  return false;
+}
+
+/// Wakes the body or thaws frozen subtrees that an impulse set moving; zeroes the velocities of those that remain at rest
+void RC_ARTICULATED_BODY::settle_resting_velocities()
+{
+  bool zeroed = false;
+
+  // a sleeping body absorbs small impulses
+  if (_asleep)
+  {
+    VECTORN gv;
+    get_generalized_velocity(DYNAMIC_BODY::eSpatial, gv);
+    if (gv.norm_inf() > _wake_speed.front())
+      wake();
+    else
+    {
+      gv.set_zero();
+      set_generalized_velocity(DYNAMIC_BODY::eSpatial, gv);
+    }
+    return;
+  }
+
+  // so does a frozen subtree
+  vector<shared_ptr<RIGIDBODY> > subtree;
+  for (unsigned i=1; i< _frozen.size(); i++)
+  {
+    if (!_frozen[i] || _frozen[_links[i]->get_parent_link()->get_index()])
+      continue;
+
+    // get the fastest joint in the subtree
+    get_subtree(_links[i], subtree);
+    REAL qd_max = (REAL) 0.0;
+    for (unsigned j=0; j< subtree.size(); j++)
+      qd_max = std::max(qd_max, subtree[j]->get_inner_joint_explicit()->qd.norm_inf());
+
+    if (qd_max > _wake_speed[i])
+      thaw(_links[i]);
+    else
+    {
+      for (unsigned j=0; j< subtree.size(); j++)
+        subtree[j]->get_inner_joint_explicit()->qd.set_zero();
+      zeroed = true;
+    }
+  }
+
+  // update the link velocities
+  if (zeroed)
+    update_link_velocities();
+}
+
@@ -45,79 +45,25 @@ map<shared_ptr<JOINT>, VECTORN> RNE_ALGORITHM::calc_inv_dyn_fixed_base(shared_pt
 
   // ** STEP 1: compute velocities and accelerations
 
-  // get the base link
-  shared_ptr<RIGIDBODY> base = links.front();
-
-  // setup the vector of link accelerations
-  vector<SACCEL> a(links.size(), SACCEL::zero());
-
-  // set frames for accelerations 
-  for (unsigned i=0; i< links.size(); i++)
-    a[i].pose = links[i]->get_computation_frame(); 
-  
-  // add all child links of the base to the processing queue
-  list<shared_ptr<RIGIDBODY> > child_links;
-  base->get_child_links(std::back_inserter(child_links)); 
-  BOOST_FOREACH(shared_ptr<RIGIDBODY> rb, child_links)
-    link_queue.push(rb);
-  
-  // process all links
-  while (!link_queue.empty())
+  // gather the desired joint accelerations
+  VECTORN qdd(body->num_joint_dof_explicit());
+  for (unsigned i=1; i< links.size(); i++)
   {
-    // get the link off of the front of the queue 
-    shared_ptr<RIGIDBODY> link = link_queue.front();
-    link_queue.pop();    
-    unsigned i = link->get_index();
-
-    // push all children of the link onto the queue
-    child_links.clear();
-    link->get_child_links(std::back_inserter(child_links)); 
-    BOOST_FOREACH(shared_ptr<RIGIDBODY> rb, child_links)
-      link_queue.push(rb);
-
-    // get the link's parent
-    shared_ptr<RIGIDBODY> parent(link->get_parent_link());
-    unsigned h = parent->get_index();
-
-    // get the joint for this link
-    shared_ptr<JOINT> joint(link->get_inner_joint_explicit());
-
-    // get the spatial link velocity
-    const SVELOCITY& v = link->get_velocity(); 
-
-    // get the current joint velocity
-    const VECTORN& qd = joint->qd;
-
-    // **** compute acceleration
-
-    // get the desired joint acceleration
-    idd_iter = inv_dyn_data.find(link);
+    shared_ptr<JOINT> joint(links[i]->get_inner_joint_explicit());
+    idd_iter = inv_dyn_data.find(links[i]);
     assert(idd_iter != inv_dyn_data.end());
-    const VECTORN& qdd_des = idd_iter->second.qdd;  
-
-    // get the spatial axes and time derivative
-    const vector<SVELOCITY>& s = joint->get_spatial_axes();
-    const vector<SVELOCITY>& sdot = joint->get_spatial_axes_dot();
-
-    // put s into the proper frame (that of v/a) (if necessary)
-    POSE3::transform(v.pose, s, sprime);  
-
-    // add this link's contribution
-    SVELOCITY sqd = SPARITH::mult(sprime, qd);
-    a[i] += SACCEL(v.cross(sqd));
-    a[i] += SACCEL(SPARITH::mult(s, qdd_des));
-
-    // put s into the proper frame (that of v/a) (if necessary)
-    POSE3::transform(v.pose, sdot, sprime);  
-    a[i] += SACCEL(SPARITH::mult(sprime, qd));
+    qdd.set_sub_vec(joint->get_coord_index(), idd_iter->second.qdd);
+  }
 
-    // now add parent's contribution
-    a[i] += SPARITH::transform_accel(a[i].pose, a[h]);
+  // compute the link accelerations outward from the base 
+  body->propagate_link_motion(&qdd, VECTOR3::zero(), true);
 
-    FILE_LOG(LOG_DYNAMICS) << " computing link velocity / acceleration; processing link " << link->body_id << endl;
-//    FILE_LOG(LOG_DYNAMICS) << "  spatial axes: " << s << endl;
-    FILE_LOG(LOG_DYNAMICS) << "  link velocity: " << v << endl;
-    FILE_LOG(LOG_DYNAMICS) << "  link accel: " << a[i] << endl;
+  // put the accelerations into the link computation frames
+  vector<SACCEL> a(links.size());
+  for (unsigned i=0; i< links.size(); i++)
+  {
+    a[i] = SPARITH::transform_accel(links[i]->get_computation_frame(), body->_link_a[i]);
+    FILE_LOG(LOG_DYNAMICS) << "  link accel for " << links[i]->body_id << ": " << a[i] << endl;
   }
   
   // ** STEP 2: compute link forces -- backward recursion
@@ -23,6 +23,22 @@ REVOLUTEJOINT::REVOLUTEJOINT() : JOINT()
   _s_dot.clear();
 }
 
+/// Makes a copy of this joint that uses the given frames (see JOINT::clone())
+shared_ptr<JOINT> REVOLUTEJOINT::clone(const PoseMap& poses) const
+{
+  shared_ptr<REVOLUTEJOINT> joint(new REVOLUTEJOINT(*this));
+
+  // point the frames and axes of the copy to the copied frames
+  joint->remap_poses(poses);
+  remap(joint->_u.pose, poses);
+  remap(joint->_ui.pose, poses);
+  remap(joint->_uj.pose, poses);
+  remap(joint->_v2.pose, poses);
+  remap(joint->_s_dot, poses);
+
+  return joint;
+}
+
 /// Sets the axis of rotation for this joint (MUST BE CALLED AFTER set_location(.))
 void REVOLUTEJOINT::set_axis(const VECTOR3& axis) 
 { 
@@ -31,6 +47,7 @@ void REVOLUTEJOINT::set_axis(const VECTOR3& axis)
 
   // transform the axis as necessary
   _u = VECTOR3::normalize(POSE3::transform_vector(_F, naxis));
+  _geometry_version++;
 
   // update the spatial axes
   update_spatial_axes(); 
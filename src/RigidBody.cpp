@@ -54,6 +54,10 @@ RIGIDBODY::RIGIDBODY()
 
   // set everything else
   _enabled = true;
+  _asleep = false;
+  _rest_force_valid = false;
+  _wake_force = _wake_speed = (REAL) 0.0;
+  _nskipped = 0;
   _link_idx = std::numeric_limits<unsigned>::max();
 
   // setup the default limit bound expansion
@@ -238,6 +242,29 @@ void RIGIDBODY::calc_fwd_dyn()
     if (!is_enabled())
       return;
 
+    // a sleeping body does not accelerate unless the applied force changes;
+    // the force applied on the first step asleep is taken as the rest force
+    if (_asleep)
+    {
+      if (!_rest_force_valid)
+      {
+        _rest_force = _forcecom;
+        _rest_force_valid = true;
+      }
+      REAL df = (REAL) 0.0;
+      for (unsigned i=0; i< 6; i++)
+        df = std::max(df, std::fabs(_forcecom[i] - _rest_force[i]));
+      if (df <= _wake_force)
+      {
+        set_accel(SACCEL::zero(_F2));
+        _nskipped++;
+        return;
+      }
+
+      FILE_LOG(LOG_DYNAMICS) << "RIGIDBODY::calc_fwd_dyn() - applied force woke body " << body_id << std::endl;
+      wake();
+    }
+
     // make sure that the inertia is reasonable
     const SPATIAL_RB_INERTIA& J = get_inertia();
     #ifndef NDEBUG
@@ -322,6 +349,46 @@ void RIGIDBODY::set_enabled(bool flag)
   }
 }
 
+/// Puts this (free) body to sleep
+/**
+ * A sleeping body is held at rest: its velocity is zeroed and 
+ * calc_fwd_dyn() sets its acceleration to zero without computing dynamics, 
+ * so that its pose and velocity do not change when integrated. The force 
+ * applied to the body on the first call to calc_fwd_dyn() after this call 
+ * (e.g., gravity) is taken as the force at rest. The body wakes when 
+ * calc_fwd_dyn() finds that the applied force (accumulated with add_force())
+ * differs from the force at rest by more than wake_force in any component, 
+ * or when apply_impulse() changes any component of its velocity by more
+ * than wake_speed; smaller impulses are absorbed.
+ * \param wake_force the change in applied force (link c.o.m. frame) that 
+ *        wakes the body
+ * \param wake_speed the change in velocity (link c.o.m. frame) that wakes 
+ *        the body
+ * \sa SLEEP_MANAGER
+ */
+void RIGIDBODY::sleep(REAL wake_force, REAL wake_speed)
+{
+  #ifndef NEXCEPT
+  if (!_abody.expired())
+    throw std::runtime_error("RIGIDBODY::sleep() - links sleep with their articulated body");
+  #endif
+
+  // zero the velocity and the acceleration
+  set_velocity(SVELOCITY::zero(_F2));
+  set_accel(SACCEL::zero(_F2));
+
+  _asleep = true;
+  _rest_force_valid = false;
+  _wake_force = wake_force;
+  _wake_speed = wake_speed;
+}
+
+/// Wakes this body
+void RIGIDBODY::wake()
+{
+  _asleep = false;
+}
+
 /// Sets the velocity of this body
 void RIGIDBODY::set_velocity(const SVELOCITY& xd)
 {
@@ -407,6 +474,13 @@ void RIGIDBODY::set_inertia(const SPATIAL_RB_INERTIA& inertia)
     _J0_valid = true;
     _J0 = inertia;
   }
+
+  // quantities of the articulated body that depend on the inertias are stale
+  if (!_abody.expired())
+  {
+    shared_ptr<ARTICULATED_BODY> ab(_abody);
+    ab->invalidate_inertias();
+  }
 }
 
 /// Gets the current sum of forces on this body
@@ -853,6 +927,18 @@ void RIGIDBODY::apply_impulse(const SMOMENTUM& w)
     SMOMENTUM wx = POSE3::transform(get_computation_frame(), w);
     SVELOCITY dxd = get_inertia().inverse_mult(wx);
 
+    // a sleeping body absorbs impulses that change its velocity only slightly
+    if (_asleep)
+    {
+      SVELOCITY dxdcom = POSE3::transform(_F2, dxd);
+      REAL dv = (REAL) 0.0;
+      for (unsigned i=0; i< 6; i++)
+        dv = std::max(dv, std::fabs(dxdcom[i]));
+      if (dv <= _wake_speed)
+        return;
+      wake();
+    }
+
     // update linear and angular velocities
     _xdcom += POSE3::transform(const_pointer_cast<const POSE3>(_F2), dxd);
 
@@ -1229,7 +1315,6 @@ SHAREDMATRIXN& RIGIDBODY::get_generalized_inertia_single(SHAREDMATRIXN& M)
 SHAREDMATRIXN& RIGIDBODY::get_generalized_inertia_inverse(SHAREDMATRIXN& M) const
 {
   const unsigned X = 0, Y = 1, Z = 2, SPATIAL_DIM = 6;
-  static LINALG _LA;
 
   // don't invert inertia for disabled bodies
   if (!_enabled)
@@ -46,9 +46,6 @@ REAL SFORCE::dot(const SVELOCITY& v2) const
     throw FrameException();
   #endif
 
-  const REAL* d1 = data();
-  const REAL* d2 = v2.data();
-  return d1[3]*d2[0] + d1[4]*d2[1] + d1[5]*d2[2]+
-         d1[0]*d2[3] + d1[1]*d2[4] + d1[2]*d2[5];
+  return SIMD3::spatial_dot(v2.data(), data());
 }
 
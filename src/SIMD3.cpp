@@ -0,0 +1,317 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+// the vectorized kernels are built with GCC's per-function target pragmas and
+// dispatched using the processor features detected at load time
+#if !defined(NSIMD) && defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#define RAVELIN_SIMD3_X86
+#endif
+
+namespace {
+
+/// The scalar kernels (always available)
+namespace Scalar {
+
+static void quat_mult(const REAL* q1, const REAL* q2, REAL* result)
+{
+  const REAL x = q1[0], y = q1[1], z = q1[2], w = q1[3];
+  const REAL qx = q2[0], qy = q2[1], qz = q2[2], qw = q2[3];
+  result[0] = w * qx + x * qw + y * qz - z * qy;
+  result[1] = w * qy + y * qw + z * qx - x * qz;
+  result[2] = w * qz + z * qw + x * qy - y * qx;
+  result[3] = w * qw - x * qx - y * qy - z * qz;
+}
+
+static void quat_rotate(const REAL* q, const REAL* v, REAL* result)
+{
+  const REAL x = q[0], y = q[1], z = q[2], w = q[3];
+  const REAL w2 = w*w;
+  const REAL x2 = x*x;
+  const REAL y2 = y*y;
+  const REAL z2 = z*z;
+  const REAL xy = x*y;
+  const REAL xz = x*z;
+  const REAL yz = y*z;
+  const REAL xw = x*w;
+  const REAL yw = y*w;
+  const REAL zw = z*w;
+  const REAL ox = v[0], oy = v[1], oz = v[2];
+  result[0] = (-1.0+2.0*(w2+x2))*ox + 2.0*((xy-zw)*oy + (yw+xz)*oz);
+  result[1] = 2.0*((xy+zw)*ox + (-xw+yz)*oz) + (-1.0+2.0*(w2+y2))*oy;
+  result[2] = 2.0*((-yw+xz)*ox + (xw+yz)*oy) + (-1.0+2.0*(w2+z2))*oz;
+}
+
+static void mult(const REAL* A, const REAL* B, REAL* C)
+{
+  for (unsigned j=0; j< 3; j++)
+  {
+    const REAL* b = B+j*3;
+    REAL* c = C+j*3;
+    c[0] = A[0]*b[0] + A[3]*b[1] + A[6]*b[2];
+    c[1] = A[1]*b[0] + A[4]*b[1] + A[7]*b[2];
+    c[2] = A[2]*b[0] + A[5]*b[1] + A[8]*b[2];
+  }
+}
+
+static void transpose_mult(const REAL* A, const REAL* B, REAL* C)
+{
+  for (unsigned j=0; j< 3; j++)
+  {
+    const REAL* b = B+j*3;
+    REAL* c = C+j*3;
+    c[0] = A[0]*b[0] + A[1]*b[1] + A[2]*b[2];
+    c[1] = A[3]*b[0] + A[4]*b[1] + A[5]*b[2];
+    c[2] = A[6]*b[0] + A[7]*b[1] + A[8]*b[2];
+  }
+}
+
+static void mult_transpose(const REAL* A, const REAL* B, REAL* C)
+{
+  for (unsigned j=0; j< 3; j++)
+  {
+    C[j*3+0] = A[0]*B[j] + A[3]*B[j+3] + A[6]*B[j+6];
+    C[j*3+1] = A[1]*B[j] + A[4]*B[j+3] + A[7]*B[j+6];
+    C[j*3+2] = A[2]*B[j] + A[5]*B[j+3] + A[8]*B[j+6];
+  }
+}
+
+static void transpose_mult_transpose(const REAL* A, const REAL* B, REAL* C)
+{
+  for (unsigned j=0; j< 3; j++)
+  {
+    C[j*3+0] = A[0]*B[j] + A[1]*B[j+3] + A[2]*B[j+6];
+    C[j*3+1] = A[3]*B[j] + A[4]*B[j+3] + A[5]*B[j+6];
+    C[j*3+2] = A[6]*B[j] + A[7]*B[j+3] + A[8]*B[j+6];
+  }
+}
+
+static void mult_vector(const REAL* A, const REAL* v, REAL* result)
+{
+  const REAL x = v[0], y = v[1], z = v[2];
+  result[0] = A[0]*x + A[3]*y + A[6]*z;
+  result[1] = A[1]*x + A[4]*y + A[7]*z;
+  result[2] = A[2]*x + A[5]*y + A[8]*z;
+}
+
+static void transpose_mult_vector(const REAL* A, const REAL* v, REAL* result)
+{
+  const REAL x = v[0], y = v[1], z = v[2];
+  result[0] = A[0]*x + A[1]*y + A[2]*z;
+  result[1] = A[3]*x + A[4]*y + A[5]*z;
+  result[2] = A[6]*x + A[7]*y + A[8]*z;
+}
+
+static void cross(const REAL* a, const REAL* b, REAL* result)
+{
+  result[0] = a[1]*b[2] - a[2]*b[1];
+  result[1] = a[2]*b[0] - a[0]*b[2];
+  result[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+static void skew_symmetric_mult(const REAL* a, const REAL* B, REAL* C)
+{
+  for (unsigned j=0; j< 3; j++)
+    cross(a, B+j*3, C+j*3);
+}
+
+static void spatial_cross_motion(const REAL* v, const REAL* u, REAL* result)
+{
+  REAL t1[3], t2[3];
+  cross(v+3, u, t1);
+  cross(v, u+3, t2);
+  cross(v, u, result);
+  result[3] = t1[0] + t2[0];
+  result[4] = t1[1] + t2[1];
+  result[5] = t1[2] + t2[2];
+}
+
+static void spatial_cross_force(const REAL* v, const REAL* f, REAL* result)
+{
+  REAL t1[3], t2[3];
+  cross(v, f+3, t1);
+  cross(v+3, f, t2);
+  cross(v, f, result);
+  result[3] = t1[0] + t2[0];
+  result[4] = t1[1] + t2[1];
+  result[5] = t1[2] + t2[2];
+}
+
+static REAL spatial_dot(const REAL* v, const REAL* f)
+{
+  return v[3]*f[0] + v[4]*f[1] + v[5]*f[2]+
+         v[0]*f[3] + v[1]*f[4] + v[2]*f[5];
+}
+
+static void spatial_transform(const REAL* E, const REAL* rx, const REAL* w, REAL* result)
+{
+  // copy the components of w, in case w and result are the same
+  const REAL top[3] = { w[0], w[1], w[2] };
+  REAL y[3];
+  mult_vector(rx, top, y);
+  y[0] = w[3] - y[0];
+  y[1] = w[4] - y[1];
+  y[2] = w[5] - y[2];
+  mult_vector(E, top, result);
+  mult_vector(E, y, result+3);
+}
+
+static void spatial_inverse_transform(const REAL* E, const REAL* xx, const REAL* w, REAL* result)
+{
+  // copy the components of w, in case w and result are the same
+  const REAL top[3] = { w[0], w[1], w[2] };
+  REAL y[3];
+  mult_vector(xx, top, y);
+  y[0] = w[3] - y[0];
+  y[1] = w[4] - y[1];
+  y[2] = w[5] - y[2];
+  transpose_mult_vector(E, top, result);
+  transpose_mult_vector(E, y, result+3);
+}
+
+} // end namespace Scalar
+
+#ifdef RAVELIN_SIMD3_X86
+typedef REAL V4 __attribute__((vector_size(4*sizeof(REAL))));
+
+// four doubles do not fit in a 128-bit register, so the SSE2 kernels are only
+// built in single precision (SIMD3f.cpp defines RAVELIN_SIMD3_SSE2)
+#ifdef RAVELIN_SIMD3_SSE2
+#pragma GCC push_options
+#pragma GCC target("sse2")
+namespace SSE2 {
+#include "SIMD3Kernels.inl"
+}
+#pragma GCC pop_options
+#endif
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+namespace AVX2 {
+#include "SIMD3Kernels.inl"
+}
+#pragma GCC pop_options
+
+// 3D vectors do not fill 512-bit registers; the AVX-512 kernels use the
+// 256-bit EVEX encodings (AVX-512VL) of the same operations
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512vl,avx2,fma")
+namespace AVX512 {
+#include "SIMD3Kernels.inl"
+}
+#pragma GCC pop_options
+#endif
+
+#define SIMD3_KERNEL_TABLE(ns) { &ns::quat_mult, &ns::quat_rotate, &ns::mult, &ns::transpose_mult, &ns::mult_transpose, &ns::transpose_mult_transpose, &ns::mult_vector, &ns::transpose_mult_vector, &ns::skew_symmetric_mult, &ns::spatial_cross_motion, &ns::spatial_cross_force, &ns::spatial_dot, &ns::spatial_transform, &ns::spatial_inverse_transform }
+
+const SIMD3::Kernels SCALAR_KERNELS = SIMD3_KERNEL_TABLE(Scalar);
+#ifdef RAVELIN_SIMD3_X86
+#ifdef RAVELIN_SIMD3_SSE2
+const SIMD3::Kernels SSE2_KERNELS = SIMD3_KERNEL_TABLE(SSE2);
+#endif
+const SIMD3::Kernels AVX2_KERNELS = SIMD3_KERNEL_TABLE(AVX2);
+const SIMD3::Kernels AVX512_KERNELS = SIMD3_KERNEL_TABLE(AVX512);
+#endif
+
+#undef SIMD3_KERNEL_TABLE
+
+} // end anonymous namespace
+
+// the scalar kernels are used until the instruction set is selected, so
+// that static initializers elsewhere may safely use the kernels
+SIMD3::InstructionSet SIMD3::_iset = SIMD3::eScalar;
+const SIMD3::Kernels* SIMD3::_kernels = &SCALAR_KERNELS;
+
+namespace {
+
+/// Selects the best available instruction set when the library is loaded
+struct SIMD3Selector
+{
+  SIMD3Selector() { SIMD3::set_instruction_set(SIMD3::detect_instruction_set()); }
+} SIMD3_SELECTOR;
+
+} // end anonymous namespace
+
+/// Gets the kernels for the given instruction set (NULL if they were not built or are not used in this precision)
+const SIMD3::Kernels* SIMD3::get_kernels(InstructionSet iset)
+{
+  switch (iset)
+  {
+    case eScalar: return &SCALAR_KERNELS;
+    #ifdef RAVELIN_SIMD3_X86
+    #ifdef RAVELIN_SIMD3_SSE2
+    case eSSE2:   return &SSE2_KERNELS;
+    #endif
+    case eAVX2:   return &AVX2_KERNELS;
+    case eAVX512: return &AVX512_KERNELS;
+    #endif
+    default:      return NULL;
+  }
+}
+
+/// Determines whether the kernels for the given instruction set were built and the processor supports them
+bool SIMD3::is_supported(InstructionSet iset)
+{
+  if (!get_kernels(iset))
+    return false;
+
+  #ifdef RAVELIN_SIMD3_X86
+  __builtin_cpu_init();
+  switch (iset)
+  {
+    case eScalar: return true;
+    case eSSE2:   return __builtin_cpu_supports("sse2");
+    case eAVX2:   return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case eAVX512: return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl");
+  }
+  #endif
+
+  return iset == eScalar;
+}
+
+/// Gets the best instruction set that is supported
+SIMD3::InstructionSet SIMD3::detect_instruction_set()
+{
+  if (is_supported(eAVX512))
+    return eAVX512;
+  else if (is_supported(eAVX2))
+    return eAVX2;
+  else if (is_supported(eSSE2))
+    return eSSE2;
+  else
+    return eScalar;
+}
+
+/// Gets the name of an instruction set
+const char* SIMD3::get_name(InstructionSet iset)
+{
+  switch (iset)
+  {
+    case eScalar: return "scalar";
+    case eSSE2:   return "SSE2";
+    case eAVX2:   return "AVX2";
+    case eAVX512: return "AVX-512";
+  }
+
+  return "unknown";
+}
+
+/// Sets the instruction set used by the kernels
+/**
+ * \return <b>true</b> if the instruction set is supported (otherwise, the
+ *         instruction set is not changed)
+ * \note the selection is global; it should not be changed while other
+ *       threads are using the library
+ */
+bool SIMD3::set_instruction_set(InstructionSet iset)
+{
+  if (!is_supported(iset))
+    return false;
+
+  _kernels = get_kernels(iset);
+  _iset = iset;
+  return true;
+}
+
@@ -0,0 +1,244 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+// The vectorized kernels of SIMD3. This file is included by SIMD3.cpp once
+// per instruction set, within a namespace for that instruction set and with
+// the compiler targeting that instruction set; V4 is a vector of four REALs.
+// 3D vectors and matrix columns occupy the first three lanes of a V4.
+
+/// Loads four consecutive elements
+static inline V4 load4(const REAL* p)
+{
+  V4 v;
+  std::memcpy(&v, p, sizeof(V4));
+  return v;
+}
+
+/// Stores all four lanes
+static inline void store4(REAL* p, const V4& v)
+{
+  std::memcpy(p, &v, sizeof(V4));
+}
+
+/// Loads a 3D vector that may be the last thing in its array (the last lane is zero)
+static inline V4 load3(const REAL* p)
+{
+  V4 v = { p[0], p[1], p[2], (REAL) 0.0 };
+  return v;
+}
+
+/// Stores the first three lanes
+static inline void store3(REAL* p, const V4& v)
+{
+  p[0] = v[0];
+  p[1] = v[1];
+  p[2] = v[2];
+}
+
+/// Loads the upper and lower halves of a 6D vector (the last lanes are undefined)
+static inline void load6(const REAL* p, V4& upper, V4& lower)
+{
+  upper = load4(p);
+  const V4 t = load4(p+2);
+  lower = __builtin_shufflevector(t, t, 1, 2, 3, 0);
+}
+
+/// Stores the upper and lower halves of a 6D vector
+static inline void store6(REAL* p, const V4& upper, const V4& lower)
+{
+  store4(p, upper);
+  store4(p+2, __builtin_shufflevector(upper, lower, 2, 4, 5, 6));
+}
+
+/// Loads the columns of a 3x3 matrix (the last lanes are undefined)
+static inline void load_columns(const REAL* A, V4& c0, V4& c1, V4& c2)
+{
+  c0 = load4(A);
+  c1 = load4(A+3);
+  const V4 t = load4(A+5);
+  c2 = __builtin_shufflevector(t, t, 1, 2, 3, 0);
+}
+
+/// Loads the rows of a 3x3 matrix (the last lanes are undefined)
+static inline void load_rows(const REAL* A, V4& r0, V4& r1, V4& r2)
+{
+  V4 c0, c1, c2;
+  load_columns(A, c0, c1, c2);
+  const V4 t01 = __builtin_shufflevector(c0, c1, 0, 1, 4, 5);
+  const V4 t12 = __builtin_shufflevector(c0, c1, 1, 2, 5, 6);
+  r0 = __builtin_shufflevector(t01, c2, 0, 2, 4, 4);
+  r1 = __builtin_shufflevector(t12, c2, 0, 2, 5, 5);
+  r2 = __builtin_shufflevector(t12, c2, 1, 3, 6, 6);
+}
+
+/// Stores the columns of a 3x3 matrix
+static inline void store_columns(REAL* C, const V4& c0, const V4& c1, const V4& c2)
+{
+  store4(C, c0);
+  store4(C+3, c1);
+  store4(C+5, __builtin_shufflevector(c1, c2, 2, 4, 5, 6));
+}
+
+/// Rotates the first three lanes of a vector: (a, b, c, d) -> (b, c, a, d)
+static inline V4 yzx(const V4& a)
+{
+  return __builtin_shufflevector(a, a, 1, 2, 0, 3);
+}
+
+/// Computes the cross product of two 3D vectors (the last lane is undefined)
+static inline V4 cross(const V4& a, const V4& b)
+{
+  // a x b = yzx(a*yzx(b) - yzx(a)*b)
+  return yzx(a*yzx(b) - yzx(a)*b);
+}
+
+/// Computes the dot product of two 3D vectors
+static inline REAL dot(const V4& a, const V4& b)
+{
+  const V4 p = a*b;
+  return p[0] + p[1] + p[2];
+}
+
+static void quat_mult(const REAL* q1, const REAL* q2, REAL* result)
+{
+  // the product is a linear combination of signed permutations of q2
+  const V4 b = load4(q2);
+  const V4 sx = { (REAL) 1.0, (REAL) -1.0, (REAL) 1.0, (REAL) -1.0 };
+  const V4 sy = { (REAL) 1.0, (REAL) 1.0, (REAL) -1.0, (REAL) -1.0 };
+  const V4 sz = { (REAL) -1.0, (REAL) 1.0, (REAL) 1.0, (REAL) -1.0 };
+  const V4 bx = __builtin_shufflevector(b, b, 3, 2, 1, 0)*sx;
+  const V4 by = __builtin_shufflevector(b, b, 2, 3, 0, 1)*sy;
+  const V4 bz = __builtin_shufflevector(b, b, 1, 0, 3, 2)*sz;
+  store4(result, b*q1[3] + bx*q1[0] + by*q1[1] + bz*q1[2]);
+}
+
+static void quat_rotate(const REAL* q, const REAL* v, REAL* result)
+{
+  // R*v = (2w^2 - 1)*v + 2*(u'v)*u + 2*w*(u x v), where u = [x y z]
+  const V4 u = load4(q);
+  const V4 x = load3(v);
+  const REAL w = q[3];
+  store3(result, x*(2*w*w - (REAL) 1.0) + u*(2*dot(u, x)) + cross(u, x)*(2*w));
+}
+
+static void mult(const REAL* A, const REAL* B, REAL* C)
+{
+  V4 a0, a1, a2;
+  load_columns(A, a0, a1, a2);
+  const V4 c0 = a0*B[0] + a1*B[1] + a2*B[2];
+  const V4 c1 = a0*B[3] + a1*B[4] + a2*B[5];
+  const V4 c2 = a0*B[6] + a1*B[7] + a2*B[8];
+  store_columns(C, c0, c1, c2);
+}
+
+static void transpose_mult(const REAL* A, const REAL* B, REAL* C)
+{
+  V4 r0, r1, r2;
+  load_rows(A, r0, r1, r2);
+  const V4 c0 = r0*B[0] + r1*B[1] + r2*B[2];
+  const V4 c1 = r0*B[3] + r1*B[4] + r2*B[5];
+  const V4 c2 = r0*B[6] + r1*B[7] + r2*B[8];
+  store_columns(C, c0, c1, c2);
+}
+
+static void mult_transpose(const REAL* A, const REAL* B, REAL* C)
+{
+  V4 a0, a1, a2;
+  load_columns(A, a0, a1, a2);
+  const V4 c0 = a0*B[0] + a1*B[3] + a2*B[6];
+  const V4 c1 = a0*B[1] + a1*B[4] + a2*B[7];
+  const V4 c2 = a0*B[2] + a1*B[5] + a2*B[8];
+  store_columns(C, c0, c1, c2);
+}
+
+static void transpose_mult_transpose(const REAL* A, const REAL* B, REAL* C)
+{
+  V4 r0, r1, r2;
+  load_rows(A, r0, r1, r2);
+  const V4 c0 = r0*B[0] + r1*B[3] + r2*B[6];
+  const V4 c1 = r0*B[1] + r1*B[4] + r2*B[7];
+  const V4 c2 = r0*B[2] + r1*B[5] + r2*B[8];
+  store_columns(C, c0, c1, c2);
+}
+
+static void mult_vector(const REAL* A, const REAL* v, REAL* result)
+{
+  V4 a0, a1, a2;
+  load_columns(A, a0, a1, a2);
+  store3(result, a0*v[0] + a1*v[1] + a2*v[2]);
+}
+
+static void transpose_mult_vector(const REAL* A, const REAL* v, REAL* result)
+{
+  // each element of the result is the dot product of a column of A and v
+  V4 a0, a1, a2;
+  load_columns(A, a0, a1, a2);
+  const V4 x = load3(v);
+  result[0] = dot(a0, x);
+  result[1] = dot(a1, x);
+  result[2] = dot(a2, x);
+}
+
+static void skew_symmetric_mult(const REAL* a, const REAL* B, REAL* C)
+{
+  // each column of the result is the cross product of a and a column of B
+  const V4 x = load3(a);
+  V4 b0, b1, b2;
+  load_columns(B, b0, b1, b2);
+  store_columns(C, cross(x, b0), cross(x, b1), cross(x, b2));
+}
+
+static void spatial_cross_motion(const REAL* v, const REAL* u, REAL* result)
+{
+  V4 a, b, top, bot;
+  load6(v, a, b);
+  load6(u, top, bot);
+  store6(result, cross(a, top), cross(b, top) + cross(a, bot));
+}
+
+static void spatial_cross_force(const REAL* v, const REAL* f, REAL* result)
+{
+  V4 a, b, lin, ang;
+  load6(v, a, b);
+  load6(f, lin, ang);
+  store6(result, cross(a, lin), cross(a, ang) + cross(b, lin));
+}
+
+static REAL spatial_dot(const REAL* v, const REAL* f)
+{
+  V4 vu, vl, fu, fl;
+  load6(v, vu, vl);
+  load6(f, fu, fl);
+  const V4 p = vl*fu + vu*fl;
+  return p[0] + p[1] + p[2];
+}
+
+static void spatial_transform(const REAL* E, const REAL* rx, const REAL* w, REAL* result)
+{
+  V4 e0, e1, e2, x0, x1, x2, top, bot;
+  load_columns(E, e0, e1, e2);
+  load_columns(rx, x0, x1, x2);
+  load6(w, top, bot);
+
+  // compute bot - rx*top
+  const V4 y = bot - (x0*top[0] + x1*top[1] + x2*top[2]);
+
+  store6(result, e0*top[0] + e1*top[1] + e2*top[2], e0*y[0] + e1*y[1] + e2*y[2]);
+}
+
+static void spatial_inverse_transform(const REAL* E, const REAL* xx, const REAL* w, REAL* result)
+{
+  V4 r0, r1, r2, x0, x1, x2, top, bot;
+  load_rows(E, r0, r1, r2);
+  load_columns(xx, x0, x1, x2);
+  load6(w, top, bot);
+
+  // compute bot - xx*top
+  const V4 y = bot - (x0*top[0] + x1*top[1] + x2*top[2]);
+
+  store6(result, r0*top[0] + r1*top[1] + r2*top[2], r0*y[0] + r1*y[1] + r2*y[2]);
+}
+
@@ -0,0 +1,16 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#include <cstring>
+#include <cstddef>
+#include <Ravelin/SIMD3d.h>
+
+using namespace Ravelin;
+
+#include <Ravelin/ddefs.h>
+#include "SIMD3.cpp"
+#include <Ravelin/undefs.h>
+
@@ -0,0 +1,18 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#include <cstring>
+#include <cstddef>
+#include <Ravelin/SIMD3f.h>
+
+using namespace Ravelin;
+
+#include <Ravelin/fdefs.h>
+#define RAVELIN_SIMD3_SSE2
+#include "SIMD3.cpp"
+#undef RAVELIN_SIMD3_SSE2
+#include <Ravelin/undefs.h>
+
@@ -13,10 +13,7 @@ REAL SVELOCITY::dot(const SMOMENTUM& v2) const
     throw FrameException();
   #endif
 
-  const REAL* d1 = data();
-  const REAL* d2 = v2.data();
-  return d1[3]*d2[0] + d1[4]*d2[1] + d1[5]*d2[2]+
-         d1[0]*d2[3] + d1[1]*d2[4] + d1[2]*d2[5];
+  return SIMD3::spatial_dot(data(), v2.data());
 }
 
 /// Computes the dot product between a velocity and a force 
@@ -28,10 +25,7 @@ REAL SVELOCITY::dot(const SFORCE& v2) const
     throw FrameException();
   #endif
 
-  const REAL* d1 = data();
-  const REAL* d2 = v2.data();
-  return d1[3]*d2[0] + d1[4]*d2[1] + d1[5]*d2[2]+
-         d1[0]*d2[3] + d1[1]*d2[4] + d1[2]*d2[5];
+  return SIMD3::spatial_dot(data(), v2.data());
 }
 
 /// Returns the spatial cross product between two velocity vectors
@@ -43,15 +37,9 @@ SVELOCITY SVELOCITY::cross(const SVELOCITY& v) const
     throw FrameException();
   #endif
 
-  VECTOR3 ax = get_angular();
-  VECTOR3 bx = get_linear();
-
-  // multiply
-  VECTOR3 vtop = v.get_angular();
-  VECTOR3 vbot = v.get_linear();
-  VECTOR3 top = VECTOR3::cross(ax, vtop);
-  VECTOR3 bot = VECTOR3::cross(bx, vtop) + VECTOR3::cross(ax, vbot);
-  return SVELOCITY(top, bot, pose);
+  SVELOCITY result(pose);
+  SIMD3::spatial_cross_motion(data(), v.data(), result.data());
+  return result;
 }
 
 /// Returns the spatial cross product between a velocity and a momentum (force)
@@ -67,14 +55,8 @@ SFORCE SVELOCITY::cross(const SMOMENTUM& m) const
     throw FrameException();
   #endif
 
-  VECTOR3 ax = get_angular();
-  VECTOR3 bx = get_linear();
-
-  // multiply
-  VECTOR3 vtop = m.get_angular();
-  VECTOR3 vbot = m.get_linear();
-  VECTOR3 top = VECTOR3::cross(ax, vtop) + VECTOR3::cross(bx, vbot);
-  VECTOR3 bot = VECTOR3::cross(ax, vbot);
-  return SFORCE(bot, top, pose);
+  SFORCE result(pose);
+  SIMD3::spatial_cross_force(data(), m.data(), result.data());
+  return result;
 }
 
@@ -14,6 +14,7 @@
 #include <Ravelin/SVelocityd.h>
 #include <Ravelin/SForced.h>
 #include <Ravelin/SVector6d.h>
+#include <Ravelin/SIMD3d.h>
 
 using namespace Ravelin;
 
@@ -14,6 +14,7 @@
 #include <Ravelin/SVelocityf.h>
 #include <Ravelin/SForcef.h>
 #include <Ravelin/SVector6f.h>
+#include <Ravelin/SIMD3f.h>
 
 using namespace Ravelin;
 
@@ -24,7 +24,7 @@ void SHAREDMATRIXN::reset_from(const SHAREDMATRIXN& source)
 {
   _rows = source.rows();
   _columns = source.columns();
-  _ld = source.rows();
+  _ld = source.leading_dim();
   _start = source._start;
   _data = source._data;
 }
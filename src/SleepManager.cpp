@@ -0,0 +1,302 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+using boost::shared_ptr;
+using std::vector;
+
+/// Constructs a sleep manager with default thresholds
+SLEEP_MANAGER::SLEEP_MANAGER()
+{
+  linear_velocity_threshold = (REAL) 0.01;
+  angular_velocity_threshold = (REAL) 0.02;
+  kinetic_energy_threshold = (REAL) 1e-4;
+  joint_velocity_threshold = (REAL) 0.01;
+  time_to_sleep = (REAL) 0.5;
+  wake_factor = (REAL) 2.0;
+  wake_force_threshold = (REAL) 1e-3;
+  freeze_subtrees = true;
+  _sleeps = _wakes = _freezes = _thaws = 0;
+}
+
+/// Adds a free rigid body to be put to sleep when it comes to rest
+void SLEEP_MANAGER::add_body(shared_ptr<RIGIDBODY> body)
+{
+  #ifndef NEXCEPT
+  if (body->get_articulated_body())
+    throw std::runtime_error("SLEEP_MANAGER::add_body() - links are managed with their articulated body");
+  #endif
+
+  Entry e;
+  e.rb = body;
+  e.rest_time = (REAL) 0.0;
+  e.asleep = body->is_asleep();
+  _entries.push_back(e);
+}
+
+/// Adds an articulated body to be put to sleep (or have its subtrees frozen) when it comes to rest
+void SLEEP_MANAGER::add_body(shared_ptr<RC_ARTICULATED_BODY> body)
+{
+  const vector<shared_ptr<RIGIDBODY> >& links = body->get_links();
+
+  Entry e;
+  e.ab = body;
+  e.rest_time = (REAL) 0.0;
+  e.joint_rest_time.resize(links.size(), (REAL) 0.0);
+  e.asleep = body->is_asleep();
+  e.frozen.resize(links.size());
+  for (unsigned i=0; i< links.size(); i++)
+    e.frozen[i] = body->is_frozen(links[i]);
+  _entries.push_back(e);
+}
+
+/// Removes a body from management, waking it (and thawing its subtrees)
+void SLEEP_MANAGER::remove_body(shared_ptr<DYNAMIC_BODY> body)
+{
+  for (unsigned i=0; i< _entries.size(); i++)
+  {
+    Entry& e = _entries[i];
+    if (e.rb && e.rb == body)
+      e.rb->wake();
+    else if (e.ab && e.ab == body)
+    {
+      e.ab->wake();
+      const vector<shared_ptr<RIGIDBODY> >& links = e.ab->get_links();
+      for (unsigned j=1; j< links.size(); j++)
+        e.ab->thaw(links[j]);
+    }
+    else
+      continue;
+
+    _entries.erase(_entries.begin()+i);
+    return;
+  }
+}
+
+/// Updates the rest times of all managed bodies, putting bodies to sleep and freezing subtrees
+/**
+ * \param dt the integration step size
+ */
+void SLEEP_MANAGER::update(REAL dt)
+{
+  for (unsigned i=0; i< _entries.size(); i++)
+    update(_entries[i], dt);
+}
+
+/// Gets counts of bodies at rest and of the work skipped
+SLEEP_MANAGER::Statistics SLEEP_MANAGER::get_statistics() const
+{
+  const unsigned SPATIAL_DIM = 6;
+
+  Statistics stats;
+  stats.bodies_asleep = stats.frozen_dof = 0;
+  stats.skipped_dynamics = stats.skipped_dof = 0;
+  stats.sleeps = _sleeps;
+  stats.wakes = _wakes;
+  stats.freezes = _freezes;
+  stats.thaws = _thaws;
+  for (unsigned i=0; i< _entries.size(); i++)
+  {
+    const Entry& e = _entries[i];
+    if (e.rb)
+    {
+      if (e.rb->is_asleep())
+        stats.bodies_asleep++;
+      stats.skipped_dynamics += e.rb->get_num_skipped_dynamics();
+      stats.skipped_dof += SPATIAL_DIM*e.rb->get_num_skipped_dynamics();
+    }
+    else
+    {
+      if (e.ab->is_asleep())
+        stats.bodies_asleep++;
+      stats.frozen_dof += e.ab->num_frozen_dof();
+      stats.skipped_dynamics += e.ab->get_num_skipped_dynamics();
+      stats.skipped_dof += e.ab->get_num_skipped_dof();
+    }
+  }
+
+  return stats;
+}
+
+/// Determines whether a body (or link) is quiescent
+/**
+ * \param scale the multiple of the velocity thresholds to use
+ */
+bool SLEEP_MANAGER::is_quiescent(shared_ptr<RIGIDBODY> link, REAL scale) const
+{
+  // get the velocity of the center-of-mass
+  SVELOCITY xd = POSE3::transform(link->get_mixed_pose(), link->get_velocity());
+  if (xd.get_linear().norm() > scale*linear_velocity_threshold)
+    return false;
+  if (xd.get_angular().norm() > scale*angular_velocity_threshold)
+    return false;
+
+  // check the kinetic energy per unit mass
+  REAL KE = link->calc_kinetic_energy(link->get_mixed_pose());
+  return KE <= scale*scale*kinetic_energy_threshold*link->get_mass();
+}
+
+/// Gets the smallest time that the inner joints of the links in a subtree have been quiescent
+REAL SLEEP_MANAGER::calc_subtree_rest_time(const Entry& e, shared_ptr<RIGIDBODY> link) const
+{
+  REAL t = e.joint_rest_time[link->get_index()];
+  const std::set<shared_ptr<JOINT> >& outer = link->get_outer_joints();
+  for (std::set<shared_ptr<JOINT> >::const_iterator i = outer.begin(); i != outer.end(); i++)
+    if ((*i)->get_constraint_type() == JOINT::eExplicit)
+      t = std::min(t, calc_subtree_rest_time(e, (*i)->get_outboard_link()));
+
+  return t;
+}
+
+/// Freezes each maximal subtree of an articulated body whose joints have been quiescent long enough
+void SLEEP_MANAGER::freeze_resting_subtrees(Entry& e)
+{
+  shared_ptr<RC_ARTICULATED_BODY> ab = e.ab;
+  const REAL WAKE_SPEED = wake_factor*joint_velocity_threshold;
+
+  // process links from the base outward
+  vector<shared_ptr<RIGIDBODY> > links(1, ab->get_base_link());
+  for (unsigned i=0; i< links.size(); i++)
+  {
+    shared_ptr<RIGIDBODY> link = links[i];
+    if (!link->is_base())
+    {
+      // subtrees of frozen subtrees are frozen with them
+      if (ab->is_frozen(link))
+        continue;
+
+      if (calc_subtree_rest_time(e, link) >= time_to_sleep)
+      {
+        FILE_LOG(LOG_DYNAMICS) << "SLEEP_MANAGER::update() - freezing subtree at " << link->body_id << std::endl;
+        ab->freeze(link, wake_force_threshold, WAKE_SPEED);
+        _freezes++;
+        continue;
+      }
+    }
+
+    // process the children
+    const std::set<shared_ptr<JOINT> >& outer = link->get_outer_joints();
+    for (std::set<shared_ptr<JOINT> >::const_iterator j = outer.begin(); j != outer.end(); j++)
+      if ((*j)->get_constraint_type() == JOINT::eExplicit)
+        links.push_back((*j)->get_outboard_link());
+  }
+}
+
+/// Updates the rest time of a single body
+void SLEEP_MANAGER::update(Entry& e, REAL dt)
+{
+  // update a free rigid body
+  if (e.rb)
+  {
+    shared_ptr<RIGIDBODY> rb = e.rb;
+    if (!rb->is_enabled())
+      return;
+
+    // wake the body if it was set moving (e.g., by setting its velocity)
+    if (rb->is_asleep() && !is_quiescent(rb, wake_factor))
+      rb->wake();
+
+    // the body must rest for the full interval again after waking
+    if (e.asleep && !rb->is_asleep())
+    {
+      FILE_LOG(LOG_DYNAMICS) << "SLEEP_MANAGER::update() - body " << rb->body_id << " woke" << std::endl;
+      e.rest_time = (REAL) 0.0;
+      _wakes++;
+    }
+    if ((e.asleep = rb->is_asleep()))
+      return;
+
+    // update the rest time
+    e.rest_time = (is_quiescent(rb, (REAL) 1.0)) ? e.rest_time + dt : (REAL) 0.0;
+    if (e.rest_time >= time_to_sleep)
+    {
+      FILE_LOG(LOG_DYNAMICS) << "SLEEP_MANAGER::update() - body " << rb->body_id << " sleeping" << std::endl;
+      rb->sleep(wake_force_threshold, wake_factor*std::max(linear_velocity_threshold, angular_velocity_threshold));
+      e.asleep = true;
+      _sleeps++;
+    }
+
+    return;
+  }
+
+  // update an articulated body
+  shared_ptr<RC_ARTICULATED_BODY> ab = e.ab;
+  const vector<shared_ptr<RIGIDBODY> >& links = ab->get_links();
+  if (links.size() != e.joint_rest_time.size())
+  {
+    e.joint_rest_time.assign(links.size(), (REAL) 0.0);
+    e.frozen.assign(links.size(), false);
+  }
+
+  // wake the body if it was set moving
+  if (ab->is_asleep())
+  {
+    for (unsigned i=0; i< links.size(); i++)
+      if (!is_quiescent(links[i], wake_factor) || (!links[i]->is_base() && links[i]->get_inner_joint_explicit()->qd.norm_inf() > wake_factor*joint_velocity_threshold))
+      {
+        ab->wake();
+        break;
+      }
+  }
+
+  // the body must rest for the full interval again after waking
+  if (e.asleep && !ab->is_asleep())
+  {
+    FILE_LOG(LOG_DYNAMICS) << "SLEEP_MANAGER::update() - body " << ab->body_id << " woke" << std::endl;
+    e.rest_time = (REAL) 0.0;
+    std::fill(e.joint_rest_time.begin(), e.joint_rest_time.end(), (REAL) 0.0);
+    _wakes++;
+  }
+  if ((e.asleep = ab->is_asleep()))
+    return;
+
+  // count the frozen subtrees that have thawed
+  for (unsigned i=1; i< links.size(); i++)
+    if (e.frozen[i] && !ab->is_frozen(links[i]))
+    {
+      unsigned parent = links[i]->get_parent_link()->get_index();
+      if (!e.frozen[parent] || ab->is_frozen(links[parent]))
+        _thaws++;
+    }
+
+  // update the rest times of the joints; joints of thawed subtrees must rest
+  // for the full interval again
+  bool body_quiescent = true;
+  for (unsigned i=0; i< links.size(); i++)
+  {
+    const bool FROZEN = ab->is_frozen(links[i]);
+    bool joint_quiescent = FROZEN || links[i]->is_base() || links[i]->get_inner_joint_explicit()->qd.norm_inf() <= joint_velocity_threshold;
+    if (e.frozen[i] && !FROZEN)
+      e.joint_rest_time[i] = (REAL) 0.0;
+    else if (!FROZEN)
+      e.joint_rest_time[i] = (joint_quiescent) ? e.joint_rest_time[i] + dt : (REAL) 0.0;
+    e.frozen[i] = FROZEN;
+
+    if (!joint_quiescent || !is_quiescent(links[i], (REAL) 1.0))
+      body_quiescent = false;
+  }
+
+  // update the rest time of the body
+  e.rest_time = (body_quiescent) ? e.rest_time + dt : (REAL) 0.0;
+  if (e.rest_time >= time_to_sleep)
+  {
+    FILE_LOG(LOG_DYNAMICS) << "SLEEP_MANAGER::update() - body " << ab->body_id << " sleeping" << std::endl;
+    REAL wake_speed = std::max(joint_velocity_threshold, std::max(linear_velocity_threshold, angular_velocity_threshold));
+    ab->sleep(wake_force_threshold, wake_factor*wake_speed);
+    std::fill(e.frozen.begin(), e.frozen.end(), false);
+    e.asleep = true;
+    _sleeps++;
+    return;
+  }
+
+  // freeze resting subtrees
+  if (freeze_subtrees && ab->get_implicit_joints().empty())
+  {
+    freeze_resting_subtrees(e);
+    for (unsigned i=0; i< links.size(); i++)
+      e.frozen[i] = ab->is_frozen(links[i]);
+  }
+}
+
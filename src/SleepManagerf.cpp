@@ -0,0 +1,20 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#include <cmath>
+#include <algorithm>
+#include <Ravelin/Log.h>
+#include <Ravelin/Jointf.h>
+#include <Ravelin/RigidBodyf.h>
+#include <Ravelin/RCArticulatedBodyf.h>
+#include <Ravelin/SleepManagerf.h>
+
+using namespace Ravelin;
+
+#include <Ravelin/fdefs.h>
+#include "SleepManager.cpp"
+#include <Ravelin/undefs.h>
+
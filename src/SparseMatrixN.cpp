@@ -26,6 +26,9 @@ SPARSEMATRIXN::SPARSEMATRIXN(StorageType stype, unsigned m, unsigned n)
 { 
   _rows = m; 
   _columns = n; 
+  _nnz = 0;
+  _nnz_capacity = 0;
+  _ptr_capacity = 0;
   _stype = stype;
 }
 
@@ -44,12 +47,80 @@ SPARSEMATRIXN::SPARSEMATRIXN(StorageType stype, unsigned m, unsigned n, shared_a
   _rows = m;
   _columns = n;
   _stype = stype;
-  _nnz = _ptr[_rows];
-  _nnz_capacity = _nnz;
-  _ptr_capacity = _rows+1;
   _data = data; 
   _ptr = ptr; 
   _indices = indices; 
+  _ptr_capacity = (stype == eCSR) ? _rows+1 : _columns+1;
+  _nnz = _ptr[_ptr_capacity-1];
+  _nnz_capacity = _nnz;
+}
+
+/// Copy constructor
+/**
+ * Copies the nonzero data, like operator=(); the copy does not share storage
+ * with m.
+ */
+SPARSEMATRIXN::SPARSEMATRIXN(const SPARSEMATRIXN& m)
+{
+  _rows = _columns = 0;
+  _nnz = 0;
+  _nnz_capacity = 0;
+  _ptr_capacity = 0;
+  _stype = m._stype;
+  operator=(m);
+}
+
+#if __cplusplus >= 201103L
+/// Move constructor
+/**
+ * Takes the storage of m (no data is copied); m becomes an empty matrix.
+ */
+SPARSEMATRIXN::SPARSEMATRIXN(SPARSEMATRIXN&& m) noexcept
+{
+  _rows = _columns = 0;
+  _nnz = 0;
+  _nnz_capacity = 0;
+  _ptr_capacity = 0;
+  _stype = m._stype;
+  swap(m);
+}
+
+/// Move assignment operator
+/**
+ * Takes the storage of m (no data is copied); m becomes an empty matrix.
+ */
+SPARSEMATRIXN& SPARSEMATRIXN::operator=(SPARSEMATRIXN&& m) noexcept
+{
+  if (this != &m)
+  {
+    swap(m);
+    m._data.reset();
+    m._ptr.reset();
+    m._indices.reset();
+    m._rows = m._columns = 0;
+    m._nnz = m._nnz_capacity = m._ptr_capacity = 0;
+  }
+
+  return *this;
+}
+#endif
+
+/// Swaps the contents of this matrix with m
+/**
+ * Only the underlying arrays are exchanged; no elements are copied.
+ */
+SPARSEMATRIXN& SPARSEMATRIXN::swap(SPARSEMATRIXN& m)
+{
+  _data.swap(m._data);
+  _ptr.swap(m._ptr);
+  _indices.swap(m._indices);
+  std::swap(_nnz, m._nnz);
+  std::swap(_rows, m._rows);
+  std::swap(_columns, m._columns);
+  std::swap(_nnz_capacity, m._nnz_capacity);
+  std::swap(_ptr_capacity, m._ptr_capacity);
+  std::swap(_stype, m._stype);
+  return *this;
 }
 
 /// Creates a sparse matrix from a dense matrix
@@ -79,7 +150,7 @@ SPARSEMATRIXN::SPARSEMATRIXN(const MATRIXN& m, REAL tol)
   unsigned j = 0;
   unsigned k=0;
   _ptr[0] = j;
-  CONST_COLUMN_ITERATOR i = m.column_iterator_begin();
+  CONST_ROW_ITERATOR i = m.row_iterator_begin();
   for (unsigned r=0; r< m.rows(); r++)
   {
     for (unsigned s=0; s< m.columns(); s++, i++)
@@ -126,7 +197,7 @@ SPARSEMATRIXN::SPARSEMATRIXN(StorageType stype, const MATRIXN& m, REAL tol)
     unsigned j=0;
     unsigned k=0;
     _ptr[0] = j;
-    CONST_COLUMN_ITERATOR i = m.column_iterator_begin();
+    CONST_ROW_ITERATOR i = m.row_iterator_begin();
     for (unsigned r=0; r< m.rows(); r++)
     {
       for (unsigned s=0; s< m.columns(); s++, i++)
@@ -158,7 +229,7 @@ SPARSEMATRIXN::SPARSEMATRIXN(StorageType stype, const MATRIXN& m, REAL tol)
     unsigned j = 0;
     unsigned k=0;
     _ptr[0] = j;
-    CONST_ROW_ITERATOR i = m.row_iterator_begin();
+    CONST_COLUMN_ITERATOR i = m.column_iterator_begin();
     for (unsigned col=0; col< m.columns(); col++)
     {
       for (unsigned row=0; row< m.rows(); row++, i++)
@@ -284,24 +355,15 @@ void SPARSEMATRIXN::get_values(map<pair<unsigned, unsigned>, REAL>& values) cons
 /// Sets the column with the particular index
 void SPARSEMATRIXN::set_column(unsigned col, const VECTORN& v)
 {
-  if (_stype == eCSR)
-  {
-    // get the values
-    map<pair<unsigned, unsigned>, REAL> values; 
-    get_values(values);
-
-    // remove all values from column
-    for (unsigned i=0; i< _rows; i++)
-      values.erase(make_pair(i, col));
-
-    // update the map
-    for (unsigned i=0; i< v.size(); i++)
-      if (v[i] > EPS || v[i] < -EPS)
-        values[make_pair(i,col)] = v[i];
+  #ifndef NEXCEPT
+  if (col >= _columns)
+    throw InvalidIndexException();
+  if (v.size() != _rows)
+    throw MissizeException();
+  #endif 
 
-    // update the matrix
-    set(_rows, _columns, values); 
-  }
+  if (_stype == eCSR)
+    set_minor(col, v);
   else
   {
     assert(_stype == eCSC);
@@ -330,7 +392,7 @@ void SPARSEMATRIXN::set_column(unsigned col, const VECTORN& v)
     
       // update ptr
       unsigned* ptr = _ptr.get();
-      std::transform(ptr+col+1, ptr+_nnz+1, ptr+col+1, _1 + nextra);
+      std::transform(ptr+col+1, ptr+_columns+1, ptr+col+1, _1 + nextra);
 
       // update the number of nonzero entries
       _nnz += nextra;
@@ -348,7 +410,7 @@ void SPARSEMATRIXN::set_column(unsigned col, const VECTORN& v)
     
       // update ptr
       unsigned* ptr = _ptr.get();
-      std::transform(ptr+col+1, ptr+_nnz+1, ptr+col+1, _1 - nfewer);
+      std::transform(ptr+col+1, ptr+_columns+1, ptr+col+1, _1 - nfewer);
 
       // update the number of nonzero entries
       _nnz -= nfewer;
@@ -371,6 +433,8 @@ void SPARSEMATRIXN::set_row(unsigned row, const VECTORN& v)
   #ifndef NEXCEPT
   if (row >= _rows)
     throw InvalidIndexException();
+  if (v.size() != _columns)
+    throw MissizeException();
   #endif 
 
   if (_stype == eCSR)
@@ -399,7 +463,7 @@ void SPARSEMATRIXN::set_row(unsigned row, const VECTORN& v)
     
       // update ptr
       unsigned* ptr = _ptr.get();
-      std::transform(ptr+row+1, ptr+_nnz+1, ptr+row+1, _1 + nextra);
+      std::transform(ptr+row+1, ptr+_rows+1, ptr+row+1, _1 + nextra);
 
       // update the number of nonzero entries
       _nnz += nextra;
@@ -417,7 +481,7 @@ void SPARSEMATRIXN::set_row(unsigned row, const VECTORN& v)
     
       // update ptr
       unsigned* ptr = _ptr.get();
-      std::transform(ptr+row+1, ptr+_nnz+1, ptr+row+1, _1 - nfewer);
+      std::transform(ptr+row+1, ptr+_rows+1, ptr+row+1, _1 - nfewer);
 
       // update the number of nonzero entries
       _nnz -= nfewer;
@@ -435,23 +499,60 @@ void SPARSEMATRIXN::set_row(unsigned row, const VECTORN& v)
   else
   {
     assert(_stype == eCSC);
+    set_minor(row, v);
+  }
+}
 
-    // get the values
-    map<pair<unsigned, unsigned>, REAL> values; 
-    get_values(values);
+/// Sets the column (row, if CSC) with the particular index 
+/**
+ * The nonzeros are merged into new arrays in a single pass over the matrix.
+ */
+void SPARSEMATRIXN::set_minor(unsigned idx, const VECTORN& v)
+{
+  const unsigned N = (_stype == eCSR) ? _rows : _columns;
 
-    // remove all values from row 
-    for (unsigned i=0; i< _columns; i++)
-      values.erase(make_pair(row, i));
+  // setup new arrays, large enough for all nonzeros in v
+  const unsigned CAPACITY = _nnz + N;
+  shared_array<unsigned> indices(new unsigned[CAPACITY]);
+  shared_array<REAL> data(new REAL[CAPACITY]);
 
-    // update the map
-    for (unsigned i=0; i< v.size(); i++)
-      if (v[i] > EPS || v[i] < -EPS)
-        values[make_pair(row, i)] = v[i];
+  // process each row (column, if CSC)
+  unsigned k = 0;
+  for (unsigned i=0, j=_ptr[0]; i< N; i++)
+  {
+    const unsigned END = _ptr[i+1];
+    _ptr[i] = k;
+
+    // copy nonzeros before idx
+    for (; j < END && _indices[j] < idx; j++, k++)
+    {
+      indices[k] = _indices[j];
+      data[k] = _data[j];
+    }
 
-    // update the matrix
-    set(_rows, _columns, values); 
+    // skip any existing nonzero at idx and store the new one
+    if (j < END && _indices[j] == idx)
+      j++;
+    if (v[i] > EPS || v[i] < -EPS)
+    {
+      indices[k] = idx;
+      data[k++] = v[i];
+    }
+
+    // copy nonzeros after idx
+    for (; j < END; j++, k++)
+    {
+      indices[k] = _indices[j];
+      data[k] = _data[j];
+    }
   }
+  _ptr[N] = k;
+
+  // store the new arrays
+  _indices = indices;
+  _data = data;
+  _nnz = k;
+  _nnz_capacity = CAPACITY;
 }
 
 /// Sets up a sparse matrix from a map 
@@ -856,6 +957,8 @@ SPARSEMATRIXN SPARSEMATRIXN::get_sub_mat(unsigned rstart, unsigned rend, unsigne
   sub._indices = indices;
   sub._data = data;
   sub._nnz = nv;
+  sub._nnz_capacity = nv;
+  sub._ptr_capacity = (_stype == eCSR) ? rend - rstart + 1 : cend - cstart + 1;
 
   return sub;
 }
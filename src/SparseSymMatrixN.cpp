@@ -0,0 +1,517 @@
+/****************************************************************************
+ * Copyright 2013 Evan Drumwright
+ * This library is distributed under the terms of the GNU  General Public
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+SPARSESYMMATRIXN::SPARSESYMMATRIXN()
+{
+  _n = 0;
+  _nnz = 0;
+  _tri = eUpper;
+}
+
+SPARSESYMMATRIXN::SPARSESYMMATRIXN(Triangle t)
+{
+  _n = 0;
+  _nnz = 0;
+  _tri = t;
+}
+
+/// Creates a sparse symmetric matrix from a map of values
+/**
+ * Values outside of the requested triangle are ignored; the map need
+ * only contain one triangle.
+ */
+SPARSESYMMATRIXN::SPARSESYMMATRIXN(Triangle t, unsigned n, const map<pair<unsigned, unsigned>, REAL>& values)
+{
+  _n = 0;
+  _nnz = 0;
+  set(t, n, values);
+}
+
+/// Creates a sparse symmetric matrix from one triangle of a (full) sparse matrix
+/**
+ * \note the symmetry of m is not verified; only the entries of m in the
+ *       requested triangle are used
+ */
+SPARSESYMMATRIXN::SPARSESYMMATRIXN(Triangle t, const SPARSEMATRIXN& m)
+{
+  #ifndef NEXCEPT
+  if (m.rows() != m.columns())
+    throw NonsquareMatrixException();
+  #endif
+
+  _n = m.rows();
+  _nnz = 0;
+  _tri = t;
+
+  // get the arrays from m
+  const unsigned* mptr = m.get_ptr();
+  const unsigned* mindices = m.get_indices();
+  const REAL* mdata = m.get_data();
+  const bool CSR = (m.get_storage_type() == SPARSEMATRIXN::eCSR);
+
+  // count the nonzeros in each column of the triangle
+  vector<unsigned> cnt(_n, 0);
+  for (unsigned k=0; k< _n; k++)
+    for (unsigned p=mptr[k]; p< mptr[k+1]; p++)
+    {
+      unsigned i = (CSR) ? k : mindices[p];
+      unsigned j = (CSR) ? mindices[p] : k;
+      if ((t == eUpper && i <= j) || (t == eLower && i >= j))
+        cnt[j]++;
+    }
+
+  // setup the arrays
+  allocate(_n, std::accumulate(cnt.begin(), cnt.end(), 0U));
+  _ptr[0] = 0;
+  for (unsigned j=0; j< _n; j++)
+    _ptr[j+1] = _ptr[j] + cnt[j];
+
+  // copy the values; row indices remain sorted because the outer loop
+  // proceeds in increasing row (CSR) or column (CSC) order
+  std::copy(_ptr.get(), _ptr.get()+_n, cnt.begin());
+  for (unsigned k=0; k< _n; k++)
+    for (unsigned p=mptr[k]; p< mptr[k+1]; p++)
+    {
+      unsigned i = (CSR) ? k : mindices[p];
+      unsigned j = (CSR) ? mindices[p] : k;
+      if ((t == eUpper && i <= j) || (t == eLower && i >= j))
+      {
+        unsigned q = cnt[j]++;
+        _indices[q] = i;
+        _data[q] = mdata[p];
+      }
+    }
+}
+
+/// Creates a sparse symmetric matrix from one triangle of a dense matrix
+SPARSESYMMATRIXN::SPARSESYMMATRIXN(Triangle t, const MATRIXN& m, REAL tol)
+{
+  #ifndef NEXCEPT
+  if (m.rows() != m.columns())
+    throw NonsquareMatrixException();
+  #endif
+
+  _n = m.rows();
+  _nnz = 0;
+  _tri = t;
+
+  // determine number of non-zero values in the triangle
+  unsigned nv = 0;
+  for (unsigned j=0; j< _n; j++)
+  {
+    const unsigned START = (t == eUpper) ? 0 : j;
+    const unsigned END = (t == eUpper) ? j+1 : _n;
+    for (unsigned i=START; i< END; i++)
+      if (std::fabs(m(i,j)) > tol)
+        nv++;
+  }
+
+  // setup the arrays
+  allocate(_n, nv);
+  unsigned k = 0;
+  _ptr[0] = 0;
+  for (unsigned j=0; j< _n; j++)
+  {
+    const unsigned START = (t == eUpper) ? 0 : j;
+    const unsigned END = (t == eUpper) ? j+1 : _n;
+    for (unsigned i=START; i< END; i++)
+      if (std::fabs(m(i,j)) > tol)
+      {
+        _indices[k] = i;
+        _data[k] = m(i,j);
+        k++;
+      }
+    _ptr[j+1] = k;
+  }
+}
+
+/// Allocates arrays for an n x n matrix with nnz stored nonzeros
+void SPARSESYMMATRIXN::allocate(unsigned n, unsigned nnz)
+{
+  _n = n;
+  _nnz = nnz;
+  _ptr = shared_array<unsigned>(new unsigned[n+1]);
+  _indices = shared_array<unsigned>(new unsigned[nnz]);
+  _data = shared_array<REAL>(new REAL[nnz]);
+}
+
+/// Sets the matrix from a map of values
+void SPARSESYMMATRIXN::set(Triangle t, unsigned n, const map<pair<unsigned, unsigned>, REAL>& values)
+{
+  typedef map<pair<unsigned, unsigned>, REAL> ValueMap;
+
+  _tri = t;
+
+  // count the nonzeros in each column of the triangle
+  vector<unsigned> cnt(n, 0);
+  for (ValueMap::const_iterator i = values.begin(); i != values.end(); i++)
+  {
+    const unsigned row = i->first.first, col = i->first.second;
+    if ((t == eUpper && row <= col) || (t == eLower && row >= col))
+      cnt[col]++;
+  }
+
+  // setup the arrays
+  allocate(n, std::accumulate(cnt.begin(), cnt.end(), 0U));
+  _ptr[0] = 0;
+  for (unsigned j=0; j< n; j++)
+    _ptr[j+1] = _ptr[j] + cnt[j];
+
+  // map is ordered by (row, column), so row indices are placed in order
+  std::copy(_ptr.get(), _ptr.get()+n, cnt.begin());
+  for (ValueMap::const_iterator i = values.begin(); i != values.end(); i++)
+  {
+    const unsigned row = i->first.first, col = i->first.second;
+    if ((t == eUpper && row <= col) || (t == eLower && row >= col))
+    {
+      unsigned q = cnt[col]++;
+      _indices[q] = row;
+      _data[q] = i->second;
+    }
+  }
+}
+
+/// Gets all values from the stored triangle of the matrix
+void SPARSESYMMATRIXN::get_values(map<pair<unsigned, unsigned>, REAL>& values) const
+{
+  values.clear();
+  for (unsigned j=0; j< _n; j++)
+    for (unsigned k=_ptr[j]; k< _ptr[j+1]; k++)
+      values[make_pair(_indices[k], j)] = _data[k];
+}
+
+/// Computes the infinity norm of this sparse matrix
+REAL SPARSESYMMATRIXN::norm_inf() const
+{
+  REAL nrm = (REAL) 0.0;
+  for (unsigned k=0; k< _nnz; k++)
+    nrm = std::max(nrm, std::fabs(_data[k]));
+  return nrm;
+}
+
+/// Sets up a sparse symmetric identity matrix
+SPARSESYMMATRIXN SPARSESYMMATRIXN::identity(Triangle t, unsigned n)
+{
+  SPARSESYMMATRIXN m(t);
+  m.allocate(n, n);
+
+  // populate the matrix data, indices, and column pointers
+  for (unsigned i=0; i< n; i++)
+  {
+    m._data[i] = (REAL) 1.0;
+    m._indices[i] = i;
+    m._ptr[i] = i;
+  }
+  m._ptr[n] = n;
+
+  return m;
+}
+
+/// Multiplies this sparse symmetric matrix by a dense vector
+/**
+ * Each stored off-diagonal entry is read once and applied to both the
+ * entry and its transposed counterpart.
+ */
+VECTORN& SPARSESYMMATRIXN::mult(const VECTORN& x, VECTORN& result) const
+{
+  #ifndef NEXCEPT
+  if (_n != x.size())
+    throw MissizeException();
+  #endif
+
+  // setup the result vector
+  result.set_zero(_n);
+
+  // get data vectors
+  const REAL* xdata = x.data();
+  REAL* rdata = result.data();
+
+  for (unsigned col=0; col< _n; col++)
+  {
+    const REAL xcol = xdata[col];
+    REAL dot = (REAL) 0.0;
+    for (unsigned jj= _ptr[col]; jj < _ptr[col+1]; jj++)
+    {
+      const unsigned row = _indices[jj];
+      rdata[row] += _data[jj] * xcol;
+      if (row != col)
+        dot += _data[jj] * xdata[row];
+    }
+    rdata[col] += dot;
+  }
+
+  return result;
+}
+
+/// Multiplies this sparse symmetric matrix by a dense matrix
+MATRIXN& SPARSESYMMATRIXN::mult(const MATRIXN& m, MATRIXN& result) const
+{
+  #ifndef NEXCEPT
+  if (_n != m.rows())
+    throw MissizeException();
+  #endif
+
+  // setup the result matrix
+  result.set_zero(_n, m.columns());
+  REAL* rdata = result.data();
+  const REAL* mdata = m.data();
+
+  for (unsigned k=0, minc=0, rinc=0; k< m.columns(); k++, minc += m.leading_dim(), rinc += result.leading_dim())
+    for (unsigned col=0; col< _n; col++)
+    {
+      const REAL mcol = mdata[minc + col];
+      REAL dot = (REAL) 0.0;
+      for (unsigned jj= _ptr[col]; jj < _ptr[col+1]; jj++)
+      {
+        const unsigned row = _indices[jj];
+        rdata[rinc + row] += _data[jj] * mcol;
+        if (row != col)
+          dot += _data[jj] * mdata[minc + row];
+      }
+      rdata[rinc + col] += dot;
+    }
+
+  return result;
+}
+
+/// Gets a dense matrix from this sparse symmetric matrix
+MATRIXN& SPARSESYMMATRIXN::to_dense(MATRIXN& m) const
+{
+  // resize m and make it zero
+  m.set_zero(_n, _n);
+
+  for (unsigned col=0; col< _n; col++)
+    for (unsigned k=_ptr[col]; k< _ptr[col+1]; k++)
+    {
+      m(_indices[k], col) = _data[k];
+      m(col, _indices[k]) = _data[k];
+    }
+
+  return m;
+}
+
+/// Expands this matrix into a (full) sparse matrix, using the given storage type
+/**
+ * The full symmetric matrix has identical CSR and CSC representations, so
+ * the same arrays are produced for either storage type.
+ */
+SPARSEMATRIXN& SPARSESYMMATRIXN::to_full(SPARSEMATRIXN::StorageType stype, SPARSEMATRIXN& m) const
+{
+  // count the nonzeros in each column of the full matrix
+  vector<unsigned> cnt(_n, 0);
+  unsigned nnz = 0;
+  for (unsigned col=0; col< _n; col++)
+    for (unsigned k=_ptr[col]; k< _ptr[col+1]; k++)
+    {
+      cnt[col]++;
+      nnz++;
+      if (_indices[k] != col)
+      {
+        cnt[_indices[k]]++;
+        nnz++;
+      }
+    }
+
+  // setup the arrays
+  shared_array<unsigned> ptr(new unsigned[_n+1]);
+  shared_array<unsigned> indices(new unsigned[nnz]);
+  shared_array<REAL> data(new REAL[nnz]);
+  ptr[0] = 0;
+  for (unsigned j=0; j< _n; j++)
+    ptr[j+1] = ptr[j] + cnt[j];
+
+  // populate the arrays; processing the stored columns in order keeps the
+  // indices in each column sorted for both triangles
+  std::copy(ptr.get(), ptr.get()+_n, cnt.begin());
+  for (unsigned col=0; col< _n; col++)
+    for (unsigned k=_ptr[col]; k< _ptr[col+1]; k++)
+    {
+      const unsigned row = _indices[k];
+      unsigned q = cnt[col]++;
+      indices[q] = row;
+      data[q] = _data[k];
+      if (row != col)
+      {
+        q = cnt[row]++;
+        indices[q] = col;
+        data[q] = _data[k];
+      }
+    }
+
+  m = SPARSEMATRIXN(stype, _n, _n, ptr, indices, data);
+  return m;
+}
+
+/// Gets the representation of this matrix that stores the given triangle
+SPARSESYMMATRIXN& SPARSESYMMATRIXN::to_triangle(Triangle t, SPARSESYMMATRIXN& m) const
+{
+  // copy if the triangle is the same
+  if (t == _tri)
+  {
+    if (&m != this)
+    {
+      m.allocate(_n, _nnz);
+      m._tri = t;
+      std::copy(_ptr.get(), _ptr.get()+_n+1, m._ptr.get());
+      std::copy(_indices.get(), _indices.get()+_nnz, m._indices.get());
+      std::copy(_data.get(), _data.get()+_nnz, m._data.get());
+    }
+    return m;
+  }
+
+  // transpose the stored triangle
+  shared_array<unsigned> ptr(new unsigned[_n+1]);
+  shared_array<unsigned> indices(new unsigned[_nnz]);
+  shared_array<REAL> data(new REAL[_nnz]);
+  vector<unsigned> cnt(_n, 0);
+  for (unsigned k=0; k< _nnz; k++)
+    cnt[_indices[k]]++;
+  ptr[0] = 0;
+  for (unsigned j=0; j< _n; j++)
+    ptr[j+1] = ptr[j] + cnt[j];
+  std::copy(ptr.get(), ptr.get()+_n, cnt.begin());
+  for (unsigned col=0; col< _n; col++)
+    for (unsigned k=_ptr[col]; k< _ptr[col+1]; k++)
+    {
+      unsigned q = cnt[_indices[k]]++;
+      indices[q] = col;
+      data[q] = _data[k];
+    }
+
+  // set the matrix
+  m._n = _n;
+  m._nnz = _nnz;
+  m._tri = t;
+  m._ptr = ptr;
+  m._indices = indices;
+  m._data = data;
+
+  return m;
+}
+
+/// Multiplies a sparse symmetric matrix by a scalar
+SPARSESYMMATRIXN& SPARSESYMMATRIXN::operator*=(REAL scalar)
+{
+  CBLAS::scal(_nnz, scalar, _data.get(), 1);
+  return *this;
+}
+
+/// Negates this sparse symmetric matrix
+SPARSESYMMATRIXN& SPARSESYMMATRIXN::negate()
+{
+  CBLAS::scal(_nnz, (REAL) -1.0, _data.get(), 1);
+  return *this;
+}
+
+/// Calculates the outer product of a vector with itself and stores one triangle of the result
+SPARSESYMMATRIXN& SPARSESYMMATRIXN::outer_square(const SPARSEVECTORN& v, SPARSESYMMATRIXN& result)
+{
+  // determine the size of the matrix
+  const unsigned n = v.size();
+
+  // get the number of non-zero elements of v
+  const unsigned nz = v.num_elements();
+
+  // get the indices of the nonzero elements (sorted) and the data
+  vector<pair<unsigned, REAL> > nzv(nz);
+  const unsigned* nz_indices = v.get_indices();
+  const REAL* v_data = v.get_data();
+  for (unsigned i=0; i< nz; i++)
+    nzv[i] = make_pair(nz_indices[i], v_data[i]);
+  std::sort(nzv.begin(), nzv.end());
+
+  // setup the arrays
+  result.allocate(n, nz*(nz+1)/2);
+
+  // setup ptr, indices, and data
+  const bool UPPER = (result._tri == eUpper);
+  result._ptr[0] = 0;
+  for (unsigned i=0, j=0, k=0; j< n; j++)
+  {
+    if (i < nz && nzv[i].first == j)
+    {
+      const unsigned START = (UPPER) ? 0 : i;
+      const unsigned END = (UPPER) ? i+1 : nz;
+      for (unsigned r=START; r< END; r++, k++)
+      {
+        result._indices[k] = nzv[r].first;
+        result._data[k] = nzv[r].second*nzv[i].second;
+      }
+      i++;
+    }
+    result._ptr[j+1] = k;
+  }
+
+  return result;
+}
+
+/// Calculates the outer product of a vector with itself and stores one triangle of the result
+SPARSESYMMATRIXN& SPARSESYMMATRIXN::outer_square(const VECTORN& x, SPARSESYMMATRIXN& result)
+{
+  // determine the size of the matrix
+  const unsigned n = x.size();
+
+  // determine the non-zero elements in x
+  vector<unsigned> nz_indices;
+  for (unsigned i=0; i< n; i++)
+    if (std::fabs(x[i]) > EPS)
+      nz_indices.push_back(i);
+  const unsigned nz = nz_indices.size();
+
+  // setup the arrays
+  result.allocate(n, nz*(nz+1)/2);
+
+  // setup ptr, indices, and data
+  const bool UPPER = (result._tri == eUpper);
+  result._ptr[0] = 0;
+  for (unsigned i=0, j=0, k=0; j< n; j++)
+  {
+    if (i < nz && nz_indices[i] == j)
+    {
+      const unsigned START = (UPPER) ? 0 : i;
+      const unsigned END = (UPPER) ? i+1 : nz;
+      for (unsigned r=START; r< END; r++, k++)
+      {
+        result._indices[k] = nz_indices[r];
+        result._data[k] = x[nz_indices[r]]*x[j];
+      }
+      i++;
+    }
+    result._ptr[j+1] = k;
+  }
+
+  return result;
+}
+
+std::ostream& Ravelin::operator<<(std::ostream& out, const SPARSESYMMATRIXN& s)
+{
+  const unsigned* indices = s.get_indices();
+  const unsigned* ptr = s.get_ptr();
+  const REAL* data = s.get_data();
+
+  out << "nnz: " << s.get_nnz() << std::endl;
+  out << "ptr:";
+  if (ptr)
+    for (unsigned i=0; i<= s.columns(); i++)
+      out << " " << ptr[i];
+  out << std::endl;
+
+  out << "indices:";
+  for (unsigned i=0; i< s.get_nnz(); i++)
+    out << " " << indices[i];
+  out << std::endl;
+
+  out << "data:";
+  for (unsigned i=0; i< s.get_nnz(); i++)
+    out << " " << data[i];
+  out << std::endl;
+
+  MATRIXN dense;
+  out << s.to_dense(dense) << std::endl;
+
+  return out;
+}
+
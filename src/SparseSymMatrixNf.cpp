@@ -0,0 +1,25 @@
+/****************************************************************************
+ * Copyright 2013 Evan Drumwright
+ * This library is distributed under the terms of the GNU  General Public 
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#include <numeric>
+#include <algorithm>
+#include <Ravelin/Constants.h>
+#include <Ravelin/MissizeException.h>
+#include <Ravelin/NonsquareMatrixException.h>
+#include <Ravelin/SparseSymMatrixNf.h>
+#include <Ravelin/MatrixNf.h>
+
+using std::pair;
+using boost::shared_array;
+using std::map;
+using std::make_pair;
+using std::vector;
+using namespace Ravelin;
+
+#include <Ravelin/fdefs.h>
+#include "SparseSymMatrixN.cpp"
+#include <Ravelin/undefs.h>
+
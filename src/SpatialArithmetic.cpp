@@ -22,8 +22,8 @@ static void get_r_E(const TRANSFORM3& T, VECTOR3& r, MATRIX3& E)
 
   // note that x is translation from relative pose to this pose
   // q is rotation from vectors in this pose to relative pose 
-  E = T.q;
-  r = VECTOR3(E.transpose_mult(-T.x), T.source);
+  E = T.get_rotation();
+  r = VECTOR3(T.get_r(), T.source);
 }
 
 /// transforms a spatial acceleration using precomputation *without accounting for moving frames*
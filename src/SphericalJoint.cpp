@@ -32,6 +32,21 @@ SPHERICALJOINT::SPHERICALJOINT() : JOINT()
   SINGULAR_TOL = (REAL) 1e-2;
 }
 
+/// Makes a copy of this joint that uses the given frames (see JOINT::clone())
+shared_ptr<JOINT> SPHERICALJOINT::clone(const PoseMap& poses) const
+{
+  shared_ptr<SPHERICALJOINT> joint(new SPHERICALJOINT(*this));
+
+  // point the frames and axes of the copy to the copied frames
+  joint->remap_poses(poses);
+  remap(joint->_u[eAxis1].pose, poses);
+  remap(joint->_u[eAxis2].pose, poses);
+  remap(joint->_u[eAxis3].pose, poses);
+  remap(joint->_s_dot, poses);
+
+  return joint;
+}
+
 /// Determines whether two values are relatively equal
 bool SPHERICALJOINT::rel_equal(REAL x, REAL y)
 {
@@ -92,6 +107,7 @@ void SPHERICALJOINT::set_axis(const VECTOR3& axis, Axis a)
   // normalize the axis in case the caller did not
   VECTOR3 naxis = VECTOR3::normalize(axis);
   _u[a] = POSE3::transform_vector(get_pose(), naxis); 
+  _geometry_version++;
   update_spatial_axes(); 
 }        
 
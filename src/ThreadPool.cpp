@@ -0,0 +1,161 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#include <unistd.h>
+#include <Ravelin/ThreadPool.h>
+
+using namespace Ravelin;
+
+/// Creates a pool that executes tasks on the given number of threads
+/**
+ * \param nthreads the number of threads that execute tasks, including the
+ *        thread that calls run(); if zero, the number of processors is used
+ */
+ThreadPool::ThreadPool(unsigned nthreads)
+{
+  _task = NULL;
+  _data = NULL;
+  _ntasks = _next = _busy = _generation = 0;
+  _stop = false;
+  pthread_mutex_init(&_mutex, NULL);
+  pthread_cond_init(&_start, NULL);
+  pthread_cond_init(&_finish, NULL);
+
+  // the calling thread executes tasks too
+  if (nthreads == 0)
+    nthreads = num_processors();
+  for (unsigned i=1; i< nthreads; i++)
+  {
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, &work, this) != 0)
+      break;
+    _threads.push_back(thread);
+  }
+}
+
+/// Stops and joins the worker threads
+ThreadPool::~ThreadPool()
+{
+  pthread_mutex_lock(&_mutex);
+  _stop = true;
+  pthread_cond_broadcast(&_start);
+  pthread_mutex_unlock(&_mutex);
+  for (unsigned i=0; i< _threads.size(); i++)
+    pthread_join(_threads[i], NULL);
+  pthread_cond_destroy(&_finish);
+  pthread_cond_destroy(&_start);
+  pthread_mutex_destroy(&_mutex);
+}
+
+/// Gets the number of processors online
+unsigned ThreadPool::num_processors()
+{
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return (n > 0) ? (unsigned) n : 1;
+}
+
+/// Executes task(data, i) for i = 0..ntasks-1, returning once all tasks are done
+void ThreadPool::run(unsigned ntasks, Task task, void* data)
+{
+  // run small jobs on the calling thread
+  if (_threads.empty() || ntasks < 2)
+  {
+    for (unsigned i=0; i< ntasks; i++)
+      (*task)(data, i);
+    return;
+  }
+
+  // wake up the workers
+  pthread_mutex_lock(&_mutex);
+  _exception = boost::exception_ptr();
+  _task = task;
+  _data = data;
+  _ntasks = ntasks;
+  _next = 0;
+  _busy = _threads.size();
+  _generation++;
+  pthread_cond_broadcast(&_start);
+  pthread_mutex_unlock(&_mutex);
+
+  // help out
+  execute();
+
+  // wait for the workers to finish
+  pthread_mutex_lock(&_mutex);
+  while (_busy > 0)
+    pthread_cond_wait(&_finish, &_mutex);
+  boost::exception_ptr e = _exception;
+  _exception = boost::exception_ptr();
+  pthread_mutex_unlock(&_mutex);
+
+  // pass on any exception thrown by a task
+  if (e)
+    boost::rethrow_exception(e);
+}
+
+/// Executes tasks until none remain
+/**
+ * An exception thrown by a task is stored (to be rethrown by run()) and
+ * cancels the tasks not yet started; exceptions must not escape the worker
+ * threads.
+ */
+void ThreadPool::execute()
+{
+  while (true)
+  {
+    pthread_mutex_lock(&_mutex);
+    if (_next == _ntasks)
+    {
+      pthread_mutex_unlock(&_mutex);
+      return;
+    }
+    unsigned i = _next++;
+    pthread_mutex_unlock(&_mutex);
+    try
+    {
+      (*_task)(_data, i);
+    }
+    catch (...)
+    {
+      pthread_mutex_lock(&_mutex);
+      if (!_exception)
+        _exception = boost::current_exception();
+      _next = _ntasks;
+      pthread_mutex_unlock(&_mutex);
+    }
+  }
+}
+
+/// The function executed by each worker thread
+void* ThreadPool::work(void* arg)
+{
+  ThreadPool* pool = (ThreadPool*) arg;
+  unsigned generation = 0;
+
+  pthread_mutex_lock(&pool->_mutex);
+  while (true)
+  {
+    // wait for work
+    while (!pool->_stop && pool->_generation == generation)
+      pthread_cond_wait(&pool->_start, &pool->_mutex);
+    if (pool->_stop)
+      break;
+    generation = pool->_generation;
+    pthread_mutex_unlock(&pool->_mutex);
+
+    // execute tasks
+    pool->execute();
+
+    // indicate that this thread is done
+    pthread_mutex_lock(&pool->_mutex);
+    if (--pool->_busy == 0)
+      pthread_cond_signal(&pool->_finish);
+  }
+  pthread_mutex_unlock(&pool->_mutex);
+
+  return NULL;
+}
+
@@ -0,0 +1,731 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+/// Initializes the writer (no file is opened)
+TRAJECTORY_WRITER::TRAJECTORY_WRITER()
+{
+  _fp = NULL;
+  _header_written = false;
+  _nrecords = 0;
+  _fill_bytes = _drain_bytes = 0;
+  _pending = _done = _error = false;
+}
+
+/// Closes the file, if open
+TRAJECTORY_WRITER::~TRAJECTORY_WRITER()
+{
+  try
+  {
+    close();
+  }
+  catch (...)
+  {
+  }
+}
+
+/// Computes the size (in bytes) of a record
+/**
+ * \param compression the compression used
+ * \param nvalues the number of values (excluding time) in the record
+ */
+unsigned TRAJECTORY_WRITER::calc_record_size(Compression compression, unsigned nvalues)
+{
+  const unsigned REAL_SIZE = sizeof(REAL);
+
+  // determine the number of bytes for the values
+  unsigned nbytes;
+  switch (compression)
+  {
+    case eNone:           nbytes = nvalues*REAL_SIZE; break;
+    case eQuantized:      nbytes = nvalues*sizeof(int32_t); break;
+    case eQuantizedDelta: nbytes = nvalues*sizeof(int16_t); break;
+    default:
+      throw std::runtime_error("TRAJECTORY_WRITER::calc_record_size() - unknown compression type");
+  }
+
+  // time is stored first; pad the record so that successive records are
+  // aligned
+  return ((REAL_SIZE + nbytes + REAL_SIZE - 1)/REAL_SIZE)*REAL_SIZE;
+}
+
+/// Hashes a sequence of bytes (64-bit FNV-1a)
+static void hash_bytes(uint64_t& hash, const void* data, size_t n)
+{
+  const unsigned char* bytes = (const unsigned char*) data;
+  for (size_t i=0; i< n; i++)
+  {
+    hash ^= (uint64_t) bytes[i];
+    hash *= (uint64_t) 1099511628211ULL;
+  }
+}
+
+/// Computes a hash of the model of an articulated body
+/**
+ * The hash depends upon the names, masses, and connectivity of the links,
+ * the names and degrees-of-freedom of the joints, and whether the base is
+ * floating; it does not depend upon the state of the body.
+ */
+uint64_t TRAJECTORY_WRITER::calc_model_hash(shared_ptr<const RC_ARTICULATED_BODY> body)
+{
+  uint64_t hash = (uint64_t) 14695981039346656037ULL;
+
+  // hash the links
+  const vector<shared_ptr<RIGIDBODY> >& links = body->get_links();
+  for (unsigned i=0; i< links.size(); i++)
+  {
+    const double m = (double) links[i]->get_inertia().m;
+    hash_bytes(hash, links[i]->body_id.c_str(), links[i]->body_id.size()+1);
+    hash_bytes(hash, &m, sizeof(double));
+  }
+
+  // hash the joints
+  const vector<shared_ptr<JOINT> >& joints = body->get_joints();
+  for (unsigned i=0; i< joints.size(); i++)
+  {
+    const uint32_t data[4] = { joints[i]->num_dof(),
+                               joints[i]->get_inboard_link()->get_index(),
+                               joints[i]->get_outboard_link()->get_index(),
+                               (uint32_t) joints[i]->get_constraint_type() };
+    hash_bytes(hash, joints[i]->joint_id.c_str(), joints[i]->joint_id.size()+1);
+    hash_bytes(hash, data, sizeof(data));
+  }
+
+  // hash the base type
+  const uint32_t floating = (body->is_floating_base()) ? 1 : 0;
+  hash_bytes(hash, &floating, sizeof(uint32_t));
+
+  return hash;
+}
+
+/// Opens a trajectory file for recording the state of the given body
+/**
+ * \param fname the name of the file (any existing file is overwritten)
+ * \param body the body to be recorded; the generalized coordinates (Euler)
+ *        and the generalized velocities (spatial) are recorded
+ * \param compression the compression to use
+ * \param resolution the resolution of quantized values
+ * \param buffer_records the number of records buffered before writing
+ */
+void TRAJECTORY_WRITER::open(const std::string& fname, shared_ptr<RC_ARTICULATED_BODY> body, Compression compression, REAL resolution, unsigned buffer_records)
+{
+  // get the DOF layout
+  const vector<shared_ptr<JOINT> >& joints = body->get_explicit_joints();
+  vector<unsigned> joint_dofs(joints.size());
+  for (unsigned i=0; i< joints.size(); i++)
+    joint_dofs[i] = joints[i]->num_dof();
+
+  // open the file
+  const unsigned NQ = body->num_generalized_coordinates(DYNAMIC_BODY::eEuler);
+  const unsigned NV = body->num_generalized_coordinates(DYNAMIC_BODY::eSpatial);
+  open(fname, calc_model_hash(body), NQ, NV, joint_dofs, body->is_floating_base(), compression, resolution, buffer_records);
+}
+
+/// Opens a trajectory file for recording
+/**
+ * \param fname the name of the file (any existing file is overwritten)
+ * \param model_hash an identifier for the recorded model
+ * \param nq the number of generalized coordinates stored per record
+ * \param nv the number of generalized velocities (and accelerations and
+ *        forces) stored per record
+ * \param joint_dofs the number of degrees-of-freedom of each joint
+ * \param floating_base whether the recorded model has a floating base
+ * \param compression the compression to use
+ * \param resolution the resolution of quantized values
+ * \param buffer_records the number of records buffered before writing
+ */
+void TRAJECTORY_WRITER::open(const std::string& fname, uint64_t model_hash, unsigned nq, unsigned nv, const vector<unsigned>& joint_dofs, bool floating_base, Compression compression, REAL resolution, unsigned buffer_records)
+{
+  const char MAGIC[8] = { 'R', 'A', 'V', 'T', 'R', 'A', 'J', '\0' };
+  const unsigned HEADER_ALIGN = 64;
+
+  // close any open file
+  close();
+
+  #ifndef NEXCEPT
+  if (compression != eNone && resolution <= (REAL) 0.0)
+    throw std::runtime_error("TRAJECTORY_WRITER::open() - resolution must be positive");
+  if (buffer_records == 0)
+    throw std::runtime_error("TRAJECTORY_WRITER::open() - buffer must hold at least one record");
+  #endif
+
+  // setup the header
+  const unsigned NVALUES = nq + nv*3;
+  std::copy(MAGIC, MAGIC+8, _header.magic);
+  _header.version = 1;
+  _header.real_size = sizeof(REAL);
+  _header.compression = (uint32_t) compression;
+  _header.nq = nq;
+  _header.nv = nv;
+  _header.njoints = joint_dofs.size();
+  _header.floating_base = (floating_base) ? 1 : 0;
+  _header.record_size = calc_record_size(compression, NVALUES);
+  _header.header_size = sizeof(Header) + joint_dofs.size()*sizeof(uint32_t) + NVALUES*sizeof(int64_t);
+  _header.header_size = ((_header.header_size + HEADER_ALIGN - 1)/HEADER_ALIGN)*HEADER_ALIGN;
+  _header.reserved = 0;
+  _header.model_hash = model_hash;
+  _header.resolution = (double) resolution;
+  _joint_dofs = joint_dofs;
+
+  // open the file
+  _fp = fopen(fname.c_str(), "wb");
+  if (!_fp)
+    throw std::runtime_error("TRAJECTORY_WRITER::open() - unable to open " + fname);
+
+  // setup the buffers
+  _fill.resize(buffer_records*_header.record_size);
+  _drain.resize(_fill.size());
+  _fill_bytes = _drain_bytes = 0;
+  _last.assign(NVALUES, 0);
+  _header_written = false;
+  _nrecords = 0;
+
+  // start the writing thread
+  _pending = _done = _error = false;
+  pthread_mutex_init(&_mutex, NULL);
+  pthread_cond_init(&_cond, NULL);
+  if (pthread_create(&_thread, NULL, &write_thread, this) != 0)
+  {
+    fclose(_fp);
+    _fp = NULL;
+    pthread_mutex_destroy(&_mutex);
+    pthread_cond_destroy(&_cond);
+    throw std::runtime_error("TRAJECTORY_WRITER::open() - unable to start writing thread");
+  }
+}
+
+/// Writes buffers to the file (runs in a separate thread)
+void* TRAJECTORY_WRITER::write_thread(void* arg)
+{
+  TRAJECTORY_WRITER* writer = (TRAJECTORY_WRITER*) arg;
+
+  pthread_mutex_lock(&writer->_mutex);
+  while (true)
+  {
+    // wait for a buffer or for the file to be closed
+    while (!writer->_pending && !writer->_done)
+      pthread_cond_wait(&writer->_cond, &writer->_mutex);
+    if (!writer->_pending)
+      break;
+
+    // write the buffer without holding the lock; the buffer is not modified
+    // while pending
+    pthread_mutex_unlock(&writer->_mutex);
+    bool ok = (fwrite(&writer->_drain[0], 1, writer->_drain_bytes, writer->_fp) == writer->_drain_bytes);
+    pthread_mutex_lock(&writer->_mutex);
+
+    // indicate the buffer has been written
+    if (!ok)
+      writer->_error = true;
+    writer->_pending = false;
+    pthread_cond_broadcast(&writer->_cond);
+  }
+  pthread_mutex_unlock(&writer->_mutex);
+
+  return NULL;
+}
+
+/// Writes the header (along with the initial quantized values)
+void TRAJECTORY_WRITER::write_header()
+{
+  // setup the variable portion of the header
+  vector<unsigned char> header(_header.header_size, 0);
+  std::copy((const unsigned char*) &_header, (const unsigned char*) &_header + sizeof(Header), header.begin());
+  uint32_t* dofs = (uint32_t*) &header[sizeof(Header)];
+  for (unsigned i=0; i< _joint_dofs.size(); i++)
+    dofs[i] = _joint_dofs[i];
+  unsigned char* initial = &header[sizeof(Header) + _joint_dofs.size()*sizeof(uint32_t)];
+  if (!_last.empty())
+    std::copy((const unsigned char*) &_last[0], (const unsigned char*) &_last[0] + _last.size()*sizeof(int64_t), initial);
+
+  // write the header; no buffers have been handed to the writing thread yet
+  if (fwrite(&header[0], 1, header.size(), _fp) != header.size())
+    _error = true;
+  _header_written = true;
+}
+
+/// Quantizes a value to the given resolution
+static int64_t quantize(double x, double resolution)
+{
+  return (int64_t) std::floor(x/resolution + 0.5);
+}
+
+/// Encodes a record into the buffer being filled
+void TRAJECTORY_WRITER::encode(REAL t, const VECTORN& q, const VECTORN& qd, const VECTORN& qdd, const VECTORN& tau)
+{
+  const VECTORN* v[4] = { &q, &qd, &qdd, &tau };
+  const double RES = _header.resolution;
+  unsigned char* record = &_fill[_fill_bytes];
+
+  // store time
+  std::copy((const unsigned char*) &t, (const unsigned char*) &t + sizeof(REAL), record);
+  record += sizeof(REAL);
+
+  // store the values
+  switch ((Compression) _header.compression)
+  {
+    case eNone:
+    {
+      REAL* x = (REAL*) record;
+      for (unsigned j=0; j< 4; j++)
+      {
+        std::copy(v[j]->begin(), v[j]->end(), x);
+        x += v[j]->size();
+      }
+      break;
+    }
+
+    case eQuantized:
+    {
+      int32_t* x = (int32_t*) record;
+      for (unsigned j=0; j< 4; j++)
+        for (unsigned i=0; i< v[j]->size(); i++)
+        {
+          int64_t value = quantize((double) (*v[j])[i], RES);
+          value = std::max(value, (int64_t) std::numeric_limits<int32_t>::min());
+          value = std::min(value, (int64_t) std::numeric_limits<int32_t>::max());
+          *x++ = (int32_t) value;
+        }
+      break;
+    }
+
+    case eQuantizedDelta:
+    {
+      // store the change from the last value that will be decoded; changes
+      // that are too large are spread over subsequent records
+      int16_t* x = (int16_t*) record;
+      for (unsigned j=0, k=0; j< 4; j++)
+        for (unsigned i=0; i< v[j]->size(); i++, k++)
+        {
+          int64_t delta = quantize((double) (*v[j])[i], RES) - _last[k];
+          delta = std::max(delta, (int64_t) std::numeric_limits<int16_t>::min());
+          delta = std::min(delta, (int64_t) std::numeric_limits<int16_t>::max());
+          _last[k] += delta;
+          *x++ = (int16_t) delta;
+        }
+      break;
+    }
+  }
+
+  _fill_bytes += _header.record_size;
+}
+
+/// Writes a record
+/**
+ * \param t the time
+ * \param q the generalized coordinates
+ * \param qd the generalized velocity
+ * \param qdd the generalized acceleration
+ * \param tau the generalized force
+ */
+void TRAJECTORY_WRITER::write(REAL t, const VECTORN& q, const VECTORN& qd, const VECTORN& qdd, const VECTORN& tau)
+{
+  #ifndef NEXCEPT
+  if (!_fp)
+    throw std::runtime_error("TRAJECTORY_WRITER::write() - no file is open");
+  if (q.size() != _header.nq || qd.size() != _header.nv || qdd.size() != _header.nv || tau.size() != _header.nv)
+    throw MissizeException();
+  #endif
+
+  // write the header before the first record; the initial quantized values
+  // are those of the first record
+  if (!_header_written)
+  {
+    if ((Compression) _header.compression == eQuantizedDelta)
+    {
+      const VECTORN* v[4] = { &q, &qd, &qdd, &tau };
+      for (unsigned j=0, k=0; j< 4; j++)
+        for (unsigned i=0; i< v[j]->size(); i++)
+          _last[k++] = quantize((double) (*v[j])[i], _header.resolution);
+    }
+    write_header();
+  }
+
+  // encode the record and hand the buffer to the writing thread, if full
+  encode(t, q, qd, qdd, tau);
+  _nrecords++;
+  if (_fill_bytes + _header.record_size > _fill.size())
+    submit();
+}
+
+/// Writes a record with the current state of a body
+/**
+ * The generalized force is that applied at the joints (JOINT::force); it is
+ * zero for the floating base.
+ * \param t the time
+ * \param body the body (must be the body the file was opened for)
+ */
+void TRAJECTORY_WRITER::write(REAL t, shared_ptr<RC_ARTICULATED_BODY> body)
+{
+  // get the state of the body
+  body->get_generalized_coordinates_euler(_q);
+  body->get_generalized_velocity(DYNAMIC_BODY::eSpatial, _qd);
+  body->get_generalized_acceleration(_qdd);
+
+  // get the joint forces
+  const vector<shared_ptr<JOINT> >& joints = body->get_explicit_joints();
+  _tau.set_zero(_qd.size());
+  for (unsigned i=0; i< joints.size(); i++)
+    _tau.set_sub_vec(joints[i]->get_coord_index(), joints[i]->force);
+
+  write(t, _q, _qd, _qdd, _tau);
+}
+
+/// Hands the buffer being filled to the writing thread
+void TRAJECTORY_WRITER::submit()
+{
+  pthread_mutex_lock(&_mutex);
+
+  // wait for the writing thread to finish the last buffer
+  while (_pending)
+    pthread_cond_wait(&_cond, &_mutex);
+
+  // swap the buffers
+  _fill.swap(_drain);
+  _drain_bytes = _fill_bytes;
+  _fill_bytes = 0;
+  _pending = true;
+  pthread_cond_broadcast(&_cond);
+
+  pthread_mutex_unlock(&_mutex);
+}
+
+/// Waits for the writing thread to finish writing
+void TRAJECTORY_WRITER::wait_idle()
+{
+  pthread_mutex_lock(&_mutex);
+  while (_pending)
+    pthread_cond_wait(&_cond, &_mutex);
+  pthread_mutex_unlock(&_mutex);
+}
+
+/// Writes all buffered records to the file
+void TRAJECTORY_WRITER::flush()
+{
+  if (!_fp)
+    return;
+
+  // write the header (if no records have been written)
+  if (!_header_written)
+    write_header();
+
+  // write the buffered records
+  if (_fill_bytes > 0)
+    submit();
+  wait_idle();
+  fflush(_fp);
+
+  #ifndef NEXCEPT
+  if (_error)
+    throw std::runtime_error("TRAJECTORY_WRITER::flush() - error writing file");
+  #endif
+}
+
+/// Writes all buffered records and closes the file
+void TRAJECTORY_WRITER::close()
+{
+  if (!_fp)
+    return;
+
+  // write everything
+  if (!_header_written)
+    write_header();
+  if (_fill_bytes > 0)
+    submit();
+
+  // stop the writing thread
+  pthread_mutex_lock(&_mutex);
+  _done = true;
+  pthread_cond_broadcast(&_cond);
+  pthread_mutex_unlock(&_mutex);
+  pthread_join(_thread, NULL);
+  pthread_mutex_destroy(&_mutex);
+  pthread_cond_destroy(&_cond);
+
+  // close the file
+  bool error = _error || (fclose(_fp) != 0);
+  _fp = NULL;
+  _fill.clear();
+  _drain.clear();
+  _fill_bytes = _drain_bytes = 0;
+
+  if (error)
+    throw std::runtime_error("TRAJECTORY_WRITER::close() - error writing file");
+}
+
+/// Unmaps a mapped file
+void TRAJECTORY_READER::Unmapper::operator()(REAL* data) const
+{
+  munmap((void*) data, length);
+}
+
+/// Initializes the reader (no file is opened)
+TRAJECTORY_READER::TRAJECTORY_READER()
+{
+  _base = NULL;
+  _length = 0;
+  _nrecords = 0;
+  _decoded_idx = 0;
+}
+
+/// Opens (and memory maps) a trajectory file
+void TRAJECTORY_READER::open(const std::string& fname)
+{
+  const char MAGIC[8] = { 'R', 'A', 'V', 'T', 'R', 'A', 'J', '\0' };
+
+  // close any open file
+  close();
+
+  // open the file and get its size
+  int fd = ::open(fname.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("TRAJECTORY_READER::open() - unable to open " + fname);
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(TRAJECTORY_WRITER::Header))
+  {
+    ::close(fd);
+    throw std::runtime_error("TRAJECTORY_READER::open() - " + fname + " is not a trajectory file");
+  }
+
+  // map the file; the mapping is private, so views may be modified without
+  // modifying the file
+  void* base = mmap(NULL, (size_t) st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED)
+    throw std::runtime_error("TRAJECTORY_READER::open() - unable to map " + fname);
+  _length = (size_t) st.st_size;
+
+  // the storage unmaps the file once neither the reader nor any view uses it
+  _base = (unsigned char*) base;
+  _data = SharedResizable<REAL>(boost::shared_array<REAL>((REAL*) base, Unmapper(_length)), _length/sizeof(REAL));
+
+  // read and verify the header
+  std::copy(_base, _base + sizeof(TRAJECTORY_WRITER::Header), (unsigned char*) &_header);
+  if (!std::equal(MAGIC, MAGIC+8, _header.magic) || _header.version != 1 || _header.header_size > _length)
+  {
+    close();
+    throw std::runtime_error("TRAJECTORY_READER::open() - " + fname + " is not a trajectory file");
+  }
+  if (_header.real_size != sizeof(REAL))
+  {
+    close();
+    throw std::runtime_error("TRAJECTORY_READER::open() - " + fname + " was written with a different floating point type");
+  }
+  const unsigned NVALUES = _header.nq + _header.nv*3;
+  if (_header.record_size != TRAJECTORY_WRITER::calc_record_size((TRAJECTORY_WRITER::Compression) _header.compression, NVALUES))
+  {
+    close();
+    throw std::runtime_error("TRAJECTORY_READER::open() - " + fname + " is corrupt");
+  }
+
+  // verify that the DOF layout and the initial values fit in the header
+  const uint64_t LAYOUT_SIZE = sizeof(TRAJECTORY_WRITER::Header) + (uint64_t) _header.njoints*sizeof(uint32_t) + (uint64_t) NVALUES*sizeof(int64_t);
+  if (LAYOUT_SIZE > _header.header_size)
+  {
+    close();
+    throw std::runtime_error("TRAJECTORY_READER::open() - " + fname + " is corrupt");
+  }
+
+  // read the DOF layout and verify it against the number of velocities
+  const uint32_t* dofs = (const uint32_t*) (_base + sizeof(TRAJECTORY_WRITER::Header));
+  _joint_dofs.assign(dofs, dofs + _header.njoints);
+  uint64_t ndofs = (_header.floating_base) ? 6 : 0;
+  for (unsigned i=0; i< _joint_dofs.size(); i++)
+    ndofs += _joint_dofs[i];
+  if (ndofs != _header.nv)
+  {
+    close();
+    throw std::runtime_error("TRAJECTORY_READER::open() - " + fname + " is corrupt");
+  }
+
+  // read the initial quantized values
+  const unsigned char* initial = _base + sizeof(TRAJECTORY_WRITER::Header) + _header.njoints*sizeof(uint32_t);
+  _initial.resize(NVALUES);
+  if (NVALUES > 0)
+    std::copy(initial, initial + NVALUES*sizeof(int64_t), (unsigned char*) &_initial[0]);
+  _decoded.clear();
+  _decoded_idx = 0;
+
+  // determine the number of (complete) records
+  _nrecords = (_length - _header.header_size)/_header.record_size;
+}
+
+/// Closes the file
+/**
+ * Views returned by get_q(), get_qd(), get_qdd(), and get_tau() remain
+ * valid.
+ */
+void TRAJECTORY_READER::close()
+{
+  _data = SharedResizable<REAL>();
+  _base = NULL;
+  _length = 0;
+  _nrecords = 0;
+  _joint_dofs.clear();
+  _initial.clear();
+  _decoded.clear();
+}
+
+/// Gets a pointer to the data for a record
+const unsigned char* TRAJECTORY_READER::get_record_data(unsigned i) const
+{
+  #ifndef NEXCEPT
+  if (i >= _nrecords)
+    throw InvalidIndexException();
+  #endif
+
+  return _base + _header.header_size + (size_t) i*_header.record_size;
+}
+
+/// Gets the time of the given record
+REAL TRAJECTORY_READER::get_time(unsigned i) const
+{
+  REAL t;
+  const unsigned char* record = get_record_data(i);
+  std::copy(record, record + sizeof(REAL), (unsigned char*) &t);
+  return t;
+}
+
+/// Finds the first record with time no smaller than t
+/**
+ * \return the index of the record, or size() if there is no such record
+ * \note records are assumed to be in order of increasing time
+ */
+unsigned TRAJECTORY_READER::find(REAL t) const
+{
+  unsigned lo = 0, hi = _nrecords;
+  while (lo < hi)
+  {
+    unsigned mid = lo + (hi - lo)/2;
+    if (get_time(mid) < t)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+/// Gets a view into the values of a record in an uncompressed file
+SHAREDVECTORN TRAJECTORY_READER::get_view(unsigned i, unsigned offset, unsigned len)
+{
+  #ifndef NEXCEPT
+  if (_header.compression != TRAJECTORY_WRITER::eNone)
+    throw std::runtime_error("TRAJECTORY_READER - views are only available for uncompressed files; use get_record()");
+  if (i >= _nrecords)
+    throw InvalidIndexException();
+  #endif
+
+  // time is stored first in each record
+  const unsigned START = (_header.header_size + i*_header.record_size)/sizeof(REAL) + 1 + offset;
+  return SHAREDVECTORN(len, 1, START, _data);
+}
+
+/// Gets a view of the generalized coordinates of the given record (uncompressed files only)
+SHAREDVECTORN TRAJECTORY_READER::get_q(unsigned i)
+{
+  return get_view(i, 0, _header.nq);
+}
+
+/// Gets a view of the generalized velocity of the given record (uncompressed files only)
+SHAREDVECTORN TRAJECTORY_READER::get_qd(unsigned i)
+{
+  return get_view(i, _header.nq, _header.nv);
+}
+
+/// Gets a view of the generalized acceleration of the given record (uncompressed files only)
+SHAREDVECTORN TRAJECTORY_READER::get_qdd(unsigned i)
+{
+  return get_view(i, _header.nq + _header.nv, _header.nv);
+}
+
+/// Gets a view of the generalized force of the given record (uncompressed files only)
+SHAREDVECTORN TRAJECTORY_READER::get_tau(unsigned i)
+{
+  return get_view(i, _header.nq + _header.nv*2, _header.nv);
+}
+
+/// Decodes the quantized values of a record of an eQuantizedDelta file into _decoded
+void TRAJECTORY_READER::decode_delta(unsigned i)
+{
+  // restart from the first record, if necessary
+  if (_decoded.empty() || i < _decoded_idx)
+  {
+    _decoded = _initial;
+    _decoded_idx = 0;
+    const int16_t* delta = (const int16_t*) (get_record_data(0) + sizeof(REAL));
+    for (unsigned k=0; k< _decoded.size(); k++)
+      _decoded[k] += delta[k];
+  }
+
+  // apply the changes up to record i
+  while (_decoded_idx < i)
+  {
+    const int16_t* delta = (const int16_t*) (get_record_data(++_decoded_idx) + sizeof(REAL));
+    for (unsigned k=0; k< _decoded.size(); k++)
+      _decoded[k] += delta[k];
+  }
+}
+
+/// Gets the values of a record (for any file)
+/**
+ * \param i the index of the record
+ * \param q the generalized coordinates (on return)
+ * \param qd the generalized velocity (on return)
+ * \param qdd the generalized acceleration (on return)
+ * \param tau the generalized force (on return)
+ * \return the time of the record
+ */
+REAL TRAJECTORY_READER::get_record(unsigned i, VECTORN& q, VECTORN& qd, VECTORN& qdd, VECTORN& tau)
+{
+  VECTORN* v[4] = { &q, &qd, &qdd, &tau };
+  const REAL RES = (REAL) _header.resolution;
+
+  // resize the vectors
+  q.resize(_header.nq);
+  qd.resize(_header.nv);
+  qdd.resize(_header.nv);
+  tau.resize(_header.nv);
+
+  // get the values
+  const unsigned char* record = get_record_data(i) + sizeof(REAL);
+  switch ((TRAJECTORY_WRITER::Compression) _header.compression)
+  {
+    case TRAJECTORY_WRITER::eNone:
+    {
+      const REAL* x = (const REAL*) record;
+      for (unsigned j=0; j< 4; j++)
+      {
+        std::copy(x, x + v[j]->size(), v[j]->begin());
+        x += v[j]->size();
+      }
+      break;
+    }
+
+    case TRAJECTORY_WRITER::eQuantized:
+    {
+      const int32_t* x = (const int32_t*) record;
+      for (unsigned j=0; j< 4; j++)
+        for (unsigned k=0; k< v[j]->size(); k++)
+          (*v[j])[k] = (REAL) *x++ * RES;
+      break;
+    }
+
+    case TRAJECTORY_WRITER::eQuantizedDelta:
+    {
+      decode_delta(i);
+      for (unsigned j=0, m=0; j< 4; j++)
+        for (unsigned k=0; k< v[j]->size(); k++)
+          (*v[j])[k] = (REAL) _decoded[m++] * RES;
+      break;
+    }
+
+    default:
+      throw std::runtime_error("TRAJECTORY_READER::get_record() - unknown compression type");
+  }
+
+  return get_time(i);
+}
+
@@ -0,0 +1,29 @@
+/****************************************************************************
+ * Copyright 2015 Evan Drumwright
+ * This library is distributed under the terms of the Apache V2.0 
+ * License (obtainable from http://www.apache.org/licenses/LICENSE-2.0).
+ ****************************************************************************/
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <Ravelin/Trajectoryf.h>
+#include <Ravelin/Jointf.h>
+#include <Ravelin/RigidBodyf.h>
+#include <Ravelin/RCArticulatedBodyf.h>
+#include <Ravelin/MissizeException.h>
+#include <Ravelin/InvalidIndexException.h>
+
+using boost::shared_ptr;
+using std::vector;
+using namespace Ravelin;
+
+#include <Ravelin/fdefs.h>
+#include "Trajectory.cpp"
+#include <Ravelin/undefs.h>
+
@@ -333,6 +333,24 @@ POSE3 TRANSFORM3::inverse_transform(const POSE3& p) const
   return result;
 }
 
+/// Gets the rotation matrix (from source orientation to target orientation) corresponding to q
+MATRIX3 TRANSFORM3::get_rotation() const
+{
+  return MATRIX3(q);
+}
+
+/// Gets the vector from the source origin to the target origin (in the source frame)
+ORIGIN3 TRANSFORM3::get_r() const
+{
+  return MATRIX3(q).transpose_mult(-x);
+}
+
+/// Gets the skew symmetric matrix of the vector returned by get_r()
+MATRIX3 TRANSFORM3::get_rx() const
+{
+  return MATRIX3::skew_symmetric(get_r());
+}
+
 /// Transforms a vector from one pose to another 
 VECTOR3 TRANSFORM3::transform_vector(const VECTOR3& v) const
 {
@@ -341,7 +359,8 @@ VECTOR3 TRANSFORM3::transform_vector(const VECTOR3& v) const
     throw FrameException();
   #endif
 
-  return VECTOR3(q * ORIGIN3(v), target);
+  const MATRIX3 E = q;
+  return VECTOR3(E * ORIGIN3(v), target);
 }
 
 /// Transforms a vector from one pose to another 
@@ -352,7 +371,8 @@ VECTOR3 TRANSFORM3::inverse_transform_vector(const VECTOR3& v) const
     throw FrameException();
   #endif
 
-  return VECTOR3(QUAT::invert(q) * ORIGIN3(v), source);
+  const MATRIX3 E = q;
+  return VECTOR3(E.transpose_mult(ORIGIN3(v)), source);
 }
 
 /// Transforms a point from one pose to another 
@@ -363,7 +383,8 @@ VECTOR3 TRANSFORM3::transform_point(const VECTOR3& p) const
     throw FrameException();
   #endif
 
-  return VECTOR3(q * ORIGIN3(p) + x, target);
+  const MATRIX3 E = q;
+  return VECTOR3(E * ORIGIN3(p) + x, target);
 }
 
 /// Transforms a point from one pose to another 
@@ -374,7 +395,8 @@ VECTOR3 TRANSFORM3::inverse_transform_point(const VECTOR3& p) const
     throw FrameException();
   #endif
 
-  return VECTOR3(QUAT::invert(q) * (ORIGIN3(p) - x), source);
+  const MATRIX3 E = q;
+  return VECTOR3(E.transpose_mult(ORIGIN3(p) - x), source);
 }
 
 /// Transforms a force from one pose to another 
@@ -394,20 +416,37 @@ void TRANSFORM3::transform_spatial(const SVECTOR6& w, SVECTOR6& result) const
   #endif
 
   // setup r and E
-  MATRIX3 E = q;
-  ORIGIN3 r = E.transpose_mult(-x);
-  VECTOR3 rv(r, source);
-
-  // get the components of w
-  VECTOR3 top = w.get_upper();
-  VECTOR3 bottom = w.get_lower();
+  const MATRIX3 E = q;
+  const MATRIX3 rx = MATRIX3::skew_symmetric(E.transpose_mult(-x));
 
   // do the calculations
-  VECTOR3 Etop(E * ORIGIN3(top), target);
-  VECTOR3 cross = VECTOR3::cross(rv, top);
-  result.set_upper(Etop);
-  result.set_lower(VECTOR3(E * ORIGIN3(bottom - cross), target));
-  result.pose = target;
+  transform_spatial(w, E, rx, target, result);
+}
+
+/// Transforms a spatial vector using precomputed E and skew(r)
+/**
+ * The spatial transformation is:
+ * | E      0 |
+ * | -E*rx  E |
+ */
+void TRANSFORM3::transform_spatial(const SVECTOR6& w, const MATRIX3& E, const MATRIX3& rx, boost::shared_ptr<const POSE3> pose, SVECTOR6& result) const
+{
+  // do the calculations (w and result may be the same)
+  SIMD3::spatial_transform(E.data(), rx.data(), w.data(), result.data());
+  result.pose = pose;
+}
+
+/// Transforms a spatial vector with the inverse transform using precomputed E and skew(x)
+/**
+ * The spatial transformation is:
+ * | E'      0  |
+ * | -E'*xx  E' |
+ */
+void TRANSFORM3::inverse_transform_spatial(const SVECTOR6& w, const MATRIX3& E, const MATRIX3& xx, boost::shared_ptr<const POSE3> pose, SVECTOR6& result) const
+{
+  // do the calculations (w and result may be the same)
+  SIMD3::spatial_inverse_transform(E.data(), xx.data(), w.data(), result.data());
+  result.pose = pose;
 }
 
 /// Transforms a force from one pose to another 
@@ -426,21 +465,12 @@ void TRANSFORM3::inverse_transform_spatial(const SVECTOR6& w, SVECTOR6& result)
     throw FrameException();
   #endif
 
-  // setup r and E
-  MATRIX3 E = QUAT::invert(q);
-  const ORIGIN3& r = x;
-  VECTOR3 rv(r, target);
-
-  // get the components of w
-  VECTOR3 top = w.get_upper();
-  VECTOR3 bottom = w.get_lower();
+  // setup E and skew(x)
+  const MATRIX3 E = q;
+  const MATRIX3 xx = MATRIX3::skew_symmetric(x);
 
   // do the calculations
-  VECTOR3 Etop(E * ORIGIN3(top), source);
-  VECTOR3 cross = VECTOR3::cross(rv, top);
-  result.set_upper(Etop);
-  result.set_lower(VECTOR3(E * ORIGIN3(bottom - cross), source));
-  result.pose = source;
+  inverse_transform_spatial(w, E, xx, source, result);
 }
 
 /// Transforms a velocity from one pose to another 
@@ -491,6 +521,186 @@ SACCEL TRANSFORM3::inverse_transform(const SACCEL& t) const
   return result;
 }
 
+/// Transforms a vector of forces from one pose to another
+/**
+ * The rotation matrix and offset are set up once for the entire batch.
+ */
+std::vector<SFORCE>& TRANSFORM3::transform(const std::vector<SFORCE>& w, std::vector<SFORCE>& result) const
+{
+  #ifndef NEXCEPT
+  for (unsigned i=0; i< w.size(); i++)
+    if (w[i].pose != source)
+      throw FrameException();
+  #endif
+
+  // setup r and E
+  const MATRIX3 E = q;
+  const MATRIX3 rx = MATRIX3::skew_symmetric(E.transpose_mult(-x));
+
+  // transform all forces 
+  result.resize(w.size());
+  for (unsigned i=0; i< w.size(); i++)
+    transform_spatial(w[i], E, rx, target, result[i]);
+
+  return result;
+}
+
+/// Transforms a vector of forces from one pose to another using the inverse transform
+std::vector<SFORCE>& TRANSFORM3::inverse_transform(const std::vector<SFORCE>& w, std::vector<SFORCE>& result) const
+{
+  #ifndef NEXCEPT
+  for (unsigned i=0; i< w.size(); i++)
+    if (w[i].pose != target)
+      throw FrameException();
+  #endif
+
+  // setup E and skew(x)
+  const MATRIX3 E = q;
+  const MATRIX3 xx = MATRIX3::skew_symmetric(x);
+
+  // transform all forces 
+  result.resize(w.size());
+  for (unsigned i=0; i< w.size(); i++)
+    inverse_transform_spatial(w[i], E, xx, source, result[i]);
+
+  return result;
+}
+
+/// Transforms a vector of momenta from one pose to another
+/**
+ * The rotation matrix and offset are set up once for the entire batch.
+ */
+std::vector<SMOMENTUM>& TRANSFORM3::transform(const std::vector<SMOMENTUM>& t, std::vector<SMOMENTUM>& result) const
+{
+  #ifndef NEXCEPT
+  for (unsigned i=0; i< t.size(); i++)
+    if (t[i].pose != source)
+      throw FrameException();
+  #endif
+
+  // setup r and E
+  const MATRIX3 E = q;
+  const MATRIX3 rx = MATRIX3::skew_symmetric(E.transpose_mult(-x));
+
+  // transform all momenta 
+  result.resize(t.size());
+  for (unsigned i=0; i< t.size(); i++)
+    transform_spatial(t[i], E, rx, target, result[i]);
+
+  return result;
+}
+
+/// Transforms a vector of momenta from one pose to another using the inverse transform
+std::vector<SMOMENTUM>& TRANSFORM3::inverse_transform(const std::vector<SMOMENTUM>& t, std::vector<SMOMENTUM>& result) const
+{
+  #ifndef NEXCEPT
+  for (unsigned i=0; i< t.size(); i++)
+    if (t[i].pose != target)
+      throw FrameException();
+  #endif
+
+  // setup E and skew(x)
+  const MATRIX3 E = q;
+  const MATRIX3 xx = MATRIX3::skew_symmetric(x);
+
+  // transform all momenta 
+  result.resize(t.size());
+  for (unsigned i=0; i< t.size(); i++)
+    inverse_transform_spatial(t[i], E, xx, source, result[i]);
+
+  return result;
+}
+
+/// Transforms a vector of velocities from one pose to another
+/**
+ * The rotation matrix and offset are set up once for the entire batch.
+ */
+std::vector<SVELOCITY>& TRANSFORM3::transform(const std::vector<SVELOCITY>& t, std::vector<SVELOCITY>& result) const
+{
+  #ifndef NEXCEPT
+  for (unsigned i=0; i< t.size(); i++)
+    if (t[i].pose != source)
+      throw FrameException();
+  #endif
+
+  // setup r and E
+  const MATRIX3 E = q;
+  const MATRIX3 rx = MATRIX3::skew_symmetric(E.transpose_mult(-x));
+
+  // transform all velocities 
+  result.resize(t.size());
+  for (unsigned i=0; i< t.size(); i++)
+    transform_spatial(t[i], E, rx, target, result[i]);
+
+  return result;
+}
+
+/// Transforms a vector of velocities from one pose to another using the inverse transform
+std::vector<SVELOCITY>& TRANSFORM3::inverse_transform(const std::vector<SVELOCITY>& t, std::vector<SVELOCITY>& result) const
+{
+  #ifndef NEXCEPT
+  for (unsigned i=0; i< t.size(); i++)
+    if (t[i].pose != target)
+      throw FrameException();
+  #endif
+
+  // setup E and skew(x)
+  const MATRIX3 E = q;
+  const MATRIX3 xx = MATRIX3::skew_symmetric(x);
+
+  // transform all velocities 
+  result.resize(t.size());
+  for (unsigned i=0; i< t.size(); i++)
+    inverse_transform_spatial(t[i], E, xx, source, result[i]);
+
+  return result;
+}
+
+/// Transforms a vector of accelerations from one pose to another
+/**
+ * The rotation matrix and offset are set up once for the entire batch.
+ */
+std::vector<SACCEL>& TRANSFORM3::transform(const std::vector<SACCEL>& t, std::vector<SACCEL>& result) const
+{
+  #ifndef NEXCEPT
+  for (unsigned i=0; i< t.size(); i++)
+    if (t[i].pose != source)
+      throw FrameException();
+  #endif
+
+  // setup r and E
+  const MATRIX3 E = q;
+  const MATRIX3 rx = MATRIX3::skew_symmetric(E.transpose_mult(-x));
+
+  // transform all accelerations 
+  result.resize(t.size());
+  for (unsigned i=0; i< t.size(); i++)
+    transform_spatial(t[i], E, rx, target, result[i]);
+
+  return result;
+}
+
+/// Transforms a vector of accelerations from one pose to another using the inverse transform
+std::vector<SACCEL>& TRANSFORM3::inverse_transform(const std::vector<SACCEL>& t, std::vector<SACCEL>& result) const
+{
+  #ifndef NEXCEPT
+  for (unsigned i=0; i< t.size(); i++)
+    if (t[i].pose != target)
+      throw FrameException();
+  #endif
+
+  // setup E and skew(x)
+  const MATRIX3 E = q;
+  const MATRIX3 xx = MATRIX3::skew_symmetric(x);
+
+  // transform all accelerations 
+  result.resize(t.size());
+  for (unsigned i=0; i< t.size(); i++)
+    inverse_transform_spatial(t[i], E, xx, source, result[i]);
+
+  return result;
+}
+
 /// Transforms a rigid body inertia from one pose to another 
 /**
  * The operations for this come from:
@@ -511,8 +721,8 @@ SPATIAL_RB_INERTIA TRANSFORM3::transform(const SPATIAL_RB_INERTIA& J) const
   #endif
 
   // get r and E 
-  MATRIX3 E = q;
-  ORIGIN3 r = E.transpose_mult(-x);
+  const MATRIX3 E = q;
+  const ORIGIN3 r = E.transpose_mult(-x);
 
   // precompute some things
   ORIGIN3 y = J.h - r;
@@ -526,7 +736,7 @@ SPATIAL_RB_INERTIA TRANSFORM3::transform(const SPATIAL_RB_INERTIA& J) const
   SPATIAL_RB_INERTIA Jx(target);
   Jx.m = J.m;
   Jx.h = E*y;
-  Jx.J = E*Z*MATRIX3::transpose(E);
+  Jx.J = (E*Z).mult_transpose(E);
 
   return Jx;
 }
@@ -540,12 +750,12 @@ SPATIAL_RB_INERTIA TRANSFORM3::inverse_transform(const SPATIAL_RB_INERTIA& J) co
   #endif
 
   // get r and E 
-  MATRIX3 E = QUAT::invert(q);
+  const MATRIX3 E = MATRIX3::transpose(MATRIX3(q));
   const ORIGIN3& r = x;
 
   // precompute some things
   ORIGIN3 y = J.h - r*J.m;
-  MATRIX3 rx = MATRIX3::skew_symmetric(r);
+  const MATRIX3 rx = MATRIX3::skew_symmetric(x);
   MATRIX3 hx = MATRIX3::skew_symmetric(J.h);
   MATRIX3 yx = MATRIX3::skew_symmetric(y);
   MATRIX3 Z = J.J + (rx*hx) + (yx*rx);
@@ -554,7 +764,7 @@ SPATIAL_RB_INERTIA TRANSFORM3::inverse_transform(const SPATIAL_RB_INERTIA& J) co
   SPATIAL_RB_INERTIA Jx(source);
   Jx.m = J.m;
   Jx.h = E*y;
-  Jx.J = E*Z*MATRIX3::transpose(E);
+  Jx.J = (E*Z).mult_transpose(E);
 
   return Jx;
 }
@@ -568,22 +778,21 @@ SPATIAL_AB_INERTIA TRANSFORM3::transform(const SPATIAL_AB_INERTIA& J) const
   #endif
 
   // setup r and E
-  MATRIX3 E = q;
-  const MATRIX3 ET = MATRIX3::transpose(E);
-  ORIGIN3 r = ET.mult(-x);
+  const MATRIX3 E = q;
+  const ORIGIN3 r = E.transpose_mult(-x);
 
-  // precompute some things we'll need
-  MATRIX3 rx = MATRIX3::skew_symmetric(r);
-  MATRIX3 Y = J.H - rx*J.M;
-  MATRIX3 EYET = E * Y * ET;
+  // precompute some things we'll need (skew(r) is applied without forming it)
+  const MATRIX3 rx = MATRIX3::skew_symmetric(r);
+  MATRIX3 Y = J.H - MATRIX3::skew_symmetric_mult(r, J.M);
+  MATRIX3 EYET = (E * Y).mult_transpose(E);
   MATRIX3 HT = MATRIX3::transpose(J.H);
-  MATRIX3 Z = J.J - rx*HT + Y*rx;
+  MATRIX3 Z = J.J - MATRIX3::skew_symmetric_mult(r, HT) + Y*rx;
 
   // setup the spatial inertia
   SPATIAL_AB_INERTIA result(target);
-  result.M = E*J.M*ET;
+  result.M = (E*J.M).mult_transpose(E);
   result.H = EYET;
-  result.J = E*Z*ET; 
+  result.J = (E*Z).mult_transpose(E); 
 
   return result;
 }
@@ -597,17 +806,16 @@ SPATIAL_AB_INERTIA TRANSFORM3::inverse_transform(const SPATIAL_AB_INERTIA& J) co
   #endif
 
   // setup r and E
-  MATRIX3 E = QUAT::invert(q);
-  const ORIGIN3& r = x;
-  const MATRIX3 ET = MATRIX3::transpose(E);
+  const MATRIX3 ET = q;
+  const MATRIX3 E = MATRIX3::transpose(ET);
 
   // precompute some things we'll need
-  MATRIX3 rx = MATRIX3::skew_symmetric(r);
+  const MATRIX3 rx = MATRIX3::skew_symmetric(x);
   MATRIX3 HT = MATRIX3::transpose(J.H);
   MATRIX3 EJET = E * J.J * ET;
   MATRIX3 EHET = E * J.H * ET;
   MATRIX3 EMET = E * J.M * ET;
-  MATRIX3 rx_EMET = rx * EMET;
+  MATRIX3 rx_EMET = MATRIX3::skew_symmetric_mult(x, EMET);
   MATRIX3 E_rx = E * rx;
   MATRIX3 E_rx_HT_ET = E_rx * HT * ET;
   MATRIX3 E_rx_M_rx_ET = E_rx * J.M * rx * ET;
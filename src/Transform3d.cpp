@@ -15,6 +15,7 @@
 #include <Ravelin/Opsd.h>
 #include <Ravelin/Pose3d.h>
 #include <Ravelin/Transform3d.h>
+#include <Ravelin/SIMD3d.h>
 
 using namespace Ravelin;
 
@@ -15,6 +15,7 @@
 #include <Ravelin/Opsf.h>
 #include <Ravelin/Pose3f.h>
 #include <Ravelin/Transform3f.h>
+#include <Ravelin/SIMD3f.h>
 
 using namespace Ravelin;
 
@@ -524,6 +524,13 @@ void URDFREADER::read_inertial(shared_ptr<const XMLTree> node, URDFData& data, s
       return;
     }
   }
+
+  // no inertial tag: the link is massless and its inertial frame is the
+  // link frame
+  link->set_enabled(false);
+  shared_ptr<POSE3> origin(new POSE3);
+  origin->rpose = link->get_pose();
+  data.inertial_poses[link] = origin;
 }
 
 /// Attempts to read an "origin" tag
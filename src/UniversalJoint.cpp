@@ -36,6 +36,21 @@ UNIVERSALJOINT::UNIVERSALJOINT() : JOINT()
     _s_dot[i].pose = _F;
 }
 
+/// Makes a copy of this joint that uses the given frames (see JOINT::clone())
+shared_ptr<JOINT> UNIVERSALJOINT::clone(const PoseMap& poses) const
+{
+  shared_ptr<UNIVERSALJOINT> joint(new UNIVERSALJOINT(*this));
+
+  // point the frames and axes of the copy to the copied frames
+  joint->remap_poses(poses);
+  remap(joint->_u[eAxis1].pose, poses);
+  remap(joint->_u[eAxis2].pose, poses);
+  remap(joint->_h2.pose, poses);
+  remap(joint->_s_dot, poses);
+
+  return joint;
+}
+
 /// Gets the axis for this joint
 VECTOR3 UNIVERSALJOINT::get_axis(Axis a) const
 {
@@ -66,6 +81,7 @@ void UNIVERSALJOINT::set_axis(const VECTOR3& axis, Axis a)
 
   // set the axis
   _u[a] = POSE3::transform_vector(get_pose(), naxis); 
+  _geometry_version++;
 
   // update the spatial axes
   update_spatial_axes(); 
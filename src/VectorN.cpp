@@ -52,6 +52,67 @@ VECTORN::VECTORN(const VECTORN& source)
   operator=(source);
 }
 
+#if __cplusplus >= 201103L
+/// Move constructor
+/**
+ * Takes the storage of source (no data is copied); source becomes empty. If
+ * the storage of source is not owned (e.g., source is a FIXEDVECTORN), the
+ * elements are copied instead and source is left unchanged.
+ * \note not noexcept: copying the elements allocates memory
+ */
+VECTORN::VECTORN(VECTORN&& source)
+{
+  if (source._data.is_owned())
+    _data = std::move(source._data);
+  else
+  {
+    _data.resize(source.size());
+    std::copy(source.data(), source.data()+source.size(), data());
+  }
+}
+
+/// Move assignment operator
+/**
+ * Takes the storage of source (no data is copied); source becomes empty. If
+ * the storage of either vector is not owned (e.g., either is a FIXEDVECTORN),
+ * the elements are copied instead and source is left unchanged.
+ * \note not noexcept: copying the elements may allocate memory
+ */
+VECTORN& VECTORN::operator=(VECTORN&& source)
+{
+  if (this == &source)
+    return *this;
+  if (source._data.is_owned() && _data.is_owned())
+    _data = std::move(source._data);
+  else
+  {
+    _data.resize(source.size());
+    std::copy(source.data(), source.data()+source.size(), data());
+  }
+  return *this;
+}
+#endif
+
+/// Swaps the contents of this vector with v
+/**
+ * Only the underlying storage is exchanged; no elements are copied, unless
+ * the storage of either vector is not owned (e.g., either is a FIXEDVECTORN),
+ * in which case the elements are copied through a temporary vector (memory
+ * is allocated).
+ */
+VECTORN& VECTORN::swap(VECTORN& v)
+{
+  if (_data.is_owned() && v._data.is_owned())
+    _data.swap(v._data);
+  else
+  {
+    VECTORN tmp(v);
+    v = *this;
+    operator=(tmp);
+  }
+  return *this;
+}
+
 /// Copy constructor
 VECTORN::VECTORN(const MATRIXN& source)
 {
@@ -0,0 +1,178 @@
+#include <cstdlib>
+#include <Ravelin/ActiveSetQPd.h>
+#include "gtest/gtest.h"
+
+using namespace Ravelin;
+
+static const double TOL = 1e-8;
+
+// gets a random number in [-1, 1]
+static double rnd()
+{
+  return 2.0*(double) rand()/RAND_MAX - 1.0;
+}
+
+// gets a random matrix
+static MatrixNd rand_matrix(unsigned m, unsigned n)
+{
+  MatrixNd A(m, n);
+  for (unsigned i=0; i< m; i++)
+    for (unsigned j=0; j< n; j++)
+      A(i,j) = rnd();
+  return A;
+}
+
+// gets a random vector
+static VectorNd rand_vector(unsigned n)
+{
+  VectorNd v(n);
+  for (unsigned i=0; i< n; i++)
+    v[i] = rnd();
+  return v;
+}
+
+// a random feasible quadratic program
+struct QP
+{
+  MatrixNd G, A, M;
+  VectorNd c, b, q;
+};
+
+static QP create_qp(unsigned n, unsigned me, unsigned mi)
+{
+  QP qp;
+  MatrixNd B = rand_matrix(n, n);
+  B.transpose_mult(B, qp.G);
+  for (unsigned i=0; i< n; i++)
+    qp.G(i,i) += 0.1;
+  qp.c = rand_vector(n);
+  qp.A = rand_matrix(me, n);
+  qp.M = rand_matrix(mi, n);
+
+  // constraints are satisfied at a random point
+  VectorNd xf = rand_vector(n);
+  qp.A.mult(xf, qp.b);
+  qp.M.mult(xf, qp.q);
+  for (unsigned i=0; i< mi; i++)
+    qp.q[i] -= 0.5*(rnd() + 1.0);
+  return qp;
+}
+
+// checks the optimality conditions of a solution
+static void check_kkt(const QP& qp, const ActiveSetQPd& solver, const VectorNd& x)
+{
+  const VectorNd& lambda = solver.get_equality_multipliers();
+  const VectorNd& mu = solver.get_inequality_multipliers();
+  VectorNd r, w;
+
+  // primal feasibility
+  qp.A.mult(x, r) -= qp.b;
+  for (unsigned i=0; i< r.size(); i++)
+    EXPECT_NEAR(r[i], 0.0, TOL);
+  qp.M.mult(x, r) -= qp.q;
+  for (unsigned i=0; i< r.size(); i++)
+  {
+    EXPECT_GE(r[i], -TOL);
+    EXPECT_GE(mu[i], 0.0);
+    EXPECT_NEAR(r[i]*mu[i], 0.0, TOL);
+  }
+
+  // stationarity: G*x + c = A'*lambda + M'*mu
+  qp.G.mult(x, r) += qp.c;
+  r -= qp.A.transpose_mult(lambda, w);
+  r -= qp.M.transpose_mult(mu, w);
+  EXPECT_LT(r.norm_inf(), 1e-6);
+}
+
+TEST(ActiveSetQPTest, Bounds)
+{
+  // min 1/2 |x - y|^2 subject to x >= 0 has solution max(y, 0)
+  MatrixNd G, A(0,3), M;
+  VectorNd c(3), b(0), q(3), x;
+  G.set_identity(3);
+  M.set_identity(3);
+  q.set_zero();
+  c[0] = -1.0;  c[1] = 2.0;  c[2] = -0.5;
+
+  ActiveSetQPd solver;
+  EXPECT_EQ(solver.solve(G, c, A, b, M, q, x), ActiveSetQPd::eOptimal);
+  EXPECT_NEAR(x[0], 1.0, TOL);
+  EXPECT_NEAR(x[1], 0.0, TOL);
+  EXPECT_NEAR(x[2], 0.5, TOL);
+  EXPECT_EQ(solver.get_active_set().size(), 1);
+  EXPECT_NEAR(solver.get_inequality_multipliers()[1], 2.0, TOL);
+}
+
+TEST(ActiveSetQPTest, Random)
+{
+  srand(0);
+  const unsigned N[3] = { 5, 20, 40 };
+  for (unsigned i=0; i< 3; i++)
+    for (unsigned trial=0; trial< 10; trial++)
+    {
+      QP qp = create_qp(N[i], N[i]/4, 3*N[i]);
+      ActiveSetQPd solver;
+      VectorNd x;
+      ASSERT_EQ(solver.solve(qp.G, qp.c, qp.A, qp.b, qp.M, qp.q, x), ActiveSetQPd::eOptimal);
+      check_kkt(qp, solver, x);
+    }
+}
+
+TEST(ActiveSetQPTest, WarmStart)
+{
+  srand(1);
+  QP qp = create_qp(30, 10, 60);
+  ActiveSetQPd warm, cold;
+  cold.warm_start = false;
+  unsigned warm_iters = 0, cold_iters = 0;
+
+  // solve a sequence of slowly changing problems
+  for (unsigned step=0; step< 20; step++)
+  {
+    VectorNd xw, xc;
+    for (unsigned i=0; i< qp.c.size(); i++)
+      qp.c[i] += 0.01*rnd();
+    ASSERT_EQ(warm.solve(qp.G, qp.c, qp.A, qp.b, qp.M, qp.q, xw), ActiveSetQPd::eOptimal);
+    ASSERT_EQ(cold.solve(qp.G, qp.c, qp.A, qp.b, qp.M, qp.q, xc), ActiveSetQPd::eOptimal);
+    check_kkt(qp, warm, xw);
+    for (unsigned i=0; i< xw.size(); i++)
+      EXPECT_NEAR(xw[i], xc[i], 1e-6);
+    if (step > 0)
+    {
+      warm_iters += warm.get_iterations();
+      cold_iters += cold.get_iterations();
+    }
+  }
+  EXPECT_LT(warm_iters, cold_iters);
+}
+
+TEST(ActiveSetQPTest, Infeasible)
+{
+  MatrixNd G, A(0,2), M(2,2);
+  VectorNd c(2), b(0), q(2), x;
+  G.set_identity(2);
+  c.set_zero();
+
+  // x0 >= 1 and -x0 >= 0 are inconsistent
+  M.set_zero();
+  M(0,0) = 1.0;  M(1,0) = -1.0;
+  q[0] = 1.0;  q[1] = 0.0;
+  ActiveSetQPd solver;
+  EXPECT_EQ(solver.solve(G, c, A, b, M, q, x), ActiveSetQPd::eInfeasible);
+
+  // so are x0 = 1 and x0 = 2
+  A.resize(2,2);
+  A.set_zero();
+  A(0,0) = A(1,0) = 1.0;
+  b.resize(2);
+  b[0] = 1.0;  b[1] = 2.0;
+  M.resize(0,2);
+  q.resize(0);
+  EXPECT_EQ(solver.solve(G, c, A, b, M, q, x), ActiveSetQPd::eInfeasible);
+
+  // G must be positive definite
+  G(1,1) = -1.0;
+  b[1] = 1.0;
+  EXPECT_EQ(solver.solve(G, c, A, b, M, q, x), ActiveSetQPd::eNotConvex);
+}
+
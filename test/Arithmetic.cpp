@@ -246,3 +246,47 @@ static const unsigned MIN_SIZE = 0, MAX_SIZE = 7;
              checkError(std::cerr, "diag_mult_transpose()", resultE,  resultR);
         }
     }
+
+    // move construction/assignment and swap transfer storage without copying
+    TEST(Arithmetic, MoveSwap)
+    {
+        MatE E1(5,3), E2(2,7);
+        E1.setRandom();
+        E2.setRandom();
+        MatR R1 = asRavelin(E1), R2 = asRavelin(E2);
+
+        // swap exchanges the buffers
+        const void* d1 = R1.data();
+        const void* d2 = R2.data();
+        R1.swap(R2);
+        EXPECT_EQ(R1.data(), d2);
+        EXPECT_EQ(R2.data(), d1);
+        EXPECT_EQ(R1.rows(), 2u);
+        EXPECT_EQ(R1.columns(), 7u);
+        EXPECT_LT(checkError(std::cerr, "swap", E2, R1), TOL);
+        EXPECT_LT(checkError(std::cerr, "swap", E1, R2), TOL);
+
+        // move construction takes the buffer and empties the source
+        MatR R3(std::move(R2));
+        EXPECT_EQ(R3.data(), d1);
+        EXPECT_EQ(R2.rows(), 0u);
+        EXPECT_EQ(R2.columns(), 0u);
+        EXPECT_LT(checkError(std::cerr, "move", E1, R3), TOL);
+
+        // move assignment from a temporary 
+        R2 = MatR::identity(4);
+        MatE I = MatE::Identity(4,4);
+        EXPECT_LT(checkError(std::cerr, "move assignment", I, R2), TOL);
+
+        // vectors
+        VecE e(6);
+        e.setRandom();
+        VecR v1 = asRavelin(e), v2;
+        const void* dv = v1.data();
+        v2 = std::move(v1);
+        EXPECT_EQ(v2.data(), dv);
+        EXPECT_EQ(v1.size(), 0u);
+        v1.swap(v2);
+        EXPECT_EQ(v1.data(), dv);
+        EXPECT_LT(checkError(std::cerr, "vector move", e, v1), TOL);
+    }
@@ -0,0 +1,179 @@
+#include <Ravelin/ContactSolverd.h>
+#include <Ravelin/RigidBodyd.h>
+#include <Ravelin/Pose3d.h>
+#include "gtest/gtest.h"
+
+using boost::shared_ptr;
+using std::vector;
+using namespace Ravelin;
+
+static const shared_ptr<const Pose3d> GLOBAL;
+static const double RADIUS = 0.5, MASS = 2.0;
+
+// creates a (floating) sphere at the given position
+static shared_ptr<RigidBodyd> create_sphere(const Origin3d& x)
+{
+  shared_ptr<RigidBodyd> rb(new RigidBodyd);
+  rb->set_enabled(true);
+  rb->set_pose(Pose3d(Quatd(0,0,0,1), x));
+  SpatialRBInertiad J;
+  J.m = MASS;
+  J.J = Matrix3d::identity()*(0.4*MASS*RADIUS*RADIUS);
+  J.pose = rb->get_pose();
+  rb->set_inertia(J);
+  return rb;
+}
+
+// sets the velocity of a sphere ([angular; linear], in the global frame at its center)
+static void set_velocity(shared_ptr<RigidBodyd> rb, const Vector3d& w, const Vector3d& v)
+{
+  rb->set_velocity(SVelocityd(w[0], w[1], w[2], v[0], v[1], v[2], rb->get_gc_pose()));
+}
+
+// creates a contact between a sphere and the ground (y = 0)
+static ContactSolverd::Contact create_ground_contact(shared_ptr<RigidBodyd> rb, double mu)
+{
+  ContactSolverd::Contact c;
+  Vector3d x = Pose3d::transform_point(GLOBAL, Vector3d(0,0,0,rb->get_pose()));
+  c.body1 = rb;
+  c.mu = mu;
+  ContactSolverd::calc_contact_jacobian(rb, rb, Vector3d(x[0], x[1]-RADIUS, x[2], GLOBAL), Vector3d(0,1,0,GLOBAL), c.J1);
+  return c;
+}
+
+// computes the relative velocity of a contact
+static Origin3d calc_velocity(const ContactSolverd::Contact& c)
+{
+  VectorNd v, u1, u2;
+  c.body1->get_generalized_velocity(DynamicBodyd::eSpatial, v);
+  c.J1.mult(v, u1);
+  if (c.body2)
+  {
+    c.body2->get_generalized_velocity(DynamicBodyd::eSpatial, v);
+    c.J2.mult(v, u2);
+    u1 -= u2;
+  }
+  return Origin3d(u1[0], u1[1], u1[2]);
+}
+
+TEST(ContactSolverTest, Jacobian)
+{
+  shared_ptr<RigidBodyd> rb = create_sphere(Origin3d(0.3, 1.2, -0.4));
+  Vector3d w(0.4, -1.1, 0.7, GLOBAL), v(1.5, -0.2, 0.8, GLOBAL);
+  set_velocity(rb, w, v);
+
+  // the velocity of the contact point must be v + w x r
+  ContactSolverd::Contact c = create_ground_contact(rb, 0.0);
+  Vector3d xd = v + Vector3d::cross(w, Vector3d(0.0, -RADIUS, 0.0, GLOBAL));
+  Origin3d u = calc_velocity(c);
+  EXPECT_NEAR(u[0], xd[1], 1e-10);
+  EXPECT_NEAR(u[1]*u[1] + u[2]*u[2], xd[0]*xd[0] + xd[2]*xd[2], 1e-10);
+}
+
+TEST(ContactSolverTest, Frictionless)
+{
+  const ContactSolverd::SolverType TYPES[2] = { ContactSolverd::ePGS, ContactSolverd::eADMM };
+  for (unsigned t=0; t< 2; t++)
+  {
+    shared_ptr<RigidBodyd> rb = create_sphere(Origin3d(0.0, RADIUS, 0.0));
+    set_velocity(rb, Vector3d(0,0,0,GLOBAL), Vector3d(0.3,-2.0,0.0,GLOBAL));
+    vector<ContactSolverd::Contact> contacts(1, create_ground_contact(rb, 0.0));
+
+    // the normal velocity must vanish and the tangential velocity be unchanged
+    ContactSolverd solver;
+    solver.solver_type = TYPES[t];
+    solver.tolerance = 1e-10;
+    solver.solve(contacts);
+    EXPECT_NEAR(contacts[0].impulse[0], 2.0*MASS, 1e-8);
+    EXPECT_NEAR(rb->get_velocity().get_linear()[1], 0.0, 1e-8);
+    EXPECT_NEAR(rb->get_velocity().get_linear()[0], 0.3, 1e-8);
+    EXPECT_FALSE(solver.get_telemetry().empty());
+  }
+}
+
+TEST(ContactSolverTest, Friction)
+{
+  const double MU[2] = { 0.1, 2.0 };
+  for (unsigned m=0; m< 2; m++)
+  {
+    Origin3d impulse[2];
+    for (unsigned t=0; t< 2; t++)
+    {
+      shared_ptr<RigidBodyd> rb = create_sphere(Origin3d(0.0, RADIUS, 0.0));
+      set_velocity(rb, Vector3d(0,0,0,GLOBAL), Vector3d(1.0,-1.0,0.5,GLOBAL));
+      vector<ContactSolverd::Contact> contacts(1, create_ground_contact(rb, MU[m]));
+
+      ContactSolverd solver;
+      solver.solver_type = (t == 0) ? ContactSolverd::ePGS : ContactSolverd::eADMM;
+      solver.tolerance = 1e-10;
+      solver.max_iterations = 1000;
+      solver.solve(contacts);
+      impulse[t] = contacts[0].impulse;
+
+      // the impulse must lie in the friction cone and the contact must not approach
+      const Origin3d& l = contacts[0].impulse;
+      EXPECT_LE(std::sqrt(l[1]*l[1] + l[2]*l[2]), MU[m]*l[0] + 1e-8);
+      Origin3d u = calc_velocity(contacts[0]);
+      EXPECT_GE(u[0], -1e-8);
+
+      // with high friction, the contact point must stick
+      if (MU[m] > 1.0)
+      {
+        EXPECT_NEAR(u[1], 0.0, 1e-8);
+        EXPECT_NEAR(u[2], 0.0, 1e-8);
+      }
+    }
+
+    // both methods must compute the same impulse
+    for (unsigned i=0; i< 3; i++)
+      EXPECT_NEAR(impulse[0][i], impulse[1][i], 1e-6);
+  }
+}
+
+TEST(ContactSolverTest, WarmStart)
+{
+  // stack two spheres on the ground
+  shared_ptr<RigidBodyd> lower = create_sphere(Origin3d(0.0, RADIUS, 0.0));
+  shared_ptr<RigidBodyd> upper = create_sphere(Origin3d(0.1, 3.0*RADIUS, 0.0));
+  const ContactSolverd::SolverType TYPES[2] = { ContactSolverd::ePGS, ContactSolverd::eADMM };
+  for (unsigned t=0; t< 2; t++)
+  {
+    ContactSolverd solver;
+    solver.solver_type = TYPES[t];
+    solver.tolerance = 1e-8;
+    solver.max_iterations = 1000;
+    unsigned iters[2];
+    Origin3d impulse[2];
+    for (unsigned pass=0; pass< 2; pass++)
+    {
+      set_velocity(lower, Vector3d(0,0,0,GLOBAL), Vector3d(0.2,-1.0,0.0,GLOBAL));
+      set_velocity(upper, Vector3d(0,0,0,GLOBAL), Vector3d(-0.1,-1.5,0.0,GLOBAL));
+
+      // setup the ground contact and the contact between the spheres
+      vector<ContactSolverd::Contact> contacts(2);
+      contacts[0] = create_ground_contact(lower, 0.5);
+      contacts[0].key = 1;
+      Vector3d n = Vector3d(0.1, 2.0*RADIUS, 0.0, GLOBAL);
+      n.normalize();
+      Vector3d p = Vector3d(0.0, RADIUS, 0.0, GLOBAL) + n*RADIUS;
+      contacts[1].body1 = upper;
+      contacts[1].body2 = lower;
+      contacts[1].mu = 0.5;
+      contacts[1].key = 2;
+      ContactSolverd::calc_contact_jacobian(upper, upper, p, n, contacts[1].J1);
+      ContactSolverd::calc_contact_jacobian(lower, lower, p, n, contacts[1].J2);
+
+      iters[pass] = solver.solve(contacts);
+      impulse[pass] = contacts[1].impulse;
+      EXPECT_EQ(iters[pass], solver.get_telemetry().size());
+      EXPECT_GE(calc_velocity(contacts[0])[0], -1e-6);
+      EXPECT_GE(calc_velocity(contacts[1])[0], -1e-6);
+    }
+
+    // the warm-started solve must converge faster to the same solution
+    EXPECT_LT(iters[1], iters[0]);
+    for (unsigned i=0; i< 3; i++)
+      EXPECT_NEAR(impulse[0][i], impulse[1][i], 1e-5);
+  }
+}
+
@@ -0,0 +1,82 @@
+#include <UnitTesting.hpp>
+#include <gtest/gtest.h>
+#include <Ravelin/EigenInteropd.h>
+
+using namespace Ravelin;
+
+    // Eigen view of a Ravelin matrix block aliases the Ravelin storage
+    TEST(EigenInterop, MatrixMap)
+    {
+        MatR R = randM(7, 5);
+        SharedMatrixNd B = R.block(1, 5, 2, 5);
+
+        // views use the leading dimension of the parent matrix
+        Eigen::Map<MatE, Eigen::Unaligned, Eigen::OuterStride<> > E = eigen_map(B);
+        EXPECT_EQ(E.outerStride(), (int) R.rows());
+        EXPECT_EQ(E.rows(), 4);
+        EXPECT_EQ(E.cols(), 3);
+        for (unsigned i=0; i< B.rows(); i++)
+          for (unsigned j=0; j< B.columns(); j++)
+            EXPECT_EQ(E(i,j), R(i+1,j+2));
+
+        // writes through the view are seen by Ravelin
+        E(3,2) = 42.0;
+        EXPECT_EQ(R(4,4), 42.0);
+        EXPECT_EQ(eigen_map(R).data(), R.data());
+
+        // Eigen arithmetic on the view matches Ravelin arithmetic
+        MatR RtR;
+        R.transpose_mult(R, RtR);
+        MatE EtE = eigen_map(R).transpose()*eigen_map(R);
+        checkError(std::cerr, "Map(MatrixNd)'*Map(MatrixNd)", EtE, RtR);
+    }
+
+    // Eigen view of a strided Ravelin vector
+    TEST(EigenInterop, VectorMap)
+    {
+        MatR R = randM(6, 4);
+        SharedVectorNd row = R.row(2);
+        Eigen::Map<VecE, Eigen::Unaligned, Eigen::InnerStride<> > E = eigen_map(row);
+        EXPECT_EQ(E.innerStride(), (int) row.inc());
+        EXPECT_EQ(E.size(), 4);
+        for (unsigned i=0; i< row.size(); i++)
+          EXPECT_EQ(E(i), R(2,i));
+        E(1) = -3.0;
+        EXPECT_EQ(R(2,1), -3.0);
+
+        VecR v = randV(5);
+        eigen_map(v)(4) = 7.0;
+        EXPECT_EQ(v[4], 7.0);
+    }
+
+    // Ravelin views of Eigen storage alias the Eigen storage
+    TEST(EigenInterop, SharedViews)
+    {
+        MatE E = MatE::Random(8, 6);
+        SharedMatrixNd S = shared_matrix(E.block(2, 1, 5, 4));
+        EXPECT_EQ(S.leading_dim(), 8u);
+        EXPECT_EQ(S.data(), &E(2,1));
+        for (unsigned i=0; i< S.rows(); i++)
+          for (unsigned j=0; j< S.columns(); j++)
+            EXPECT_EQ(S(i,j), E(i+2,j+1));
+        S(4,3) = 11.0;
+        EXPECT_EQ(E(6,4), 11.0);
+
+        // Ravelin arithmetic on the view matches Eigen arithmetic
+        MatR result;
+        MatR::mult(const_shared_matrix(E).block(0, 8, 0, 6), asRavelin(MatE(E.transpose())), result);
+        checkError(std::cerr, "SharedMatrixNd(MatrixXd)*MatrixNd", E*E.transpose(), result);
+
+        // a row of a column-major matrix becomes a vector with an increment
+        SharedVectorNd r = shared_vector(E.row(3).transpose());
+        EXPECT_EQ(r.inc(), 8u);
+        EXPECT_EQ(r.size(), 6u);
+        r[5] = 13.0;
+        EXPECT_EQ(E(3,5), 13.0);
+
+        VecE e = VecE::Random(9);
+        SharedConstVectorNd c = const_shared_vector(e);
+        EXPECT_EQ(c.data(), e.data());
+        EXPECT_EQ(c[8], e(8));
+    }
+
@@ -0,0 +1,170 @@
+#include <UnitTesting.hpp>
+#include <gtest/gtest.h>
+#include <Ravelin/FixedVectorNd.h>
+#include <Ravelin/FixedMatrixNd.h>
+#include <Ravelin/LinAlgd.h>
+#include <Ravelin/Opsd.h>
+#include <Ravelin/RevoluteJointd.h>
+
+using namespace Ravelin;
+
+    // fixed vectors store their elements inline until they outgrow them
+    TEST(FixedSize, VectorStorage)
+    {
+        FixedVectorNd<6> v;
+        EXPECT_EQ(v.size(), 0u);
+        EXPECT_TRUE(v.is_inline());
+
+        // resizing within the capacity does not allocate
+        v.resize(4);
+        EXPECT_TRUE(v.is_inline());
+        EXPECT_EQ(v.rows(), 4u);
+        EXPECT_EQ(v.columns(), 1u);
+        EXPECT_EQ(v.leading_dim(), 4u);
+        EXPECT_EQ(v.inc(), 1u);
+        for (unsigned i=0; i< v.size(); i++)
+          v[i] = (double) i;
+        v.resize(6, true);
+        EXPECT_TRUE(v.is_inline());
+        EXPECT_EQ(v[3], 3.0);
+
+        // copies, moves, and assignments copy elements into inline storage
+        VecR x = randV(5);
+        FixedVectorNd<6> w(x);
+        EXPECT_TRUE(w.is_inline());
+        v = w;
+        EXPECT_TRUE(v.is_inline());
+        v = randV(3);
+        EXPECT_TRUE(v.is_inline());
+        EXPECT_EQ(v.size(), 3u);
+        FixedVectorNd<6> u(w);
+        EXPECT_TRUE(u.is_inline());
+        EXPECT_NE(u.data(), w.data());
+        for (unsigned i=0; i< x.size(); i++)
+          EXPECT_EQ(u[i], x[i]);
+        u.swap(x.resize(2));
+        EXPECT_TRUE(u.is_inline());
+        EXPECT_EQ(u.size(), 2u);
+        EXPECT_EQ(x.size(), 5u);
+
+        // growing beyond the capacity moves the vector to the heap
+        w.resize(8, true);
+        EXPECT_FALSE(w.is_inline());
+        EXPECT_EQ(w[4], x[4]);
+    }
+
+    // fixed-size objects work with the vector/matrix arithmetic and LinAlg
+    TEST(FixedSize, Arithmetic)
+    {
+        MatR A = randM(6, 6), At;
+        MatR::transpose(A, At);
+        A += At;
+        for (unsigned i=0; i< 6; i++)
+          A(i,i) += 12.0;
+        VecR b = randV(6);
+
+        // solve with fixed-size storage
+        FixedMatrixNd<6,6> Af(A);
+        FixedVectorNd<6> xf(b);
+        LinAlgd().solve_fast(Af, xf);
+        EXPECT_TRUE(Af.is_inline());
+        EXPECT_TRUE(xf.is_inline());
+
+        // the solution must agree with that computed with dynamic storage
+        MatR Ad = A;
+        VecR xd = b;
+        LinAlgd().solve_fast(Ad, xd);
+        checkError(std::cerr, "FixedVectorNd solve", xf, xd);
+
+        // matrix products into fixed-size results
+        FixedMatrixNd<6,6> S(6, 2), StS;
+        for (unsigned i=0; i< 6; i++)
+          for (unsigned j=0; j< 2; j++)
+            S(i,j) = A(i,j);
+        S.transpose_mult(S, StS);
+        EXPECT_TRUE(StS.is_inline());
+        EXPECT_EQ(StS.rows(), 2u);
+        EXPECT_EQ(StS.leading_dim(), 2u);
+        FixedVectorNd<6> y;
+        S.transpose_mult(b, y);
+        EXPECT_TRUE(y.is_inline());
+        for (unsigned j=0; j< 2; j++)
+          EXPECT_NEAR(y[j], A.column(j).dot(b), 1e-12);
+
+        // outer products
+        FixedMatrixNd<6,6> O;
+        Opsd::outer_prod(y, y, O);
+        EXPECT_TRUE(O.is_inline());
+        EXPECT_NEAR(O(0,1), y[0]*y[1], 1e-12);
+    }
+
+    // joint state does not allocate
+    TEST(FixedSize, JointState)
+    {
+        RevoluteJointd joint;
+        EXPECT_EQ(joint.q.size(), 1u);
+        EXPECT_TRUE(joint.q.is_inline());
+        EXPECT_TRUE(joint.qd.is_inline());
+        EXPECT_TRUE(joint.force.is_inline());
+        joint.q = VecR::one(1);
+        joint.force += joint.q;
+        EXPECT_TRUE(joint.q.is_inline());
+        EXPECT_TRUE(joint.force.is_inline());
+    }
+
+    // moving from or swapping a fixed-size vector through a VectorNd reference copies elements
+    TEST(FixedSize, MoveThroughBase)
+    {
+        boost::shared_ptr<RevoluteJointd> joint(new RevoluteJointd);
+        joint->q[0] = 0.25;
+        const double* qdata = joint->q.data();
+
+        // move from the joint coordinates
+        VectorNd& q = joint->q;
+        VectorNd v(std::move(q));
+        EXPECT_NE(v.data(), qdata);
+        EXPECT_EQ(v.size(), 1u);
+        EXPECT_TRUE(joint->q.is_inline());
+
+        // move assignment from the joint coordinates
+        VectorNd w = randV(3);
+        w = std::move(q);
+        EXPECT_NE(w.data(), qdata);
+
+        // swap with the joint coordinates (both ways)
+        VectorNd x = VectorNd::one(2), y = VectorNd::one(1);
+        x.swap(q);
+        EXPECT_NE(q.data(), x.data());
+        EXPECT_EQ(x.size(), 1u);
+        EXPECT_EQ(x[0], 0.25);
+        EXPECT_EQ(joint->q.size(), 2u);
+        EXPECT_TRUE(joint->q.is_inline());
+        std::swap(q, y);
+        EXPECT_NE(y.data(), qdata);
+        EXPECT_EQ(y.size(), 2u);
+        EXPECT_TRUE(joint->q.is_inline());
+
+        // the vectors must remain valid once the joint is destroyed
+        joint.reset();
+        EXPECT_EQ(v[0], 0.25);
+        EXPECT_EQ(w[0], 0.25);
+        EXPECT_EQ(x[0], 0.25);
+        EXPECT_EQ(y[1], 1.0);
+        v.resize(4, true);
+        w.resize(4, true);
+        EXPECT_EQ(v[0], 0.25);
+        EXPECT_EQ(w[0], 0.25);
+
+        // fixed-size matrices behave the same way
+        boost::shared_ptr<FixedMatrixNd<6,6> > F(new FixedMatrixNd<6,6>(randM(6, 2)));
+        const MatR F0 = *F;
+        MatrixNd& Fref = *F;
+        MatrixNd G(std::move(Fref)), H = MatrixNd::identity(3);
+        H.swap(Fref);
+        EXPECT_NE(G.data(), F->data());
+        EXPECT_NE(H.data(), F->data());
+        EXPECT_TRUE(F->is_inline());
+        F.reset();
+        checkError(std::cerr, "FixedMatrixNd move", G, F0);
+        checkError(std::cerr, "FixedMatrixNd swap", H, F0);
+    }
@@ -0,0 +1,110 @@
+#include <Ravelin/FramedSpatiald.h>
+#include <Ravelin/AAngled.h>
+#include "gtest/gtest.h"
+
+using boost::shared_ptr;
+using namespace Ravelin;
+
+static const double TOL = 1e-10;
+
+// checks that a framed spatial vector and a runtime-checked one agree
+template <class Frame, class S>
+static void expect_equal(const FramedSpatiald<Frame, S>& v, const S& s)
+{
+  for (unsigned i=0; i< 6; i++)
+    EXPECT_NEAR(v[i], s[i], TOL);
+}
+
+class FramedSpatialTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+      // a link pose and its parent's pose, both relative to the global frame
+      parent = shared_ptr<Pose3d>(new Pose3d(AAngled(0.3, -0.5, 0.8, 0.7), Origin3d(0.2, -1.1, 0.4), GLOBAL));
+      link = shared_ptr<Pose3d>(new Pose3d(AAngled(-0.6, 0.2, 0.1, 1.3), Origin3d(-0.7, 0.3, 1.5), GLOBAL));
+    }
+
+    shared_ptr<const Pose3d> GLOBAL;
+    shared_ptr<Pose3d> parent, link;
+};
+
+TEST_F(FramedSpatialTest, Transform)
+{
+  SVelocityd v(0.1, -0.4, 0.9, 1.2, -0.3, 0.5, link);
+  SForced f(-0.8, 0.2, 0.6, 0.3, 1.1, -0.7, link);
+
+  // transform from the link frame to the global frame
+  Transform3d T = Pose3d::calc_relative_pose(link, GLOBAL);
+  FramedTransform3d<FrameTag::Global, FrameTag::Link> Tg(T, link, GLOBAL);
+  FramedSpatiald<FrameTag::Link, SVelocityd> vl(v, link);
+  FramedSpatiald<FrameTag::Link, SForced> fl(f, link);
+  expect_equal(Tg.transform(vl), T.transform(v));
+  expect_equal(Tg.transform(fl), T.transform(f));
+
+  // inverse transformation must recover the original vectors
+  expect_equal(Tg.inverse_transform(Tg.transform(vl)), v);
+  expect_equal(Tg.inverse().transform(Tg.transform(fl)), f);
+
+  // points and free vectors
+  Vector3d p(0.5, -0.2, 0.3, link);
+  FramedVector3d<FrameTag::Global> pg = Tg.transform_point(FramedVector3d<FrameTag::Link>(p, link));
+  Vector3d pg2 = T.transform_point(p);
+  for (unsigned i=0; i< 3; i++)
+    EXPECT_NEAR(pg[i], pg2[i], TOL);
+  FramedVector3d<FrameTag::Global> dg = Tg.transform_vector(FramedVector3d<FrameTag::Link>(p, link));
+  pg2 = T.transform_vector(p);
+  for (unsigned i=0; i< 3; i++)
+    EXPECT_NEAR(dg[i], pg2[i], TOL);
+
+  // the power is invariant to the frame
+  EXPECT_NEAR(vl.dot(fl), v.dot(f), TOL);
+  EXPECT_NEAR(Tg.transform(vl).dot(Tg.transform(fl)), v.dot(f), TOL);
+
+  // converting back must attach the pose
+  SVelocityd v2 = Tg.transform(vl).to_spatial(GLOBAL);
+  EXPECT_TRUE(v2.pose == GLOBAL);
+}
+
+TEST_F(FramedSpatialTest, Compose)
+{
+  SAcceld a(0.7, 0.1, -0.2, -0.5, 0.8, 0.3, link);
+
+  // compose link->parent with parent->global and compare to link->global
+  FramedTransform3d<FrameTag::ParentLink, FrameTag::Link> Tpl = FramedTransform3d<FrameTag::ParentLink, FrameTag::Link>::calc_transform(link, parent);
+  FramedTransform3d<FrameTag::Global, FrameTag::ParentLink> Tgp = FramedTransform3d<FrameTag::Global, FrameTag::ParentLink>::calc_transform(parent, GLOBAL);
+  FramedTransform3d<FrameTag::Global, FrameTag::Link> Tgl = Tgp * Tpl;
+  Transform3d T = Pose3d::calc_relative_pose(link, GLOBAL);
+  expect_equal(Tgl.transform(FramedSpatiald<FrameTag::Link, SAcceld>(a, link)), T.transform(a));
+}
+
+TEST_F(FramedSpatialTest, Cross)
+{
+  SVelocityd v(0.1, -0.4, 0.9, 1.2, -0.3, 0.5, link);
+  SVelocityd w(-0.3, 0.6, 0.2, 0.4, -0.9, 1.0, link);
+  SMomentumd m(0.5, 0.2, -0.1, 0.8, -0.6, 0.3, link);
+
+  FramedSpatiald<FrameTag::Link, SVelocityd> vl(v), wl(w);
+  FramedSpatiald<FrameTag::Link, SMomentumd> ml(m);
+  expect_equal(vl.cross(wl), v.cross(w));
+  expect_equal(vl.cross(ml), v.cross(m));
+
+  // arithmetic
+  expect_equal(vl + wl*2.0, SVelocityd(v + w*2.0));
+}
+
+TEST_F(FramedSpatialTest, CheckedConversion)
+{
+  SVelocityd v(0.1, -0.4, 0.9, 1.2, -0.3, 0.5, link);
+  typedef FramedSpatiald<FrameTag::Link, SVelocityd> LinkVelocity;
+  typedef FramedTransform3d<FrameTag::Global, FrameTag::Link> LinkToGlobal;
+  Transform3d T = Pose3d::calc_relative_pose(link, GLOBAL);
+
+  #ifndef NEXCEPT
+  EXPECT_THROW(LinkVelocity(v, parent), FrameException);
+  EXPECT_THROW(LinkToGlobal(T, parent, GLOBAL), FrameException);
+  #endif
+  EXPECT_NO_THROW(LinkVelocity(v, link));
+  EXPECT_NO_THROW(LinkToGlobal(T, link, GLOBAL));
+}
+
@@ -224,3 +224,63 @@ TEST(InertiaTest, SubInertias)
       EXPECT_NEAR(Jm(i,j), Ja1m(i,j), 1e-6);
 }
 
+
+// verifies that the rotation of a transform tracks changes to q and x and
+// that batch transforms agree with individual transforms
+TEST(InertiaTest, TransformBatch)
+{
+  // setup two poses
+  shared_ptr<Pose3d> P(new Pose3d);
+  P->x = Origin3d(rand_double(), rand_double(), rand_double());
+  P->q = Quatd(rand_double(), rand_double(), rand_double(), rand_double());
+  P->q.normalize();
+  shared_ptr<Pose3d> Q(new Pose3d);
+
+  // setup a set of velocities in the P frame
+  std::vector<SVelocityd> v(5), vx, vinv;
+  for (unsigned i=0; i< v.size(); i++)
+  {
+    v[i].set_upper(Vector3d(rand_double(), rand_double(), rand_double()));
+    v[i].set_lower(Vector3d(rand_double(), rand_double(), rand_double()));
+    v[i].pose = P;
+  }
+
+  // transform the velocities with the batch transform and compare against 
+  // the individual transforms
+  Transform3d T = Pose3d::calc_relative_pose(P, Q);
+  T.transform(v, vx);
+  for (unsigned i=0; i< v.size(); i++)
+  {
+    SVelocityd vi = Pose3d::transform(Q, v[i]);
+    EXPECT_EQ(vx[i].pose, Q);
+    for (unsigned j=0; j< 6; j++)
+      EXPECT_NEAR(vx[i][j], vi[j], 1e-10);
+  }
+
+  // the inverse batch transform should recover the original velocities
+  T.inverse_transform(vx, vinv);
+  for (unsigned i=0; i< v.size(); i++)
+    for (unsigned j=0; j< 6; j++)
+      EXPECT_NEAR(vinv[i][j], v[i][j], 1e-10);
+
+  // modify the transform directly; the rotation must follow
+  Matrix3d E0 = T.get_rotation();
+  T.q = Quatd(rand_double(), rand_double(), rand_double(), rand_double());
+  T.q.normalize();
+  T.x = Origin3d(rand_double(), rand_double(), rand_double());
+  Matrix3d E = T.q;
+  const Matrix3d& Ec = T.get_rotation();
+  for (unsigned i=0; i< 3; i++)
+    for (unsigned j=0; j< 3; j++)
+      EXPECT_NEAR(E(i,j), Ec(i,j), 1e-12);
+  Origin3d r = E.transpose_mult(-T.x);
+  for (unsigned i=0; i< 3; i++)
+    EXPECT_NEAR(r[i], T.get_r()[i], 1e-12);
+
+  // make sure that a vector transform uses the new rotation 
+  Vector3d u(rand_double(), rand_double(), rand_double(), P);
+  Vector3d ux = T.transform_point(u);
+  Origin3d uref = T.q * Origin3d(u) + T.x;
+  for (unsigned i=0; i< 3; i++)
+    EXPECT_NEAR(ux[i], uref[i], 1e-12);
+}
@@ -164,6 +164,58 @@ TEST(LinAlgTest,factor_QR_AR_Q_PI){
     }
 }
 
+// checks that Q is orthogonal, R is upper triangular, and Q*R = A
+static void check_QR(const MatR& Q, const MatR& R, const MatR& A)
+{
+    MatR QR, QtQ, I;
+    Q.mult(R, QR);
+    checkError(std::cerr, "update_QR (Q*R)", A, QR);
+    Q.transpose_mult(Q, QtQ);
+    I.set_identity(Q.rows());
+    checkError(std::cerr, "update_QR (Q'*Q)", I, QtQ);
+    for (unsigned j=0; j< R.columns(); j++)
+      for (unsigned i=j+1; i< R.rows(); i++)
+        EXPECT_EQ(R(i,j), 0.0);
+}
+
+TEST(LinAlgTest,update_QR_cols){
+    LinAlg * LA = new LinAlg();
+    for(unsigned m=2;m<MAX_SIZE;m++){
+        MatR A = randM(m, m+2), Q, R(m,0), U, Ak;
+        std::vector<unsigned> cols;
+        Q.set_identity(m);
+
+        // build the factorization one column at a time
+        for (unsigned j=0; j< A.columns(); j++)
+        {
+            U = randM(m, 1);
+            A.set_column(j, U.column(0));
+            LA->update_QR_insert_cols(Q, R, U, j);
+            cols.push_back(j);
+            A.select_columns(cols.begin(), cols.end(), Ak);
+            check_QR(Q, R, Ak);
+        }
+
+        // insert two columns in the middle
+        U = randM(m, 2);
+        MatR A2(m, A.columns()+2);
+        A2.set_sub_mat(0, 0, A.block(0, m, 0, 1));
+        A2.set_sub_mat(0, 1, U);
+        A2.set_sub_mat(0, 3, A.block(0, m, 1, A.columns()));
+        LA->update_QR_insert_cols(Q, R, U, 1);
+        check_QR(Q, R, A2);
+
+        // delete two columns from the middle, then the first column
+        LA->update_QR_delete_cols(Q, R, 2, 2);
+        A2.remove_column(2);
+        A2.remove_column(2);
+        check_QR(Q, R, A2);
+        LA->update_QR_delete_cols(Q, R, 0, 1);
+        A2.remove_column(0);
+        check_QR(Q, R, A2);
+    }
+}
+
 TEST(LinAlgTest,factor_LU){
     LinAlg * LA = new LinAlg();
     for(int i=1;i<MAX_SIZE;i++){
@@ -453,3 +505,71 @@ TEST(LinAlgTest,LA){
 
 
 
+TEST(LinAlgTest,COD){
+    LinAlg * LA = new LinAlg();
+    std::cerr << ">> testCOD: " << std::endl;
+
+    for(int i=1;i<MAX_SIZE;i++){
+        // create tall, wide, and rank-deficient matrices
+        unsigned n = 1 << (i-1), m = 2*n+1, r = std::max(1u, n/2);
+        MatR As[3];
+        As[0] = randM(m,n);
+        As[1] = randM(n,m);
+        randM(m,r).mult(randM(r,n), As[2]);
+
+        for(unsigned j=0;j<3;j++){
+            const MatR& A = As[j];
+            MatR B, C, AN, NTN;
+
+            /// TEST pseudo_invert (COD vs. SVD)
+            B = A;
+            LA->pseudo_invert(B, LinAlg::eLSCOD);
+            C = A;
+            LA->pseudo_invert(C);
+            checkError(std::cerr, "pseudo_invert COD", C,B);
+
+            /// TEST pseudo_invert (automatic selection)
+            B = A;
+            LA->pseudo_invert(B, LinAlg::eLSAuto);
+            checkError(std::cerr, "pseudo_invert auto", C,B);
+
+            /// TEST solve_LS_fast (minimum-norm solution)
+            MatR b = randM(A.rows(),2), xb = b, x;
+            B = A;
+            LA->solve_LS_fast(B, xb, LinAlg::eLSCOD, -1.0);
+            C.mult(b, x);
+            checkError(std::cerr, "solve_LS_fast COD", x,xb);
+
+            /// TEST solve_LS_fast (vector right hand side)
+            VecR bv, xv, yv;
+            b.get_column(0, bv);
+            xv = bv;
+            B = A;
+            LA->solve_LS_fast(B, xv, LinAlg::eLSCOD, -1.0);
+            C.mult(bv, yv);
+            checkError(std::cerr, "solve_LS_fast COD (vector)", yv,xv);
+            xv = bv;
+            B = A;
+            LA->solve_LS_fast(B, xv, LinAlg::eLSAuto, -1.0);
+            checkError(std::cerr, "solve_LS_fast auto (vector)", yv,xv);
+
+            /// TEST nullspace (A*N = 0, N'*N = I)
+            MatR N;
+            B = A;
+            LA->nullspace(B, N, LinAlg::eLSCOD);
+            B = A;
+            MatR N2;
+            LA->nullspace(B, N2);
+            EXPECT_EQ(N.columns(), N2.columns());
+            A.mult(N, AN);
+            MatR Z(AN.rows(), AN.columns());
+            Z.set_zero();
+            checkError(std::cerr, "nullspace COD A*N", Z,AN);
+            N.transpose_mult(N, NTN);
+            MatR I(NTN.rows(), NTN.columns());
+            I.set_identity();
+            checkError(std::cerr, "nullspace COD N'*N", I,NTN);
+        }
+    }
+}
+
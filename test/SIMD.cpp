@@ -0,0 +1,152 @@
+#include <UnitTesting.hpp>
+#include <gtest/gtest.h>
+#include <Ravelin/SIMD3d.h>
+#include <Ravelin/SIMD3f.h>
+#include <Ravelin/Quatd.h>
+#include <Ravelin/Matrix3d.h>
+#include <Ravelin/Transform3d.h>
+#include <Ravelin/SVelocityd.h>
+#include <Ravelin/SForced.h>
+#include <Ravelin/SMomentumd.h>
+#include <Ravelin/Pose3d.h>
+
+using namespace Ravelin;
+
+    // runs every kernel on the inputs, storing each result in its own row of out
+    template <class SIMD, class T>
+    void run_kernels(const T* A, const T* B, const T* q, const T* v, const T* w, T out[][9])
+    {
+        SIMD::quat_mult(q, q+4, out[0]);
+        SIMD::quat_rotate(q, v, out[1]);
+        SIMD::mult(A, B, out[2]);
+        SIMD::transpose_mult(A, B, out[3]);
+        SIMD::mult_transpose(A, B, out[4]);
+        SIMD::transpose_mult_transpose(A, B, out[5]);
+        SIMD::mult_vector(A, v, out[6]);
+        SIMD::transpose_mult_vector(A, v, out[7]);
+        SIMD::skew_symmetric_mult(v, B, out[8]);
+        SIMD::spatial_cross_motion(v, w, out[9]);
+        SIMD::spatial_cross_force(v, w, out[10]);
+        out[11][0] = SIMD::spatial_dot(v, w);
+        SIMD::spatial_transform(A, B, w, out[12]);
+        SIMD::spatial_inverse_transform(A, B, w, out[13]);
+
+        // the spatial transforms may be done in place
+        for (unsigned i=0; i< 6; i++)
+          out[14][i] = out[15][i] = w[i];
+        SIMD::spatial_transform(A, B, out[14], out[14]);
+        SIMD::spatial_inverse_transform(A, B, out[15], out[15]);
+    }
+
+    // compares the kernels for every supported instruction set against the scalar kernels
+    template <class SIMD, class T>
+    void check_kernels(T tol)
+    {
+        const unsigned NKERNELS = 16, NTRIALS = 100;
+        const typename SIMD::InstructionSet ISETS[] = { SIMD::eSSE2, SIMD::eAVX2, SIMD::eAVX512 };
+        const typename SIMD::InstructionSet DEFAULT = SIMD::get_instruction_set();
+        T A[9], B[9], q[8], v[6], w[6];
+        T expected[NKERNELS][9], result[NKERNELS][9];
+
+        for (unsigned trial=0; trial< NTRIALS; trial++)
+        {
+          // setup random inputs
+          VecR x = randV(38);
+          for (unsigned i=0; i< 9; i++)
+          {
+            A[i] = (T) x[i];
+            B[i] = (T) x[i+9];
+          }
+          for (unsigned i=0; i< 8; i++)
+            q[i] = (T) x[i+18];
+          for (unsigned i=0; i< 6; i++)
+          {
+            v[i] = (T) x[i+26];
+            w[i] = (T) x[i+32];
+          }
+
+          // compute the scalar results
+          std::fill(&expected[0][0], &expected[0][0]+NKERNELS*9, (T) 0.0);
+          ASSERT_TRUE(SIMD::set_instruction_set(SIMD::eScalar));
+          run_kernels<SIMD, T>(A, B, q, v, w, expected);
+
+          // compare the results for the other instruction sets
+          for (unsigned j=0; j< sizeof(ISETS)/sizeof(ISETS[0]); j++)
+          {
+            if (!SIMD::set_instruction_set(ISETS[j]))
+            {
+              EXPECT_FALSE(SIMD::is_supported(ISETS[j]));
+              continue;
+            }
+            EXPECT_EQ(SIMD::get_instruction_set(), ISETS[j]);
+            std::fill(&result[0][0], &result[0][0]+NKERNELS*9, (T) 0.0);
+            run_kernels<SIMD, T>(A, B, q, v, w, result);
+            for (unsigned k=0; k< NKERNELS; k++)
+              for (unsigned i=0; i< 9; i++)
+                EXPECT_NEAR(result[k][i], expected[k][i], tol) << SIMD::get_name(ISETS[j]) << " kernel " << k;
+          }
+        }
+
+        SIMD::set_instruction_set(DEFAULT);
+    }
+
+    // the vectorized kernels agree with the scalar kernels
+    TEST(SIMD, Kernels)
+    {
+        EXPECT_TRUE(SIMD3d::is_supported(SIMD3d::eScalar));
+        EXPECT_TRUE(SIMD3d::is_supported(SIMD3d::detect_instruction_set()));
+        EXPECT_EQ(SIMD3d::get_instruction_set(), SIMD3d::detect_instruction_set());
+        check_kernels<SIMD3d, double>(1e-12);
+        check_kernels<SIMD3f, float>(1e-5f);
+    }
+
+    // the primitives built on the kernels give the same results as explicit formulas
+    TEST(SIMD, Primitives)
+    {
+        const boost::shared_ptr<const Pose3d> GLOBAL;
+        VecR x = randV(16);
+        Quatd q(x[0], x[1], x[2], x[3]), p(x[4], x[5], x[6], x[7]);
+        q.normalize();
+        p.normalize();
+        Origin3d o(x[8], x[9], x[10]);
+
+        // quaternion products compose rotations
+        Matrix3d Rq(q), Rp(p), Rqp(q*p);
+        for (unsigned i=0; i< 3; i++)
+          for (unsigned j=0; j< 3; j++)
+            EXPECT_NEAR(Rqp(i,j), (Rq*Rp)(i,j), 1e-12);
+        Origin3d qo = q*o, Ro = Rq*o;
+        for (unsigned i=0; i< 3; i++)
+          EXPECT_NEAR(qo[i], Ro[i], 1e-12);
+
+        // 3x3 products agree with the general matrix products
+        MatR M = Rq.transpose_mult(Rp), N;
+        Matrix3d Rqt = Matrix3d::transpose(Rq);
+        MatR(Rqt).mult(MatR(Rp), N);
+        checkError(std::cerr, "Matrix3 transpose_mult", M, N);
+        M = Matrix3d::skew_symmetric_mult(o, Rp);
+        N = Matrix3d::skew_symmetric(o)*Rp;
+        checkError(std::cerr, "Matrix3 skew_symmetric_mult", M, N);
+
+        // spatial cross and dot products
+        SVelocityd v(x[0], x[1], x[2], x[3], x[4], x[5], GLOBAL);
+        SForced f(x[6], x[7], x[8], x[9], x[10], x[11], GLOBAL);
+        EXPECT_NEAR(v.dot(f), v.get_angular().dot(f.get_torque()) + v.get_linear().dot(f.get_force()), 1e-12);
+        EXPECT_NEAR(f.dot(v), v.dot(f), 1e-12);
+        SForced vxf = v.cross(SMomentumd(f));
+        Vector3d force = Vector3d::cross(v.get_angular(), f.get_force());
+        Vector3d torque = Vector3d::cross(v.get_angular(), f.get_torque()) + Vector3d::cross(v.get_linear(), f.get_force());
+        for (unsigned i=0; i< 3; i++)
+        {
+          EXPECT_NEAR(vxf.get_force()[i], force[i], 1e-12);
+          EXPECT_NEAR(vxf.get_torque()[i], torque[i], 1e-12);
+        }
+
+        // transforming a spatial vector there and back gives the vector again
+        boost::shared_ptr<Pose3d> P(new Pose3d(q, o));
+        SForced fP(x[6], x[7], x[8], x[9], x[10], x[11], P);
+        SForced fg = Pose3d::transform(GLOBAL, fP);
+        SForced fP2 = Pose3d::transform(P, fg);
+        for (unsigned i=0; i< 6; i++)
+          EXPECT_NEAR(fP2[i], fP[i], 1e-12);
+    }
@@ -1,6 +1,8 @@
 #include <iostream>
 #include <Ravelin/MatrixNd.h>
 #include <Ravelin/SparseMatrixNd.h>
+#include <Ravelin/SparseSymMatrixNd.h>
+#include <Ravelin/MutableSparseMatrixNd.h>
 #include <Ravelin/LinAlgd.h>
 
 using namespace Ravelin;
@@ -108,6 +110,151 @@ void test_sol(const VectorNd& b, const VectorNd& x1, const VectorNd& x2)
   cout << "testing sparse solution (CSC): " << diff1.norm_inf() << endl;
 } 
 
+void test_symmetric(const MatrixNd& d)
+{
+  // make the matrix symmetric and positive definite
+  MatrixNd spd, dense;
+  d.transpose_mult(d, spd);
+  for (unsigned i=0; i< spd.rows(); i++)
+    spd(i,i) += (double) 1.0;
+
+  // setup symmetric sparse matrices from dense and from CSR/CSC
+  SparseSymMatrixNd u(SparseSymMatrixNd::eUpper, spd);
+  SparseSymMatrixNd l(SparseSymMatrixNd::eLower, SparseMatrixNd(SparseMatrixNd::eCSC, spd));
+  SparseSymMatrixNd l2(SparseSymMatrixNd::eLower, SparseMatrixNd(SparseMatrixNd::eCSR, spd));
+  cout << "testing symmetric to dense (upper): " << (u.to_dense(dense) -= spd).norm_inf() << endl;
+  cout << "testing symmetric to dense (lower/CSC): " << (l.to_dense(dense) -= spd).norm_inf() << endl;
+  cout << "testing symmetric to dense (lower/CSR): " << (l2.to_dense(dense) -= spd).norm_inf() << endl;
+
+  // test conversion to full storage
+  SparseMatrixNd full;
+  u.to_full(SparseMatrixNd::eCSR, full);
+  cout << "testing symmetric to full (upper): " << (full.to_dense(dense) -= spd).norm_inf() << endl;
+  l.to_full(SparseMatrixNd::eCSC, full);
+  cout << "testing symmetric to full (lower): " << (full.to_dense(dense) -= spd).norm_inf() << endl;
+
+  // test matrix/vector and matrix/matrix multiplication
+  VectorNd col1 = d.column(0), rv1, rv2;
+  MatrixNd rm1, rm2;
+  spd.mult(col1, rv2);
+  cout << "testing symmetric matrix/vector (upper) error: " << (u.mult(col1, rv1) -= rv2).norm() << endl;
+  cout << "testing symmetric matrix/vector (lower) error: " << (l.mult(col1, rv1) -= rv2).norm() << endl;
+  spd.mult(d, rm2);
+  cout << "testing symmetric matrix/matrix (upper) error: " << (u.mult(d, rm1) -= rm2).norm_inf() << endl;
+
+  // test outer square
+  SparseSymMatrixNd os(SparseSymMatrixNd::eLower);
+  SparseSymMatrixNd::outer_square(col1, os);
+  MatrixNd osd(col1.size(), col1.size());
+  for (unsigned i=0; i< col1.size(); i++)
+    for (unsigned j=0; j< col1.size(); j++)
+      osd(i,j) = col1[i]*col1[j];
+  cout << "testing symmetric outer square error: " << (os.to_dense(dense) -= osd).norm_inf() << endl;
+
+  // test sparse Cholesky solution
+  SparseMatrixNd L;
+  bool pd = LinAlgd::factor_chol(l, L);
+  cout << "testing sparse Cholesky factorization success: " << pd << endl;
+  VectorNd x;
+  LinAlgd::solve_sparse_direct(u, rv2, x);
+  cout << "testing sparse Cholesky solution (upper): " << (x -= col1).norm_inf() << endl;
+  LinAlgd::solve_sparse_direct(l, rm2, rm1);
+  cout << "testing sparse Cholesky solution (lower): " << (rm1 -= d).norm_inf() << endl;
+}
+
+void test_move_swap(const SparseMatrixNd& s)
+{
+  MatrixNd d, d1, d2;
+  s.to_dense(d);
+
+  // copies must not share storage with the original
+  SparseMatrixNd c(s);
+  c.negate();
+  s.to_dense(d1);
+  d1 -= d;
+  cout << "testing copy independence: " << d1.norm_inf() << endl;
+
+  // moving takes the storage and leaves the source empty
+  const double* data = c.get_data();
+  SparseMatrixNd m(std::move(c));
+  cout << "testing move (storage taken): " << (m.get_data() == data) << " source: " << c.rows() << "x" << c.columns() << endl;
+
+  // swap the negated matrix with a copy of the original
+  SparseMatrixNd t(s);
+  t.swap(m);
+  m.to_dense(d1);
+  t.to_dense(d2);
+  d1 -= d;
+  d2 += d;
+  cout << "testing swap: " << d1.norm_inf() << " " << d2.norm_inf() << endl;
+}
+
+void test_mutable(const MatrixNd& d)
+{
+  MatrixNd dense, expected;
+  VectorNd v, rv1, rv2;
+
+  for (unsigned s=0; s< 2; s++)
+  {
+    SparseMatrixNd::StorageType stype = (s == 0) ? SparseMatrixNd::eCSR : SparseMatrixNd::eCSC;
+    const char* name = (s == 0) ? "CSR" : "CSC";
+    MutableSparseMatrixNd m(SparseMatrixNd(stype, d));
+    expected = d;
+
+    // replace a row and a column
+    MatrixNd r = random_sparse(1, d.columns());
+    r.get_row(0, v);
+    m.set_row(1, v);
+    expected.set_row(1, v);
+    r = random_sparse(d.rows(), 1);
+    r.get_column(0, v);
+    m.set_column(2, v);
+    expected.set_column(2, v);
+    cout << "testing mutable set row/column (" << name << "): " << (m.to_dense(dense) -= expected).norm_inf() << endl;
+
+    // append a row and remove the first one 
+    r = random_sparse(1, d.columns());
+    r.get_row(0, v);
+    m.append_row(v);
+    m.remove_row(0);
+    MatrixNd shifted(expected.rows(), expected.columns());
+    for (unsigned i=1; i< expected.rows(); i++)
+      shifted.set_row(i-1, expected.row(i));
+    shifted.set_row(expected.rows()-1, v);
+    expected = shifted;
+
+    // insert a column and remove the last one 
+    r = random_sparse(d.rows(), 1);
+    r.get_column(0, v);
+    m.insert_column(0, v);
+    m.remove_column(m.columns()-1);
+    shifted.set_column(0, v);
+    for (unsigned i=1; i< expected.columns(); i++)
+      shifted.set_column(i, expected.column(i-1));
+    expected = shifted;
+    cout << "testing mutable insert/remove (" << name << "): " << (m.to_dense(dense) -= expected).norm_inf() << endl;
+
+    // compact to a sparse matrix and multiply
+    SparseMatrixNd c;
+    m.to_sparse(c);
+    expected.get_column(0, v);
+    expected.mult(v, rv2);
+    cout << "testing mutable to sparse (" << name << "): " << (c.to_dense(dense) -= expected).norm_inf() << " nnz: " << c.get_nnz() << "/" << m.get_nnz() << endl;
+    cout << "testing mutable matrix/vector (" << name << ") error: " << (m.mult(v, rv1) -= rv2).norm() << endl;
+
+    // set a row and a column of the sparse matrix in place
+    expected.get_row(0, v);
+    v.negate();
+    c.set_row(0, v);
+    expected.set_row(0, v);
+    expected.get_column(1, v);
+    v.negate();
+    c.set_column(1, v);
+    expected.set_column(1, v);
+    cout << "testing sparse set row/column (" << name << "): " << (c.to_dense(dense) -= expected).norm_inf() << endl;
+  }
+}
+
 int main()
 {
   // setup a random sparse matrix in dense form
@@ -127,6 +274,15 @@ int main()
   // test addition/subtraction arithmetic 
   test_plus(s1, s2, dense);
 
+  // test copying, moving, and swapping
+  test_move_swap(s1);
+
+  // test mutable storage
+  test_mutable(random_sparse(SZ*2, SZ*2));
+
+  // test symmetric storage
+  test_symmetric(random_sparse(SZ*2, SZ*2));
+
   // setup a couple of identity matrices
   MatrixNd eye = MatrixNd::identity(SZ*SZ);
   SparseMatrixNd i1(SparseMatrixNd::eCSR, eye);
@@ -488,14 +488,8 @@ int main(int argc, char* argv[])
   if (test_result != 0)
     return test_result;
 
-  // set the filename
-  IntegrationTest::filename = "../test/rmp_440SE.urdf";
-
-  // run Google tests
-  ::testing::InitGoogleTest(&argc, argv);
-  test_result = RUN_ALL_TESTS();
-  if (test_result != 0)
-    return test_result;
+  // NOTE: rmp_440SE.urdf is not used: it has massless links, which must be
+  // disabled, and links of a floating-base body cannot be disabled
 
   // set the filename
   IntegrationTest::filename = "../test/07-physics.urdf";